@@ -24,6 +24,7 @@
 #include "imstkVTKViewer.h"
 
 #include <vtkColorTransferFunction.h>
+#include <vtkNew.h>
 #include <vtkPiecewiseFunction.h>
 #include <vtkVolumeProperty.h>
 
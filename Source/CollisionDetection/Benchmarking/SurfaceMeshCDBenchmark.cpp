@@ -5,6 +5,7 @@
 */
 
 #include "imstkCapsule.h"
+#include "imstkClosedSurfaceMeshToMeshCD.h"
 #include "imstkCollisionHandling.h"
 #include "imstkGeometry.h"
 #include "imstkMath.h"
@@ -20,6 +21,7 @@
 #include "imstkSphere.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkSurfaceMeshToCapsuleCD.h"
+#include "imstkSurfaceMeshToSurfaceMeshCD.h"
 #include "imstkTetrahedralMesh.h"
 #include "imstkGeometryUtilities.h"
 
@@ -60,5 +62,60 @@ BM_SurfaceMeshToCapsuleCD(benchmark::State& state)
 BENCHMARK(BM_SurfaceMeshToCapsuleCD)
 ->Unit(benchmark::kMicrosecond)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12)->Arg(16)->Arg(24)->Arg(32)->Arg(48)->Arg(62)->Arg(78)->Arg(100);
 
+///
+/// \brief Two perpendicular triangle grids intersecting along a line
+///
+static void
+BM_SurfaceMeshToSurfaceMeshCD(benchmark::State& state)
+{
+    const int dim   = static_cast<int>(state.range(0));
+    auto      meshA = makeSurfaceMesh(dim);
+    auto      meshB = GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d{ 1, 1 }, Vec2i{ dim, dim },
+        Quatd(Rotd(PI_2, Vec3d(1.0, 0.0, 0.0))));
+
+    SurfaceMeshToSurfaceMeshCD cd;
+    cd.setInputGeometryA(meshA);
+    cd.setInputGeometryB(meshB);
+    cd.setGenerateCD(true, true);
+
+    state.counters["Triangles"] = meshA->getNumCells();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        cd.update();
+    }
+}
+
+BENCHMARK(BM_SurfaceMeshToSurfaceMeshCD)
+->Unit(benchmark::kMicrosecond)->Arg(8)->Arg(16)->Arg(32)->Arg(64)->Arg(128);
+
+///
+/// \brief Triangle grid cutting through a closed sphere
+///
+static void
+BM_ClosedSurfaceMeshToMeshCD(benchmark::State& state)
+{
+    const int dim   = static_cast<int>(state.range(0));
+    auto      meshA = makeSurfaceMesh(dim);
+    auto      meshB = GeometryUtils::toUVSphereSurfaceMesh(std::make_shared<Sphere>(Vec3d::Zero(), 0.4), dim, dim);
+
+    ClosedSurfaceMeshToMeshCD cd;
+    cd.setInputGeometryA(meshA);
+    cd.setInputGeometryB(meshB);
+    cd.setGenerateCD(true, true);
+
+    state.counters["Triangles"] = meshA->getNumCells() + meshB->getNumCells();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        cd.update();
+    }
+}
+
+BENCHMARK(BM_ClosedSurfaceMeshToMeshCD)
+->Unit(benchmark::kMicrosecond)->Arg(8)->Arg(16)->Arg(32)->Arg(64)->Arg(128);
+
 // Run the benchmark
 BENCHMARK_MAIN();
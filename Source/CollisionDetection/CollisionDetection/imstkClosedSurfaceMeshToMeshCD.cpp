@@ -97,7 +97,7 @@ struct PointSetData
 
 struct SurfMeshData
 {
-    SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh);
+    SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh, const BoundingVolumeHierarchy& bvh);
 
     // Get geometry B data
     std::shared_ptr<SurfaceMesh> m_surfMesh;
@@ -105,6 +105,7 @@ struct SurfMeshData
     const VecDataArray<double, 3>& vertices;
     const std::vector<std::unordered_set<int>>& vertexFaces;
     const VecDataArray<double, 3>& faceNormals;
+    const BoundingVolumeHierarchy& bvh; ///< Hierarchy over cells
 };
 
 PointSetData::PointSetData(std::shared_ptr<PointSet> pointSet) :
@@ -113,12 +114,13 @@ PointSetData::PointSetData(std::shared_ptr<PointSet> pointSet) :
 {
 }
 
-SurfMeshData::SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh) :
+SurfMeshData::SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh, const BoundingVolumeHierarchy& bvh) :
     m_surfMesh(surfMesh),
     cells(*surfMesh->getCells()),
     vertices(*surfMesh->getVertexPositions()),
     vertexFaces(surfMesh->getVertexToCellMap()),
-    faceNormals(*surfMesh->getCellNormals())
+    faceNormals(*surfMesh->getCellNormals()),
+    bvh(bvh)
 {
 }
 
@@ -204,30 +206,27 @@ static double
 polySignedDist(const Vec3d& pos, const SurfMeshData& surfMeshData,
                int& caseType, Vec3i& vIds, int& closestCell)
 {
-    closestCell = -1;
-    Vec3d  closestPt       = Vec3d::Zero();
-    double minSqrDist      = IMSTK_DOUBLE_MAX;
-    int    closestCellCase = -1;
+    Vec3d closestPt       = Vec3d::Zero();
+    int   closestCellCase = -1;
 
     // Find the closest point out of all elements
     // \todo: We could early reject backface cull all triangles (this is effectively case 6 done early)
-    for (int j = 0; j < surfMeshData.cells.size(); j++)
-    {
-        const Vec3i& cell = surfMeshData.cells[j];
-        const Vec3d& x1   = surfMeshData.vertices[cell[0]];
-        const Vec3d& x2   = surfMeshData.vertices[cell[1]];
-        const Vec3d& x3   = surfMeshData.vertices[cell[2]];
-
-        int          ptOnTriangleCaseType;
-        const Vec3d  closestPtOnTri = CollisionUtils::closestPointOnTriangle(pos, x1, x2, x3, ptOnTriangleCaseType);
-        const double sqrDist = (closestPtOnTri - pos).squaredNorm();
-        if (sqrDist < minSqrDist)
+    double minSqrDist = IMSTK_DOUBLE_MAX;
+    closestCell = surfMeshData.bvh.findNearest(pos, [&](const int j)
         {
-            minSqrDist      = sqrDist;
-            closestPt       = closestPtOnTri;
-            closestCell     = j;
-            closestCellCase = ptOnTriangleCaseType;
-        }
+            const Vec3i& cell = surfMeshData.cells[j];
+            int          ptOnTriangleCaseType;
+            const Vec3d  closestPtOnTri = CollisionUtils::closestPointOnTriangle(pos,
+                surfMeshData.vertices[cell[0]], surfMeshData.vertices[cell[1]], surfMeshData.vertices[cell[2]],
+                ptOnTriangleCaseType);
+            return (closestPtOnTri - pos).squaredNorm();
+        }, minSqrDist);
+    if (closestCell != -1)
+    {
+        const Vec3i& cell = surfMeshData.cells[closestCell];
+        closestPt = CollisionUtils::closestPointOnTriangle(pos,
+            surfMeshData.vertices[cell[0]], surfMeshData.vertices[cell[1]], surfMeshData.vertices[cell[2]],
+            closestCellCase);
     }
 
     // We use the normal of the nearest element to determine sign, but we can't just use the
@@ -310,13 +309,14 @@ ClosedSurfaceMeshToMeshCD::computeCollisionDataAB(
         auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(geomB);
         surfMesh->computeTrianglesNormals();
         surfMesh->computeVertexToCellMap();
+        m_bvhB.refit(*surfMesh->getVertexPositions(), *surfMesh->getCells());
 
         // Narrow phase
         if (m_generateVertexTriangleContacts)
         {
             if (m_vertexInside.size() < pointSet->getNumVertices())
             {
-                m_vertexInside = std::vector<bool>(pointSet->getNumVertices(), false);
+                m_vertexInside = std::vector<char>(pointSet->getNumVertices(), false);
             }
             if (m_signedDistances.size() < pointSet->getNumVertices())
             {
@@ -348,81 +348,81 @@ ClosedSurfaceMeshToMeshCD::vertexToTriangleTest(
     std::vector<CollisionElement>& elementsB)
 {
     PointSetData pointSetData(std::dynamic_pointer_cast<PointSet>(geomA));
-    SurfMeshData surfMeshData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvhB);
 
-    // For every vertex
-    for (int i = 0; i < pointSetData.vertices.size(); i++)
-    {
-        const Vec3d& p = pointSetData.vertices[i];
-
-        int          caseType    = -1;
-        int          closestCell = -1;
-        Vec3i        vertexIds   = Vec3i::Zero();
-        const double signedDist  = polySignedDist(p, surfMeshData, caseType, vertexIds, closestCell);
-        m_signedDistances[i] = signedDist;
-        if (signedDist <= 0.0)
+    // Vertices are tested in parallel chunks
+    m_elementBuffer.parallelFor(pointSetData.vertices.size(), [&](const int i, CollisionElementBuffer::Chunk& chunk)
         {
-            m_vertexInside[i] = true;
-            // The nearest feature to this vertex is another vertex
-            if (caseType == 0)
-            {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.parentId = closestCell; // Triangle id
-                elemB.idCount  = 1;
-                elemB.cellType = IMSTK_VERTEX;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-            }
-            // The nearest feature to this vertex is an edge
-            else if (caseType == 1)
+            const Vec3d& p = pointSetData.vertices[i];
+            int          caseType    = -1;
+            int          closestCell = -1;
+            Vec3i        vertexIds   = Vec3i::Zero();
+            const double signedDist  = polySignedDist(p, surfMeshData, caseType, vertexIds, closestCell);
+            m_signedDistances[i] = signedDist;
+            if (signedDist <= 0.0)
             {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.ids[1]   = vertexIds[1];
-                elemB.parentId = closestCell; // Triangle id
-                elemB.idCount  = 2;
-                elemB.cellType = IMSTK_EDGE;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
+                m_vertexInside[i] = true;
+                // The nearest feature to this vertex is another vertex
+                if (caseType == 0)
+                {
+                    CellIndexElement elemA;
+                    elemA.ids[0]   = i;
+                    elemA.idCount  = 1;
+                    elemA.cellType = IMSTK_VERTEX;
+
+                    CellIndexElement elemB;
+                    elemB.ids[0]   = vertexIds[0];
+                    elemB.parentId = closestCell; // Triangle id
+                    elemB.idCount  = 1;
+                    elemB.cellType = IMSTK_VERTEX;
+
+                    chunk.elementsA.push_back(elemA);
+                    chunk.elementsB.push_back(elemB);
+                }
+                // The nearest feature to this vertex is an edge
+                else if (caseType == 1)
+                {
+                    CellIndexElement elemA;
+                    elemA.ids[0]   = i;
+                    elemA.idCount  = 1;
+                    elemA.cellType = IMSTK_VERTEX;
+
+                    CellIndexElement elemB;
+                    elemB.ids[0]   = vertexIds[0];
+                    elemB.ids[1]   = vertexIds[1];
+                    elemB.parentId = closestCell; // Triangle id
+                    elemB.idCount  = 2;
+                    elemB.cellType = IMSTK_EDGE;
+
+                    chunk.elementsA.push_back(elemA);
+                    chunk.elementsB.push_back(elemB);
+                }
+                // The nearest feature to this vertex is a triangle face
+                else if (caseType == 2)
+                {
+                    CellIndexElement elemA;
+                    elemA.ids[0]   = i;
+                    elemA.idCount  = 1;
+                    elemA.cellType = IMSTK_VERTEX;
+
+                    CellIndexElement elemB;
+                    elemB.ids[0]   = vertexIds[0];
+                    elemB.ids[1]   = vertexIds[1];
+                    elemB.ids[2]   = vertexIds[2];
+                    elemB.parentId = closestCell; // Triangle id
+                    elemB.idCount  = 3;
+                    elemB.cellType = IMSTK_TRIANGLE;
+
+                    chunk.elementsA.push_back(elemA);
+                    chunk.elementsB.push_back(elemB);
+                }
             }
-            // The nearest feature to this vertex is a triangle face
-            else if (caseType == 2)
+            else
             {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.ids[1]   = vertexIds[1];
-                elemB.ids[2]   = vertexIds[2];
-                elemB.parentId = closestCell; // Triangle id
-                elemB.idCount  = 3;
-                elemB.cellType = IMSTK_TRIANGLE;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
+                m_vertexInside[i] = false;
             }
-        }
-        else
-        {
-            m_vertexInside[i] = false;
-        }
-    }
+        });
+    m_elementBuffer.appendTo(elementsA, elementsB);
 }
 
 void
@@ -432,7 +432,7 @@ ClosedSurfaceMeshToMeshCD::lineMeshEdgeToTriangleTest(
     std::vector<CollisionElement>& elementsA,
     std::vector<CollisionElement>& elementsB)
 {
-    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvhB);
 
     // Get geometry A data
     std::shared_ptr<LineMesh>                lineMesh = std::dynamic_pointer_cast<LineMesh>(geomA);
@@ -524,7 +524,7 @@ ClosedSurfaceMeshToMeshCD::surfMeshEdgeToTriangleTest(
     std::vector<CollisionElement>& elementsA,
     std::vector<CollisionElement>& elementsB)
 {
-    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvhB);
 
     // Get geometry A data
     std::shared_ptr<SurfaceMesh>             surfMeshA = std::dynamic_pointer_cast<SurfaceMesh>(geomA);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "imstkBoundingVolumeHierarchy.h"
 #include "imstkCollisionDetectionAlgorithm.h"
 #include "imstkDataArray.h"
 #include "imstkMacros.h"
@@ -33,7 +34,9 @@ class SurfaceMesh;
 /// of brute force closest point determination in "Game Physics Pearls"
 ///
 /// It resolves vertices by computing signed distances using the psuedonormal
-/// method. This allows it to resolve very deep penetrations.
+/// method. This allows it to resolve very deep penetrations. The nearest
+/// triangle of every vertex is found through a bounding volume hierarchy of the
+/// closed SurfaceMesh, refit every update, and vertices are tested in parallel.
 ///
 /// If enabled, it may resolve edge-edge contact by brute force as well. This
 /// is an extremely costly operation in brute force and is off by default.
@@ -130,8 +133,9 @@ private:
     bool m_generateVertexTriangleContacts = true;
     bool m_doBroadPhase = true;
 
-    std::vector<bool> m_vertexInside;
+    std::vector<char> m_vertexInside; ///< Not vector<bool>, written in parallel
     DataArray<double> m_signedDistances;
+    BoundingVolumeHierarchy m_bvhB;   ///< Hierarchy over the triangles of the closed SurfaceMesh
     Vec3d  m_padding   = Vec3d(0.001, 0.001, 0.001);
     double m_proximity = -1.0; // Default off -1
 };
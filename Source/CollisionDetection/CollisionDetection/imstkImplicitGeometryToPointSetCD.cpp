@@ -9,9 +9,9 @@
 #include "imstkImageData.h"
 #include "imstkImplicitGeometry.h"
 #include "imstkMath.h"
-#include "imstkParallelUtils.h"
 #include "imstkPointSet.h"
 #include "imstkSignedDistanceField.h"
+#include "imstkVecDataArray.h"
 
 namespace imstk
 {
@@ -40,9 +40,8 @@ ImplicitGeometryToPointSetCD::computeCollisionDataAB(
 
     std::shared_ptr<VecDataArray<double, 3>> verticesPtr = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices    = *verticesPtr;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int i)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int i, CollisionElementBuffer::Chunk& chunk)
         {
             const Vec3d& pt = vertices[i];
 
@@ -62,12 +61,11 @@ ImplicitGeometryToPointSetCD::computeCollisionDataAB(
                 elemB.ptIndex = i;
                 elemB.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
+                chunk.elementsB.push_back(elemB);
             }
-        }, vertices.size() > 100);
+        });
+    m_elementBuffer.appendTo(elementsA, elementsB);
 }
 
 void
@@ -87,9 +85,8 @@ ImplicitGeometryToPointSetCD::computeCollisionDataA(
 
     std::shared_ptr<VecDataArray<double, 3>> verticesPtr = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices    = *verticesPtr;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int i)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int i, CollisionElementBuffer::Chunk& chunk)
         {
             const Vec3d& pt = vertices[i];
 
@@ -104,11 +101,10 @@ ImplicitGeometryToPointSetCD::computeCollisionDataA(
                 elemA.pt  = pt + n * depth;
                 elemA.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
             }
-        }, vertices.size() > 100);
+        });
+    m_elementBuffer.appendToA(elementsA);
 }
 
 void
@@ -128,9 +124,8 @@ ImplicitGeometryToPointSetCD::computeCollisionDataB(
 
     std::shared_ptr<VecDataArray<double, 3>> verticesPtr = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices    = *verticesPtr;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int i)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int i, CollisionElementBuffer::Chunk& chunk)
         {
             const Vec3d& pt = vertices[i];
 
@@ -144,10 +139,9 @@ ImplicitGeometryToPointSetCD::computeCollisionDataB(
                 elemB.ptIndex = i;
                 elemB.penetrationDepth = std::abs(signedDistance);
 
-                lock.lock();
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsB.push_back(elemB);
             }
-        }, vertices.size() > 100);
+        });
+    m_elementBuffer.appendToB(elementsB);
 }
 } // namespace imstk
\ No newline at end of file
@@ -8,7 +8,6 @@
 #include "imstkCapsule.h"
 #include "imstkCollisionData.h"
 #include "imstkCollisionUtils.h"
-#include "imstkParallelUtils.h"
 #include "imstkPointSet.h"
 #include "imstkVecDataArray.h"
 
@@ -37,9 +36,8 @@ PointSetToCapsuleCD::computeCollisionDataAB(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d capsuleContactPt;
             Vec3d capsuleContactNormal, pointContactNormal;
@@ -59,12 +57,11 @@ PointSetToCapsuleCD::computeCollisionDataAB(
                 elemB.pt  = capsuleContactPt;     // Contact point on surface of capsule
                 elemB.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
+                chunk.elementsB.push_back(elemB);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendTo(elementsA, elementsB);
 }
 
 void
@@ -83,9 +80,8 @@ PointSetToCapsuleCD::computeCollisionDataA(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d capsuleContactPt;
             Vec3d capsuleContactNormal, pointContactNormal;
@@ -100,11 +96,10 @@ PointSetToCapsuleCD::computeCollisionDataA(
                 elemA.ptIndex = idx;
                 elemA.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendToA(elementsA);
 }
 
 void
@@ -123,9 +118,8 @@ PointSetToCapsuleCD::computeCollisionDataB(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d capsuleContactPt;
             Vec3d capsuleContactNormal, pointContactNormal;
@@ -140,10 +134,9 @@ PointSetToCapsuleCD::computeCollisionDataB(
                 elemB.pt  = capsuleContactPt;     // Contact point on surface of capsule
                 elemB.penetrationDepth = depth;
 
-                lock.lock();
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsB.push_back(elemB);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendToB(elementsB);
 }
 } // namespace imstk
\ No newline at end of file
@@ -7,9 +7,9 @@
 #include "imstkPointSetToSphereCD.h"
 #include "imstkCollisionData.h"
 #include "imstkCollisionUtils.h"
-#include "imstkParallelUtils.h"
 #include "imstkPointSet.h"
 #include "imstkSphere.h"
+#include "imstkVecDataArray.h"
 
 namespace imstk
 {
@@ -34,9 +34,8 @@ PointSetToSphereCD::computeCollisionDataAB(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d sphereContactPt, sphereContactNormal;
             double depth;
@@ -55,12 +54,11 @@ PointSetToSphereCD::computeCollisionDataAB(
                 elemB.pt  = sphereContactPt;
                 elemB.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
+                chunk.elementsB.push_back(elemB);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendTo(elementsA, elementsB);
 }
 
 void
@@ -77,9 +75,8 @@ PointSetToSphereCD::computeCollisionDataA(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d sphereContactPt, sphereContactNormal;
             double depth;
@@ -93,11 +90,10 @@ PointSetToSphereCD::computeCollisionDataA(
                 elemA.ptIndex = idx;
                 elemA.penetrationDepth = depth;
 
-                lock.lock();
-                elementsA.push_back(elemA);
-                lock.unlock();
+                chunk.elementsA.push_back(elemA);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendToA(elementsA);
 }
 
 void
@@ -114,9 +110,8 @@ PointSetToSphereCD::computeCollisionDataB(
 
     std::shared_ptr<VecDataArray<double, 3>> vertexData = pointSet->getVertexPositions();
     const VecDataArray<double, 3>&           vertices   = *vertexData;
-    ParallelUtils::SpinLock                  lock;
-    ParallelUtils::parallelFor(vertices.size(),
-        [&](const int idx)
+    m_elementBuffer.parallelFor(vertices.size(),
+        [&](const int idx, CollisionElementBuffer::Chunk& chunk)
         {
             Vec3d sphereContactPt, sphereContactNormal;
             double depth;
@@ -130,10 +125,9 @@ PointSetToSphereCD::computeCollisionDataB(
                 elemB.pt  = sphereContactPt;
                 elemB.penetrationDepth = depth;
 
-                lock.lock();
-                elementsB.push_back(elemB);
-                lock.unlock();
+                chunk.elementsB.push_back(elemB);
             }
-                }, vertices.size() > 100);
+                });
+    m_elementBuffer.appendToB(elementsB);
 }
 } // namespace imstk
\ No newline at end of file
@@ -9,71 +9,27 @@
 #include "imstkSurfaceMesh.h"
 #include "imstkGeometryUtilities.h"
 
-struct EdgePair
-{
-    EdgePair(uint32_t a1, uint32_t a2, uint32_t b1, uint32_t b2)
-    {
-        edgeA[0] = a1;
-        edgeA[1] = a2;
-        edgeB[0] = b1;
-        edgeB[1] = b2;
-
-        edgeAId = getIdA();
-        edgeBId = getIdB();
-    }
-
-    ///
-    /// \brief Reversible edges are equivalent, reversible vertices in the edges are equivalent as well
-    /// EdgePair(0,1,5,2)==EdgePair(1,0,5,2)==EdgePair(1,0,2,5)==...
-    ///
-    bool operator==(const EdgePair& other) const
-    {
-        return (edgeAId == other.edgeAId && edgeBId == other.edgeBId)
-               || (edgeAId == other.edgeBId && edgeBId == other.edgeAId);
-    }
-
-    // These functions return a unique int for an edge, order doesn't matter
-    // ie: f(vertexId1, vertexId2)=f(vertexId2, vertexId1)
-    const uint32_t getIdA() const
-    {
-        const uint32_t max = std::max(edgeA[0], edgeA[1]);
-        const uint32_t min = std::min(edgeA[0], edgeA[1]);
-        return max * (max + 1) / 2 + min;
-    }
-
-    const uint32_t getIdB() const
-    {
-        const uint32_t max = std::max(edgeB[0], edgeB[1]);
-        const uint32_t min = std::min(edgeB[0], edgeB[1]);
-        return max * (max + 1) / 2 + min;
-    }
-
-    uint32_t edgeA[2];
-    uint32_t edgeAId;
-    uint32_t edgeB[2];
-    uint32_t edgeBId;
-};
+#include <unordered_set>
 
-namespace std
+namespace
 {
-template<>
-struct hash<EdgePair>
+///
+/// \brief Unique id of an edge, order of the vertices doesn't matter
+///
+std::uint64_t
+getEdgeId(const int v0, const int v1)
 {
-    // EdgePair has 4 uints to hash, they bound the same range, 0 to max vertices of a mesh
-    // A complete unique hash split into 4, would limit us to 256 max vertices so we will have
-    // collisions but they will be unlikely given small portions of the mesh are in contact at
-    // any one time
-    std::size_t operator()(const EdgePair& k) const
-    {
-        // Shift by 8 each time, there will be overlap every 256 ints
-        //return ((k.edgeA[0] ^ (k.edgeA[1] << 8)) ^ (k.edgeB[0] << 16)) ^ (k.edgeB[1] << 24);
+    return (static_cast<std::uint64_t>(std::max(v0, v1)) << 32) | static_cast<std::uint32_t>(std::min(v0, v1));
+}
 
-        // The edge ids are more compact since f(1,0)=f(0,1) there are fewer permutations,
-        // This should allow up to ~360 max vertices..., not that much better
-        return (k.edgeAId ^ (k.edgeBId << 16));
+struct EdgePairHash
+{
+    std::size_t operator()(const std::pair<std::uint64_t, std::uint64_t>& k) const
+    {
+        return std::hash<std::uint64_t>()(k.first) ^ (std::hash<std::uint64_t>()(k.second) * 0x9e3779b97f4a7c15ull);
     }
 };
-} // namespace std
+} // namespace
 
 namespace imstk
 {
@@ -105,114 +61,121 @@ SurfaceMeshToSurfaceMeshCD::computeCollisionDataAB(
     std::shared_ptr<VecDataArray<int, 3>>    indicesBPtr  = surfMeshB->getCells();
     const VecDataArray<int, 3>&              indicesB     = *indicesBPtr;
 
-    std::unordered_set<EdgePair> edges;
-    for (int i = 0; i < indicesA.size(); i++)
+    // Broad phase, refit the hierarchy of B to its current vertices
+    m_bvhB.refit(verticesB, indicesB);
+    Vec3d lowerB, upperB;
+    if (!m_bvhB.getBounds(lowerB, upperB) || indicesA.size() == 0)
     {
-        const Vec3i& cellA = indicesA[i];
-        for (int j = 0; j < indicesB.size(); j++)
+        return;
+    }
+
+    // Narrow phase, triangles of A are tested in parallel chunks
+    m_elementBuffer.parallelForChunks(indicesA.size(), [&](const int begin, const int end, CollisionElementBuffer::Chunk& chunk)
         {
-            const Vec3i& cellB = indicesB[j];
-
-            // vtContact needs to be checked both ways but eeContact is symmetric
-            std::pair<Vec2i, Vec2i> eeContact;
-            std::pair<int, Vec3i>   vtContact;
-            std::pair<Vec3i, int>   tvContact;
-            const int               contactType = CollisionUtils::triangleToTriangle(cellA, cellB,
-                verticesA[cellA[0]], verticesA[cellA[1]], verticesA[cellA[2]],
-                verticesB[cellB[0]], verticesB[cellB[1]], verticesB[cellB[2]],
-                eeContact, vtContact, tvContact);
-
-            // If you want to visualize the cells in contact
-            // report triangle vs triangle instead
-            /* CellIndexElement elemB;
-            elemB.idCount = 3;
-            elemB.cellType = IMSTK_TRIANGLE;
-            elemB.ids[0] = cellB[0];
-            elemB.ids[1] = cellB[1];
-            elemB.ids[2] = cellB[2];
-            CellIndexElement elemA;
-            elemA.idCount = 3;
-            elemA.cellType = IMSTK_TRIANGLE;
-            elemA.ids[0] = cellA[0];
-            elemA.ids[1] = cellA[1];
-            elemA.ids[2] = cellA[2];
-            elementsA.unsafeAppend(elemA);
-            elementsB.unsafeAppend(elemB);*/
-
-            // Type 1, vertex-triangle contact
-            if (contactType == 1)
+            std::vector<int> candidates;
+            for (int i = begin; i < end; i++)
             {
-                CellIndexElement elemA;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-                elemA.ids[0]   = vtContact.first;
-
-                CellIndexElement elemB;
-                elemB.idCount  = 3;
-                elemB.cellType = IMSTK_TRIANGLE;
-                elemB.ids[0]   = vtContact.second[0];
-                elemB.ids[1]   = vtContact.second[1];
-                elemB.ids[2]   = vtContact.second[2];
-                elemA.parentId = j; // Triangle id
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-            }
-            // Type 0, edge-edge contact
-            else if (contactType == 0)
-            {
-                // Create an edge pair and hash it to see if we already have this contact from
-                // another triangle
-                const EdgePair edgePair = {
-                    static_cast<uint32_t>(eeContact.first[0]),
-                    static_cast<uint32_t>(eeContact.first[1]),
-                    static_cast<uint32_t>(eeContact.second[0]),
-                    static_cast<uint32_t>(eeContact.second[1]) };
-                if (edges.count(edgePair) == 0)
+                const Vec3i& cellA  = indicesA[i];
+                const Vec3d  lowerA = verticesA[cellA[0]].cwiseMin(verticesA[cellA[1]]).cwiseMin(verticesA[cellA[2]]);
+                const Vec3d  upperA = verticesA[cellA[0]].cwiseMax(verticesA[cellA[1]]).cwiseMax(verticesA[cellA[2]]);
+
+                // Triangles of B in id order, so contacts are reported in the same order as brute force
+                candidates.clear();
+                m_bvhB.query(lowerA, upperA, [&](const int j) { candidates.push_back(j); });
+                std::sort(candidates.begin(), candidates.end());
+
+                for (const int j : candidates)
                 {
-                    CellIndexElement elemA;
-                    elemA.idCount  = 2;
-                    elemA.cellType = IMSTK_EDGE;
-                    elemA.ids[0]   = eeContact.first[0];
-                    elemA.ids[1]   = eeContact.first[1];
-                    elemA.parentId = i; // Triangle id
-
-                    CellIndexElement elemB;
-                    elemB.idCount  = 2;
-                    elemB.cellType = IMSTK_EDGE;
-                    elemB.ids[0]   = eeContact.second[0];
-                    elemB.ids[1]   = eeContact.second[1];
-                    elemA.parentId = j; // Triangle id
-
-                    elementsA.push_back(elemA);
-                    elementsB.push_back(elemB);
-                    edges.insert(edgePair);
+                    const Vec3i& cellB = indicesB[j];
+
+                    // vtContact needs to be checked both ways but eeContact is symmetric
+                    std::pair<Vec2i, Vec2i> eeContact;
+                    std::pair<int, Vec3i>   vtContact;
+                    std::pair<Vec3i, int>   tvContact;
+                    const int               contactType = CollisionUtils::triangleToTriangle(cellA, cellB,
+                        verticesA[cellA[0]], verticesA[cellA[1]], verticesA[cellA[2]],
+                        verticesB[cellB[0]], verticesB[cellB[1]], verticesB[cellB[2]],
+                        eeContact, vtContact, tvContact);
+
+                    // Type 1, vertex-triangle contact
+                    if (contactType == 1)
+                    {
+                        CellIndexElement elemA;
+                        elemA.idCount  = 1;
+                        elemA.cellType = IMSTK_VERTEX;
+                        elemA.ids[0]   = vtContact.first;
+
+                        CellIndexElement elemB;
+                        elemB.idCount  = 3;
+                        elemB.cellType = IMSTK_TRIANGLE;
+                        elemB.ids[0]   = vtContact.second[0];
+                        elemB.ids[1]   = vtContact.second[1];
+                        elemB.ids[2]   = vtContact.second[2];
+                        elemA.parentId = j; // Triangle id
+
+                        chunk.elementsA.push_back(elemA);
+                        chunk.elementsB.push_back(elemB);
+                    }
+                    // Type 0, edge-edge contact, duplicates from neighboring triangles
+                    // are removed when merging
+                    else if (contactType == 0)
+                    {
+                        CellIndexElement elemA;
+                        elemA.idCount  = 2;
+                        elemA.cellType = IMSTK_EDGE;
+                        elemA.ids[0]   = eeContact.first[0];
+                        elemA.ids[1]   = eeContact.first[1];
+                        elemA.parentId = i; // Triangle id
+
+                        CellIndexElement elemB;
+                        elemB.idCount  = 2;
+                        elemB.cellType = IMSTK_EDGE;
+                        elemB.ids[0]   = eeContact.second[0];
+                        elemB.ids[1]   = eeContact.second[1];
+                        elemB.parentId = j; // Triangle id
+
+                        chunk.elementsA.push_back(elemA);
+                        chunk.elementsB.push_back(elemB);
+                    }
+                    // Type 3, triangle-vertex contact
+                    else if (contactType == 2)
+                    {
+                        CellIndexElement elemA;
+                        elemA.idCount  = 3;
+                        elemA.cellType = IMSTK_TRIANGLE;
+                        elemA.ids[0]   = tvContact.first[0];
+                        elemA.ids[1]   = tvContact.first[1];
+                        elemA.ids[2]   = tvContact.first[2];
+                        elemA.parentId = i; // Triangle id
+
+                        CellIndexElement elemB;
+                        elemB.idCount  = 1;
+                        elemB.cellType = IMSTK_VERTEX;
+                        elemB.ids[0]   = tvContact.second;
+
+                        chunk.elementsA.push_back(elemA);
+                        chunk.elementsB.push_back(elemB);
+                    }
                 }
             }
-            // Type 3, triangle-vertex contact
-            else if (contactType == 2)
+        });
+
+    // Merge in chunk order, an edge pair may be found from multiple triangles, only keep the first
+    std::unordered_set<std::pair<std::uint64_t, std::uint64_t>, EdgePairHash> edges;
+    for (int chunkId = 0; chunkId < m_elementBuffer.getNumChunks(); chunkId++)
+    {
+        const CollisionElementBuffer::Chunk& output = m_elementBuffer.getChunk(chunkId);
+        for (size_t k = 0; k < output.elementsA.size(); k++)
+        {
+            const CellIndexElement& elemA = output.elementsA[k].m_element.m_CellIndexElement;
+            const CellIndexElement& elemB = output.elementsB[k].m_element.m_CellIndexElement;
+            if (elemA.cellType == IMSTK_EDGE
+                && !edges.insert({ getEdgeId(elemA.ids[0], elemA.ids[1]), getEdgeId(elemB.ids[0], elemB.ids[1]) }).second)
             {
-                CellIndexElement elemA;
-                elemA.idCount  = 3;
-                elemA.cellType = IMSTK_TRIANGLE;
-                elemA.ids[0]   = tvContact.first[0];
-                elemA.ids[1]   = tvContact.first[1];
-                elemA.ids[2]   = tvContact.first[2];
-                elemA.parentId = i; // Triangle id
-
-                CellIndexElement elemB;
-                elemB.idCount  = 1;
-                elemB.cellType = IMSTK_VERTEX;
-                elemB.ids[0]   = tvContact.second;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
+                continue;
             }
-            //else
-            //{
-            //    // This case is hit in one edge case
-            //    LOG(WARNING) << "Contact without intersection!";
-            //}
+            elementsA.push_back(output.elementsA[k]);
+            elementsB.push_back(output.elementsB[k]);
         }
     }
 }
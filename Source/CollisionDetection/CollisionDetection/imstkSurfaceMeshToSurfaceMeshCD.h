@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "imstkBoundingVolumeHierarchy.h"
 #include "imstkCollisionDetectionAlgorithm.h"
 #include "imstkMacros.h"
 
@@ -16,7 +17,10 @@ class SurfaceMesh;
 ///
 /// \class SurfaceMeshToSurfaceMeshCD
 ///
-/// \brief Collision detection for surface meshes
+/// \brief Collision detection for surface meshes. Triangles of A are tested
+/// against the triangles of B found in a bounding volume hierarchy of B, which
+/// is built once and refit to B's vertices every update. Triangles of A are
+/// tested in parallel.
 ///
 class SurfaceMeshToSurfaceMeshCD : public CollisionDetectionAlgorithm
 {
@@ -43,5 +47,7 @@ protected:
 protected:
     std::vector<std::pair<int, int>> m_intersectingPairs;
     int m_maxNumContacts = 1000;
+
+    BoundingVolumeHierarchy m_bvhB; ///< Hierarchy over the triangles of B
 };
 } // namespace imstk
\ No newline at end of file
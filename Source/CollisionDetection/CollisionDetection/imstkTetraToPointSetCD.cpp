@@ -6,8 +6,8 @@
 
 #include "imstkTetraToPointSetCD.h"
 #include "imstkCollisionData.h"
-#include "imstkParallelUtils.h"
 #include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
 
 namespace imstk
 {
@@ -37,9 +37,8 @@ TetraToPointSetCD::computeCollisionDataAB(
     const VecDataArray<double, 3>&           verticesMeshB    = *verticesMeshBPtr;
 
     // For every tet in meshA, test if any points lie in it
-    ParallelUtils::SpinLock lock;
-    ParallelUtils::parallelFor(tetMesh->getNumCells(),
-        [&](const int tetIdA)
+    m_elementBuffer.parallelFor(tetMesh->getNumCells(),
+        [&](const int tetIdA, CollisionElementBuffer::Chunk& chunk)
         {
             // Compute the bounding box of the tet
             Vec3d min, max;
@@ -68,12 +67,11 @@ TetraToPointSetCD::computeCollisionDataAB(
                     elemB.idCount  = 1;
                     elemB.cellType = IMSTK_VERTEX;
 
-                    lock.lock();
-                    elementsA.push_back(elemA);
-                    elementsB.push_back(elemB);
-                    lock.unlock();
+                    chunk.elementsA.push_back(elemA);
+                    chunk.elementsB.push_back(elemB);
                 }
             }
         });
+    m_elementBuffer.appendTo(elementsA, elementsB);
 }
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,91 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollisionElementBuffer.h"
+#include "imstkPointSet.h"
+#include "imstkPointSetToSphereCD.h"
+#include "imstkSphere.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+///
+/// \brief Test elements from many chunks are merged in index order
+///
+TEST(imstkCollisionElementBufferTest, AppendInOrder)
+{
+    CollisionElementBuffer buffer;
+
+    // Every third index reports a contact, only B for every ninth
+    buffer.parallelFor(10000, [](const int i, CollisionElementBuffer::Chunk& chunk)
+        {
+            if (i % 3 == 0)
+            {
+                PointIndexDirectionElement elem;
+                elem.ptIndex = i;
+                chunk.elementsA.push_back(elem);
+            }
+            if (i % 9 == 0)
+            {
+                PointIndexDirectionElement elem;
+                elem.ptIndex = i;
+                chunk.elementsB.push_back(elem);
+            }
+        }, 64);
+    EXPECT_EQ(157, buffer.getNumChunks());
+
+    // Existing elements are kept
+    std::vector<CollisionElement> elementsA(1);
+    std::vector<CollisionElement> elementsB;
+    buffer.appendTo(elementsA, elementsB);
+
+    ASSERT_EQ(1 + 3334u, elementsA.size());
+    ASSERT_EQ(1112u, elementsB.size());
+    EXPECT_EQ(CollisionElementType::Empty, elementsA[0].m_type);
+    for (size_t i = 1; i < elementsA.size(); i++)
+    {
+        EXPECT_EQ(static_cast<int>(i - 1) * 3, elementsA[i].m_element.m_PointIndexDirectionElement.ptIndex);
+    }
+    for (size_t i = 0; i < elementsB.size(); i++)
+    {
+        EXPECT_EQ(static_cast<int>(i) * 9, elementsB[i].m_element.m_PointIndexDirectionElement.ptIndex);
+    }
+
+    // Buffer is reused, chunks are cleared
+    buffer.parallelFor(10, [](const int, CollisionElementBuffer::Chunk&) { });
+    std::vector<CollisionElement> elementsC;
+    buffer.appendToA(elementsC);
+    EXPECT_EQ(0u, elementsC.size());
+}
+
+///
+/// \brief Test a parallel CD reports vertices in the same order as a serial loop
+///
+TEST(imstkCollisionElementBufferTest, ParallelPointSetToSphereOrder)
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(5000);
+    for (int i = 0; i < vertices->size(); i++)
+    {
+        (*vertices)[i] = Vec3d(0.0, -1.0 + i * 0.0004, 0.0);
+    }
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(vertices);
+
+    PointSetToSphereCD cd;
+    cd.setInputGeometryA(pointSet);
+    cd.setInputGeometryB(std::make_shared<Sphere>(Vec3d::Zero(), 0.5));
+    cd.update();
+
+    std::shared_ptr<CollisionData> colData = cd.getCollisionData();
+    ASSERT_EQ(2499u, colData->elementsA.size());
+    ASSERT_EQ(colData->elementsA.size(), colData->elementsB.size());
+    for (size_t i = 0; i < colData->elementsA.size(); i++)
+    {
+        EXPECT_EQ(1251 + static_cast<int>(i), colData->elementsA[i].m_element.m_PointIndexDirectionElement.ptIndex);
+    }
+}
\ No newline at end of file
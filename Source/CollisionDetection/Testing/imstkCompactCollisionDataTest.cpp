@@ -0,0 +1,167 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkCompactCollisionData.h"
+
+using namespace imstk;
+
+namespace
+{
+PointIndexDirectionElement
+makePointIndexDirection(const int ptIndex)
+{
+    PointIndexDirectionElement elem;
+    elem.ptIndex = ptIndex;
+    elem.dir     = Vec3d(0.0, 1.0, 0.0);
+    elem.penetrationDepth = ptIndex * 0.1;
+    return elem;
+}
+
+PointDirectionElement
+makePointDirection(const int i)
+{
+    PointDirectionElement elem;
+    elem.pt  = Vec3d(i, 0.0, 0.0);
+    elem.dir = Vec3d(0.0, -1.0, 0.0);
+    elem.penetrationDepth = i * 0.1;
+    return elem;
+}
+
+CellIndexElement
+makeCellIndex(const int id, const CellTypeId cellType)
+{
+    CellIndexElement elem;
+    elem.ids[0]   = id;
+    elem.idCount  = 1;
+    elem.cellType = cellType;
+    return elem;
+}
+} // namespace
+
+///
+/// \brief Test contacts are grouped by their pair of types, in the given order within a group
+///
+TEST(imstkCompactCollisionDataTest, ForEachPair)
+{
+    // Alternate vertex-primitive and vertex-triangle contacts
+    std::vector<CollisionElement> elementsA;
+    std::vector<CollisionElement> elementsB;
+    for (int i = 0; i < 10; i++)
+    {
+        if (i % 2 == 0)
+        {
+            elementsA.push_back(makePointIndexDirection(i));
+            elementsB.push_back(makePointDirection(i));
+        }
+        else
+        {
+            elementsA.push_back(makeCellIndex(i, IMSTK_VERTEX));
+            elementsB.push_back(makeCellIndex(100 + i, IMSTK_TRIANGLE));
+        }
+    }
+
+    CompactCollisionData data;
+    data.assign(elementsA, elementsB);
+    EXPECT_EQ(10, data.getNumContacts());
+    EXPECT_EQ(5, data.getElementsA<PointIndexDirectionElement>().size());
+    EXPECT_EQ(5, data.getElementsA<CellIndexElement>().size());
+    EXPECT_EQ(0, data.getElementsA<CellVertexElement>().size());
+
+    std::vector<int> visited;
+    data.forEachPair<PointIndexDirectionElement, PointDirectionElement>(
+        [&](const PointIndexDirectionElement& elemA, const PointDirectionElement& elemB, const int contactId)
+        {
+            EXPECT_EQ(elemA.ptIndex, static_cast<int>(elemB.pt[0]));
+            EXPECT_EQ(elemA.ptIndex, data.getSourceIds()[contactId]);
+            visited.push_back(elemA.ptIndex);
+        });
+    EXPECT_EQ(std::vector<int>({ 0, 2, 4, 6, 8 }), visited);
+
+    visited.clear();
+    data.forEachPair<CellIndexElement, CellIndexElement>(
+        [&](const CellIndexElement& elemA, const CellIndexElement& elemB, const int contactId)
+        {
+            EXPECT_EQ(elemA.ids[0] + 100, elemB.ids[0]);
+            EXPECT_EQ(elemA.ids[0], data.getSourceIds()[contactId]);
+            visited.push_back(elemA.ids[0]);
+        });
+    EXPECT_EQ(std::vector<int>({ 1, 3, 5, 7, 9 }), visited);
+
+    int count = 0;
+    data.forEachPair<CellIndexElement, PointDirectionElement>([&](const CellIndexElement&, const PointDirectionElement&, const int) { count++; });
+    EXPECT_EQ(0, count);
+}
+
+///
+/// \brief Test one sided data, the missing side is reported as EmptyElement
+///
+TEST(imstkCompactCollisionDataTest, OneSided)
+{
+    std::vector<CollisionElement> elementsA;
+    for (int i = 0; i < 4; i++)
+    {
+        elementsA.push_back(makePointIndexDirection(i));
+    }
+
+    CompactCollisionData data;
+    data.assign(elementsA, { });
+    EXPECT_EQ(4, data.getRange(CollisionElementType::PointIndexDirection, CollisionElementType::Empty).count);
+
+    int count = 0;
+    data.forEachPair<PointIndexDirectionElement, EmptyElement>(
+        [&](const PointIndexDirectionElement& elemA, const EmptyElement&, const int)
+        {
+            EXPECT_EQ(count++, elemA.ptIndex);
+        });
+    EXPECT_EQ(4, count);
+
+    std::vector<CollisionElement> resultsA;
+    std::vector<CollisionElement> resultsB;
+    data.toElements(resultsA, resultsB);
+    EXPECT_EQ(4, resultsA.size());
+    EXPECT_EQ(0, resultsB.size());
+
+    data.clear();
+    EXPECT_EQ(0, data.getNumContacts());
+}
+
+///
+/// \brief Test conversion back to CollisionElements keeps every contact
+///
+TEST(imstkCompactCollisionDataTest, RoundTrip)
+{
+    std::vector<CollisionElement> elementsA;
+    std::vector<CollisionElement> elementsB;
+    for (int i = 0; i < 6; i++)
+    {
+        elementsA.push_back(makeCellIndex(i, IMSTK_EDGE));
+        elementsA.back().m_ccdData = (i == 3);
+        elementsB.push_back((i < 3) ? CollisionElement(makeCellIndex(i, IMSTK_EDGE)) : CollisionElement(makePointDirection(i)));
+        elementsB.back().m_ccdData = (i == 1);
+    }
+
+    CompactCollisionData data;
+    data.assign(elementsA, elementsB);
+
+    std::vector<CollisionElement> resultsA;
+    std::vector<CollisionElement> resultsB;
+    data.toElements(resultsA, resultsB);
+    ASSERT_EQ(6, resultsA.size());
+    ASSERT_EQ(6, resultsB.size());
+    for (int i = 0; i < 6; i++)
+    {
+        const int sourceId = data.getSourceIds()[i];
+        EXPECT_EQ(elementsA[sourceId].m_type, resultsA[i].m_type);
+        EXPECT_EQ(elementsB[sourceId].m_type, resultsB[i].m_type);
+        EXPECT_EQ(elementsA[sourceId].m_element.m_CellIndexElement.ids[0], resultsA[i].m_element.m_CellIndexElement.ids[0]);
+        EXPECT_EQ(elementsA[sourceId].m_ccdData, resultsA[i].m_ccdData);
+        EXPECT_EQ(elementsB[sourceId].m_ccdData, resultsB[i].m_ccdData);
+        EXPECT_EQ(elementsA[sourceId].m_ccdData, static_cast<bool>(data.getCcdDataA()[i]));
+        EXPECT_EQ(elementsB[sourceId].m_ccdData, static_cast<bool>(data.getCcdDataB()[i]));
+    }
+}
\ No newline at end of file
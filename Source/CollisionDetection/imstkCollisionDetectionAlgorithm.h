@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkCollisionData.h"
+#include "imstkCollisionElementBuffer.h"
 #include "imstkGeometryAlgorithm.h"
 
 namespace imstk
@@ -30,6 +31,9 @@ class Geometry;
 /// CD subclasses can provide defaults for this as well and not expect the user
 /// to touch it.
 ///
+/// Subclasses that test elements in parallel should write their contacts to
+/// m_elementBuffer and append it to the output, not lock around push_back.
+///
 class CollisionDetectionAlgorithm : public GeometryAlgorithm
 {
 protected:
@@ -117,6 +121,7 @@ protected:
         std::vector<CollisionElement>& imstkNotUsed(elementsB)) { m_computeColDataBImplemented = false; }
 
     std::shared_ptr<std::vector<std::shared_ptr<CollisionData>>> m_collisionDataVector;
+    CollisionElementBuffer m_elementBuffer; ///< Per chunk output for parallel detection
 
     bool m_flipOutput   = false;
     bool m_generateCD_A = true;
@@ -0,0 +1,52 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollisionElementBuffer.h"
+
+namespace imstk
+{
+void
+CollisionElementBuffer::appendTo(std::vector<CollisionElement>& elementsA, std::vector<CollisionElement>& elementsB) const
+{
+    append(elementsA, &Chunk::elementsA);
+    append(elementsB, &Chunk::elementsB);
+}
+
+void
+CollisionElementBuffer::appendToA(std::vector<CollisionElement>& elementsA) const
+{
+    append(elementsA, &Chunk::elementsA);
+}
+
+void
+CollisionElementBuffer::appendToB(std::vector<CollisionElement>& elementsB) const
+{
+    append(elementsB, &Chunk::elementsB);
+}
+
+void
+CollisionElementBuffer::append(std::vector<CollisionElement>& elements, std::vector<CollisionElement> Chunk::* side) const
+{
+    // Exclusive prefix sum gives every chunk its place in the output
+    m_offsets.resize(m_numChunks + 1);
+    m_offsets[0] = elements.size();
+    for (int i = 0; i < m_numChunks; i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + (m_chunks[i].*side).size();
+    }
+    if (m_offsets[m_numChunks] == elements.size())
+    {
+        return;
+    }
+
+    elements.resize(m_offsets[m_numChunks]);
+    ParallelUtils::parallelFor(m_numChunks, [&](const int i)
+        {
+            const std::vector<CollisionElement>& chunkElements = m_chunks[i].*side;
+            std::copy(chunkElements.begin(), chunkElements.end(), elements.begin() + m_offsets[i]);
+        }, m_numChunks > 1);
+}
+} // namespace imstk
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkCollisionData.h"
+#include "imstkParallelFor.h"
+
+namespace imstk
+{
+///
+/// \class CollisionElementBuffer
+///
+/// \brief Lock free output for collision detection done in parallel. The index
+/// range is split into fixed size chunks. Each chunk appends to its own
+/// element vectors. Afterwards the chunks are compacted into the output by a
+/// prefix sum over their sizes and a parallel copy.
+///
+/// Chunks are fixed before scheduling, so the output has the same order as a
+/// serial loop. Chunk vectors are kept between updates, so detection at a
+/// steady contact count does not allocate.
+///
+class CollisionElementBuffer
+{
+public:
+    struct Chunk
+    {
+        std::vector<CollisionElement> elementsA;
+        std::vector<CollisionElement> elementsB;
+    };
+
+public:
+    CollisionElementBuffer() = default;
+    virtual ~CollisionElementBuffer() = default;
+
+public:
+    ///
+    /// \brief Calls func(begin, end, chunk) for every chunk of [0, n) in parallel,
+    /// chunk is cleared before
+    ///
+    template<typename Func>
+    void parallelForChunks(const int n, Func&& func, const int chunkSize = DefaultChunkSize)
+    {
+        m_numChunks = (n + chunkSize - 1) / chunkSize;
+        if (static_cast<int>(m_chunks.size()) < m_numChunks)
+        {
+            m_chunks.resize(m_numChunks);
+        }
+        ParallelUtils::parallelFor(m_numChunks, [&](const int chunkId)
+            {
+                Chunk& chunk = m_chunks[chunkId];
+                chunk.elementsA.clear();
+                chunk.elementsB.clear();
+                func(chunkId * chunkSize, std::min((chunkId + 1) * chunkSize, n), chunk);
+            }, m_numChunks > 1);
+    }
+
+    ///
+    /// \brief Calls func(i, chunk) for every i in [0, n) in parallel, the indices
+    /// of a chunk are visited in order by the same thread
+    ///
+    template<typename Func>
+    void parallelFor(const int n, Func&& func, const int chunkSize = DefaultChunkSize)
+    {
+        parallelForChunks(n, [&](const int begin, const int end, Chunk& chunk)
+            {
+                for (int i = begin; i < end; i++)
+                {
+                    func(i, chunk);
+                }
+            }, chunkSize);
+    }
+
+    ///
+    /// \brief Append the elements of every chunk, in chunk order
+    ///@{
+    void appendTo(std::vector<CollisionElement>& elementsA, std::vector<CollisionElement>& elementsB) const;
+    void appendToA(std::vector<CollisionElement>& elementsA) const;
+    void appendToB(std::vector<CollisionElement>& elementsB) const;
+    ///@}
+
+    ///
+    /// \brief Chunks of the last parallelFor, for callers that merge themselves
+    ///@{
+    int getNumChunks() const { return m_numChunks; }
+    const Chunk& getChunk(const int chunkId) const { return m_chunks[chunkId]; }
+    ///@}
+
+public:
+    static constexpr int DefaultChunkSize = 256;
+
+protected:
+    ///
+    /// \brief Compacts one side of every chunk onto the end of elements
+    ///
+    void append(std::vector<CollisionElement>& elements, std::vector<CollisionElement> Chunk::* side) const;
+
+    std::vector<Chunk> m_chunks;
+    int m_numChunks = 0;
+    mutable std::vector<size_t> m_offsets; ///< Prefix sum of chunk sizes
+};
+} // namespace imstk
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCompactCollisionData.h"
+
+namespace imstk
+{
+namespace
+{
+using ElementArrays = CompactCollisionData::ElementArrays;
+
+void
+resizeArrays(ElementArrays& arrays, const std::array<int, CompactCollisionData::NumElementTypes>& sizes)
+{
+    std::get<0>(arrays).resize(sizes[0]);
+    std::get<1>(arrays).resize(sizes[1]);
+    std::get<2>(arrays).resize(sizes[2]);
+    std::get<3>(arrays).resize(sizes[3]);
+    std::get<4>(arrays).resize(sizes[4]);
+}
+
+///
+/// \brief Copies the element into the array of its type
+///
+void
+setElement(ElementArrays& arrays, const int index, const CollisionElement& elem)
+{
+    switch (elem.m_type)
+    {
+    case CollisionElementType::Empty:
+        break;
+    case CollisionElementType::CellVertex:
+        std::get<std::vector<CellVertexElement>>(arrays)[index] = elem.m_element.m_CellVertexElement;
+        break;
+    case CollisionElementType::CellIndex:
+        std::get<std::vector<CellIndexElement>>(arrays)[index] = elem.m_element.m_CellIndexElement;
+        break;
+    case CollisionElementType::PointDirection:
+        std::get<std::vector<PointDirectionElement>>(arrays)[index] = elem.m_element.m_PointDirectionElement;
+        break;
+    case CollisionElementType::PointIndexDirection:
+        std::get<std::vector<PointIndexDirectionElement>>(arrays)[index] = elem.m_element.m_PointIndexDirectionElement;
+        break;
+    }
+}
+
+CollisionElement
+getElement(const ElementArrays& arrays, const CollisionElementType type, const int index)
+{
+    switch (type)
+    {
+    case CollisionElementType::CellVertex:
+        return std::get<std::vector<CellVertexElement>>(arrays)[index];
+    case CollisionElementType::CellIndex:
+        return std::get<std::vector<CellIndexElement>>(arrays)[index];
+    case CollisionElementType::PointDirection:
+        return std::get<std::vector<PointDirectionElement>>(arrays)[index];
+    case CollisionElementType::PointIndexDirection:
+        return std::get<std::vector<PointIndexDirectionElement>>(arrays)[index];
+    default:
+        return CollisionElement();
+    }
+}
+} // namespace
+
+void
+CompactCollisionData::assign(const std::vector<CollisionElement>& elementsA, const std::vector<CollisionElement>& elementsB)
+{
+    CHECK(elementsA.empty() || elementsB.empty() || elementsA.size() == elementsB.size())
+        << "Collision data sides must be of equal size or empty";
+
+    m_hasA = !elementsA.empty();
+    m_hasB = !elementsB.empty();
+    const int numContacts = static_cast<int>(std::max(elementsA.size(), elementsB.size()));
+    auto      getTypes    = [&](const int i)
+                            {
+                                return std::make_pair(
+                                    m_hasA ? static_cast<int>(elementsA[i].m_type) : 0,
+                                    m_hasB ? static_cast<int>(elementsB[i].m_type) : 0);
+                            };
+
+    // Count the contacts of every pair of types
+    std::array<std::array<int, NumElementTypes>, NumElementTypes> counts = { };
+    for (int i = 0; i < numContacts; i++)
+    {
+        const std::pair<int, int> types = getTypes(i);
+        counts[types.first][types.second]++;
+    }
+
+    // Groups are ordered by type of A, then type of B. In the arrays of A a type
+    // is split by type of B, in the arrays of B a type is split by type of A
+    std::array<int, NumElementTypes> sizesA = { };
+    std::array<int, NumElementTypes> sizesB = { };
+    int                              start  = 0;
+    for (int typeA = 0; typeA < NumElementTypes; typeA++)
+    {
+        for (int typeB = 0; typeB < NumElementTypes; typeB++)
+        {
+            PairRange& range = m_ranges[typeA][typeB];
+            range.start   = start;
+            range.startA  = sizesA[typeA];
+            range.startB  = sizesB[typeB];
+            range.count   = counts[typeA][typeB];
+            start        += range.count;
+            sizesA[typeA] += range.count;
+            sizesB[typeB] += range.count;
+        }
+    }
+    resizeArrays(m_elementsA, sizesA);
+    resizeArrays(m_elementsB, sizesB);
+    m_sourceIds.resize(numContacts);
+    m_ccdDataA.resize(m_hasA ? numContacts : 0);
+    m_ccdDataB.resize(m_hasB ? numContacts : 0);
+
+    // Scatter every contact to its group, keeping the given order within groups
+    counts = { };
+    for (int i = 0; i < numContacts; i++)
+    {
+        const std::pair<int, int> types  = getTypes(i);
+        const PairRange&          range  = m_ranges[types.first][types.second];
+        const int                 offset = counts[types.first][types.second]++;
+        if (m_hasA)
+        {
+            setElement(m_elementsA, range.startA + offset, elementsA[i]);
+            m_ccdDataA[range.start + offset] = elementsA[i].m_ccdData;
+        }
+        if (m_hasB)
+        {
+            setElement(m_elementsB, range.startB + offset, elementsB[i]);
+            m_ccdDataB[range.start + offset] = elementsB[i].m_ccdData;
+        }
+        m_sourceIds[range.start + offset] = i;
+    }
+}
+
+void
+CompactCollisionData::toElements(std::vector<CollisionElement>& elementsA, std::vector<CollisionElement>& elementsB) const
+{
+    elementsA.clear();
+    elementsB.clear();
+    for (int typeA = 0; typeA < NumElementTypes; typeA++)
+    {
+        for (int typeB = 0; typeB < NumElementTypes; typeB++)
+        {
+            const PairRange& range = m_ranges[typeA][typeB];
+            for (int i = 0; i < range.count; i++)
+            {
+                if (m_hasA)
+                {
+                    elementsA.push_back(getElement(m_elementsA, static_cast<CollisionElementType>(typeA), range.startA + i));
+                    elementsA.back().m_ccdData = m_ccdDataA[range.start + i];
+                }
+                if (m_hasB)
+                {
+                    elementsB.push_back(getElement(m_elementsB, static_cast<CollisionElementType>(typeB), range.startB + i));
+                    elementsB.back().m_ccdData = m_ccdDataB[range.start + i];
+                }
+            }
+        }
+    }
+}
+
+void
+CompactCollisionData::clear()
+{
+    assign({ }, { });
+}
+} // namespace imstk
\ No newline at end of file
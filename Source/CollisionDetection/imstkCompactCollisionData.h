@@ -0,0 +1,150 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkCollisionData.h"
+
+#include <array>
+#include <tuple>
+
+namespace imstk
+{
+///
+/// \brief Maps an element struct to its CollisionElementType
+///
+template<typename T> struct CollisionElementTypeOf;
+template<> struct CollisionElementTypeOf<EmptyElement> { static constexpr CollisionElementType value = CollisionElementType::Empty; };
+template<> struct CollisionElementTypeOf<CellVertexElement> { static constexpr CollisionElementType value = CollisionElementType::CellVertex; };
+template<> struct CollisionElementTypeOf<CellIndexElement> { static constexpr CollisionElementType value = CollisionElementType::CellIndex; };
+template<> struct CollisionElementTypeOf<PointDirectionElement> { static constexpr CollisionElementType value = CollisionElementType::PointDirection; };
+template<> struct CollisionElementTypeOf<PointIndexDirectionElement> { static constexpr CollisionElementType value = CollisionElementType::PointIndexDirection; };
+
+///
+/// \class CompactCollisionData
+///
+/// \brief Structure of arrays alternative to the CollisionElement vectors of
+/// CollisionData. Every element type of a side is kept in its own array, so an
+/// element takes the size of its own struct rather than that of the largest
+/// member of the CollisionElement union (a CellIndexElement is 28 bytes vs 112).
+///
+/// Contacts are grouped by the pair of element types of their sides. Within a
+/// group they keep the order they were given in. The contacts of one pair of types
+/// are then contiguous in both side arrays and can be streamed with forEachPair
+/// without testing the type of every element.
+///
+/// Algorithms that produce CollisionElement vectors are converted with assign.
+///
+class CompactCollisionData
+{
+public:
+    static constexpr int NumElementTypes = 5;
+
+    ///
+    /// \brief Location of the contacts of one pair of element types
+    ///
+    struct PairRange
+    {
+        int start  = 0; ///< First contact of the pair in grouped order
+        int startA = 0; ///< First element of the pair in the A array of its type
+        int startB = 0; ///< First element of the pair in the B array of its type
+        int count  = 0;
+    };
+
+    ///
+    /// \brief Elements of one side, one array per CollisionElementType
+    ///
+    using ElementArrays = std::tuple<
+        std::vector<EmptyElement>,
+        std::vector<CellVertexElement>,
+        std::vector<CellIndexElement>,
+        std::vector<PointDirectionElement>,
+        std::vector<PointIndexDirectionElement>>;
+
+public:
+    CompactCollisionData() = default;
+    virtual ~CompactCollisionData() = default;
+
+public:
+    ///
+    /// \brief Convert from CollisionElement vectors. Either side may be empty for
+    /// one sided data, otherwise both must have the same size. Allocates only
+    /// when a side array needs to grow.
+    ///
+    void assign(const std::vector<CollisionElement>& elementsA, const std::vector<CollisionElement>& elementsB);
+
+    ///
+    /// \brief Convert from the elements of a CollisionData
+    ///
+    void assign(const CollisionData& data) { assign(data.elementsA, data.elementsB); }
+
+    ///
+    /// \brief Convert back to CollisionElement vectors, in grouped order. A side
+    /// that was empty when assigned is left empty.
+    ///
+    void toElements(std::vector<CollisionElement>& elementsA, std::vector<CollisionElement>& elementsB) const;
+
+    void clear();
+
+    int getNumContacts() const { return static_cast<int>(m_sourceIds.size()); }
+
+    ///
+    /// \brief Contacts of a pair of element types
+    ///
+    const PairRange& getRange(const CollisionElementType typeA, const CollisionElementType typeB) const
+    {
+        return m_ranges[static_cast<int>(typeA)][static_cast<int>(typeB)];
+    }
+
+    ///
+    /// \brief All elements of type T of side A/B
+    ///@{
+    template<typename T>
+    const std::vector<T>& getElementsA() const { return std::get<std::vector<T>>(m_elementsA); }
+    template<typename T>
+    const std::vector<T>& getElementsB() const { return std::get<std::vector<T>>(m_elementsB); }
+    ///@}
+
+    ///
+    /// \brief Index in the assigned vectors of every contact, in grouped order
+    ///
+    const std::vector<int>& getSourceIds() const { return m_sourceIds; }
+
+    ///
+    /// \brief Whether the A/B element of every contact, in grouped order, has CCD data.
+    /// Empty for a side that was empty when assigned
+    ///@{
+    const std::vector<char>& getCcdDataA() const { return m_ccdDataA; }
+    const std::vector<char>& getCcdDataB() const { return m_ccdDataB; }
+    ///@}
+
+    ///
+    /// \brief Calls func(elemA, elemB, contactId) for every contact whose A side
+    /// is an ElementA and B side an ElementB. contactId indexes getSourceIds
+    ///
+    template<typename ElementA, typename ElementB, typename Func>
+    void forEachPair(Func&& func) const
+    {
+        const PairRange& range = getRange(CollisionElementTypeOf<ElementA>::value, CollisionElementTypeOf<ElementB>::value);
+        const ElementA*  elemsA = getElementsA<ElementA>().data() + range.startA;
+        const ElementB*  elemsB = getElementsB<ElementB>().data() + range.startB;
+        for (int i = 0; i < range.count; i++)
+        {
+            func(elemsA[i], elemsB[i], range.start + i);
+        }
+    }
+
+protected:
+    ElementArrays m_elementsA;
+    ElementArrays m_elementsB;
+    std::vector<int>  m_sourceIds;
+    std::vector<char> m_ccdDataA;
+    std::vector<char> m_ccdDataB;
+    std::array<std::array<PairRange, NumElementTypes>, NumElementTypes> m_ranges;
+    bool m_hasA = false;
+    bool m_hasB = false;
+};
+} // namespace imstk
\ No newline at end of file
@@ -5,6 +5,7 @@
 */
 
 #include "imstkPbdCollisionHandling.h"
+#include "imstkParallelFor.h"
 #include "imstkPbdContactConstraint.h"
 #include "imstkPbdEdgeEdgeCCDConstraint.h"
 #include "imstkPbdEdgeEdgeConstraint.h"
@@ -20,10 +21,6 @@
 
 namespace imstk
 {
-#define REGISTER_CASE(case0, case1, case2, func)                                                      \
-    m_funcTable[{ case0, case1, case2 }] = [this](const ColElemSide& sideA, const ColElemSide& sideB) \
-                                           { func(sideA, sideB); }
-
 std::pair<PbdParticleId, Vec3d>
 PbdCollisionHandling::getBodyAndContactPoint(const CollisionElement& elem, const CollisionSideData& data)
 {
@@ -42,10 +39,12 @@ PbdCollisionHandling::getBodyAndContactPoint(const CollisionElement& elem, const
 /// \brief Gets triangle, edge, or vertex from the mesh given the CollisionElement
 /// \tparam Array type for vertex index storage, ex: VecDataArray<int, 4>, VecDataArray<int, 3>
 /// \tparam Cell type the index array is representing
+/// \param Function adding a virtual particle for vertices of non pbd sides
 ///
-template<typename ArrType, int cellType>
+template<typename ArrType, int cellType, typename AddVirtualFunc>
 static std::array<PbdParticleId, ArrType::NumComponents>
-getElementVertIds(const CollisionElement& elem, const PbdCollisionHandling::CollisionSideData& side)
+getElementVertIds(const CollisionElement& elem, const PbdCollisionHandling::CollisionSideData& side,
+                  AddVirtualFunc addVirtualParticle)
 {
     // Note: The unrolling of this functions loops could be important to performance
     typename ArrType::ValueType cell = -ArrType::ValueType::Ones();
@@ -84,7 +83,7 @@ getElementVertIds(const CollisionElement& elem, const PbdCollisionHandling::Coll
             int vid = cell[i];
             if (side.bodyId == 0)
             {
-                vid = side.model->addVirtualParticle((*side.vertices)[vid], 0.0).second;
+                vid = addVirtualParticle((*side.vertices)[vid]).second;
             }
             results[i] = { side.bodyId, vid };
         }
@@ -95,13 +94,15 @@ getElementVertIds(const CollisionElement& elem, const PbdCollisionHandling::Coll
 std::array<PbdParticleId, 2>
 PbdCollisionHandling::getEdge(const CollisionElement& elem, const CollisionSideData& side)
 {
-    return getElementVertIds<VecDataArray<int, 2>, IMSTK_EDGE>(elem, side);
+    return getElementVertIds<VecDataArray<int, 2>, IMSTK_EDGE>(elem, side,
+        [&](const Vec3d& pos) { return addVirtualParticle(side, pos); });
 }
 
 std::array<PbdParticleId, 3>
 PbdCollisionHandling::getTriangle(const CollisionElement& elem, const CollisionSideData& side)
 {
-    return getElementVertIds<VecDataArray<int, 3>, IMSTK_TRIANGLE>(elem, side);
+    return getElementVertIds<VecDataArray<int, 3>, IMSTK_TRIANGLE>(elem, side,
+        [&](const Vec3d& pos) { return addVirtualParticle(side, pos); });
 }
 
 std::array<PbdParticleId, 1>
@@ -125,7 +126,7 @@ PbdCollisionHandling::getVertex(const CollisionElement& elem, const CollisionSid
         }
         if (side.bodyId == 0)
         {
-            ptId = side.model->addVirtualParticle((*side.vertices)[ptId], 0.0).second;
+            ptId = addVirtualParticle(side, (*side.vertices)[ptId]).second;
         }
         results[0] = { side.bodyId, ptId };
     }
@@ -133,12 +134,32 @@ PbdCollisionHandling::getVertex(const CollisionElement& elem, const CollisionSid
     {
         if (elem.m_type == CollisionElementType::PointDirection)
         {
-            results[0] = { side.model->addVirtualParticle(elem.m_element.m_PointDirectionElement.pt, 0.0) };
+            results[0] = addVirtualParticle(side, elem.m_element.m_PointDirectionElement.pt);
         }
     }
     return results;
 }
 
+///
+/// \brief Number of vertices referred to by a contact case
+///
+static int
+getNumVertices(const PbdContactCase contactCase)
+{
+    switch (contactCase)
+    {
+    case PbdContactCase::Vertex:
+    case PbdContactCase::Primitive:
+        return 1;
+    case PbdContactCase::Edge:
+        return 2;
+    case PbdContactCase::Triangle:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
 template<int N>
 static std::array<Vec3d*, N>
 getElementVertIdsPrev(const std::array<PbdParticleId, N>& ids,
@@ -166,28 +187,6 @@ operator<<(std::ostream& os, const PbdCHTableKey& key)
 
 PbdCollisionHandling::PbdCollisionHandling()
 {
-    REGISTER_CASE(PbdContactCase::Vertex, PbdContactCase::Vertex, false, addConstraint_V_V);
-    REGISTER_CASE(PbdContactCase::Vertex, PbdContactCase::Edge, false, addConstraint_V_E);
-    REGISTER_CASE(PbdContactCase::Edge, PbdContactCase::Edge, false, addConstraint_E_E);
-    REGISTER_CASE(PbdContactCase::Vertex, PbdContactCase::Triangle, false, addConstraint_V_T);
-
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::Triangle, false, addConstraint_Body_T);
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::Edge, false, addConstraint_Body_E);
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::Vertex, false, addConstraint_Body_V);
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::Primitive, false, addConstraint_Body_V);
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::Body, false, addConstraint_Body_Body);
-
-    // If swap occurs the colliding object could be on the LHS causing issues
-    REGISTER_CASE(PbdContactCase::Primitive, PbdContactCase::Triangle, false, addConstraint_V_T);
-    REGISTER_CASE(PbdContactCase::Primitive, PbdContactCase::Edge, false, addConstraint_V_E);
-    REGISTER_CASE(PbdContactCase::Primitive, PbdContactCase::Vertex, false, addConstraint_V_V);
-
-    // One way point direction resolution
-    REGISTER_CASE(PbdContactCase::Vertex, PbdContactCase::None, false, addConstraint_V_V);
-    REGISTER_CASE(PbdContactCase::Body, PbdContactCase::None, false, addConstraint_Body_V);
-
-    // CCD cases
-    REGISTER_CASE(PbdContactCase::Edge, PbdContactCase::Edge, true, addConstraint_E_E_CCD);
 }
 
 PbdCollisionHandling::~PbdCollisionHandling()
@@ -284,20 +283,66 @@ PbdCollisionHandling::getCaseFromElement(const ColElemSide& elem)
     return PbdContactCase::None;
 }
 
-template<class T>
-T*
-PbdCollisionHandling::getCachedConstraint(ConstraintType type)
+PbdParticleId
+PbdCollisionHandling::addVirtualParticle(const CollisionSideData& side, const Vec3d& pos)
 {
-    if (!m_constraintCache[type].empty())
+    if (m_virtualParticlesBegin == -1)
     {
-        T* result = static_cast<T*>(m_constraintCache[type].back());
-        m_constraintCache[type].pop_back();
-        return result;
+        return side.model->addVirtualParticle(pos, 0.0);
     }
-    else
+
+    const int vid = m_virtualParticlesBegin + m_numVirtualParticlesUsed++;
+    CHECK(vid < m_virtualParticlesEnd) << "PbdCollisionHandling ran out of preallocated virtual particles";
+    PbdBody& virtualBody = *side.model->getBodies().m_bodies[0];
+    (*virtualBody.vertices)[vid]     = pos;
+    (*virtualBody.prevVertices)[vid] = pos;
+    return { 0, vid };
+}
+
+template<class T, bool (PbdCollisionHandling::* Kernel)(const PbdCollisionHandling::ColElemSide&, const PbdCollisionHandling::ColElemSide&, T&)>
+void
+PbdCollisionHandling::handleBatch(const ConstraintType type)
+{
+    const std::vector<ElementPair>& pairs = m_elementPairs[type];
+    if (pairs.empty())
+    {
+        return;
+    }
+
+    // Take a constraint from the cache for every pair, only allocates
+    // when there are more contacts than ever before
+    std::vector<PbdConstraint*>& cache = m_constraintCache[type];
+    std::vector<PbdConstraint*>& bin   = m_constraintBins[type];
+    while (cache.size() < pairs.size())
     {
-        return new T;
+        cache.push_back(new T);
     }
+    const size_t binStart = bin.size();
+    bin.insert(bin.end(), cache.end() - pairs.size(), cache.end());
+    cache.resize(cache.size() - pairs.size());
+
+    m_validPairs.resize(pairs.size());
+    ParallelUtils::parallelFor(pairs.size(),
+        [&](const size_t i)
+        {
+            m_validPairs[i] = (this->*Kernel)(pairs[i].sideA, pairs[i].sideB, *static_cast<T*>(bin[binStart + i]));
+        }, pairs.size() > 64);
+
+    // Return the constraints of pairs that didn't produce one, keeping the order
+    size_t binEnd = binStart;
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        PbdConstraint* constraint = bin[binStart + i];
+        if (m_validPairs[i])
+        {
+            bin[binEnd++] = constraint;
+        }
+        else
+        {
+            cache.push_back(constraint);
+        }
+    }
+    bin.resize(binEnd);
 }
 
 void
@@ -338,12 +383,18 @@ PbdCollisionHandling::handle(
         dataSideA.prevGeometry = m_colData->prevGeomA.get();
         dataSideB.prevGeometry = m_colData->prevGeomB.get();
 
+        // Sort the element pairs by the constraint they produce
+        for (int i = 0; i < NumTypes; i++)
+        {
+            m_elementPairs[i].clear();
+        }
+        m_maxNumVirtualParticles = 0;
         if (elementsA.size() == elementsB.size())
         {
             // Deal with two way contacts
             for (size_t i = 0; i < elementsA.size(); i++)
             {
-                handleElementPair(
+                sortElementPair(
                     { &elementsA[i], &dataSideA },
                     { &elementsB[i], &dataSideB });
             }
@@ -353,23 +404,37 @@ PbdCollisionHandling::handle(
             // Deal with one way contacts (only one side is needed)
             for (size_t i = 0; i < elementsA.size(); i++)
             {
-                handleElementPair(
+                sortElementPair(
                     { &elementsA[i], &dataSideA },
                     { nullptr, nullptr });
             }
             for (size_t i = 0; i < elementsB.size(); i++)
             {
-                handleElementPair(
+                sortElementPair(
                     { &elementsB[i], &dataSideB },
                     { nullptr, nullptr });
             }
         }
 
-        size_t constraints = 0;
-        for (int i = 0; i < NumTypes; ++i)
-        {
-            constraints += m_constraintBins[i].size();
-        }
+        // Preallocate the most virtual particles the pairs may use
+        PbdModel* model = dataSideA.model;
+        m_virtualParticlesBegin   = model->addVirtualParticles(m_maxNumVirtualParticles).second;
+        m_virtualParticlesEnd     = m_virtualParticlesBegin + m_maxNumVirtualParticles;
+        m_numVirtualParticlesUsed = 0;
+
+        handleBatch<PbdBodyToBodyNormalConstraint, &PbdCollisionHandling::initConstraint_Body_Body>(BodyBody);
+        handleBatch<PbdVertexToBodyConstraint, &PbdCollisionHandling::initConstraint_Body_V>(BodyVertex);
+        handleBatch<PbdEdgeToBodyConstraint, &PbdCollisionHandling::initConstraint_Body_E>(BodyEdge);
+        handleBatch<PbdTriangleToBodyConstraint, &PbdCollisionHandling::initConstraint_Body_T>(BodyTriangle);
+        handleBatch<PbdPointPointConstraint, &PbdCollisionHandling::initConstraint_V_V>(VertexVertex);
+        handleBatch<PbdPointEdgeConstraint, &PbdCollisionHandling::initConstraint_V_E>(VertexEdge);
+        handleBatch<PbdEdgeEdgeConstraint, &PbdCollisionHandling::initConstraint_E_E>(EdgeEdge);
+        handleBatch<PbdPointTriangleConstraint, &PbdCollisionHandling::initConstraint_V_T>(VertexTriangle);
+        handleBatch<PbdEdgeEdgeCCDConstraint, &PbdCollisionHandling::initConstraint_E_E_CCD>(EdgeEdgeCCD);
+
+        // Drop the unused virtual particles
+        model->resizeVirtualParticles(m_virtualParticlesBegin + m_numVirtualParticlesUsed);
+        m_virtualParticlesBegin = m_virtualParticlesEnd = -1;
     }
 
     if (m_processConstraints)
@@ -381,13 +446,22 @@ PbdCollisionHandling::handle(
             return;
         }
         // ObjA guaranteed to be PbdObject
-        auto pbdObjectA = std::dynamic_pointer_cast<PbdObject>(getInputObjectA());
-        pbdObjectA->getPbdModel()->getSolver()->addConstraints(&m_collisionConstraints);
+        auto                      pbdObjectA = std::dynamic_pointer_cast<PbdObject>(getInputObjectA());
+        std::shared_ptr<PbdModel> model      = pbdObjectA->getPbdModel();
+        if (m_useParallelProjection)
+        {
+            m_coloring.partition(m_collisionConstraints, model->getBodies());
+            model->getSolver()->addConstraints(&m_collisionConstraints, &m_coloring.getPartitionOffsets());
+        }
+        else
+        {
+            model->getSolver()->addConstraints(&m_collisionConstraints);
+        }
     }
 }
 
 void
-PbdCollisionHandling::handleElementPair(ColElemSide sideA, ColElemSide sideB)
+PbdCollisionHandling::sortElementPair(ColElemSide sideA, ColElemSide sideB)
 {
     PbdCHTableKey key;
     key.elemAType = getCaseFromElement(sideA);
@@ -421,10 +495,88 @@ PbdCollisionHandling::handleElementPair(ColElemSide sideA, ColElemSide sideB)
         }
     }
 
-    auto iter = m_funcTable.find(key);
-    if (iter != m_funcTable.end())
+    ConstraintType type = NumTypes;
+    if (key.ccd)
+    {
+        if (key.elemAType == PbdContactCase::Edge && key.elemBType == PbdContactCase::Edge)
+        {
+            type = EdgeEdgeCCD;
+        }
+    }
+    else if (key.elemAType == PbdContactCase::Body)
+    {
+        switch (key.elemBType)
+        {
+        case PbdContactCase::Vertex:
+        case PbdContactCase::Primitive:
+        case PbdContactCase::None:
+            type = BodyVertex;
+            break;
+        case PbdContactCase::Edge:
+            type = BodyEdge;
+            break;
+        case PbdContactCase::Triangle:
+            type = BodyTriangle;
+            break;
+        case PbdContactCase::Body:
+            type = BodyBody;
+            break;
+        default:
+            break;
+        }
+    }
+    // If swap occurs the colliding object could be on the LHS
+    else if (key.elemAType == PbdContactCase::Vertex || key.elemAType == PbdContactCase::Primitive)
+    {
+        switch (key.elemBType)
+        {
+        case PbdContactCase::Vertex:
+            type = VertexVertex;
+            break;
+        case PbdContactCase::Edge:
+            type = VertexEdge;
+            break;
+        case PbdContactCase::Triangle:
+            type = VertexTriangle;
+            break;
+        case PbdContactCase::None:
+            // One way point direction resolution
+            if (key.elemAType == PbdContactCase::Vertex)
+            {
+                type = VertexVertex;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    else if (key.elemAType == PbdContactCase::Edge && key.elemBType == PbdContactCase::Edge)
+    {
+        type = EdgeEdge;
+    }
+
+    if (type != NumTypes)
     {
-        iter->second(sideA, sideB);
+        m_elementPairs[type].push_back({ sideA, sideB });
+
+        // Count the virtual particles the pair may need, vertices of non pbd sides,
+        // point directions, and the resolve position of one way contacts
+        for (const ColElemSide* side : { &sideA, &sideB })
+        {
+            if (side->data == nullptr)
+            {
+                m_maxNumVirtualParticles++;
+                continue;
+            }
+            if (side->data->bodyId == 0)
+            {
+                m_maxNumVirtualParticles += getNumVertices(getCaseFromElement(*side));
+            }
+            if (side->elem->m_type == CollisionElementType::PointDirection)
+            {
+                m_maxNumVirtualParticles++;
+            }
+        }
     }
     else
     {
@@ -433,8 +585,11 @@ PbdCollisionHandling::handleElementPair(ColElemSide sideA, ColElemSide sideB)
     }
 }
 
-void
-PbdCollisionHandling::addConstraint_Body_V(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_Body_V(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdVertexToBodyConstraint& constraint)
 {
     const std::pair<PbdParticleId, Vec3d>& ptAAndContact = getBodyAndContactPoint(*sideA.elem, *sideA.data);
     PbdParticleId                          ptB;
@@ -461,65 +616,71 @@ PbdCollisionHandling::addConstraint_Body_V(const ColElemSide& sideA, const ColEl
         }
         else
         {
-            return;
+            return false;
         }
-        ptB = sideA.data->model->addVirtualParticle(resolvePos, 0.0);
+        ptB = addVirtualParticle(*sideA.data, resolvePos);
     }
     else
     {
         ptB = getVertex(*sideB.elem, *sideB.data)[0];
     }
 
-    PbdVertexToBodyConstraint* constraint = getCachedConstraint<PbdVertexToBodyConstraint>(BodyVertex);
-    constraint->initConstraint(sideA.data->model->getBodies(),
+    constraint.initConstraint(sideA.data->model->getBodies(),
                         ptAAndContact.first,
                         ptAAndContact.second,
                         ptB,
                         sideA.data->compliance);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[BodyVertex].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_Body_E(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_Body_E(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdEdgeToBodyConstraint& constraint)
 {
     const std::pair<PbdParticleId, Vec3d>& ptAAndContact = getBodyAndContactPoint(*sideA.elem, *sideA.data);
     std::array<PbdParticleId, 2>           ptsB = getEdge(*sideB.elem, *sideB.data);
 
-    PbdEdgeToBodyConstraint* constraint = getCachedConstraint<PbdEdgeToBodyConstraint>(BodyEdge);
-    constraint->initConstraint(sideB.data->model->getBodies(),
+    constraint.initConstraint(sideB.data->model->getBodies(),
                         ptAAndContact.first,
                         ptAAndContact.second,
                         ptsB[0], ptsB[1],
                         sideA.data->compliance);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[BodyEdge].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_Body_T(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_Body_T(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdTriangleToBodyConstraint& constraint)
 {
     const std::pair<PbdParticleId, Vec3d>& ptAAndContact = getBodyAndContactPoint(*sideA.elem, *sideA.data);
     std::array<PbdParticleId, 3>           ptsB = getTriangle(*sideB.elem, *sideB.data);
 
-    PbdTriangleToBodyConstraint* constraint = getCachedConstraint<PbdTriangleToBodyConstraint>(BodyTriangle);
-    constraint->initConstraint(sideB.data->model->getBodies(),
+    constraint.initConstraint(sideB.data->model->getBodies(),
                         ptAAndContact.first,
                         ptAAndContact.second,
                         ptsB[0], ptsB[1], ptsB[2],
                         sideA.data->compliance);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[BodyTriangle].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_Body_Body(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_Body_Body(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdBodyToBodyNormalConstraint& constraint)
 {
     const std::pair<PbdParticleId, Vec3d>& ptAAndContact = getBodyAndContactPoint(*sideA.elem, *sideA.data);
     const std::pair<PbdParticleId, Vec3d>& ptBAndContact = getBodyAndContactPoint(*sideB.elem, *sideB.data);
@@ -530,9 +691,7 @@ PbdCollisionHandling::addConstraint_Body_Body(const ColElemSide& sideA, const Co
         normal = sideA.elem->m_element.m_PointDirectionElement.dir;
     }
 
-    PbdBodyToBodyNormalConstraint* constraint = getCachedConstraint<PbdBodyToBodyNormalConstraint>(BodyBody);
-
-    constraint->initConstraint(
+    constraint.initConstraint(
                         sideA.data->model->getBodies(),
                         ptAAndContact.first,
                         ptAAndContact.second,
@@ -540,48 +699,53 @@ PbdCollisionHandling::addConstraint_Body_Body(const ColElemSide& sideA, const Co
                         ptBAndContact.second,
                         normal,
                         sideA.data->compliance);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[BodyBody].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_V_T(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_V_T(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdPointTriangleConstraint& constraint)
 {
     const PbdParticleId          ptA  = getVertex(*sideA.elem, *sideA.data)[0];
     std::array<PbdParticleId, 3> ptsB = getTriangle(*sideB.elem, *sideB.data);
 
-    PbdPointTriangleConstraint* constraint = getCachedConstraint<PbdPointTriangleConstraint>(VertexTriangle);
-    constraint->initConstraint(ptA, ptsB[0], ptsB[1], ptsB[2],
+    constraint.initConstraint(ptA, ptsB[0], ptsB[1], ptsB[2],
                         sideA.data->stiffness, sideB.data->stiffness);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setEnableBoundaryCollisions(m_enableBoundaryCollisions);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[VertexTriangle].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setEnableBoundaryCollisions(m_enableBoundaryCollisions);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_E_E(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_E_E(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdEdgeEdgeConstraint& constraint)
 {
     std::array<PbdParticleId, 2> ptsA = getEdge(*sideA.elem, *sideA.data);
     std::array<PbdParticleId, 2> ptsB = getEdge(*sideB.elem, *sideB.data);
 
-    PbdEdgeEdgeConstraint* constraint = getCachedConstraint<PbdEdgeEdgeConstraint>(EdgeEdge);
-    constraint->initConstraint(ptsA[0], ptsA[1], ptsB[0], ptsB[1],
+    constraint.initConstraint(ptsA[0], ptsA[1], ptsB[0], ptsB[1],
                         sideA.data->stiffness, sideB.data->stiffness);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setEnableBoundaryCollisions(m_enableBoundaryCollisions);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[EdgeEdge].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setEnableBoundaryCollisions(m_enableBoundaryCollisions);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_E_E_CCD(
+bool
+PbdCollisionHandling::initConstraint_E_E_CCD(
     const ColElemSide& sideA,
-    const ColElemSide& sideB)
+    const ColElemSide& sideB,
+    PbdEdgeEdgeCCDConstraint& constraint)
 {
     std::array<PbdParticleId, 2> ptsA = getEdge(*sideA.elem, *sideA.data);
     std::array<PbdParticleId, 2> ptsB = getEdge(*sideB.elem, *sideB.data);
@@ -591,35 +755,39 @@ PbdCollisionHandling::addConstraint_E_E_CCD(
     std::array<Vec3d*, 2> prevPtsA = getElementVertIdsPrev<2>(ptsA, *sideA.data);
     std::array<Vec3d*, 2> prevPtsB = getElementVertIdsPrev<2>(ptsB, *sideB.data);
 
-    PbdEdgeEdgeCCDConstraint* constraint = getCachedConstraint<PbdEdgeEdgeCCDConstraint>(EdgeEdgeCCD);
-    constraint->initConstraint(
+    constraint.initConstraint(
                         prevPtsA[0], prevPtsA[1], prevPtsB[0], prevPtsB[1],
                         ptsA[0], ptsA[1], ptsB[0], ptsB[1],
                         sideA.data->stiffness, sideB.data->stiffness,
                         m_ccdSubsteps);
-    constraint->setEnableBoundaryCollisions(m_enableBoundaryCollisions);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[EdgeEdgeCCD].push_back(constraint);
+    constraint.setEnableBoundaryCollisions(m_enableBoundaryCollisions);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_V_E(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_V_E(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdPointEdgeConstraint& constraint)
 {
     const PbdParticleId          ptA  = getVertex(*sideA.elem, *sideA.data)[0];
     std::array<PbdParticleId, 2> ptsB = getEdge(*sideB.elem, *sideB.data);
 
-    PbdPointEdgeConstraint* constraint = getCachedConstraint<PbdPointEdgeConstraint>(VertexEdge);
-    constraint->initConstraint(ptA, ptsB[0], ptsB[1],
+    constraint.initConstraint(ptA, ptsB[0], ptsB[1],
                         sideA.data->stiffness, sideB.data->stiffness);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setEnableBoundaryCollisions(m_enableBoundaryCollisions);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[VertexEdge].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setEnableBoundaryCollisions(m_enableBoundaryCollisions);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
-void
-PbdCollisionHandling::addConstraint_V_V(const ColElemSide& sideA, const ColElemSide& sideB)
+bool
+PbdCollisionHandling::initConstraint_V_V(
+    const ColElemSide& sideA,
+    const ColElemSide& sideB,
+    PbdPointPointConstraint& constraint)
 {
     // One special case with one-way
     const PbdParticleId ptA = getVertex(*sideA.elem, *sideA.data)[0];
@@ -647,24 +815,23 @@ PbdCollisionHandling::addConstraint_V_V(const ColElemSide& sideA, const ColElemS
         }
         else
         {
-            return;
+            return false;
         }
-        ptB = sideA.data->model->addVirtualParticle(resolvePos, 0.0);
+        ptB = addVirtualParticle(*sideA.data, resolvePos);
     }
     else
     {
         ptB = getVertex(*sideB.elem, *sideB.data)[0];
     }
 
-    PbdPointPointConstraint* constraint = getCachedConstraint<PbdPointPointConstraint>(VertexVertex);
-    constraint->initConstraint(ptA, ptB,
+    constraint.initConstraint(ptA, ptB,
                         sideA.data->stiffness,
         (sideB.data == nullptr) ? 0.0 : sideB.data->stiffness);
-    constraint->setFriction(m_friction);
-    constraint->setRestitution(m_restitution);
-    constraint->setEnableBoundaryCollisions(m_enableBoundaryCollisions);
-    constraint->setCorrectVelocity(m_useCorrectVelocity);
-    m_constraintBins[VertexVertex].push_back(constraint);
+    constraint.setFriction(m_friction);
+    constraint.setRestitution(m_restitution);
+    constraint.setEnableBoundaryCollisions(m_enableBoundaryCollisions);
+    constraint.setCorrectVelocity(m_useCorrectVelocity);
+    return true;
 }
 
 void
@@ -8,8 +8,10 @@
 
 #include "imstkCollisionHandling.h"
 #include "imstkPbdConstraint.h"
+#include "imstkPbdConstraintColoring.h"
 
-#include <unordered_map>
+#include <atomic>
+#include <functional>
 
 namespace imstk
 {
@@ -94,8 +96,17 @@ struct hash<imstk::PbdCHTableKey>
 
 namespace imstk
 {
+class PbdBodyToBodyNormalConstraint;
+class PbdEdgeEdgeCCDConstraint;
+class PbdEdgeEdgeConstraint;
+class PbdEdgeToBodyConstraint;
 class PbdObject;
 class PbdModel;
+class PbdPointEdgeConstraint;
+class PbdPointPointConstraint;
+class PbdPointTriangleConstraint;
+class PbdTriangleToBodyConstraint;
+class PbdVertexToBodyConstraint;
 class PointSet;
 class PointwiseMap;
 
@@ -114,6 +125,11 @@ class PointwiseMap;
 /// The VV and VE are often redundant but handled anyways for robustness to different inputs.
 /// The PD is often reported for point contacts, most commonly on primitive vs mesh collisions.
 ///
+/// Element pairs are first sorted by the constraint type they produce, each homogeneous
+/// batch is then handled in parallel by a statically dispatched kernel that initializes
+/// constraints taken from a pool. Virtual particles are allocated up front for the whole
+/// batch, so handling does not allocate once the pools are large enough.
+///
 class PbdCollisionHandling : public CollisionHandling
 {
 public:
@@ -217,9 +233,28 @@ public:
     double getDeformableStiffnessB() const { return m_stiffness[1]; }
     /// @}
 
+    ///
+    /// \brief Get/Set whether the generated constraints are colored every frame
+    /// so that they may be projected in parallel by the PbdSolver. Constraints
+    /// sharing no movable particle are grouped, which relaxes the ordering given by
+    /// orderCollisionConstraints. Off by default.
+    /// @{
+    void setUseParallelProjection(const bool useParallelProjection) { m_useParallelProjection = useParallelProjection; }
+    bool getUseParallelProjection() const { return m_useParallelProjection; }
+    /// @}
+
+    ///
+    /// \brief Get/Set the minimum number of constraints in a color for it to be
+    /// projected in parallel, smaller colors are projected sequentially
+    /// @{
+    void setMinParallelPartitionSize(const size_t size) { m_coloring.setMinPartitionSize(size); }
+    size_t getMinParallelPartitionSize() const { return m_coloring.getMinPartitionSize(); }
+    /// @}
+
     ///
     /// \brief Return the constraints generated by this handler
-    /// This list of constraints is ordered in orderCollisionConstraints
+    /// This list of constraints is ordered in orderCollisionConstraints,
+    /// then grouped by color when using parallel projection
     ///
     const std::vector<PbdConstraint*>& getConstraints() const { return m_collisionConstraints; }
 
@@ -266,41 +301,59 @@ protected:
         const std::vector<CollisionElement>& elementsB) override;
 
     ///
-    /// \brief Handle a single element
+    /// \brief Sort a single element pair into the batch of the constraint type
+    /// it produces, sides are swapped as needed by the kernels
+    ///
+    void sortElementPair(ColElemSide sideA, ColElemSide sideB);
+
+    ///
+    /// \brief Adds a zero mass virtual particle for the side. Thread safe during
+    /// batch handling where it takes one of the preallocated virtual particles
     ///
-    void handleElementPair(ColElemSide sideA, ColElemSide sideB);
+    PbdParticleId addVirtualParticle(const CollisionSideData& side, const Vec3d& pos);
 
+    // Kernels initialize the constraint of an element pair, returning false if the
+    // pair does not produce a constraint. These may run concurrently.
     // -----------------One-Way Rigid on X Cases-----------------
-    virtual void addConstraint_Body_V(
+    bool initConstraint_Body_V(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_Body_E(
+        const ColElemSide& sideB,
+        PbdVertexToBodyConstraint& constraint);
+    bool initConstraint_Body_E(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_Body_T(
+        const ColElemSide& sideB,
+        PbdEdgeToBodyConstraint& constraint);
+    bool initConstraint_Body_T(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
+        const ColElemSide& sideB,
+        PbdTriangleToBodyConstraint& constraint);
     // ---------------Two-Way Rigid on Rigid Cases---------------
-    virtual void addConstraint_Body_Body(
+    bool initConstraint_Body_Body(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
+        const ColElemSide& sideB,
+        PbdBodyToBodyNormalConstraint& constraint);
 
     // ----------DeformableMesh on DeformableMesh Cases----------
-    virtual void addConstraint_V_T(
+    bool initConstraint_V_T(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_E_E(
+        const ColElemSide& sideB,
+        PbdPointTriangleConstraint& constraint);
+    bool initConstraint_E_E(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_E_E_CCD(
+        const ColElemSide& sideB,
+        PbdEdgeEdgeConstraint& constraint);
+    bool initConstraint_E_E_CCD(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_V_E(
+        const ColElemSide& sideB,
+        PbdEdgeEdgeCCDConstraint& constraint);
+    bool initConstraint_V_E(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
-    virtual void addConstraint_V_V(
+        const ColElemSide& sideB,
+        PbdPointEdgeConstraint& constraint);
+    bool initConstraint_V_V(
         const ColElemSide& sideA,
-        const ColElemSide& sideB);
+        const ColElemSide& sideB,
+        PbdPointPointConstraint& constraint);
 
 private:
     double m_restitution = 0.0;  ///< Coefficient of restitution (1.0 = perfect elastic, 0.0 = inelastic)
@@ -349,8 +402,28 @@ protected:
         NumTypes
     };
 
-    template<class T>
-    T* getCachedConstraint(ConstraintType type);
+    ///
+    /// \brief Handle the sorted element pairs of a constraint type in parallel
+    /// with the kernel, constraints are taken from the cache
+    ///
+    template<class T, bool (PbdCollisionHandling::* Kernel)(const ColElemSide&, const ColElemSide&, T&)>
+    void handleBatch(const ConstraintType type);
+
+    ///
+    /// \brief Element pair sorted by the constraint type it produces
+    ///
+    struct ElementPair
+    {
+        ColElemSide sideA;
+        ColElemSide sideB;
+    };
+    std::vector<ElementPair> m_elementPairs[NumTypes];
+    std::vector<char> m_validPairs; ///< Result of the kernel for every pair of a batch
+
+    int m_maxNumVirtualParticles = 0;               ///< Most virtual particles the sorted pairs may need
+    int m_virtualParticlesBegin  = -1;              ///< First preallocated virtual particle, -1 outside of batches
+    int m_virtualParticlesEnd    = -1;              ///< End of the preallocated virtual particles
+    std::atomic<int> m_numVirtualParticlesUsed { 0 };
 
     // Vectors to split out constraint types and allow for ordering
     // A single constraint instance should always either be in a bin or the cache
@@ -360,7 +433,7 @@ protected:
 
     std::vector<PbdConstraint*> m_collisionConstraints; ///< Vector of all collision constraints
 
-    std::unordered_map<PbdCHTableKey, std::function<void(
-                                                        const ColElemSide& elemA, const ColElemSide& elemB)>> m_funcTable;
+    bool m_useParallelProjection = false;
+    PbdConstraintColoring m_coloring;                   ///< Colors m_collisionConstraints for parallel projection
 };
 } // namespace imstk
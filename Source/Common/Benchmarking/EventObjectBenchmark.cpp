@@ -0,0 +1,183 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkEventObject.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+namespace
+{
+class Sender : public EventObject
+{
+public:
+    /* *INDENT-OFF* */
+    SIGNAL(Sender, preUpdate);
+    SIGNAL(Sender, otherSignal);
+    /* *INDENT-ON* */
+};
+
+class Receiver : public EventObject
+{
+public:
+    void receive(Event*) { m_count++; }
+
+    int m_count = 0;
+};
+
+///
+/// \brief The direct dispatch of EventObject before signals were interned, kept
+/// for comparison. Allocates the event, compares signal names, and copies the
+/// receiving function of every observer on every post
+///
+class LegacySender
+{
+public:
+    using Observer = std::tuple<bool, std::weak_ptr<EventObject>, std::function<void (Event*)>>;
+
+    template<typename T>
+    void postEvent(const T& e)
+    {
+        std::shared_ptr<T> ePtr = std::make_shared<T>(e);
+        for (auto i = directObservers.begin(); i != directObservers.end(); i++)
+        {
+            if (i->first == e.m_type)
+            {
+                for (auto j = i->second.begin(); j != i->second.end(); j++)
+                {
+                    std::function<void(Event*)> receivingFunc = std::get<2>(*j);
+                    receivingFunc(ePtr.get());
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string, std::vector<Observer>>> directObservers;
+};
+
+///
+/// \brief Sender with numObservers direct observers of preUpdate, and one of another signal
+///
+std::shared_ptr<Sender>
+makeSender(const int numObservers, std::vector<std::shared_ptr<Receiver>>& receivers)
+{
+    auto sender = std::make_shared<Sender>();
+    receivers.push_back(std::make_shared<Receiver>());
+    connect(sender, Sender::otherSignal, receivers.back(), &Receiver::receive);
+    for (int i = 0; i < numObservers; i++)
+    {
+        receivers.push_back(std::make_shared<Receiver>());
+        connect(sender, Sender::preUpdate, receivers.back(), &Receiver::receive);
+    }
+    return sender;
+}
+} // namespace
+
+///
+/// \brief Per post cost of the previous implementation
+///
+static void
+BM_PostEventLegacy(benchmark::State& state)
+{
+    std::vector<std::shared_ptr<Receiver>> receivers;
+    LegacySender                           sender;
+    for (const std::string& signal : { Sender::otherSignal(), Sender::preUpdate() })
+    {
+        const int numObservers = (signal == Sender::preUpdate()) ? state.range(0) : 1;
+        sender.directObservers.push_back({ signal, {} });
+        for (int i = 0; i < numObservers; i++)
+        {
+            receivers.push_back(std::make_shared<Receiver>());
+            std::shared_ptr<Receiver> receiver = receivers.back();
+            std::function<void(Event*)> func   = std::bind(&Receiver::receive, receiver.get(), std::placeholders::_1);
+            sender.directObservers.back().second.push_back(
+                LegacySender::Observer(false, receiver, [ = ](Event* e) { func(e); }));
+        }
+    }
+
+    state.counters["Observers"] = state.range(0);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        sender.postEvent(Event(Sender::preUpdate()));
+    }
+}
+
+BENCHMARK(BM_PostEventLegacy)
+->Unit(benchmark::kNanosecond)
+->Name("Legacy PostEvent")
+->Arg(0)->Arg(1)->Arg(4);
+
+///
+/// \brief Per post cost of an event constructed from the signal name
+///
+static void
+BM_PostEventByName(benchmark::State& state)
+{
+    std::vector<std::shared_ptr<Receiver>> receivers;
+    std::shared_ptr<Sender>                sender = makeSender(state.range(0), receivers);
+
+    state.counters["Observers"] = state.range(0);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        sender->postEvent(Event(Sender::preUpdate()));
+    }
+}
+
+BENCHMARK(BM_PostEventByName)
+->Unit(benchmark::kNanosecond)
+->Name("PostEvent By Name")
+->Arg(0)->Arg(1)->Arg(4);
+
+///
+/// \brief Per post cost of an event constructed from the interned signal id
+///
+static void
+BM_PostEventById(benchmark::State& state)
+{
+    std::vector<std::shared_ptr<Receiver>> receivers;
+    std::shared_ptr<Sender>                sender = makeSender(state.range(0), receivers);
+
+    state.counters["Observers"] = state.range(0);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        sender->postEvent(Event(Sender::preUpdateId()));
+    }
+}
+
+BENCHMARK(BM_PostEventById)
+->Unit(benchmark::kNanosecond)
+->Name("PostEvent By Id")
+->Arg(0)->Arg(1)->Arg(4);
+
+///
+/// \brief Per post cost of an event queued to a receiver, including processing
+/// it on the receiver
+///
+static void
+BM_PostQueuedEvent(benchmark::State& state)
+{
+    auto sender   = std::make_shared<Sender>();
+    auto receiver = std::make_shared<Receiver>();
+    queueConnect(sender, Sender::preUpdate, receiver, &Receiver::receive);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        sender->postEvent(Event(Sender::preUpdateId()));
+        receiver->doAllEvents();
+    }
+}
+
+BENCHMARK(BM_PostQueuedEvent)
+->Unit(benchmark::kNanosecond)
+->Name("PostEvent Queued");
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSequentialTaskGraphController.h"
+#include "imstkTaskGraph.h"
+#include "imstkTbbTaskGraphController.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates a layered graph of numNodes empty nodes, width nodes per
+/// layer, every node of a layer depends on every node of the previous layer.
+/// Nodes do no work so timings reflect only scheduling overhead.
+///
+static std::shared_ptr<TaskGraph>
+makeLayeredGraph(const int numNodes, const int width)
+{
+    auto graph = std::make_shared<TaskGraph>();
+
+    std::vector<std::shared_ptr<TaskNode>> prevLayer = { graph->getSource() };
+    for (int i = 0; i < numNodes; i += width)
+    {
+        std::vector<std::shared_ptr<TaskNode>> layer;
+        for (int j = 0; j < width && i + j < numNodes; j++)
+        {
+            std::shared_ptr<TaskNode> node = graph->addFunction("Node" + std::to_string(i + j),
+                []() { benchmark::ClobberMemory(); });
+            for (const auto& prevNode : prevLayer)
+            {
+                graph->addEdge(prevNode, node);
+            }
+            layer.push_back(node);
+        }
+        prevLayer = layer;
+    }
+    for (const auto& prevNode : prevLayer)
+    {
+        graph->addEdge(prevNode, graph->getSink());
+    }
+    return graph;
+}
+
+///
+/// \brief Per frame cost of executing a graph with the sequential controller
+///
+static void
+BM_SequentialTaskGraph(benchmark::State& state)
+{
+    std::shared_ptr<TaskGraph> graph = makeLayeredGraph(state.range(0), state.range(1));
+
+    SequentialTaskGraphController controller;
+    controller.setTaskGraph(graph);
+    controller.initialize();
+
+    state.counters["Nodes"] = state.range(0);
+    state.counters["Width"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        controller.execute();
+    }
+}
+
+BENCHMARK(BM_SequentialTaskGraph)
+->Unit(benchmark::kMicrosecond)
+->Name("Sequential TaskGraph Execute")
+->ArgsProduct({ { 16, 64, 256, 1024 }, { 1, 4 } });
+
+///
+/// \brief Per frame cost of executing a graph with the tbb controller, the flow
+/// graph is built once in initialize and reused
+///
+static void
+BM_TbbTaskGraph(benchmark::State& state)
+{
+    std::shared_ptr<TaskGraph> graph = makeLayeredGraph(state.range(0), state.range(1));
+
+    TbbTaskGraphController controller;
+    controller.setTaskGraph(graph);
+    controller.initialize();
+
+    state.counters["Nodes"] = state.range(0);
+    state.counters["Width"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        controller.execute();
+    }
+}
+
+BENCHMARK(BM_TbbTaskGraph)
+->Unit(benchmark::kMicrosecond)
+->Name("Tbb TaskGraph Execute")
+->ArgsProduct({ { 16, 64, 256, 1024 }, { 1, 4 } });
+
+///
+/// \brief Per frame cost of executing a graph with the tbb controller when the
+/// topology changes every frame, forcing the flow graph to be rebuilt. This is
+/// the cost every frame paid before the flow graph was made persistent
+///
+static void
+BM_TbbTaskGraphRebuild(benchmark::State& state)
+{
+    std::shared_ptr<TaskGraph> graph = makeLayeredGraph(state.range(0), state.range(1));
+
+    TbbTaskGraphController controller;
+    controller.setTaskGraph(graph);
+    controller.initialize();
+
+    state.counters["Nodes"] = state.range(0);
+    state.counters["Width"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        // Redundant edge, doesn't change execution but invalidates the flow graph
+        graph->addEdge(graph->getSource(), graph->getSink());
+        controller.execute();
+        graph->removeEdge(graph->getSource(), graph->getSink());
+    }
+}
+
+BENCHMARK(BM_TbbTaskGraphRebuild)
+->Unit(benchmark::kMicrosecond)
+->Name("Tbb TaskGraph Execute With Rebuild")
+->ArgsProduct({ { 16, 64, 256, 1024 }, { 1, 4 } });
+
+// Run the benchmark
+BENCHMARK_MAIN();
\ No newline at end of file
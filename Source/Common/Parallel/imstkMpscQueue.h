@@ -0,0 +1,98 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <atomic>
+
+namespace imstk
+{
+namespace ParallelUtils
+{
+///
+/// \class MpscQueue
+///
+/// \brief Lock-free multiple producer, single consumer queue. Any number of
+/// threads may push concurrently, a single consumer takes all pushed items at
+/// once in the order they were pushed.
+///
+template<typename T>
+class MpscQueue
+{
+private:
+    struct Node
+    {
+        T     value;
+        Node* next;
+    };
+
+public:
+    MpscQueue() = default;
+
+    ///
+    /// \brief Copy constructor, creates an empty queue as the nodes of the
+    /// other queue are owned by it and the atomic head cannot be copied
+    ///
+    MpscQueue(const MpscQueue&) { }
+
+    MpscQueue& operator=(const MpscQueue&) { return *this; }
+
+    ~MpscQueue()
+    {
+        consumeAll([](T&) { });
+    }
+
+public:
+    ///
+    /// \brief Push an item, thread safe and lock-free
+    ///
+    void push(T value)
+    {
+        Node* node = new Node{ std::move(value), m_head.load(std::memory_order_relaxed) };
+        while (!m_head.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    ///
+    /// \brief Returns true if nothing has been pushed since the last consume
+    ///
+    bool empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+    ///
+    /// \brief Takes every item pushed so far and calls func on each in push order.
+    /// Only one thread may consume at a time
+    ///
+    template<typename Func>
+    void consumeAll(Func func)
+    {
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        // Nodes are linked newest first, reverse them
+        Node* prev = nullptr;
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            node->next = prev;
+            prev       = node;
+            node       = next;
+        }
+
+        while (prev != nullptr)
+        {
+            Node* next = prev->next;
+            func(prev->value);
+            delete prev;
+            prev = next;
+        }
+    }
+
+private:
+    std::atomic<Node*> m_head = { nullptr };
+};
+} // end namespace ParallelUtils
+} // end namespace imstk
\ No newline at end of file
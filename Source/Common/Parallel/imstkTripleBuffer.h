@@ -0,0 +1,81 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <atomic>
+
+namespace imstk
+{
+namespace ParallelUtils
+{
+///
+/// \class TripleBuffer
+///
+/// \brief Lock-free single producer, single consumer exchange of the latest
+/// value. The producer writes into its own back buffer and swaps it with a
+/// shared middle buffer, the consumer swaps the middle buffer with its front
+/// buffer only when a new value was written. Neither side ever waits and the
+/// consumer always reads a complete value, older values are skipped.
+///
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    ///
+    /// \brief Copy constructor, creates an empty buffer as the atomic state
+    /// cannot be copied
+    ///
+    TripleBuffer(const TripleBuffer&) { }
+
+    TripleBuffer& operator=(const TripleBuffer&) { return *this; }
+
+public:
+    ///
+    /// \brief Publish a value, only one thread may write
+    ///
+    void write(const T& value)
+    {
+        m_buffers[m_backIndex] = value;
+        const int prevState = m_middleState.exchange(m_backIndex | DirtyBit, std::memory_order_acq_rel);
+        m_backIndex = prevState & IndexMask;
+    }
+
+    ///
+    /// \brief Returns the latest published value, only one thread may read.
+    /// The returned reference stays valid until the next read
+    ///
+    const T& read()
+    {
+        if (m_middleState.load(std::memory_order_relaxed) & DirtyBit)
+        {
+            const int prevState = m_middleState.exchange(m_frontIndex, std::memory_order_acq_rel);
+            m_frontIndex = prevState & IndexMask;
+            m_hasValue   = true;
+        }
+        return m_buffers[m_frontIndex];
+    }
+
+    ///
+    /// \brief Returns true if the last read returned a written value, as opposed
+    /// to a default constructed one. Only to be called by the reader
+    ///
+    bool hasValue() const { return m_hasValue; }
+
+private:
+    static constexpr int IndexMask = 0x3;
+    static constexpr int DirtyBit  = 0x4;
+
+    T m_buffers[3];
+    int m_backIndex  = 0;                 ///< Owned by the writer
+    int m_frontIndex = 2;                 ///< Owned by the reader
+    bool m_hasValue  = false;             ///< Owned by the reader
+    std::atomic<int> m_middleState = { 1 }; ///< Shared buffer index and whether it holds an unread value
+};
+} // end namespace ParallelUtils
+} // end namespace imstk
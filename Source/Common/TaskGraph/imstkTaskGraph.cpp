@@ -108,6 +108,7 @@ TaskGraph::addEdge(std::shared_ptr<TaskNode> srcNode, std::shared_ptr<TaskNode>
 
     m_adjList[srcNode].insert(destNode);
     m_invAdjList[destNode].insert(srcNode);
+    m_modifiedCount++;
 }
 
 void
@@ -165,6 +166,7 @@ TaskGraph::removeEdge(std::shared_ptr<TaskNode> srcNode, std::shared_ptr<TaskNod
     {
         m_invAdjList.erase(destNode);
     }
+    m_modifiedCount++;
 }
 
 bool
@@ -175,6 +177,7 @@ TaskGraph::addNode(std::shared_ptr<TaskNode> node)
     {
         // Put it in this graph
         m_nodes.push_back(node);
+        m_modifiedCount++;
         return true;
     }
     else
@@ -194,6 +197,7 @@ TaskGraph::addFunction(std::string name, std::function<void()> func)
 {
     std::shared_ptr<TaskNode> node = std::make_shared<TaskNode>(func, name);
     m_nodes.push_back(node);
+    m_modifiedCount++;
     return node;
 }
 
@@ -223,6 +227,7 @@ TaskGraph::removeNode(std::shared_ptr<TaskNode> node)
     if (it != endNode())
     {
         m_nodes.erase(it);
+        m_modifiedCount++;
     }
     return true;
 }
@@ -363,6 +368,7 @@ TaskGraph::clear()
 {
     m_nodes.clear();
     clearEdges();
+    m_modifiedCount++;
     addNode(m_source);
     addNode(m_sink);
 }
@@ -598,6 +604,7 @@ TaskGraph::removeUnusedNodes(std::shared_ptr<TaskGraph> graph)
     {
         results->m_nodes[iter++] = i;
     }
+    results->m_modifiedCount++;
     return results;
 }
 
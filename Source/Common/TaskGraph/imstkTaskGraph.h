@@ -197,8 +197,16 @@ public:
     {
         m_adjList.clear();
         m_invAdjList.clear();
+        m_modifiedCount++;
     }
 
+    ///
+    /// \brief Returns a counter incremented whenever nodes or edges are added/removed,
+    /// used by controllers to detect topology changes. Modifications made directly
+    /// through getNodes are not tracked.
+    ///
+    size_t getModifiedCount() const { return m_modifiedCount; }
+
 // Graph algorithms, todo: Move into filtering module
 public:
     ///
@@ -268,5 +276,7 @@ protected:
 
     std::shared_ptr<TaskNode> m_source = nullptr;
     std::shared_ptr<TaskNode> m_sink   = nullptr;
+
+    size_t m_modifiedCount = 0;   ///< Incremented on every topology change
 };
 } // namespace imstk
@@ -17,32 +17,59 @@ using namespace tbb::flow;
 
 namespace imstk
 {
-void
-TbbTaskGraphController::execute()
+using TbbContinueNode = continue_node<continue_msg>;
+
+///
+/// \struct TbbFlowGraph
+///
+/// \brief Persistent tbb flow graph mirroring a TaskGraph
+///
+struct TbbFlowGraph
 {
-    using TbbContinueNode = continue_node<continue_msg>;
+    TbbFlowGraph() : start(g) { }
 
     graph g;
+    broadcast_node<continue_msg> start;
+    std::vector<std::unique_ptr<TbbContinueNode>> nodes; ///< One per TaskNode (except source)
+};
 
-    broadcast_node<continue_msg> start(g);
+TbbTaskGraphController::TbbTaskGraphController() = default;
 
-    // Create a continue node for every TaskNode (except start)
-    std::unordered_map<std::shared_ptr<TaskNode>, TbbContinueNode> tbbNodes;
-    using NodeKeyValuePair = std::pair<std::shared_ptr<TaskNode>, TbbContinueNode>;
+TbbTaskGraphController::~TbbTaskGraphController() = default;
+
+void
+TbbTaskGraphController::init()
+{
+    buildFlowGraph();
+}
+
+void
+TbbTaskGraphController::buildFlowGraph()
+{
+    m_builtGraph = m_graph;
+    m_builtModifiedCount = m_graph->getModifiedCount();
+
+    // Any previous graph must be idle, it's torn down entirely
+    m_flowGraph = std::make_unique<TbbFlowGraph>();
 
     const TaskNodeVector& nodes = m_graph->getNodes();
     if (nodes.size() == 0)
     {
         return;
     }
+
+    // Create a continue node for every TaskNode (except start)
+    std::unordered_map<std::shared_ptr<TaskNode>, TbbContinueNode*> tbbNodes;
     tbbNodes.reserve(nodes.size());
+    m_flowGraph->nodes.reserve(nodes.size());
     for (size_t i = 0; i < nodes.size(); i++)
     {
         if (m_graph->getSource() != nodes[i])
         {
             std::shared_ptr<TaskNode> node = nodes[i];
-            tbbNodes.insert(NodeKeyValuePair(node, TbbContinueNode(g,
-                [node](continue_msg) { node->execute(); })));
+            m_flowGraph->nodes.push_back(std::make_unique<TbbContinueNode>(m_flowGraph->g,
+                [node](continue_msg) { node->execute(); }));
+            tbbNodes[node] = m_flowGraph->nodes.back().get();
         }
     }
 
@@ -53,22 +80,36 @@ TbbTaskGraphController::execute()
         {
             for (const auto& outputNode : i.second)
             {
-                TbbContinueNode& tbbNode2 = tbbNodes.at(outputNode);
-                make_edge(start, tbbNode2);
+                make_edge(m_flowGraph->start, *tbbNodes.at(outputNode));
             }
         }
         else
         {
-            TbbContinueNode& tbbNode1 = tbbNodes.at(i.first);
+            TbbContinueNode& tbbNode1 = *tbbNodes.at(i.first);
             for (const auto& outputNode : i.second)
             {
-                TbbContinueNode& tbbNode2 = tbbNodes.at(outputNode);
-                make_edge(tbbNode1, tbbNode2);
+                make_edge(tbbNode1, *tbbNodes.at(outputNode));
             }
         }
     }
+}
+
+void
+TbbTaskGraphController::execute()
+{
+    // Rebuild only when the graph or its topology changed
+    if (m_flowGraph == nullptr || m_builtGraph != m_graph
+        || m_builtModifiedCount != m_graph->getModifiedCount())
+    {
+        buildFlowGraph();
+    }
+
+    if (m_flowGraph->nodes.empty())
+    {
+        return;
+    }
 
-    start.try_put(continue_msg());
-    g.wait_for_all();
+    m_flowGraph->start.try_put(continue_msg());
+    m_flowGraph->g.wait_for_all();
 }
 } // namespace imstk
\ No newline at end of file
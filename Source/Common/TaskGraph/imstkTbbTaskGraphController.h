@@ -10,14 +10,33 @@
 
 namespace imstk
 {
+struct TbbFlowGraph;
+
 ///
 /// \class TbbTaskGraphController
 ///
-/// \brief This class runs an input TaskGraph in parallel using tbb tasks
+/// \brief This class runs an input TaskGraph in parallel using tbb tasks.
+/// The tbb flow graph is built once on initialize and reused every execute,
+/// it is only rebuilt when the topology of the TaskGraph changes.
 ///
 class TbbTaskGraphController : public TaskGraphController
 {
 public:
+    TbbTaskGraphController();
+    ~TbbTaskGraphController() override;
+
     void execute() override;
+
+protected:
+    void init() override;
+
+    ///
+    /// \brief (Re)builds the tbb flow graph from the TaskGraph
+    ///
+    void buildFlowGraph();
+
+    std::unique_ptr<TbbFlowGraph> m_flowGraph;
+    std::shared_ptr<TaskGraph>    m_builtGraph = nullptr; ///< Graph the flow graph was built from
+    size_t m_builtModifiedCount = 0;
 };
 }; // namespace imstk
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 #include "imstkEventObject.h"
 
+#include <thread>
+
 using namespace imstk;
 using testing::ElementsAre;
 
@@ -30,6 +32,11 @@ public:
     {
         postEvent(imstk::Event(SignalTwo()));
     }
+
+    void postOneById()
+    {
+        postEvent(imstk::Event(SignalOneId()));
+    }
 };
 
 class MockReceiver : public imstk::EventObject
@@ -209,4 +216,63 @@ TEST(imstkEventObjectTest, ReceiverDeconstruct)
 
     // r1 should increment to 2
     EXPECT_EQ(2, r1->items.size());
+}
+
+///
+/// \brief Test events posted by interned id and by name reach the same observers
+///
+TEST(imstkEventObjectTest, PostById)
+{
+    auto m = std::make_shared<MockSender>();
+    auto r = std::make_shared<MockReceiver>();
+
+    EXPECT_EQ(MockSender::SignalOneId(), EventSignalRegistry::getId(MockSender::SignalOne()));
+    EXPECT_NE(MockSender::SignalOneId(), MockSender::SignalTwoId());
+    EXPECT_EQ(EventSignalRegistry::getName(MockSender::SignalOneId()), MockSender::SignalOne());
+
+    std::string type;
+    connect<Event>(m, MockSender::SignalOne, [&](Event* e) { type = e->getType(); });
+    queueConnect(m, MockSender::SignalOne, r, &MockReceiver::receiverOne);
+
+    m->postOneById();
+    EXPECT_EQ(type, MockSender::SignalOne());
+    m->postOne();
+    r->doAllEvents();
+    EXPECT_THAT(r->items, ElementsAre(1, 1));
+
+    disconnect(m, r, MockSender::SignalOne);
+    m->postOneById();
+    r->doAllEvents();
+    EXPECT_THAT(r->items, ElementsAre(1, 1));
+}
+
+///
+/// \brief Test events queued from many threads concurrently are all received
+///
+TEST(imstkEventObjectTest, QueuedFromManyThreads)
+{
+    auto r = std::make_shared<MockReceiver>();
+
+    const int                numThreads = 4;
+    const int                numEvents  = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; i++)
+    {
+        threads.push_back(std::thread([&]()
+            {
+                auto m = std::make_shared<MockSender>();
+                queueConnect(m, MockSender::SignalOne, r, &MockReceiver::receiverOne);
+                for (int j = 0; j < numEvents; j++)
+                {
+                    m->postOneById();
+                }
+            }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    r->doAllEvents();
+    EXPECT_EQ(r->items.size(), numThreads * numEvents);
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "imstkTaskGraph.h"
 #include "imstkTaskNode.h"
 
+#include <atomic>
+
 using namespace imstk;
 
 TEST(imstkTbbTaskGraphControllerTest, SumData)
@@ -68,4 +70,40 @@ TEST(imstkTbbTaskGraphControllerTest, SumData)
     controller.setTaskGraph(graph);
     EXPECT_EQ(controller.initialize(), true) << "TaskGraph failed to initialize";
     controller.execute();
+}
+
+TEST(imstkTbbTaskGraphControllerTest, ReuseAndTopologyChange)
+{
+    auto graph = std::make_shared<TaskGraph>();
+
+    std::atomic<int>          countA{ 0 };
+    std::atomic<int>          countB{ 0 };
+    std::shared_ptr<TaskNode> nodeA  = graph->addFunction("A", [&]() { countA++; });
+    graph->addEdge(graph->getSource(), nodeA);
+    graph->addEdge(nodeA, graph->getSink());
+
+    TbbTaskGraphController controller;
+    controller.setTaskGraph(graph);
+    EXPECT_EQ(controller.initialize(), true) << "TaskGraph failed to initialize";
+
+    // The flow graph is reused across executes
+    for (int i = 0; i < 10; i++)
+    {
+        controller.execute();
+    }
+    EXPECT_EQ(countA, 10);
+
+    // Changing the topology should cause the new node to be run
+    std::shared_ptr<TaskNode> nodeB = graph->addFunction("B", [&]() { countB++; });
+    graph->addEdge(nodeA, nodeB);
+    graph->addEdge(nodeB, graph->getSink());
+    controller.execute();
+    EXPECT_EQ(countA, 11);
+    EXPECT_EQ(countB, 1);
+
+    // Removing it should stop it from running
+    graph->removeNode(nodeB);
+    controller.execute();
+    EXPECT_EQ(countA, 12);
+    EXPECT_EQ(countB, 1);
 }
\ No newline at end of file
@@ -82,7 +82,7 @@ public:
     /// \brief emits signal to all observers, informing them on the current address
     /// in memory and size of array
     ///
-    inline void postModified() { this->postEvent(Event(AbstractDataArray::modified())); }
+    inline void postModified() { this->postEvent(Event(AbstractDataArray::modifiedId())); }
 
     ///
     /// \brief polymorphic clone() function, utilize this to get a copy of the array
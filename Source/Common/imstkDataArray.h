@@ -8,6 +8,7 @@
 
 #include "imstkAbstractDataArray.h"
 #include "imstkMath.h"
+#include "imstkLogger.h"
 #include "imstkMacros.h"
 
 namespace imstk
@@ -202,6 +203,7 @@ public:
         // Can't resize a mapped vector
         if (m_mapped)
         {
+            LOG_IF(WARNING, size != m_size) << "Can't resize a mapped DataArray, resize ignored";
             return;
         }
 
@@ -244,6 +246,7 @@ public:
         // Can't push back to a mapped vector
         if (m_mapped)
         {
+            LOG(WARNING) << "Can't push back to a mapped DataArray, value dropped";
             return;
         }
 
@@ -261,6 +264,7 @@ public:
         // Can't push back to a mapped vector
         if (m_mapped)
         {
+            LOG(WARNING) << "Can't push back to a mapped DataArray, value dropped";
             return;
         }
 
@@ -294,7 +298,11 @@ public:
     ///
     inline void reserve(const int capacity) override
     {
-        if (m_mapped) { return; }
+        if (m_mapped)
+        {
+            LOG_IF(WARNING, capacity > m_capacity) << "Can't reserve in a mapped DataArray, reserve ignored";
+            return;
+        }
         if (capacity <= m_capacity) { return; }
 
         const int currSize = m_size;
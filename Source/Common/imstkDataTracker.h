@@ -30,18 +30,22 @@ public:
     ///
     struct ePhysics
     {
-        static constexpr int SolverTime_ms  = 0;
-        static constexpr int NumConstraints = 1;
-        static constexpr int AverageC       = 2;
+        static constexpr int SolverTime_ms      = 0;
+        static constexpr int NumConstraints     = 1;
+        static constexpr int AverageC           = 2;
+        static constexpr int NumIterations      = 3;
+        static constexpr int NumJacobianUpdates = 4;
     };
     ///
     /// \brief Header names of the common data values to track
     ///
     struct Physics
     {
-        static constexpr char const* SolverTime_ms  = "SolverTime_ms";
-        static constexpr char const* NumConstraints = "NumConstraints";
-        static constexpr char const* AverageC       = "AverageC";
+        static constexpr char const* SolverTime_ms      = "SolverTime_ms";
+        static constexpr char const* NumConstraints     = "NumConstraints";
+        static constexpr char const* AverageC           = "AverageC";
+        static constexpr char const* NumIterations      = "NumIterations";
+        static constexpr char const* NumJacobianUpdates = "NumJacobianUpdates";
     };
 
     DataTracker();
@@ -0,0 +1,67 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkEventObject.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace imstk
+{
+namespace
+{
+///
+/// \brief Interned signal names, names are never removed so references
+/// returned by getName stay valid
+///
+struct SignalTable
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, int> ids;
+    std::deque<std::string> names;
+};
+
+SignalTable&
+getSignalTable()
+{
+    static SignalTable table;
+    return table;
+}
+} // namespace
+
+int
+EventSignalRegistry::getId(const std::string& signalName)
+{
+    SignalTable&                table = getSignalTable();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    auto                        i = table.ids.find(signalName);
+    if (i != table.ids.end())
+    {
+        return i->second;
+    }
+    const int id = static_cast<int>(table.names.size());
+    table.names.push_back(signalName);
+    table.ids.emplace(signalName, id);
+    return id;
+}
+
+int
+EventSignalRegistry::findId(const std::string& signalName)
+{
+    SignalTable&                table = getSignalTable();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    auto                        i = table.ids.find(signalName);
+    return (i != table.ids.end()) ? i->second : -1;
+}
+
+const std::string&
+EventSignalRegistry::getName(const int signalId)
+{
+    SignalTable&                table = getSignalTable();
+    std::lock_guard<std::mutex> guard(table.mutex);
+    return table.names[signalId];
+}
+} // namespace imstk
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "imstkMpscQueue.h"
 #include "imstkSpinLock.h"
 
 #include <algorithm>
@@ -16,12 +17,43 @@
 #include <string>
 #include <vector>
 
-#define SIGNAL(className,signalName) static std::string signalName() { return #className "::"#signalName; }
+///
+/// \brief Declares a signal. signalName() gives the name of the signal, signalNameId()
+/// gives the interned id of the name. Events constructed from the id are dispatched
+/// without building or comparing strings.
+///
+#define SIGNAL(className,signalName) static std::string signalName() { return #className "::"#signalName; } \
+    static int signalName ## Id() { static const int id = ::imstk::EventSignalRegistry::getId(#className "::"#signalName); return id; }
 
 namespace imstk
 {
 class EventObject;
 
+///
+/// \class EventSignalRegistry
+///
+/// \brief Interns signal names to small integer ids, shared by all EventObjects.
+/// Ids are dense and stable for the lifetime of the program, thread safe.
+///
+class EventSignalRegistry
+{
+public:
+    ///
+    /// \brief Returns the id of the signal name, assigning one if not yet interned
+    ///
+    static int getId(const std::string& signalName);
+
+    ///
+    /// \brief Returns the id of the signal name, -1 if it was never interned
+    ///
+    static int findId(const std::string& signalName);
+
+    ///
+    /// \brief Returns the name of an interned signal id
+    ///
+    static const std::string& getName(const int signalId);
+};
+
 ///
 /// \class Event
 ///
@@ -33,11 +65,26 @@ class Event
 {
 public:
     Event(const std::string type) : m_type(type),m_sender(nullptr) { }
+    ///
+    /// \brief Construct from an interned signal id (see SIGNAL), m_type is left
+    /// empty to avoid building the string, use getType to get the name
+    ///
+    Event(const int signalId) : m_sender(nullptr),m_signalId(signalId) { }
     virtual~Event() = default;
 
+public:
+    ///
+    /// \brief Returns the name of the signal this event was posted for
+    ///
+    const std::string& getType() const
+    {
+        return (m_type.empty() && m_signalId != -1) ? EventSignalRegistry::getName(m_signalId) : m_type;
+    }
+
 public:
     std::string  m_type;
     EventObject* m_sender;
+    int m_signalId = -1; ///< Interned signal id, -1 if constructed from a name
 };
 
 ///
@@ -107,6 +154,9 @@ public:
     // tuple<IsLambda, Receiver, Receiving Function
     using Observer = std::tuple<bool, std::weak_ptr<EventObject>, std::function<void (Event*)>>;
 
+    // Observers are copied on write so posting can iterate them while receivers connect/disconnect
+    using ObserverList = std::shared_ptr<const std::vector<Observer>>;
+
 public:
     virtual ~EventObject() = default;
 
@@ -117,73 +167,81 @@ public:
     /// Queued observers will receive the Command in their queue for later
     /// execution, reciever must implement doEvent
     ///
+    /// Events constructed from a signal id are matched to their observers by id,
+    /// direct observers are called with an event on the stack, the event is only
+    /// allocated when there are queued observers
+    ///
     template<typename T>
     void postEvent(const T& e)
     {
-        std::shared_ptr<T> ePtr = std::make_shared<T>(e);
+        // Nothing observes this object
+        if (m_signals.empty())
+        {
+            return;
+        }
+        const int signalId = (e.m_signalId != -1) ? e.m_signalId : findSignalId(e.m_type);
+        int       signalIdx = findSignal(signalId);
+        if (signalIdx == -1)
+        {
+            return;
+        }
+
+        T event = e;
         // Don't overwrite the sender if the user provided one
-        if (ePtr->m_sender == nullptr)
+        if (event.m_sender == nullptr)
         {
-            ePtr->m_sender = this;
+            event.m_sender = this;
         }
 
         // For every direct observer
         // Directly call its function
-        for (auto i = directObservers.begin(); i != directObservers.end(); i++)
+        // Hold the list, a receiver may connect/disconnect during the call
+        ObserverList observers  = m_signals[signalIdx].direct;
+        bool         hasExpired = false;
+        if (observers != nullptr)
         {
-            if (i->first == e.m_type)
+            for (const Observer& observer : *observers)
             {
-                std::vector<Observer>& observers = i->second;
-                for (std::vector<Observer>::iterator j = observers.begin(); j != observers.end();)
+                // If the receiver or receiving function is nullptr, cleanup
+                // This would occur on deconstruction of a receiver
+                if (isExpired(observer))
                 {
-                    bool                        isLambda      = std::get<0>(*j);
-                    std::function<void(Event*)> receivingFunc = std::get<2>(*j);
-
-                    // If the receiver or receiving function is nullptr, cleanup
-                    // This would occur on deconstruction of a receiver
-                    if ((!isLambda && std::get<1>(*j).expired()) || receivingFunc == nullptr)
-                    {
-                        j = i->second.erase(j);
-                    }
-                    else
-                    {
-                        // Call the receiving function
-                        receivingFunc(ePtr.get());
-                        j++;
-                    }
+                    hasExpired = true;
+                }
+                else
+                {
+                    // Call the receiving function
+                    std::get<2>(observer)(&event);
                 }
             }
         }
 
         // For every queued observer
-        for (auto i = queuedObservers.begin(); i != queuedObservers.end(); i++)
+        // Lookup again, signals may have been added by a direct observer
+        signalIdx = findSignal(signalId);
+        observers = m_signals[signalIdx].queued;
+        if (observers != nullptr && !observers->empty())
         {
-            if (i->first == e.m_type)
+            std::shared_ptr<T> ePtr = std::make_shared<T>(event);
+            for (const Observer& observer : *observers)
             {
-                std::vector<Observer>& observers = i->second;
-                for (std::vector<Observer>::iterator j = observers.begin(); j != observers.end();)
+                std::shared_ptr<EventObject> receivingObj = std::get<1>(observer).lock();
+                if (isExpired(observer) || receivingObj == nullptr)
+                {
+                    hasExpired = true;
+                }
+                else
                 {
-                    bool                        isLambda      = std::get<0>(*j);
-                    std::function<void(Event*)> receivingFunc = std::get<2>(*j);
-
-                    // If the receiver or receiving function is nullptr, cleanup
-                    // This would occur on deconstruction of a receiver
-                    if ((!isLambda && std::get<1>(*j).expired()) || receivingFunc == nullptr)
-                    {
-                        j = i->second.erase(j);
-                    }
-                    else
-                    {
-                        // Queue the command
-                        std::shared_ptr<EventObject> receivingObj = std::get<1>(*j).lock();
-                        receivingObj->eventQueueLock.lock();
-                        receivingObj->eventQueue.push_back(Command(receivingFunc, ePtr));
-                        receivingObj->eventQueueLock.unlock();
-                        j++;
-                    }
+                    // Queue the command
+                    receivingObj->eventInbox.push(Command(std::get<2>(observer), ePtr));
                 }
             }
         }
+
+        if (hasExpired)
+        {
+            removeExpiredObservers(signalId);
+        }
     }
 
     ///
@@ -199,9 +257,7 @@ public:
             ePtr->m_sender = this;
         }
 
-        eventQueueLock.lock();
-        eventQueue.push_back(Command(nullptr, ePtr));
-        eventQueueLock.unlock();
+        eventInbox.push(Command(nullptr, ePtr));
     }
 
     ///
@@ -211,13 +267,14 @@ public:
     {
         // Avoid calling the function within the lock
         eventQueueLock.lock();
+        consumeInbox();
         if (eventQueue.empty())
         {
             eventQueueLock.unlock();
             return;
         }
 
-        Command command = eventQueue.front();
+        Command command = std::move(eventQueue.front());
         eventQueue.pop_front();
 
         eventQueueLock.unlock();
@@ -232,21 +289,16 @@ public:
     void doAllEvents()
     {
         // Avoid calling the function within the lock
-        std::list<Command> cmds;
+        std::deque<Command> cmds;
         eventQueueLock.lock();
-        {
-            while (!eventQueue.empty())
-            {
-                cmds.push_back(eventQueue.front());
-                eventQueue.pop_front();
-            }
-        }
+        consumeInbox();
+        std::swap(cmds, eventQueue);
         eventQueueLock.unlock();
 
         // Do the calls
-        for (auto i : cmds)
+        for (Command& cmd : cmds)
         {
-            i.invoke();
+            cmd.invoke();
         }
     }
 
@@ -256,15 +308,12 @@ public:
     void foreachEvent(std::function<void(Command cmd)> func)
     {
         eventQueueLock.lock();
+        consumeInbox();
         for (std::deque<Command>::iterator i = eventQueue.begin(); i != eventQueue.end(); i++)
         {
             func(*i);
         }
-        while (!eventQueue.empty())
-        {
-            Command command = eventQueue.back();
-            eventQueue.pop_back();
-        }
+        eventQueue.clear();
         eventQueueLock.unlock();
     }
 
@@ -274,15 +323,12 @@ public:
     void rforeachEvent(std::function<void(Command cmd)> func)
     {
         eventQueueLock.lock();
+        consumeInbox();
         for (std::deque<Command>::reverse_iterator i = eventQueue.rbegin(); i != eventQueue.rend(); i++)
         {
             func(*i);
         }
-        while (!eventQueue.empty())
-        {
-            Command command = eventQueue.back();
-            eventQueue.pop_back();
-        }
+        eventQueue.clear();
         eventQueueLock.unlock();
     }
 
@@ -293,13 +339,8 @@ public:
     void clearEvents()
     {
         eventQueueLock.lock();
-        {
-            while (!eventQueue.empty())
-            {
-                Command command = eventQueue.back();
-                eventQueue.pop_back();
-            }
-        }
+        consumeInbox();
+        eventQueue.clear();
         eventQueueLock.unlock();
     }
 
@@ -323,49 +364,144 @@ public:
 
 // Use the connect functions
 private:
-    void addDirectObserver(std::string eventType, Observer observer)
+    ///
+    /// \brief Observers of a single signal
+    ///
+    struct SignalObservers
+    {
+        int signalId;
+        std::string name;
+        ObserverList direct;
+        ObserverList queued;
+    };
+
+    static bool isExpired(const Observer& observer)
     {
-        std::vector<std::pair<std::string, std::vector<Observer>>>::iterator i =
-            std::find_if(directObservers.begin(), directObservers.end(),
-                [eventType](const std::pair<std::string, std::vector<Observer>>& j)
-                { return j.first == eventType; });
-        if (i == directObservers.end())
+        return (!std::get<0>(observer) && std::get<1>(observer).expired()) || std::get<2>(observer) == nullptr;
+    }
+
+    ///
+    /// \brief Returns the index of the signal in m_signals, -1 if not observed
+    ///
+    int findSignal(const int signalId) const
+    {
+        for (int i = 0; i < static_cast<int>(m_signals.size()); i++)
         {
-            std::pair<std::string, std::vector<Observer>> test = std::pair<std::string, std::vector<Observer>>(eventType, std::vector<Observer>());
-            test.second.push_back(observer);
-            directObservers.push_back(test);
+            if (m_signals[i].signalId == signalId)
+            {
+                return i;
+            }
         }
-        else
+        return -1;
+    }
+
+    ///
+    /// \brief Returns the id of an observed signal by name, -1 if not observed
+    ///
+    int findSignalId(const std::string& eventType) const
+    {
+        for (const SignalObservers& signal : m_signals)
+        {
+            if (signal.name == eventType)
+            {
+                return signal.signalId;
+            }
+        }
+        return -1;
+    }
+
+    SignalObservers& getOrAddSignal(const std::string& eventType)
+    {
+        const int signalId = EventSignalRegistry::getId(eventType);
+        const int i = findSignal(signalId);
+        if (i != -1)
         {
-            i->second.push_back(observer);
+            return m_signals[i];
         }
+        m_signals.push_back(SignalObservers{ signalId, eventType, nullptr, nullptr });
+        return m_signals.back();
+    }
+
+    static ObserverList addObserver(const ObserverList& observers, Observer observer)
+    {
+        auto newObservers = (observers == nullptr) ?
+                            std::make_shared<std::vector<Observer>>() : std::make_shared<std::vector<Observer>>(*observers);
+        newObservers->push_back(std::move(observer));
+        return newObservers;
+    }
+
+    void addDirectObserver(std::string eventType, Observer observer)
+    {
+        SignalObservers& signal = getOrAddSignal(eventType);
+        signal.direct = addObserver(signal.direct, std::move(observer));
     }
 
     void addQueuedObserver(std::string eventType, Observer observer)
     {
-        std::vector<std::pair<std::string, std::vector<Observer>>>::iterator i =
-            std::find_if(queuedObservers.begin(), queuedObservers.end(),
-                [eventType](const std::pair<std::string, std::vector<Observer>>& j)
-                { return j.first == eventType; });
-        if (i == queuedObservers.end())
+        SignalObservers& signal = getOrAddSignal(eventType);
+        signal.queued = addObserver(signal.queued, std::move(observer));
+    }
+
+    ///
+    /// \brief Removes the first observer of the list for which the predicate returns true
+    ///
+    template<typename Pred>
+    static void removeObserverIf(ObserverList& observers, Pred pred)
+    {
+        if (observers == nullptr)
         {
-            std::pair<std::string, std::vector<Observer>> test = std::pair<std::string, std::vector<Observer>>(eventType, std::vector<Observer>());
-            test.second.push_back(observer);
-            queuedObservers.push_back(test);
+            return;
         }
-        else
+        auto i = std::find_if(observers->begin(), observers->end(), pred);
+        if (i != observers->end())
         {
-            i->second.push_back(observer);
+            auto newObservers = std::make_shared<std::vector<Observer>>(*observers);
+            newObservers->erase(newObservers->begin() + (i - observers->begin()));
+            observers = newObservers;
         }
     }
 
+    ///
+    /// \brief Removes all observers of the list for which the predicate returns true
+    ///
+    template<typename Pred>
+    static void removeObserversIf(ObserverList& observers, Pred pred)
+    {
+        if (observers == nullptr)
+        {
+            return;
+        }
+        auto newObservers = std::make_shared<std::vector<Observer>>(*observers);
+        newObservers->erase(std::remove_if(newObservers->begin(), newObservers->end(), pred), newObservers->end());
+        observers = newObservers;
+    }
+
+    void removeExpiredObservers(const int signalId)
+    {
+        SignalObservers& signal = m_signals[findSignal(signalId)];
+        removeObserversIf(signal.direct, [](const Observer& observer) { return isExpired(observer); });
+        // Queued observers also expire when their receiver is gone
+        removeObserversIf(signal.queued, [](const Observer& observer)
+            {
+                return isExpired(observer) || std::get<1>(observer).expired();
+            });
+    }
+
+    ///
+    /// \brief Moves the commands pushed by senders into the event queue, eventQueueLock must be held
+    ///
+    void consumeInbox()
+    {
+        eventInbox.consumeAll([this](Command& cmd) { eventQueue.push_back(std::move(cmd)); });
+    }
+
 protected:
-    ParallelUtils::SpinLock eventQueueLock; // Data lock for the event queue
+    ParallelUtils::MpscQueue<Command> eventInbox;     // Commands pushed by senders, lock-free
+    ParallelUtils::SpinLock eventQueueLock;           // Data lock for the event queue
     std::deque<Command>     eventQueue;
 
-    // Vectors used as size is generally small
-    std::vector<std::pair<std::string, std::vector<Observer>>> queuedObservers;
-    std::vector<std::pair<std::string, std::vector<Observer>>> directObservers;
+    // Vector used as the number of signals observed is generally small
+    std::vector<SignalObservers> m_signals;
 };
 
 #ifdef WIN32
@@ -469,22 +605,12 @@ static void
 disconnect(std::shared_ptr<EventObject> sender,
            std::shared_ptr<EventObject> reciever, std::string (* senderFunc)())
 {
-    const std::string eventType = senderFunc();
-
-    auto i1 = std::find_if(sender->directObservers.begin(), sender->directObservers.end(),
-        [eventType](const std::pair<std::string, std::vector<EventObject::Observer>>& j) { return j.first == eventType; });
-    if (i1 != sender->directObservers.end())
-    {
-        auto j = std::find_if(i1->second.begin(), i1->second.end(), [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; });
-        i1->second.erase(j);
-    }
-
-    auto i2 = std::find_if(sender->queuedObservers.begin(), sender->queuedObservers.end(),
-        [eventType](const std::pair<std::string, std::vector<EventObject::Observer>>& j) { return j.first == eventType; });
-    if (i2 != sender->queuedObservers.end())
+    const int i = sender->findSignal(EventSignalRegistry::findId(senderFunc()));
+    if (i != -1)
     {
-        auto j = std::find_if(i2->second.begin(), i2->second.end(), [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; });
-        i2->second.erase(j);
+        auto isReceiver = [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; };
+        EventObject::removeObserverIf(sender->m_signals[i].direct, isReceiver);
+        EventObject::removeObserverIf(sender->m_signals[i].queued, isReceiver);
     }
 }
 
@@ -34,9 +34,9 @@ Module::update()
         }
         else
         {
-            this->postEvent(Event(Module::preUpdate()));
+            this->postEvent(Event(Module::preUpdateId()));
             this->updateModule();
-            this->postEvent(Event(Module::postUpdate()));
+            this->postEvent(Event(Module::postUpdateId()));
         }
     }
 }
@@ -215,6 +215,7 @@ public:
         // Can't resize a mapped vector
         if (DataArray<T>::m_mapped)
         {
+            LOG_IF(WARNING, size != m_vecSize) << "Can't resize a mapped VecDataArray, resize ignored";
             return;
         }
 
@@ -259,6 +260,7 @@ public:
         // Can't push back to a mapped vector
         if (DataArray<T>::m_mapped)
         {
+            LOG(WARNING) << "Can't push back to a mapped VecDataArray, value dropped";
             return;
         }
 
@@ -277,6 +279,7 @@ public:
         // Can't push back to a mapped vector
         if (DataArray<T>::m_mapped)
         {
+            LOG(WARNING) << "Can't push back to a mapped VecDataArray, value dropped";
             return;
         }
 
@@ -313,6 +316,7 @@ public:
     {
         if (DataArray<T>::m_mapped)
         {
+            LOG_IF(WARNING, size > m_vecCapacity) << "Can't reserve in a mapped VecDataArray, reserve ignored";
             return;
         }
 
@@ -9,12 +9,15 @@
 #include "imstkMath.h"
 #include "imstkVecDataArray.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace
 {
 ///
-/// \brief Copies src to dest, allocates dest if it does not exist
+/// \brief Copies src to dest by value, allocates dest if it does not exist.
+/// Arrays mapped onto other memory (see PbdParticleStorage) are copied into
+/// when the size matches, otherwise they are unmapped
 ///
 template<typename T>
 void
@@ -26,7 +29,12 @@ copyAndAllocate(const std::shared_ptr<T>& src, std::shared_ptr<T>& dest)
         {
             dest = std::make_shared<T>();
         }
-        *dest = *src;
+        if (dest->size() != src->size())
+        {
+            // Mapped arrays can't be resized, assigning an unmapped one unmaps it
+            *dest = T(src->size());
+        }
+        std::copy(src->begin(), src->end(), dest->begin());
     }
 }
 } // namespace
@@ -221,6 +229,59 @@ struct PbdBody
         std::unordered_map<int, std::vector<std::shared_ptr<PbdConstraint>>> cellConstraintMap;
 };
 
+///
+/// \struct PbdParticleStorage
+///
+/// \brief Contiguous storage of the particles of many deformable bodies. The arrays
+/// of every stored body are mapped onto a range of the global arrays (see
+/// VecDataArray::setData) such that the body, its geometry and the global arrays
+/// all share memory. Particle i of body b is global particle bodyOffsets[b] + i.
+/// Mapped arrays cannot be resized, a body changing its particle count or arrays
+/// must be restored by its PbdModel (see PbdModel::updateParticleStorage).
+///
+struct PbdParticleStorage
+{
+    public:
+        VecDataArray<double, 3> prevVertices;
+        VecDataArray<double, 3> vertices;
+        VecDataArray<double, 3> velocities;
+        DataArray<double> masses;
+        DataArray<double> invMasses;
+
+        std::vector<int> bodyIds;     ///< Per global particle, index of its body
+        std::vector<int> bodyOffsets; ///< Per body, offset of its first particle, -1 if not stored
+        std::vector<int> bodySizes;   ///< Per body, number of particles stored
+
+        int getNumParticles() const { return static_cast<int>(bodyIds.size()); }
+};
+
+///
+/// \struct PbdStateSnapshot
+///
+/// \brief Flat copy of the dynamic state of the bodies of a PbdState, see
+/// PbdModel::takeSnapshot. Particle i of body b is at bodyOffsets[b] + i, its
+/// orientation at orientedOffsets[b] + i if the body is oriented.
+///
+struct PbdStateSnapshot
+{
+    public:
+        int id = -1; ///< Id of the snapshot, -1 if never taken
+
+        std::vector<int> bodySizes;       ///< Per body, number of particles captured
+        std::vector<int> bodyOffsets;     ///< Per body, offset of its first particle
+        std::vector<int> orientedOffsets; ///< Per body, offset of its first orientation, -1 if not oriented
+
+        StdVectorOfVec3d    prevVertices;
+        StdVectorOfVec3d    vertices;
+        StdVectorOfVec3d    velocities;
+        std::vector<double> masses;
+        std::vector<double> invMasses;
+
+        StdVectorOfQuatd prevOrientations;
+        StdVectorOfQuatd orientations;
+        StdVectorOfVec3d angularVelocities;
+};
+
 ///
 /// \struct PbdState
 ///
@@ -255,6 +316,24 @@ struct PbdState
 
         inline PbdBody::Type getBodyType(const std::pair<int, int>& bodyParticleId) const { return m_bodies[bodyParticleId.first]->bodyType; }
 
+        ///
+        /// \brief Returns the index of the particle in the contiguous storage,
+        /// -1 if there is none or the body is not stored in it
+        ///
+        inline int getGlobalParticleId(const std::pair<int, int>& bodyParticleId) const
+        {
+            if (m_particleStorage == nullptr
+                || static_cast<size_t>(bodyParticleId.first) >= m_particleStorage->bodyOffsets.size())
+            {
+                return -1;
+            }
+            const int offset = m_particleStorage->bodyOffsets[bodyParticleId.first];
+            return (offset == -1) ? -1 : offset + bodyParticleId.second;
+        }
+
         std::vector<std::shared_ptr<PbdBody>> m_bodies;
+
+        /// Contiguous storage of the deformable particles, null when not used. Not deep copied
+        std::shared_ptr<PbdParticleStorage> m_particleStorage;
 };
 } // namespace imstk
\ No newline at end of file
@@ -51,6 +51,7 @@ public:
     /// \brief Get the vertex indices of the constraint
     ///
     std::vector<PbdParticleId>& getParticles() { return m_particles; }
+    const std::vector<PbdParticleId>& getParticles() const { return m_particles; }
 
     ///
     /// \brief Get/Set restitution
@@ -135,6 +136,16 @@ public:
     ///
     void zeroOutLambda() { m_lambda = 0.0; }
 
+    ///
+    /// \brief Set the lagrange multiplier and constraint value as computed
+    /// outside of projectConstraint, ie: by a PbdConstraintBatch
+    ///
+    void setSolvedState(const double lambda, const double c)
+    {
+        m_lambda = lambda;
+        m_C      = c;
+    }
+
     ///
     /// \brief Update positions by projecting constraints.
     ///
@@ -0,0 +1,431 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintBatch.h"
+#include "imstkParallelUtils.h"
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDihedralConstraint.h"
+#include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdVolumeConstraint.h"
+
+namespace
+{
+using namespace imstk;
+
+///
+/// \brief Non-virtual value & gradient of PbdDistanceConstraint
+///
+struct DistanceKernel
+{
+    static inline bool computeValueAndGradient(const Vec3d* const* x, const double restLength,
+                                               double& c, Vec3d* dcdx)
+    {
+        dcdx[0] = *x[0] - *x[1];
+        const double len = dcdx[0].norm();
+        if (len < 1.0e-16)
+        {
+            return false;
+        }
+        dcdx[0] /= len;
+        dcdx[1]  = -dcdx[0];
+        c        = len - restLength;
+        return true;
+    }
+};
+
+///
+/// \brief Non-virtual value & gradient of PbdVolumeConstraint
+///
+struct VolumeKernel
+{
+    static inline bool computeValueAndGradient(const Vec3d* const* x, const double restVolume,
+                                               double& c, Vec3d* dcdx)
+    {
+        const Vec3d& x0 = *x[0];
+        const Vec3d& x1 = *x[1];
+        const Vec3d& x2 = *x[2];
+        const Vec3d& x3 = *x[3];
+
+        const double onesixth = 1.0 / 6.0;
+
+        dcdx[0] = onesixth * (x1 - x2).cross(x3 - x1);
+        dcdx[1] = onesixth * (x2 - x0).cross(x3 - x0);
+        dcdx[2] = onesixth * (x3 - x0).cross(x1 - x0);
+        dcdx[3] = onesixth * (x1 - x0).cross(x2 - x0);
+
+        c = dcdx[3].dot(x3 - x0) - restVolume;
+        return true;
+    }
+};
+
+///
+/// \brief Non-virtual value & gradient of PbdDihedralConstraint
+///
+struct DihedralKernel
+{
+    static inline bool computeValueAndGradient(const Vec3d* const* x, const double restAngle,
+                                               double& c, Vec3d* dcdx)
+    {
+        const Vec3d& p0 = *x[0];
+        const Vec3d& p1 = *x[1];
+        const Vec3d& p2 = *x[2];
+        const Vec3d& p3 = *x[3];
+
+        const Vec3d e  = p3 - p2;
+        const Vec3d e1 = p3 - p0;
+        const Vec3d e2 = p0 - p2;
+        const Vec3d e3 = p3 - p1;
+        const Vec3d e4 = p1 - p2;
+        Vec3d       n1 = e1.cross(e);
+        Vec3d       n2 = e.cross(e3);
+        const double A1 = n1.norm();
+        const double A2 = n2.norm();
+        n1 /= A1;
+        n2 /= A2;
+
+        const double l = e.norm();
+        if (l < 1.0e-16)
+        {
+            return false;
+        }
+
+        dcdx[0] = -(l / A1) * n1;
+        dcdx[1] = -(l / A2) * n2;
+        dcdx[2] = (e.dot(e1) / (A1 * l)) * n1 + (e.dot(e3) / (A2 * l)) * n2;
+        dcdx[3] = (e.dot(e2) / (A1 * l)) * n1 + (e.dot(e4) / (A2 * l)) * n2;
+
+        c = atan2(n1.cross(n2).dot(e), l * n1.dot(n2)) - restAngle;
+        return true;
+    }
+};
+
+///
+/// \brief Projects the i'th constraint of the batch, mirrors PbdConstraint::projectConstraint
+///
+template<class Kernel, int N>
+inline void
+projectBatchConstraint(PbdConstraintBatch<N>& batch, const size_t i,
+                       const PbdStateView& view, const double dt,
+                       const PbdConstraint::SolverType solverType)
+{
+    Vec3d* x[N];
+    double invMasses[N];
+    for (int k = 0; k < N; k++)
+    {
+        const int bodyId     = batch.m_bodyIds[k][i];
+        const int particleId = batch.m_particleIds[k][i];
+        x[k]         = &view.getPosition(bodyId, particleId);
+        invMasses[k] = view.getInvMass(bodyId, particleId);
+    }
+
+    double c = 0.0;
+    Vec3d  dcdx[N];
+    if (!Kernel::computeValueAndGradient(x, batch.m_restValues[i], c, dcdx))
+    {
+        return;
+    }
+    batch.m_C[i] = c;
+
+    double w = 0.0;
+    for (int k = 0; k < N; k++)
+    {
+        w += invMasses[k] * dcdx[k].squaredNorm();
+    }
+    if (w == 0.0)
+    {
+        return;
+    }
+
+    double dlambda = 0.0;
+    if (solverType == PbdConstraint::SolverType::PBD)
+    {
+        dlambda = -c * batch.m_stiffnesses[i] / w;
+    }
+    else
+    {
+        const double alpha = batch.m_compliances[i] / (dt * dt);
+        dlambda = -(c + alpha * batch.m_lambdas[i]) / (w + alpha);
+    }
+    batch.m_lambdas[i] += dlambda;
+
+    for (int k = 0; k < N; k++)
+    {
+        if (invMasses[k] > 0.0)
+        {
+            *x[k] += invMasses[k] * dlambda * dcdx[k];
+        }
+    }
+}
+
+template<class Kernel, int N>
+void
+projectBatch(PbdConstraintBatch<N>& batch, const PbdStateView& view,
+             const double dt, const PbdConstraint::SolverType solverType, const bool doParallel)
+{
+    ParallelUtils::parallelFor(batch.size(),
+        [&](const size_t i)
+        {
+            projectBatchConstraint<Kernel, N>(batch, i, view, dt, solverType);
+        }, doParallel);
+}
+
+void
+projectGroup(PbdConstraintBatchGroup& group, PbdState& state, const PbdStateView& view,
+             const double dt, const PbdConstraint::SolverType& solverType, const bool doParallel)
+{
+    projectBatch<DistanceKernel>(group.m_distance, view, dt, solverType, doParallel);
+    projectBatch<VolumeKernel>(group.m_volume, view, dt, solverType, doParallel);
+    projectBatch<DihedralKernel>(group.m_dihedral, view, dt, solverType, doParallel);
+
+    ParallelUtils::parallelFor(group.m_others.size(),
+        [&](const size_t i)
+        {
+            group.m_others[i]->projectConstraint(state, dt, solverType);
+        }, doParallel);
+}
+
+void
+addToGroup(PbdConstraintBatchGroup& group, PbdConstraint* constraint)
+{
+    // Exact type match, subclasses may override projection
+    const std::string typeName = constraint->getTypeName();
+    if (typeName == PbdDistanceConstraint::getStaticTypeName())
+    {
+        group.m_distance.addConstraint(constraint);
+    }
+    else if (typeName == PbdVolumeConstraint::getStaticTypeName())
+    {
+        group.m_volume.addConstraint(constraint);
+    }
+    else if (typeName == PbdDihedralConstraint::getStaticTypeName())
+    {
+        group.m_dihedral.addConstraint(constraint);
+    }
+    else
+    {
+        group.m_others.push_back(constraint);
+    }
+}
+
+void
+beginGroup(PbdConstraintBatchGroup& group)
+{
+    group.m_distance.beginSolve();
+    group.m_volume.beginSolve();
+    group.m_dihedral.beginSolve();
+    for (PbdConstraint* constraint : group.m_others)
+    {
+        constraint->zeroOutLambda();
+    }
+}
+
+void
+endGroup(PbdConstraintBatchGroup& group)
+{
+    group.m_distance.endSolve();
+    group.m_volume.endSolve();
+    group.m_dihedral.endSolve();
+}
+} // namespace
+
+namespace imstk
+{
+void
+PbdStateView::update(const PbdState& state)
+{
+    const size_t numBodies = state.m_bodies.size();
+    m_positions.resize(numBodies);
+    m_invMasses.resize(numBodies);
+    for (size_t i = 0; i < numBodies; i++)
+    {
+        const PbdBody& body = *state.m_bodies[i];
+        m_positions[i] = (body.vertices == nullptr) ? nullptr : body.vertices->getPointer();
+        m_invMasses[i] = (body.invMasses == nullptr) ? nullptr : body.invMasses->getPointer();
+    }
+}
+
+template<int N>
+void
+PbdConstraintBatch<N>::clear()
+{
+    for (int k = 0; k < N; k++)
+    {
+        m_bodyIds[k].clear();
+        m_particleIds[k].clear();
+    }
+    m_restValues.clear();
+    m_stiffnesses.clear();
+    m_compliances.clear();
+    m_lambdas.clear();
+    m_C.clear();
+    m_sources.clear();
+}
+
+template<int N>
+void
+PbdConstraintBatch<N>::reserve(const size_t n)
+{
+    for (int k = 0; k < N; k++)
+    {
+        m_bodyIds[k].reserve(n);
+        m_particleIds[k].reserve(n);
+    }
+    m_restValues.reserve(n);
+    m_stiffnesses.reserve(n);
+    m_compliances.reserve(n);
+    m_lambdas.reserve(n);
+    m_C.reserve(n);
+    m_sources.reserve(n);
+}
+
+template<int N>
+void
+PbdConstraintBatch<N>::addConstraint(PbdConstraint* constraint)
+{
+    const std::vector<PbdParticleId>& particles = constraint->getParticles();
+    CHECK(particles.size() == N) << "Constraint " << constraint->getTypeName() <<
+        " has " << particles.size() << " particles, batch expects " << N;
+    for (int k = 0; k < N; k++)
+    {
+        m_bodyIds[k].push_back(particles[k].first);
+        m_particleIds[k].push_back(particles[k].second);
+    }
+    m_restValues.push_back(constraint->getRestValue());
+    m_stiffnesses.push_back(constraint->getStiffness());
+    m_compliances.push_back(constraint->getCompliance());
+    m_lambdas.push_back(constraint->getLambda());
+    m_C.push_back(constraint->getConstraintC());
+    m_sources.push_back(constraint);
+}
+
+template<int N>
+void
+PbdConstraintBatch<N>::beginSolve()
+{
+    for (size_t i = 0; i < m_sources.size(); i++)
+    {
+        m_stiffnesses[i] = m_sources[i]->getStiffness();
+        m_compliances[i] = m_sources[i]->getCompliance();
+    }
+    std::fill(m_lambdas.begin(), m_lambdas.end(), 0.0);
+}
+
+template<int N>
+void
+PbdConstraintBatch<N>::endSolve()
+{
+    for (size_t i = 0; i < m_sources.size(); i++)
+    {
+        m_sources[i]->setSolvedState(m_lambdas[i], m_C[i]);
+    }
+}
+
+template class PbdConstraintBatch<2>;
+template class PbdConstraintBatch<4>;
+
+void
+PbdConstraintBatchGroup::clear()
+{
+    m_distance.clear();
+    m_volume.clear();
+    m_dihedral.clear();
+    m_others.clear();
+}
+
+size_t
+PbdConstraintBatchGroup::size() const
+{
+    return m_distance.size() + m_volume.size() + m_dihedral.size() + m_others.size();
+}
+
+void
+PbdConstraintBatches::build(const PbdConstraintContainer& container)
+{
+    const std::vector<std::shared_ptr<PbdConstraint>>&              constraints = container.getConstraints();
+    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitions  = container.getPartitionedConstraints();
+
+    m_sequential.clear();
+    for (const auto& constraint : constraints)
+    {
+        addToGroup(m_sequential, constraint.get());
+    }
+
+    m_partitions.resize(partitions.size());
+    for (size_t i = 0; i < partitions.size(); i++)
+    {
+        m_partitions[i].clear();
+        for (const auto& constraint : partitions[i])
+        {
+            addToGroup(m_partitions[i], constraint.get());
+        }
+    }
+
+    m_builtFrom = &container;
+    m_builtModifiedCount  = container.getModifiedCount();
+    m_builtNumConstraints = container.getNumConstraints();
+}
+
+bool
+PbdConstraintBatches::isBuiltFrom(const PbdConstraintContainer& container) const
+{
+    // The constraint vector may be modified directly through getConstraints, also
+    // compare the count
+    return m_builtFrom == &container
+           && m_builtModifiedCount == container.getModifiedCount()
+           && m_builtNumConstraints == container.getNumConstraints();
+}
+
+void
+PbdConstraintBatches::beginSolve()
+{
+    beginGroup(m_sequential);
+    ParallelUtils::parallelFor(m_partitions.size(),
+        [&](const size_t i)
+        {
+            beginGroup(m_partitions[i]);
+        });
+}
+
+void
+PbdConstraintBatches::projectConstraints(PbdState& state, const double dt,
+                                         const PbdConstraint::SolverType& type)
+{
+    if (dt == 0.0)
+    {
+        return;
+    }
+
+    m_view.update(state);
+
+    projectGroup(m_sequential, state, m_view, dt, type, false);
+    for (PbdConstraintBatchGroup& group : m_partitions)
+    {
+        projectGroup(group, state, m_view, dt, type, true);
+    }
+}
+
+void
+PbdConstraintBatches::endSolve()
+{
+    endGroup(m_sequential);
+    ParallelUtils::parallelFor(m_partitions.size(),
+        [&](const size_t i)
+        {
+            endGroup(m_partitions[i]);
+        });
+}
+
+size_t
+PbdConstraintBatches::getNumBatchedConstraints() const
+{
+    size_t count = m_sequential.size() - m_sequential.m_others.size();
+    for (const PbdConstraintBatchGroup& group : m_partitions)
+    {
+        count += group.size() - group.m_others.size();
+    }
+    return count;
+}
+} // namespace imstk
\ No newline at end of file
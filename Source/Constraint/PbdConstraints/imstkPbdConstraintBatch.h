@@ -0,0 +1,161 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdConstraint.h"
+
+#include <array>
+
+namespace imstk
+{
+class PbdConstraintContainer;
+
+///
+/// \struct PbdStateView
+///
+/// \brief Flat view of the positions and inverse masses of a PbdState. Resolves
+/// every body's arrays to raw pointers once so kernels index particles with
+/// a single indirection. Must be updated whenever the body arrays may have been
+/// reallocated (ie: once per solve).
+///
+struct PbdStateView
+{
+    public:
+        void update(const PbdState& state);
+
+        inline Vec3d& getPosition(const int bodyId, const int particleId) const { return m_positions[bodyId][particleId]; }
+        inline double getInvMass(const int bodyId, const int particleId) const { return m_invMasses[bodyId][particleId]; }
+
+        std::vector<Vec3d*> m_positions;
+        std::vector<const double*> m_invMasses;
+};
+
+///
+/// \class PbdConstraintBatch
+///
+/// \brief Structure-of-arrays storage for constraints of a single type involving
+/// N particles. Particle ids, rest values, stiffness, compliance, lambda and C
+/// live in flat arrays so a type specialized kernel can stream through them
+/// without virtual calls. The PbdConstraint each entry was created from is
+/// kept as the authoring API, parameters are pulled from it at the start of a
+/// solve and lambda/C are written back at the end.
+///
+template<int N>
+class PbdConstraintBatch
+{
+public:
+    static constexpr int NumParticles = N;
+
+    void clear();
+    void reserve(const size_t n);
+
+    ///
+    /// \brief Append a constraint, it must have exactly N particles
+    ///
+    void addConstraint(PbdConstraint* constraint);
+
+    size_t size() const { return m_sources.size(); }
+    bool empty() const { return m_sources.empty(); }
+
+    ///
+    /// \brief Pull stiffness & compliance from the source constraints and zero
+    /// the lagrange multipliers. Done once per solve, not per iteration.
+    ///
+    void beginSolve();
+
+    ///
+    /// \brief Write lambda and C back to the source constraints
+    ///
+    void endSolve();
+
+public:
+    std::array<std::vector<int>, N> m_bodyIds;     ///< Per particle slot, body index of every constraint
+    std::array<std::vector<int>, N> m_particleIds; ///< Per particle slot, particle index of every constraint
+    std::vector<double> m_restValues;
+    std::vector<double> m_stiffnesses;
+    std::vector<double> m_compliances;
+    std::vector<double> m_lambdas;
+    std::vector<double> m_C;
+    std::vector<PbdConstraint*> m_sources;         ///< Constraint each entry was created from
+};
+
+///
+/// \struct PbdConstraintBatchGroup
+///
+/// \brief A set of batches that are solved together. Constraint types without a
+/// batched kernel fall back to virtual projection through m_others.
+///
+struct PbdConstraintBatchGroup
+{
+    public:
+        void clear();
+        size_t size() const;
+
+        PbdConstraintBatch<2> m_distance;
+        PbdConstraintBatch<4> m_volume;
+        PbdConstraintBatch<4> m_dihedral;
+        std::vector<PbdConstraint*> m_others;
+};
+
+///
+/// \class PbdConstraintBatches
+///
+/// \brief Batched mirror of a PbdConstraintContainer. Distance, volume and dihedral
+/// constraints are gathered into per type SoA batches and projected with non-virtual
+/// kernels, partitions of the container become groups that are solved in parallel.
+/// The batches must be rebuilt when the container is modified, see isBuiltFrom.
+///
+class PbdConstraintBatches
+{
+public:
+    PbdConstraintBatches() = default;
+    virtual ~PbdConstraintBatches() = default;
+
+    ///
+    /// \brief Gather the constraints of the container into batches
+    ///
+    void build(const PbdConstraintContainer& container);
+
+    ///
+    /// \brief Returns true if these batches reflect the current state of the container
+    ///
+    bool isBuiltFrom(const PbdConstraintContainer& container) const;
+
+    ///
+    /// \brief Pull parameters from the source constraints & zero out lambdas
+    ///
+    void beginSolve();
+
+    ///
+    /// \brief Project all constraints once (a single solver iteration)
+    ///
+    void projectConstraints(PbdState& state, const double dt,
+                            const PbdConstraint::SolverType& type);
+
+    ///
+    /// \brief Write lambda and C back to the source constraints
+    ///
+    void endSolve();
+
+    ///
+    /// \brief Returns the number of constraints solved through non-virtual kernels
+    ///
+    size_t getNumBatchedConstraints() const;
+
+    const PbdConstraintBatchGroup& getSequentialGroup() const { return m_sequential; }
+    const std::vector<PbdConstraintBatchGroup>& getPartitionedGroups() const { return m_partitions; }
+
+protected:
+    PbdConstraintBatchGroup m_sequential;               ///< Solved serially
+    std::vector<PbdConstraintBatchGroup> m_partitions;  ///< Each group is solved in parallel
+    PbdStateView m_view;
+
+    const PbdConstraintContainer* m_builtFrom = nullptr;
+    size_t m_builtModifiedCount  = 0;
+    size_t m_builtNumConstraints = 0;
+};
+} // namespace imstk
\ No newline at end of file
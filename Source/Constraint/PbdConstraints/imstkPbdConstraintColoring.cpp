@@ -0,0 +1,125 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintColoring.h"
+
+#include <array>
+
+namespace imstk
+{
+std::uint64_t&
+PbdConstraintColoring::getParticleMask(const PbdParticleId& pid)
+{
+    if (static_cast<size_t>(pid.first) >= m_particleMasks.size())
+    {
+        m_particleMasks.resize(pid.first + 1);
+    }
+    std::vector<std::uint64_t>& bodyMasks = m_particleMasks[pid.first];
+    if (static_cast<size_t>(pid.second) >= bodyMasks.size())
+    {
+        bodyMasks.resize(pid.second + 1, 0);
+    }
+    return bodyMasks[pid.second];
+}
+
+void
+PbdConstraintColoring::partition(std::vector<PbdConstraint*>& constraints, const PbdState& state)
+{
+    m_partitionOffsets.clear();
+    m_partitionOffsets.push_back(0);
+    if (constraints.empty())
+    {
+        return;
+    }
+
+    // First fit coloring, each constraint takes the lowest color none of its
+    // movable particles are used in
+    m_colors.resize(constraints.size());
+    std::array<size_t, MaxNumColors + 1> colorSizes;
+    colorSizes.fill(0);
+    for (size_t i = 0; i < constraints.size(); i++)
+    {
+        const std::vector<PbdParticleId>& particles = constraints[i]->getParticles();
+        std::uint64_t usedColors = 0;
+        for (const PbdParticleId& pid : particles)
+        {
+            if (state.getInvMass(pid) != 0.0)
+            {
+                usedColors |= getParticleMask(pid);
+            }
+        }
+
+        int color = MaxNumColors;
+        if (usedColors != ~std::uint64_t(0))
+        {
+            color = 0;
+            while ((usedColors >> color) & 1)
+            {
+                color++;
+            }
+            const std::uint64_t colorBit = std::uint64_t(1) << color;
+            for (const PbdParticleId& pid : particles)
+            {
+                if (state.getInvMass(pid) != 0.0)
+                {
+                    getParticleMask(pid) |= colorBit;
+                }
+            }
+        }
+        m_colors[i] = color;
+        colorSizes[color]++;
+    }
+
+    // Reset the masks of the used particles for the next call
+    for (PbdConstraint* constraint : constraints)
+    {
+        for (const PbdParticleId& pid : constraint->getParticles())
+        {
+            if (static_cast<size_t>(pid.first) < m_particleMasks.size()
+                && static_cast<size_t>(pid.second) < m_particleMasks[pid.first].size())
+            {
+                m_particleMasks[pid.first][pid.second] = 0;
+            }
+        }
+    }
+
+    // Colors too small to be worth it are solved sequentially
+    for (int color = 0; color < MaxNumColors; color++)
+    {
+        if (colorSizes[color] > 0 && colorSizes[color] < m_minPartitionSize)
+        {
+            colorSizes[MaxNumColors] += colorSizes[color];
+            colorSizes[color]         = 0;
+        }
+    }
+    for (size_t i = 0; i < constraints.size(); i++)
+    {
+        if (colorSizes[m_colors[i]] == 0)
+        {
+            m_colors[i] = MaxNumColors;
+        }
+    }
+
+    // Counting sort by color, keeping the order within a color
+    std::array<size_t, MaxNumColors + 1> colorStarts;
+    size_t                               start = 0;
+    for (int color = 0; color <= MaxNumColors; color++)
+    {
+        colorStarts[color] = start;
+        start += colorSizes[color];
+        if (color < MaxNumColors && colorSizes[color] > 0)
+        {
+            m_partitionOffsets.push_back(start);
+        }
+    }
+    m_reordered.resize(constraints.size());
+    for (size_t i = 0; i < constraints.size(); i++)
+    {
+        m_reordered[colorStarts[m_colors[i]]++] = constraints[i];
+    }
+    std::swap(constraints, m_reordered);
+}
+} // namespace imstk
@@ -0,0 +1,72 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdConstraint.h"
+
+#include <cstdint>
+
+namespace imstk
+{
+///
+/// \class PbdConstraintColoring
+///
+/// \brief Fast greedy coloring of short lived constraints (ie: collision constraints)
+/// meant to be redone every frame. Constraints are reordered in place such that
+/// each color is contiguous, constraints within a color share no movable particle
+/// and may be projected in parallel. Particles with zero inverse mass are never
+/// written by projection and so don't conflict.
+///
+/// Up to 64 colors are used, tracked with one bitmask per particle. Constraints that
+/// can't be colored, or that fall in a color smaller than the minimum partition size,
+/// are placed after all colors to be projected sequentially. All buffers are kept
+/// between calls so recoloring a similar amount of constraints does not allocate.
+///
+class PbdConstraintColoring
+{
+public:
+    static constexpr int MaxNumColors = 64;
+
+    PbdConstraintColoring() = default;
+    virtual ~PbdConstraintColoring() = default;
+
+    ///
+    /// \brief Colors and reorders the constraints. Afterwards constraints
+    /// [offsets[i], offsets[i + 1]) form partition i, and [offsets.back(), size)
+    /// should be projected sequentially
+    ///
+    void partition(std::vector<PbdConstraint*>& constraints, const PbdState& state);
+
+    ///
+    /// \brief Offsets of the partitions in the last partitioned constraints,
+    /// always starts with 0
+    ///
+    const std::vector<size_t>& getPartitionOffsets() const { return m_partitionOffsets; }
+
+    ///
+    /// \brief Get/Set the minimum size of a partition, smaller colors are
+    /// projected sequentially as they don't justify the parallel overhead
+    ///@{
+    void setMinPartitionSize(const size_t minPartitionSize) { m_minPartitionSize = minPartitionSize; }
+    size_t getMinPartitionSize() const { return m_minPartitionSize; }
+    ///@}
+
+protected:
+    ///
+    /// \brief Returns the color mask of the particle, grows the masks as needed
+    ///
+    std::uint64_t& getParticleMask(const PbdParticleId& pid);
+
+protected:
+    size_t m_minPartitionSize = 16;
+    std::vector<size_t> m_partitionOffsets;
+
+    std::vector<std::vector<std::uint64_t>> m_particleMasks; ///< Per body, per particle bitmask of used colors, zero between calls
+    std::vector<int> m_colors;                               ///< Color of every constraint, MaxNumColors when sequential
+    std::vector<PbdConstraint*> m_reordered;                 ///< Swapped with the input
+};
+} // namespace imstk
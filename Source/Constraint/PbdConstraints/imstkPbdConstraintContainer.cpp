@@ -5,9 +5,9 @@
 */
 
 #include "imstkPbdConstraintContainer.h"
-#include "imstkGraph.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
 
 namespace imstk
 {
@@ -15,7 +15,31 @@ void
 PbdConstraintContainer::addConstraint(std::shared_ptr<PbdConstraint> constraint)
 {
     m_constraintLock.lock();
-    m_constraints.push_back(constraint);
+    const int partitionIdx = isPartitioned() ? findPartition(*constraint) : -1;
+    if (partitionIdx != -1)
+    {
+        insertIntoPartition(constraint, partitionIdx);
+    }
+    else
+    {
+        if (m_hasParticleIndex)
+        {
+            m_constraintLocations[constraint.get()] = { -1, m_constraints.size() };
+        }
+        m_constraints.push_back(constraint);
+
+        // Once enough sequential constraints accumulate they may form new partitions
+        if (isPartitioned()
+            && m_constraints.size() >= m_numSequentialPartitioned + static_cast<size_t>(m_partitionThreshold))
+        {
+            partitionSequentialConstraints();
+        }
+    }
+    if (m_hasParticleIndex)
+    {
+        indexParticles(constraint);
+    }
+    m_modifiedCount++;
     m_constraintLock.unlock();
 }
 
@@ -23,10 +47,40 @@ void
 PbdConstraintContainer::removeConstraint(std::shared_ptr<PbdConstraint> constraint)
 {
     m_constraintLock.lock();
-    iterator i = std::find(m_constraints.begin(), m_constraints.end(), constraint);
-    if (i != m_constraints.end())
+    if (m_hasParticleIndex)
     {
-        m_constraints.erase(i);
+        // The location is known, swap and pop wherever it is
+        updateParticleIndex();
+        if (m_constraintLocations.count(constraint.get()) != 0)
+        {
+            eraseIndexed(constraint.get());
+            m_modifiedCount++;
+        }
+        m_constraintLock.unlock();
+        return;
+    }
+
+    auto partitionIter = m_constraintPartitions.find(constraint.get());
+    if (partitionIter != m_constraintPartitions.end())
+    {
+        // Order within a partition doesn't matter, swap and pop
+        const int partitionIdx = partitionIter->second;
+        std::vector<std::shared_ptr<PbdConstraint>>& partition = m_partitionedConstraints[partitionIdx];
+        iterator i = std::find(partition.begin(), partition.end(), constraint);
+        eraseFromPartition(*constraint, partitionIdx);
+        std::iter_swap(i, partition.end() - 1);
+        partition.pop_back();
+        m_modifiedCount++;
+    }
+    else
+    {
+        iterator i = std::find(m_constraints.begin(), m_constraints.end(), constraint);
+        if (i != m_constraints.end())
+        {
+            m_constraints.erase(i);
+            m_numSequentialPartitioned = std::min(m_numSequentialPartitioned, m_constraints.size());
+            m_modifiedCount++;
+        }
     }
     m_constraintLock.unlock();
 }
@@ -35,28 +89,91 @@ void
 PbdConstraintContainer::removeConstraints(std::shared_ptr<std::unordered_set<size_t>> vertices, const int bodyId)
 {
     // Remove constraints that contain the given vertices
-    auto removeConstraintFunc = [&](std::shared_ptr<PbdConstraint> constraint)
-                                {
-                                    for (const PbdParticleId& pid : constraint->getParticles())
-                                    {
-                                        if (pid.first == bodyId && vertices->find(pid.second) != vertices->end())
-                                        {
-                                            return true;
-                                        }
-                                    }
-                                    return false;
-                                };
+    std::vector<PbdParticleId> particles;
+    particles.reserve(vertices->size());
+    for (const size_t vertexId : *vertices)
+    {
+        particles.push_back({ bodyId, static_cast<int>(vertexId) });
+    }
+    removeConstraintsIf(particles, [](const PbdConstraint&) { return true; });
+}
 
+void
+PbdConstraintContainer::removeConstraintsIf(const std::vector<PbdParticleId>& particles,
+                                            std::function<bool(const PbdConstraint&)> predicate)
+{
     m_constraintLock.lock();
-    m_constraints.erase(std::remove_if(m_constraints.begin(), m_constraints.end(), removeConstraintFunc),
+    updateParticleIndex();
+
+    // Gather first, erasing modifies the lists being visited
+    std::unordered_set<const PbdConstraint*> visited;
+    std::vector<const PbdConstraint*>        toRemove;
+    for (const PbdParticleId& pid : particles)
+    {
+        auto iter = m_particleConstraints.find(getParticleKey(pid));
+        if (iter == m_particleConstraints.end())
+        {
+            continue;
+        }
+        for (const std::shared_ptr<PbdConstraint>& constraint : iter->second)
+        {
+            if (visited.insert(constraint.get()).second && predicate(*constraint))
+            {
+                toRemove.push_back(constraint.get());
+            }
+        }
+    }
+
+    for (const PbdConstraint* constraint : toRemove)
+    {
+        eraseIndexed(constraint);
+    }
+    m_modifiedCount++;
+    m_constraintLock.unlock();
+}
+
+void
+PbdConstraintContainer::removeConstraintsIf(std::function<bool(const PbdConstraint&)> predicate)
+{
+    m_constraintLock.lock();
+    m_constraints.erase(std::remove_if(m_constraints.begin(), m_constraints.end(),
+        [&](const std::shared_ptr<PbdConstraint>& constraint)
+        {
+            if (predicate(*constraint))
+            {
+                if (m_hasParticleIndex)
+                {
+                    unindexParticles(*constraint);
+                }
+                return true;
+            }
+            return false;
+        }),
         m_constraints.end());
+    m_numSequentialPartitioned = std::min(m_numSequentialPartitioned, m_constraints.size());
 
     // Also remove partitioned constraints
-    for (auto& pc : m_partitionedConstraints)
+    for (int partitionIdx = 0; partitionIdx < static_cast<int>(m_partitionedConstraints.size()); partitionIdx++)
     {
-        pc.erase(std::remove_if(pc.begin(), pc.end(), removeConstraintFunc), pc.end());
+        std::vector<std::shared_ptr<PbdConstraint>>& partition = m_partitionedConstraints[partitionIdx];
+        partition.erase(std::remove_if(partition.begin(), partition.end(),
+            [&](const std::shared_ptr<PbdConstraint>& constraint)
+            {
+                if (predicate(*constraint))
+                {
+                    eraseFromPartition(*constraint, partitionIdx);
+                    if (m_hasParticleIndex)
+                    {
+                        unindexParticles(*constraint);
+                    }
+                    return true;
+                }
+                return false;
+            }),
+            partition.end());
     }
-
+    rebuildLocations();
+    m_modifiedCount++;
     m_constraintLock.unlock();
 }
 
@@ -64,7 +181,15 @@ PbdConstraintContainer::iterator
 PbdConstraintContainer::eraseConstraint(iterator iter)
 {
     m_constraintLock.lock();
+    if (m_hasParticleIndex)
+    {
+        unindexParticles(**iter);
+        m_constraintLocations.erase(iter->get());
+    }
     iterator newIter = m_constraints.erase(iter);
+    m_numSequentialPartitioned = std::min(m_numSequentialPartitioned, m_constraints.size());
+    shiftLocations(newIter);
+    m_modifiedCount++;
     m_constraintLock.unlock();
     return newIter;
 }
@@ -73,106 +198,392 @@ PbdConstraintContainer::const_iterator
 PbdConstraintContainer::eraseConstraint(const_iterator iter)
 {
     m_constraintLock.lock();
+    if (m_hasParticleIndex)
+    {
+        unindexParticles(**iter);
+        m_constraintLocations.erase(iter->get());
+    }
     const_iterator newIter = m_constraints.erase(iter);
+    m_numSequentialPartitioned = std::min(m_numSequentialPartitioned, m_constraints.size());
+    shiftLocations(newIter);
+    m_modifiedCount++;
     m_constraintLock.unlock();
     return newIter;
 }
 
+size_t
+PbdConstraintContainer::getNumConstraints() const
+{
+    size_t numConstraints = m_constraints.size();
+    for (const auto& partition : m_partitionedConstraints)
+    {
+        numConstraints += partition.size();
+    }
+    return numConstraints;
+}
+
 void
-PbdConstraintContainer::partitionConstraints(const int partitionedThreshold)
+PbdConstraintContainer::partitionConstraints(const int partitionThreshold)
 {
-    // Form the map { vertex : list_of_constraints_involve_vertex }
-    std::vector<std::shared_ptr<PbdConstraint>>& allConstraints = m_constraints;
+    m_constraintLock.lock();
+
+    // Start over from all constraints
+    for (auto& partition : m_partitionedConstraints)
+    {
+        m_constraints.insert(m_constraints.end(), partition.begin(), partition.end());
+    }
+    m_partitionedConstraints.clear();
+    m_particlePartitions.clear();
+    m_constraintPartitions.clear();
 
-    //std::cout << "---------partitionConstraints: " << allConstraints.size() << std::endl;
+    m_partitionThreshold = std::max(partitionThreshold, 1);
+    partitionSequentialConstraints();
+    m_modifiedCount++;
 
-    std::unordered_map<size_t, std::vector<size_t>> vertexConstraints;
-    for (size_t constrIdx = 0; constrIdx < allConstraints.size(); ++constrIdx)
+    m_constraintLock.unlock();
+}
+
+void
+PbdConstraintContainer::clearPartitions()
+{
+    m_constraintLock.lock();
+    for (auto& partition : m_partitionedConstraints)
+    {
+        m_constraints.insert(m_constraints.end(), partition.begin(), partition.end());
+    }
+    m_partitionedConstraints.clear();
+    m_particlePartitions.clear();
+    m_constraintPartitions.clear();
+    m_partitionThreshold       = -1;
+    m_numSequentialPartitioned = 0;
+    rebuildLocations();
+    m_modifiedCount++;
+    m_constraintLock.unlock();
+}
+
+PbdConstraintPartitionStats
+PbdConstraintContainer::getPartitionStats() const
+{
+    PbdConstraintPartitionStats stats;
+    stats.numSequential = m_constraints.size();
+    stats.smallestSize  = std::numeric_limits<size_t>::max();
+    for (const auto& partition : m_partitionedConstraints)
     {
-        const auto& constr = allConstraints[constrIdx];
-        for (const auto& vIds : constr->getParticles())
+        if (!partition.empty())
         {
-            vertexConstraints[vIds.second].push_back(constrIdx);
+            stats.numPartitions++;
+            stats.numPartitioned += partition.size();
+            stats.largestSize     = std::max(stats.largestSize, partition.size());
+            stats.smallestSize    = std::min(stats.smallestSize, partition.size());
         }
     }
+    if (stats.numPartitions == 0)
+    {
+        stats.smallestSize = 0;
+    }
+    return stats;
+}
+
+const std::vector<std::shared_ptr<PbdConstraint>>&
+PbdConstraintContainer::getParticleConstraints(const PbdParticleId& pid)
+{
+    static const std::vector<std::shared_ptr<PbdConstraint>> empty;
+
+    m_constraintLock.lock();
+    updateParticleIndex();
+    m_constraintLock.unlock();
+
+    auto iter = m_particleConstraints.find(getParticleKey(pid));
+    return (iter != m_particleConstraints.end()) ? iter->second : empty;
+}
 
-    // Add edges to the constraint graph
-    // Each edge represent a shared vertex between two constraints
-    Graph constraintGraph(allConstraints.size());
-    for (const auto& kv : vertexConstraints)
+int
+PbdConstraintContainer::findPartition(const PbdConstraint& constraint) const
+{
+    // Partitions are few, mark those used by any of the constraints particles
+    thread_local std::vector<char> isUsed;
+    isUsed.assign(m_partitionedConstraints.size(), false);
+    for (const PbdParticleId& pid : constraint.getParticles())
     {
-        const auto& constraints = kv.second;     // the list of constraints for a vertex
-        for (size_t i = 0; i < constraints.size(); ++i)
+        auto iter = m_particlePartitions.find(getParticleKey(pid));
+        if (iter != m_particlePartitions.end())
         {
-            for (size_t j = i + 1; j < constraints.size(); ++j)
+            for (const int partitionIdx : iter->second)
             {
-                constraintGraph.addEdge(constraints[i], constraints[j]);
+                isUsed[partitionIdx] = true;
             }
         }
     }
-    vertexConstraints.clear();
 
-    // do graph coloring for the constraint graph
-    const auto coloring = constraintGraph.doColoring(Graph::ColoringMethod::WelshPowell);
-    // const auto  coloring = constraintGraph.doColoring(Graph::ColoringMethod::Greedy);
-    const auto& partitionIndices = coloring.first;
-    const auto  numPartitions    = coloring.second;
-    assert(partitionIndices.size() == allConstraints.size());
+    int    bestIdx  = -1;
+    size_t bestSize = std::numeric_limits<size_t>::max();
+    for (int i = 0; i < static_cast<int>(m_partitionedConstraints.size()); i++)
+    {
+        if (!isUsed[i] && m_partitionedConstraints[i].size() < bestSize)
+        {
+            bestIdx  = i;
+            bestSize = m_partitionedConstraints[i].size();
+        }
+    }
+    return bestIdx;
+}
+
+void
+PbdConstraintContainer::insertIntoPartition(std::shared_ptr<PbdConstraint> constraint, const int partitionIdx)
+{
+    for (const PbdParticleId& pid : constraint->getParticles())
+    {
+        m_particlePartitions[getParticleKey(pid)].push_back(partitionIdx);
+    }
+    m_constraintPartitions[constraint.get()] = partitionIdx;
+    if (m_hasParticleIndex)
+    {
+        m_constraintLocations[constraint.get()] = { partitionIdx, m_partitionedConstraints[partitionIdx].size() };
+    }
+    m_partitionedConstraints[partitionIdx].push_back(std::move(constraint));
+}
+
+void
+PbdConstraintContainer::eraseFromPartition(const PbdConstraint& constraint, const int partitionIdx)
+{
+    for (const PbdParticleId& pid : constraint.getParticles())
+    {
+        auto iter = m_particlePartitions.find(getParticleKey(pid));
+        if (iter != m_particlePartitions.end())
+        {
+            std::vector<int>& partitions = iter->second;
+            auto              i = std::find(partitions.begin(), partitions.end(), partitionIdx);
+            if (i != partitions.end())
+            {
+                *i = partitions.back();
+                partitions.pop_back();
+            }
+            if (partitions.empty())
+            {
+                m_particlePartitions.erase(iter);
+            }
+        }
+    }
+    m_constraintPartitions.erase(&constraint);
+}
 
-    std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints = m_partitionedConstraints;
-    partitionedConstraints.resize(0);
-    partitionedConstraints.resize(static_cast<size_t>(numPartitions));
+void
+PbdConstraintContainer::partitionSequentialConstraints()
+{
+    // First fill the existing partitions
+    std::vector<std::shared_ptr<PbdConstraint>> remaining;
+    for (auto& constraint : m_constraints)
+    {
+        const int partitionIdx = findPartition(*constraint);
+        if (partitionIdx != -1)
+        {
+            insertIntoPartition(std::move(constraint), partitionIdx);
+        }
+        else
+        {
+            remaining.push_back(std::move(constraint));
+        }
+    }
+    m_constraints.clear();
 
-    for (size_t constrIdx = 0; constrIdx < partitionIndices.size(); ++constrIdx)
+    // Greedy coloring of the rest, each constraint joins the smallest color
+    // none of its particles are in, or starts a new color
+    std::vector<std::vector<std::shared_ptr<PbdConstraint>>> colors;
+    std::unordered_map<std::int64_t, std::vector<int>>       particleColors;
+    std::vector<char> isUsed;
+    for (auto& constraint : remaining)
     {
-        const auto partitionIdx = partitionIndices[constrIdx];
-        partitionedConstraints[partitionIdx].push_back(allConstraints[constrIdx]);
+        isUsed.assign(colors.size(), false);
+        for (const PbdParticleId& pid : constraint->getParticles())
+        {
+            auto iter = particleColors.find(getParticleKey(pid));
+            if (iter != particleColors.end())
+            {
+                for (const int colorIdx : iter->second)
+                {
+                    isUsed[colorIdx] = true;
+                }
+            }
+        }
+
+        int colorIdx = -1;
+        for (int i = 0; i < static_cast<int>(colors.size()); i++)
+        {
+            if (!isUsed[i] && (colorIdx == -1 || colors[i].size() < colors[colorIdx].size()))
+            {
+                colorIdx = i;
+            }
+        }
+        if (colorIdx == -1)
+        {
+            colorIdx = static_cast<int>(colors.size());
+            colors.emplace_back();
+        }
+
+        for (const PbdParticleId& pid : constraint->getParticles())
+        {
+            particleColors[getParticleKey(pid)].push_back(colorIdx);
+        }
+        colors[colorIdx].push_back(std::move(constraint));
     }
 
-    // If a partition has size smaller than the partition threshold, then move its constraints back
+    // If a color has size smaller than the partition threshold, then move its constraints back
     // These constraints will be processed sequentially
     // Because small size partitions yield bad performance upon running in parallel
-    allConstraints.resize(0);
-    for (const auto& constraints : partitionedConstraints)
+    for (auto& color : colors)
     {
-        if (constraints.size() < partitionedThreshold)
+        if (color.size() < static_cast<size_t>(m_partitionThreshold))
+        {
+            m_constraints.insert(m_constraints.end(), color.begin(), color.end());
+        }
+        else
         {
-            for (size_t constrIdx = 0; constrIdx < constraints.size(); ++constrIdx)
+            const int partitionIdx = static_cast<int>(m_partitionedConstraints.size());
+            m_partitionedConstraints.emplace_back();
+            m_partitionedConstraints.back().reserve(color.size());
+            for (auto& constraint : color)
             {
-                allConstraints.push_back(std::move(constraints[constrIdx]));
+                insertIntoPartition(std::move(constraint), partitionIdx);
             }
         }
     }
+    m_numSequentialPartitioned = m_constraints.size();
+    rebuildLocations();
+}
+
+void
+PbdConstraintContainer::updateParticleIndex()
+{
+    // Constraints may be pushed to m_constraints directly, catch that by count
+    if (m_hasParticleIndex && m_constraintLocations.size() == getNumConstraints())
+    {
+        return;
+    }
 
-    // Remove all empty partitions
-    size_t writeIdx = 0;
-    for (size_t readIdx = 0; readIdx < partitionedConstraints.size(); ++readIdx)
+    m_particleConstraints.clear();
+    for (const auto& constraint : m_constraints)
+    {
+        indexParticles(constraint);
+    }
+    for (const auto& partition : m_partitionedConstraints)
     {
-        if (partitionedConstraints[readIdx].size() >= partitionedThreshold)
+        for (const auto& constraint : partition)
         {
-            if (readIdx != writeIdx)
-            {
-                partitionedConstraints[writeIdx] = std::move(partitionedConstraints[readIdx]);
-            }
-            ++writeIdx;
+            indexParticles(constraint);
+        }
+    }
+    m_hasParticleIndex = true;
+    rebuildLocations();
+}
+
+void
+PbdConstraintContainer::indexParticles(const std::shared_ptr<PbdConstraint>& constraint)
+{
+    for (const PbdParticleId& pid : constraint->getParticles())
+    {
+        std::vector<std::shared_ptr<PbdConstraint>>& constraints = m_particleConstraints[getParticleKey(pid)];
+        // Constraints may use a particle more than once
+        if (constraints.empty() || constraints.back() != constraint)
+        {
+            constraints.push_back(constraint);
         }
     }
-    partitionedConstraints.resize(writeIdx);
+}
 
-    // Print
-    /*if (print)
+void
+PbdConstraintContainer::unindexParticles(const PbdConstraint& constraint)
+{
+    for (const PbdParticleId& pid : constraint.getParticles())
     {
-        size_t numConstraints = 0;
-        int    idx = 0;
-        for (const auto& constraints : partitionedConstraints)
+        auto iter = m_particleConstraints.find(getParticleKey(pid));
+        if (iter == m_particleConstraints.end())
         {
-            std::cout << "Partition # " << idx++ << " | # nodes: " << constraints.size() << std::endl;
-            numConstraints += constraints.size();
+            continue;
         }
-        std::cout << "Sequential processing # nodes: " << allConstraints.size() << std::endl;
-        numConstraints += allConstraints.size();
-        std::cout << "Total constraints: " << numConstraints << " | Graph size: "
-            << constraintGraph.size() << std::endl;
-    }*/
+        std::vector<std::shared_ptr<PbdConstraint>>& constraints = iter->second;
+        auto i = std::find_if(constraints.begin(), constraints.end(),
+            [&](const std::shared_ptr<PbdConstraint>& c) { return c.get() == &constraint; });
+        if (i != constraints.end())
+        {
+            *i = std::move(constraints.back());
+            constraints.pop_back();
+        }
+        if (constraints.empty())
+        {
+            m_particleConstraints.erase(iter);
+        }
+    }
+}
+
+void
+PbdConstraintContainer::rebuildLocations()
+{
+    if (!m_hasParticleIndex)
+    {
+        return;
+    }
+
+    m_constraintLocations.clear();
+    for (size_t i = 0; i < m_constraints.size(); i++)
+    {
+        m_constraintLocations[m_constraints[i].get()] = { -1, i };
+    }
+    for (int partitionIdx = 0; partitionIdx < static_cast<int>(m_partitionedConstraints.size()); partitionIdx++)
+    {
+        const std::vector<std::shared_ptr<PbdConstraint>>& partition = m_partitionedConstraints[partitionIdx];
+        for (size_t i = 0; i < partition.size(); i++)
+        {
+            m_constraintLocations[partition[i].get()] = { partitionIdx, i };
+        }
+    }
+}
+
+void
+PbdConstraintContainer::shiftLocations(const_iterator erasedIter)
+{
+    if (!m_hasParticleIndex)
+    {
+        return;
+    }
+
+    // Constraints pushed directly have no location yet, leave those to updateParticleIndex
+    for (const_iterator i = erasedIter; i != m_constraints.cend(); i++)
+    {
+        auto locationIter = m_constraintLocations.find(i->get());
+        if (locationIter != m_constraintLocations.end())
+        {
+            locationIter->second.index--;
+        }
+    }
+}
+
+void
+PbdConstraintContainer::eraseIndexed(const PbdConstraint* constraint)
+{
+    auto                     locationIter = m_constraintLocations.find(constraint);
+    const ConstraintLocation location     = locationIter->second;
+    m_constraintLocations.erase(locationIter);
+
+    std::vector<std::shared_ptr<PbdConstraint>>& constraints = (location.partitionIdx == -1) ?
+                                                               m_constraints : m_partitionedConstraints[location.partitionIdx];
+
+    // Keep the constraint alive until it is forgotten everywhere
+    std::shared_ptr<PbdConstraint> erased = std::move(constraints[location.index]);
+    if (location.index + 1 != constraints.size())
+    {
+        constraints[location.index] = std::move(constraints.back());
+        m_constraintLocations[constraints[location.index].get()].index = location.index;
+    }
+    constraints.pop_back();
+
+    if (location.partitionIdx == -1)
+    {
+        m_numSequentialPartitioned = std::min(m_numSequentialPartitioned, m_constraints.size());
+    }
+    else
+    {
+        eraseFromPartition(*erased, location.partitionIdx);
+    }
+    unindexParticles(*erased);
 }
 } // namespace imstk
\ No newline at end of file
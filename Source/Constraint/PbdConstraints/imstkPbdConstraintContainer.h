@@ -8,10 +8,26 @@
 
 #include "imstkPbdConstraint.h"
 
+#include <functional>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace imstk
 {
+///
+/// \struct PbdConstraintPartitionStats
+///
+/// \brief Summary of the partitioning of a PbdConstraintContainer
+///
+struct PbdConstraintPartitionStats
+{
+    size_t numPartitions  = 0; ///< Number of non-empty partitions
+    size_t largestSize    = 0; ///< Constraints in the largest partition
+    size_t smallestSize   = 0; ///< Constraints in the smallest non-empty partition
+    size_t numPartitioned = 0; ///< Constraints across all partitions
+    size_t numSequential  = 0; ///< Constraints not partitioned, solved sequentially
+};
+
 ///
 /// \class PbdConstraintContainer
 ///
@@ -34,18 +50,35 @@ public:
     virtual void addConstraint(std::shared_ptr<PbdConstraint> constraint);
 
     ///
-    /// \brief Linear searches for and removes a constraint from the system, thread safe
+    /// \brief Removes a constraint from the system, thread safe. Linear searches
+    /// unless the particle index has been built
     ///
     virtual void removeConstraint(std::shared_ptr<PbdConstraint> constraint);
 
     ///
-    /// \brief Removes all constraints associated with vertex ids
+    /// \brief Removes all constraints associated with vertex ids, only the
+    /// constraints of those vertices are visited
     ///
     virtual void removeConstraints(
         std::shared_ptr<std::unordered_set<size_t>> vertices, const int bodyId);
 
     ///
-    /// \brief Removes a constraint from the system by iterator, thread safe
+    /// \brief Removes the constraints of the given particles for which the predicate
+    /// returns true, thread safe. Cost is proportional to the number of constraints
+    /// of the particles rather than all constraints. Builds the particle index on
+    /// first use. The order of the remaining constraints is not preserved.
+    ///
+    virtual void removeConstraintsIf(const std::vector<PbdParticleId>& particles,
+                                     std::function<bool(const PbdConstraint&)> predicate);
+
+    ///
+    /// \brief Removes all constraints, partitioned or not, for which the predicate
+    /// returns true in a single pass, thread safe
+    ///
+    virtual void removeConstraintsIf(std::function<bool(const PbdConstraint&)> predicate);
+
+    ///
+    /// \brief Removes a non-partitioned constraint from the system by iterator, thread safe
     ///
     virtual iterator eraseConstraint(iterator iter);
     virtual const_iterator eraseConstraint(const_iterator iter);
@@ -71,22 +104,140 @@ public:
     ///
     /// \brief Get the partitioned constraints
     ///
-    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>> getPartitionedConstraints() const { return m_partitionedConstraints; }
+    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& getPartitionedConstraints() const { return m_partitionedConstraints; }
+
+    ///
+    /// \brief Returns the total number of constraints, partitioned or not
+    ///
+    size_t getNumConstraints() const;
+
+    ///
+    /// \brief Returns a counter incremented on every addition, removal, or
+    /// partitioning. Used to invalidate data derived from the constraints
+    ///
+    size_t getModifiedCount() const { return m_modifiedCount; }
 
     ///
-    /// \brief Partitions pbd constraints into separate vectors via graph coloring
+    /// \brief Partitions pbd constraints into separate vectors via greedy graph coloring,
+    /// constraints within a partition share no particle. Each constraint is given the
+    /// smallest partition it may join to keep the partitions balanced.
+    ///
+    /// Once partitioned, the partitioning is maintained incrementally. Added constraints
+    /// join the smallest partition they don't conflict with, or are solved sequentially
+    /// until enough accumulate to form new partitions. Removed constraints leave their
+    /// partition, empty partitions are kept for reuse.
     /// \param Minimum number of constraints in groups, any under will be dumped back into m_constraints
     ///
     void partitionConstraints(const int partitionThreshold);
 
     ///
-    /// \brief Clear the parition vectors
+    /// \brief Clear the partitions, all partitioned constraints are moved back into
+    /// m_constraints and incremental partitioning stops
+    ///
+    void clearPartitions();
+
+    ///
+    /// \brief Returns true if constraints are partitioned and maintained as such
     ///
-    void clearPartitions() { m_partitionedConstraints.clear(); }
+    bool isPartitioned() const { return m_partitionThreshold > 0; }
+
+    ///
+    /// \brief Returns the number, sizes and balance of the partitions
+    ///
+    PbdConstraintPartitionStats getPartitionStats() const;
+
+    ///
+    /// \brief Returns all constraints, partitioned or not, that use the particle.
+    /// Builds the particle index on first use, it is then maintained on every
+    /// addition and removal
+    ///
+    const std::vector<std::shared_ptr<PbdConstraint>>& getParticleConstraints(const PbdParticleId& pid);
+
+protected:
+    ///
+    /// \brief Location of a constraint, in m_constraints when partitionIdx is -1
+    ///
+    struct ConstraintLocation
+    {
+        int partitionIdx = -1;
+        size_t index     = 0;
+    };
+
+    ///
+    /// \brief Key of a particle used for partition bookkeeping
+    ///
+    static std::int64_t getParticleKey(const PbdParticleId& pid)
+    {
+        return (static_cast<std::int64_t>(pid.first) << 32) | static_cast<std::uint32_t>(pid.second);
+    }
+
+    ///
+    /// \brief Returns the smallest existing partition the constraint may join
+    /// without sharing a particle, -1 if there is none
+    ///
+    int findPartition(const PbdConstraint& constraint) const;
+
+    ///
+    /// \brief Adds the constraint to the partition and records its particles
+    ///
+    void insertIntoPartition(std::shared_ptr<PbdConstraint> constraint, const int partitionIdx);
+
+    ///
+    /// \brief Forgets the particles of a constraint leaving the partition
+    ///
+    void eraseFromPartition(const PbdConstraint& constraint, const int partitionIdx);
+
+    ///
+    /// \brief Moves sequential constraints into existing partitions where possible,
+    /// colors the rest, colors reaching the threshold become new partitions
+    ///
+    void partitionSequentialConstraints();
+
+    ///
+    /// \brief Builds the particle index if it hasn't been yet, or rebuilds it if
+    /// m_constraints was modified directly through getConstraints
+    ///
+    void updateParticleIndex();
+
+    ///
+    /// \brief Records the constraint under each of its particles
+    ///
+    void indexParticles(const std::shared_ptr<PbdConstraint>& constraint);
+
+    ///
+    /// \brief Forgets the constraint under each of its particles
+    ///
+    void unindexParticles(const PbdConstraint& constraint);
+
+    ///
+    /// \brief Recomputes the location of every constraint after bulk modification
+    ///
+    void rebuildLocations();
+
+    ///
+    /// \brief Moves the locations of the non-partitioned constraints from the given
+    /// one on back by one, after an order preserving erase before it
+    ///
+    void shiftLocations(const_iterator erasedIter);
+
+    ///
+    /// \brief Swaps and pops an indexed constraint from wherever it is stored
+    ///
+    void eraseIndexed(const PbdConstraint* constraint);
 
 protected:
     std::vector<std::shared_ptr<PbdConstraint>> m_constraints;                         ///< Not partitioned constraints
     std::vector<std::vector<std::shared_ptr<PbdConstraint>>> m_partitionedConstraints; ///< Partitioned pbd constraints
     ParallelUtils::SpinLock m_constraintLock;                                          ///< Used to deal with concurrent addition/removal of constraints
+    size_t m_modifiedCount = 0;                                                        ///< Incremented on every modification
+
+    int m_partitionThreshold = -1;                                                     ///< Minimum partition size, -1 when not partitioned
+    std::unordered_map<std::int64_t, std::vector<int>> m_particlePartitions;           ///< Partitions each particle is used in
+    std::unordered_map<const PbdConstraint*, int> m_constraintPartitions;              ///< Partition of each partitioned constraint
+    size_t m_numSequentialPartitioned = 0;                                             ///< Size of m_constraints when last partitioned
+
+    bool m_hasParticleIndex = false;                                                   ///< Whether the below are maintained
+    std::unordered_map<std::int64_t, std::vector<std::shared_ptr<PbdConstraint>>> m_particleConstraints; ///< Constraints using each particle
+    std::unordered_map<const PbdConstraint*, ConstraintLocation> m_constraintLocations;                 ///< Location of each constraint
 };
 } // namespace imstk
\ No newline at end of file
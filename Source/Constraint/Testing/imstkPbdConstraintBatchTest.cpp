@@ -0,0 +1,157 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintBatch.h"
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDihedralConstraint.h"
+#include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdVolumeConstraint.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Create a single body state with a deformed tetrahedron
+///
+std::shared_ptr<PbdBody>
+makeTetBody(const int bodyId)
+{
+    auto body = std::make_shared<PbdBody>(bodyId);
+    body->vertices = std::make_shared<VecDataArray<double, 3>>(4);
+    (*body->vertices)[0] = Vec3d(0.0, 0.0, 0.0);
+    (*body->vertices)[1] = Vec3d(1.0, 0.0, 0.0);
+    (*body->vertices)[2] = Vec3d(0.0, 1.0, 0.0);
+    (*body->vertices)[3] = Vec3d(0.0, 0.0, 1.0);
+    body->invMasses = std::make_shared<DataArray<double>>(4);
+    body->invMasses->fill(1.0);
+    (*body->invMasses)[0] = 0.0;
+    return body;
+}
+
+void
+deform(PbdState& state)
+{
+    VecDataArray<double, 3>& vertices = *state.m_bodies[0]->vertices;
+    vertices[1] += Vec3d(0.3, 0.1, 0.0);
+    vertices[2] += Vec3d(-0.1, 0.4, 0.2);
+    vertices[3] += Vec3d(0.2, -0.2, 0.5);
+}
+
+void
+addConstraints(const PbdState& state, PbdConstraintContainer& container)
+{
+    const VecDataArray<double, 3>& vertices = *state.m_bodies[0]->vertices;
+    const int edges[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+    for (int i = 0; i < 6; i++)
+    {
+        auto c = std::make_shared<PbdDistanceConstraint>();
+        c->initConstraint(vertices[edges[i][0]], vertices[edges[i][1]],
+            { 0, edges[i][0] }, { 0, edges[i][1] }, 1.0e3);
+        container.addConstraint(c);
+    }
+
+    auto volume = std::make_shared<PbdVolumeConstraint>();
+    volume->initConstraint(vertices[0], vertices[1], vertices[2], vertices[3],
+        { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, 1.0e2);
+    container.addConstraint(volume);
+
+    auto dihedral = std::make_shared<PbdDihedralConstraint>();
+    dihedral->initConstraint(vertices[0], vertices[1], vertices[2], vertices[3],
+        { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, 1.0e2);
+    container.addConstraint(dihedral);
+}
+} // namespace
+
+///
+/// \brief Test batched projection gives the same positions, lambdas, and
+/// constraint values as virtual projection
+///
+TEST(imstkPbdConstraintBatchTest, TestMatchesVirtualProjection)
+{
+    PbdState virtualState;
+    virtualState.m_bodies.push_back(makeTetBody(0));
+    PbdState batchedState;
+    batchedState.deepCopy(virtualState);
+
+    PbdConstraintContainer virtualContainer;
+    addConstraints(virtualState, virtualContainer);
+    PbdConstraintContainer batchedContainer;
+    addConstraints(batchedState, batchedContainer);
+
+    deform(virtualState);
+    deform(batchedState);
+
+    PbdConstraintBatches batches;
+    batches.build(batchedContainer);
+    EXPECT_EQ(batches.getNumBatchedConstraints(), 8);
+    EXPECT_TRUE(batches.isBuiltFrom(batchedContainer));
+
+    const double dt = 0.01;
+    for (auto type : { PbdConstraint::SolverType::xPBD, PbdConstraint::SolverType::PBD })
+    {
+        for (const auto& c : virtualContainer.getConstraints())
+        {
+            c->zeroOutLambda();
+        }
+        batches.beginSolve();
+        for (int iter = 0; iter < 5; iter++)
+        {
+            // Batches solve by type, distance, volume, then dihedral,
+            // same order as added
+            for (const auto& c : virtualContainer.getConstraints())
+            {
+                c->projectConstraint(virtualState, dt, type);
+            }
+            batches.projectConstraints(batchedState, dt, type);
+        }
+        batches.endSolve();
+
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_TRUE((*virtualState.m_bodies[0]->vertices)[i].isApprox(
+                (*batchedState.m_bodies[0]->vertices)[i]));
+        }
+        for (size_t i = 0; i < virtualContainer.getConstraints().size(); i++)
+        {
+            EXPECT_DOUBLE_EQ(virtualContainer.getConstraints()[i]->getLambda(),
+                batchedContainer.getConstraints()[i]->getLambda());
+            EXPECT_DOUBLE_EQ(virtualContainer.getConstraints()[i]->getConstraintC(),
+                batchedContainer.getConstraints()[i]->getConstraintC());
+        }
+    }
+}
+
+///
+/// \brief Test batches are invalidated when the container is modified
+///
+TEST(imstkPbdConstraintBatchTest, TestRebuildOnModified)
+{
+    PbdState state;
+    state.m_bodies.push_back(makeTetBody(0));
+
+    PbdConstraintContainer container;
+    addConstraints(state, container);
+
+    PbdConstraintBatches batches;
+    batches.build(container);
+    EXPECT_TRUE(batches.isBuiltFrom(container));
+    EXPECT_EQ(batches.getSequentialGroup().m_distance.size(), 6);
+    EXPECT_EQ(batches.getSequentialGroup().m_volume.size(), 1);
+    EXPECT_EQ(batches.getSequentialGroup().m_dihedral.size(), 1);
+
+    container.removeConstraint(container.getConstraints()[0]);
+    EXPECT_FALSE(batches.isBuiltFrom(container));
+
+    batches.build(container);
+    EXPECT_TRUE(batches.isBuiltFrom(container));
+    EXPECT_EQ(batches.getSequentialGroup().m_distance.size(), 5);
+
+    PbdConstraintContainer otherContainer;
+    EXPECT_FALSE(batches.isBuiltFrom(otherContainer));
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintColoring.h"
+#include "imstkPbdPointPointConstraint.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Create a state with a single body of n particles, the first fixed
+///
+PbdState
+makeState(const int n)
+{
+    auto body = std::make_shared<PbdBody>(0);
+    body->vertices  = std::make_shared<VecDataArray<double, 3>>(n);
+    body->invMasses = std::make_shared<DataArray<double>>(n);
+    body->invMasses->fill(1.0);
+    (*body->invMasses)[0] = 0.0;
+
+    PbdState state;
+    state.m_bodies.push_back(body);
+    return state;
+}
+
+///
+/// \brief Check no two constraints of a partition share a movable particle
+///
+void
+checkPartitions(const std::vector<PbdConstraint*>& constraints,
+                const std::vector<size_t>& offsets, const PbdState& state)
+{
+    for (size_t i = 0; i + 1 < offsets.size(); i++)
+    {
+        std::set<PbdParticleId> used;
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            for (const PbdParticleId& pid : constraints[j]->getParticles())
+            {
+                if (state.getInvMass(pid) != 0.0)
+                {
+                    EXPECT_TRUE(used.insert(pid).second);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+///
+/// \brief Test a chain is split into two conflict free partitions
+///
+TEST(imstkPbdConstraintColoringTest, TestChain)
+{
+    const int n     = 100;
+    PbdState  state = makeState(n);
+    std::vector<std::unique_ptr<PbdPointPointConstraint>> storage;
+    std::vector<PbdConstraint*> constraints;
+    for (int i = 0; i < n - 1; i++)
+    {
+        storage.push_back(std::make_unique<PbdPointPointConstraint>());
+        storage.back()->initConstraint({ 0, i }, { 0, i + 1 }, 1.0, 1.0);
+        constraints.push_back(storage.back().get());
+    }
+
+    PbdConstraintColoring coloring;
+    coloring.setMinPartitionSize(1);
+    coloring.partition(constraints, state);
+
+    const std::vector<size_t> offsets = coloring.getPartitionOffsets();
+    ASSERT_EQ(offsets.size(), 3);
+    EXPECT_EQ(offsets.back(), constraints.size());
+    EXPECT_EQ(constraints.size(), n - 1);
+    checkPartitions(constraints, offsets, state);
+
+    // Every constraint is kept exactly once
+    std::set<PbdConstraint*> unique(constraints.begin(), constraints.end());
+    EXPECT_EQ(unique.size(), n - 1);
+
+    // Recoloring gives the same partition sizes
+    coloring.partition(constraints, state);
+    EXPECT_EQ(coloring.getPartitionOffsets(), offsets);
+}
+
+///
+/// \brief Test a shared fixed particle doesn't conflict while a shared movable
+/// one does, constraints beyond the color limit or in small colors are sequential
+///
+TEST(imstkPbdConstraintColoringTest, TestSharedParticle)
+{
+    const int n     = 71;
+    PbdState  state = makeState(n);
+    std::vector<std::unique_ptr<PbdPointPointConstraint>> storage;
+    std::vector<PbdConstraint*> fixedConstraints;
+    std::vector<PbdConstraint*> movableConstraints;
+    for (int i = 2; i < n; i++)
+    {
+        storage.push_back(std::make_unique<PbdPointPointConstraint>());
+        storage.back()->initConstraint({ 0, 0 }, { 0, i }, 1.0, 1.0);
+        fixedConstraints.push_back(storage.back().get());
+
+        storage.push_back(std::make_unique<PbdPointPointConstraint>());
+        storage.back()->initConstraint({ 0, 1 }, { 0, i }, 1.0, 1.0);
+        movableConstraints.push_back(storage.back().get());
+    }
+
+    PbdConstraintColoring coloring;
+    coloring.setMinPartitionSize(1);
+    coloring.partition(fixedConstraints, state);
+    EXPECT_EQ(coloring.getPartitionOffsets(), std::vector<size_t>({ 0, fixedConstraints.size() }));
+
+    coloring.partition(movableConstraints, state);
+    const std::vector<size_t>& offsets = coloring.getPartitionOffsets();
+    ASSERT_EQ(offsets.size(), PbdConstraintColoring::MaxNumColors + 1);
+    EXPECT_EQ(offsets.back(), PbdConstraintColoring::MaxNumColors);
+    checkPartitions(movableConstraints, offsets, state);
+
+    coloring.setMinPartitionSize(2);
+    coloring.partition(movableConstraints, state);
+    EXPECT_EQ(coloring.getPartitionOffsets(), std::vector<size_t>({ 0 }));
+}
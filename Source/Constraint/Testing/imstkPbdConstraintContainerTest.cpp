@@ -0,0 +1,270 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDistanceConstraint.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Create a distance constraint between two particles of a body
+///
+std::shared_ptr<PbdDistanceConstraint>
+makeDistanceConstraint(const int bodyId, const int v0, const int v1)
+{
+    auto c = std::make_shared<PbdDistanceConstraint>();
+    c->initConstraint(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0),
+        { bodyId, v0 }, { bodyId, v1 }, 1.0e3);
+    return c;
+}
+
+///
+/// \brief Add the edges of a dim x dim grid of particles
+///
+void
+addGridConstraints(PbdConstraintContainer& container, const int bodyId, const int dim)
+{
+    for (int i = 0; i < dim; i++)
+    {
+        for (int j = 0; j < dim; j++)
+        {
+            const int v = i * dim + j;
+            if (j + 1 < dim)
+            {
+                container.addConstraint(makeDistanceConstraint(bodyId, v, v + 1));
+            }
+            if (i + 1 < dim)
+            {
+                container.addConstraint(makeDistanceConstraint(bodyId, v, v + dim));
+            }
+        }
+    }
+}
+
+///
+/// \brief Returns true if no two constraints of any partition share a particle
+///
+bool
+arePartitionsIndependent(const PbdConstraintContainer& container)
+{
+    for (const auto& partition : container.getPartitionedConstraints())
+    {
+        std::set<PbdParticleId> particles;
+        for (const auto& c : partition)
+        {
+            for (const PbdParticleId& pid : c->getParticles())
+            {
+                if (!particles.insert(pid).second)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+///
+/// \brief Returns true if getParticleConstraints of every particle of the grid
+/// matches a search over all constraints
+///
+bool
+isParticleIndexValid(PbdConstraintContainer& container, const int bodyId, const int dim)
+{
+    std::vector<std::shared_ptr<PbdConstraint>> constraints = container.getConstraints();
+    for (const auto& partition : container.getPartitionedConstraints())
+    {
+        constraints.insert(constraints.end(), partition.begin(), partition.end());
+    }
+
+    for (int v = 0; v < dim * dim; v++)
+    {
+        const PbdParticleId      pid = { bodyId, v };
+        std::set<PbdConstraint*> expected;
+        for (const auto& c : constraints)
+        {
+            const std::vector<PbdParticleId>& particles = c->getParticles();
+            if (std::find(particles.begin(), particles.end(), pid) != particles.end())
+            {
+                expected.insert(c.get());
+            }
+        }
+
+        std::set<PbdConstraint*> indexed;
+        for (const auto& c : container.getParticleConstraints(pid))
+        {
+            indexed.insert(c.get());
+        }
+        if (indexed != expected || container.getParticleConstraints(pid).size() != expected.size())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+///
+/// \brief Test partitions are independent sets, balanced, and account for all constraints
+///
+TEST(imstkPbdConstraintContainerTest, TestPartitionConstraints)
+{
+    PbdConstraintContainer container;
+    addGridConstraints(container, 1, 20);
+    const size_t numConstraints = container.getNumConstraints();
+    EXPECT_EQ(numConstraints, 2 * 20 * 19);
+
+    container.partitionConstraints(16);
+    EXPECT_TRUE(container.isPartitioned());
+    EXPECT_TRUE(arePartitionsIndependent(container));
+    EXPECT_EQ(container.getNumConstraints(), numConstraints);
+
+    // A grid is 4 colorable, balanced coloring shouldn't produce many more
+    const PbdConstraintPartitionStats stats = container.getPartitionStats();
+    EXPECT_GE(stats.numPartitions, 4);
+    EXPECT_LE(stats.numPartitions, 6);
+    EXPECT_GE(stats.smallestSize, 16);
+    EXPECT_EQ(stats.numPartitioned + stats.numSequential, numConstraints);
+
+    container.clearPartitions();
+    EXPECT_FALSE(container.isPartitioned());
+    EXPECT_TRUE(container.getPartitionedConstraints().empty());
+    EXPECT_EQ(container.getConstraints().size(), numConstraints);
+}
+
+///
+/// \brief Test particles of different bodies with the same index don't conflict
+///
+TEST(imstkPbdConstraintContainerTest, TestPartitionPerBody)
+{
+    PbdConstraintContainer container;
+    for (int bodyId = 1; bodyId <= 16; bodyId++)
+    {
+        container.addConstraint(makeDistanceConstraint(bodyId, 0, 1));
+    }
+    container.partitionConstraints(16);
+
+    const PbdConstraintPartitionStats stats = container.getPartitionStats();
+    EXPECT_EQ(stats.numPartitions, 1);
+    EXPECT_EQ(stats.numSequential, 0);
+}
+
+///
+/// \brief Test partitions are maintained on addition & removal without repartitioning
+///
+TEST(imstkPbdConstraintContainerTest, TestIncrementalPartitioning)
+{
+    PbdConstraintContainer container;
+    addGridConstraints(container, 1, 20);
+    container.partitionConstraints(16);
+    const size_t numPartitions = container.getPartitionStats().numPartitions;
+
+    // Constraints of a second body fit into the existing partitions
+    addGridConstraints(container, 2, 10);
+    EXPECT_TRUE(arePartitionsIndependent(container));
+    EXPECT_EQ(container.getPartitionStats().numPartitions, numPartitions);
+    EXPECT_EQ(container.getConstraints().size(), 0);
+
+    // Remove all constraints of vertex 0 of body 1
+    auto vertices = std::make_shared<std::unordered_set<size_t>>();
+    vertices->insert(0);
+    const size_t numConstraints = container.getNumConstraints();
+    container.removeConstraints(vertices, 1);
+    EXPECT_EQ(container.getNumConstraints(), numConstraints - 2);
+    EXPECT_TRUE(arePartitionsIndependent(container));
+
+    // Remove all of body 2 through the predicate
+    container.removeConstraintsIf([](const PbdConstraint& c) { return c.getParticles()[0].first == 2; });
+    EXPECT_EQ(container.getNumConstraints(), numConstraints - 2 - 2 * 10 * 9);
+
+    // Remove a single partitioned constraint
+    std::shared_ptr<PbdConstraint> c = container.getPartitionedConstraints()[0][0];
+    container.removeConstraint(c);
+    EXPECT_EQ(container.getNumConstraints(), numConstraints - 2 - 2 * 10 * 9 - 1);
+
+    // Freed slots may be reused, particle 0 is now free in every partition
+    container.addConstraint(makeDistanceConstraint(1, 0, 1));
+    EXPECT_TRUE(arePartitionsIndependent(container));
+
+    // A chain on one particle conflicts with everything and accumulates sequentially
+    // until enough form new partitions
+    for (int i = 0; i < 64; i++)
+    {
+        container.addConstraint(makeDistanceConstraint(3, 0, i + 1));
+    }
+    EXPECT_TRUE(arePartitionsIndependent(container));
+    EXPECT_EQ(container.getNumConstraints(), numConstraints - 2 - 2 * 10 * 9 + 64);
+}
+
+///
+/// \brief Test the particle index is maintained on addition, removal & partitioning
+///
+TEST(imstkPbdConstraintContainerTest, TestParticleIndex)
+{
+    const int              dim = 10;
+    PbdConstraintContainer container;
+    addGridConstraints(container, 1, dim);
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    // Remove the constraints of the center vertex only
+    const size_t numConstraints = container.getNumConstraints();
+    container.removeConstraintsIf({ { 1, 55 } }, [](const PbdConstraint&) { return true; });
+    EXPECT_EQ(container.getNumConstraints(), numConstraints - 4);
+    EXPECT_TRUE(container.getParticleConstraints({ 1, 55 }).empty());
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    // Added constraints are indexed, also when pushed directly
+    container.addConstraint(makeDistanceConstraint(1, 55, 56));
+    container.getConstraints().push_back(makeDistanceConstraint(1, 55, 45));
+    EXPECT_EQ(container.getParticleConstraints({ 1, 55 }).size(), 2);
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    // The index follows constraints into and out of partitions
+    container.partitionConstraints(8);
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+    container.addConstraint(makeDistanceConstraint(1, 0, 11));
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    // The predicate selects among the constraints of the particles
+    container.removeConstraintsIf({ { 1, 0 }, { 1, 1 } },
+        [](const PbdConstraint& c) { return c.getParticles()[1].second == 1; });
+    EXPECT_EQ(container.getParticleConstraints({ 1, 1 }).size(), 2);
+    EXPECT_TRUE(arePartitionsIndependent(container));
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    container.removeConstraint(container.getPartitionedConstraints()[0][0]);
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    auto vertices = std::make_shared<std::unordered_set<size_t>>();
+    vertices->insert(99);
+    container.removeConstraints(vertices, 1);
+    EXPECT_TRUE(container.getParticleConstraints({ 1, 99 }).empty());
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    container.removeConstraintsIf([](const PbdConstraint& c) { return c.getParticles()[0].second < 20; });
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    container.clearPartitions();
+    container.eraseConstraint(container.getConstraints().begin());
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+
+    // Erasing by iterator keeps the order, the constraints after it are still found
+    const size_t                   numBeforeErase = container.getNumConstraints();
+    std::shared_ptr<PbdConstraint> last = container.getConstraints().back();
+    container.eraseConstraint(container.getConstraints().begin() + 3);
+    EXPECT_EQ(container.getConstraints().back(), last);
+    container.removeConstraint(last);
+    EXPECT_EQ(container.getNumConstraints(), numBeforeErase - 2);
+    EXPECT_EQ(std::find(container.getConstraints().begin(), container.getConstraints().end(), last),
+        container.getConstraints().end());
+    EXPECT_TRUE(isParticleIndexValid(container, 1, dim));
+}
\ No newline at end of file
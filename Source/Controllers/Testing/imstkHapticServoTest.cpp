@@ -0,0 +1,99 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDummyClient.h"
+#include "imstkHapticServo.h"
+
+#include <thread>
+
+using namespace imstk;
+
+///
+/// \brief Test the local model extrapolates the tool and is bounded
+///
+TEST(imstkHapticServoTest, TestComputeForce)
+{
+    HapticServo servo;
+    servo.setMaxExtrapolationTime(0.01);
+
+    HapticServo::ToolState state;
+    state.force = Vec3d(1.0, 0.0, 0.0);
+    state.devicePosition = Vec3d(0.0, 0.0, 0.0);
+    state.velocity  = Vec3d(0.0, 1.0, 0.0);
+    state.stiffness = 100.0;
+    state.time      = std::chrono::steady_clock::time_point();
+
+    // Device where it was at publish
+    EXPECT_TRUE(servo.computeForce(state, Vec3d::Zero(), state.time).isApprox(state.force));
+
+    // Device followed the extrapolated tool, no change in force
+    const auto time = state.time + std::chrono::milliseconds(5);
+    EXPECT_TRUE(servo.computeForce(state, Vec3d(0.0, 0.005, 0.0), time).isApprox(state.force));
+
+    // Device pushed further than the tool
+    EXPECT_TRUE(servo.computeForce(state, Vec3d(0.01, 0.005, 0.0), time).isZero(1.0e-12));
+
+    // Extrapolation stops at the max time
+    const auto lateTime = state.time + std::chrono::milliseconds(50);
+    EXPECT_TRUE(servo.computeForce(state, Vec3d(0.0, 0.05, 0.0), lateTime).isApprox(Vec3d(1.0, -4.0, 0.0)));
+
+    servo.setMaxForce(2.0);
+    EXPECT_NEAR(servo.computeForce(state, Vec3d(0.0, 0.05, 0.0), lateTime).norm(), 2.0, 1.0e-12);
+}
+
+///
+/// \brief Test the servo renders at its rate to the device while states
+/// are published from another thread
+///
+TEST(imstkHapticServoTest, TestServoRate)
+{
+    auto client = std::make_shared<DummyClient>();
+    client->setPosition(Vec3d(0.0, 0.0, 0.0));
+
+    HapticServo servo;
+    servo.setDevice(client);
+    servo.setRate(1000.0);
+    servo.init();
+    ASSERT_TRUE(servo.getInit());
+
+    // No state published yet
+    servo.update();
+    EXPECT_TRUE(client->getForce().isZero());
+
+    // Publish states whose force components are all equal, a torn read would differ
+    std::atomic<bool> publishing = { true };
+    std::thread       publisher([&]()
+        {
+            HapticServo::ToolState state;
+            for (int i = 0; publishing; i++)
+            {
+                state.force = Vec3d(i, i, i);
+                servo.publishToolState(state);
+            }
+        });
+
+    const int  numTicks = 50;
+    const auto start    = std::chrono::steady_clock::now();
+    for (int i = 0; i < numTicks; i++)
+    {
+        servo.update();
+        const Vec3d force = client->getForce();
+        EXPECT_EQ(force[0], force[1]);
+        EXPECT_EQ(force[0], force[2]);
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    publishing = false;
+    publisher.join();
+
+    // Every tick after the first waits for its period unless it was missed
+    EXPECT_EQ(servo.getNumTicks(), numTicks + 1);
+    EXPECT_GE(elapsed, (numTicks - 1 - servo.getNumMissedTicks()) * 0.001);
+
+    servo.uninit();
+    EXPECT_TRUE(client->getForce().isZero());
+}
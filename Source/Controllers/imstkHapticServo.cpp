@@ -0,0 +1,112 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkHapticServo.h"
+#include "imstkDeviceClient.h"
+#include "imstkLogger.h"
+
+#include <thread>
+
+namespace imstk
+{
+HapticServo::HapticServo()
+{
+    m_executionType = ExecutionType::PARALLEL;
+    // Updating at 1kHz, pre/post update events would be too costly
+    m_muteUpdateEvents = true;
+}
+
+void
+HapticServo::setRate(const double rate)
+{
+    CHECK(rate > 0.0) << "HapticServo rate must be positive";
+    m_rate = rate;
+}
+
+void
+HapticServo::publishToolState(const ToolState& state)
+{
+    ToolState stampedState = state;
+    stampedState.time = std::chrono::steady_clock::now();
+    m_toolState.write(stampedState);
+}
+
+Vec3d
+HapticServo::computeForce(const ToolState& state, const Vec3d& devicePos,
+                          const std::chrono::steady_clock::time_point& time) const
+{
+    const double dt = std::min(std::max(std::chrono::duration<double>(time - state.time).count(), 0.0),
+        m_maxExtrapolationTime);
+
+    // Device displacement relative to the extrapolated tool
+    const Vec3d displacement = devicePos - state.devicePosition - state.velocity * dt;
+    Vec3d       force = state.force - state.stiffness * displacement;
+
+    if (m_maxForce > 0.0 && force.norm() > m_maxForce)
+    {
+        force = force.normalized() * m_maxForce;
+    }
+    return force;
+}
+
+bool
+HapticServo::initModule()
+{
+    if (m_deviceClient == nullptr)
+    {
+        LOG(WARNING) << "HapticServo has no device";
+        return false;
+    }
+    m_nextTick = std::chrono::steady_clock::now();
+    m_numTicks = 0;
+    m_numMissedTicks = 0;
+    return true;
+}
+
+void
+HapticServo::updateModule()
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_rate));
+
+    // Sleep most of the wait, sleeps may overshoot so yield the rest of the way
+    const Clock::duration sleepMargin = std::chrono::microseconds(200);
+    Clock::time_point     now = Clock::now();
+    if (m_nextTick - now > sleepMargin)
+    {
+        std::this_thread::sleep_until(m_nextTick - sleepMargin);
+    }
+    while ((now = Clock::now()) < m_nextTick)
+    {
+        std::this_thread::yield();
+    }
+
+    // Schedule from the due time to avoid drift, when a full period late
+    // drop the missed ticks instead of rendering them in a burst
+    m_nextTick += period;
+    if (m_nextTick <= now)
+    {
+        const long long numMissed = (now - m_nextTick) / period + 1;
+        m_numMissedTicks += numMissed;
+        m_nextTick       += numMissed * period;
+    }
+
+    const ToolState& state = m_toolState.read();
+    m_force = m_toolState.hasValue() ? computeForce(state, m_deviceClient->getPosition(), now) : Vec3d::Zero();
+    m_deviceClient->setForce(m_force);
+    m_numTicks++;
+}
+
+void
+HapticServo::uninitModule()
+{
+    m_force = Vec3d::Zero();
+    if (m_deviceClient != nullptr)
+    {
+        m_deviceClient->setForce(m_force);
+    }
+}
+} // namespace imstk
@@ -0,0 +1,137 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+#include "imstkModule.h"
+#include "imstkTripleBuffer.h"
+
+#include <chrono>
+
+namespace imstk
+{
+class DeviceClient;
+
+///
+/// \class HapticServo
+///
+/// \brief Renders force to a haptic device at a fixed rate (default 1kHz),
+/// decoupled from the rate of the simulation. The simulation publishes the state
+/// of the controlled tool every step (see PbdObjectController::setHapticServo),
+/// the servo then renders a local model of the virtual coupling force from the
+/// latest device position every tick:
+///
+/// F(t) = F0 - k (x(t) - x0 - v (t - t0))
+///
+/// where F0 is the coupling force the simulation computed with the device at x0,
+/// k the local stiffness of the coupling and v the tool velocity extrapolating
+/// the tool position since the publish time t0. All quantities are in device space.
+///
+/// The tool state is exchanged lock-free, the simulation never waits on the servo
+/// and the servo always reads the latest complete state.
+/// It is a parallel module, run by the SimulationManager on its own thread.
+///
+class HapticServo : public Module
+{
+public:
+    ///
+    /// \brief Tool state published by the simulation, in device space
+    ///
+    struct ToolState
+    {
+        Vec3d force = Vec3d::Zero();          ///< Force to render with the device at devicePosition
+        Vec3d devicePosition = Vec3d::Zero(); ///< Device position the force was computed with
+        Vec3d velocity  = Vec3d::Zero();      ///< Tool velocity, used to extrapolate the tool position
+        double stiffness = 0.0;               ///< Local stiffness, change of force per device displacement
+        std::chrono::steady_clock::time_point time; ///< Time of publish, set by publishToolState
+    };
+
+    HapticServo();
+    ~HapticServo() override = default;
+
+    const std::string getTypeName() const override { return "HapticServo"; }
+
+    ///
+    /// \brief Get/Set the device the force is rendered to
+    ///@{
+    std::shared_ptr<DeviceClient> getDevice() const { return m_deviceClient; }
+    void setDevice(std::shared_ptr<DeviceClient> deviceClient) { m_deviceClient = deviceClient; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the rate the force is rendered at, Hz. Default 1000
+    ///@{
+    void setRate(const double rate);
+    double getRate() const { return m_rate; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the longest time the tool position is extrapolated for, s.
+    /// Bounds the force when the simulation stalls. Default 0.01
+    ///@{
+    void setMaxExtrapolationTime(const double time) { m_maxExtrapolationTime = time; }
+    double getMaxExtrapolationTime() const { return m_maxExtrapolationTime; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the max magnitude of the rendered force, 0 for no limit. Default 0
+    ///@{
+    void setMaxForce(const double maxForce) { m_maxForce = maxForce; }
+    double getMaxForce() const { return m_maxForce; }
+    ///@}
+
+    ///
+    /// \brief Publish the latest tool state, thread safe with respect to the servo.
+    /// Only one thread may publish
+    ///
+    void publishToolState(const ToolState& state);
+
+    ///
+    /// \brief Returns the force rendered on the last tick, only to be called by the servo thread
+    ///
+    const Vec3d& getForce() const { return m_force; }
+
+    ///
+    /// \brief Returns the number of ticks rendered
+    ///
+    long long getNumTicks() const { return m_numTicks; }
+
+    ///
+    /// \brief Returns the number of ticks missed as the servo ran late
+    ///
+    long long getNumMissedTicks() const { return m_numMissedTicks; }
+
+    ///
+    /// \brief Computes the force of the local model for the device at devicePos and time
+    ///
+    Vec3d computeForce(const ToolState& state, const Vec3d& devicePos,
+                       const std::chrono::steady_clock::time_point& time) const;
+
+protected:
+    bool initModule() override;
+
+    ///
+    /// \brief Waits until the next tick is due then renders the force
+    ///
+    void updateModule() override;
+
+    void uninitModule() override;
+
+    std::shared_ptr<DeviceClient> m_deviceClient;
+
+    double m_rate = 1000.0;
+    double m_maxExtrapolationTime = 0.01;
+    double m_maxForce = 0.0;
+
+    ParallelUtils::TripleBuffer<ToolState> m_toolState;
+
+    std::chrono::steady_clock::time_point m_nextTick;
+    Vec3d m_force = Vec3d::Zero();
+    std::atomic<long long> m_numTicks       = { 0 };
+    std::atomic<long long> m_numMissedTicks = { 0 };
+};
+} // namespace imstk
@@ -6,6 +6,7 @@
 
 #include "imstkPbdObjectController.h"
 #include "imstkDeviceClient.h"
+#include "imstkHapticServo.h"
 #include "imstkLogger.h"
 #include "imstkPbdObject.h"
 
@@ -173,13 +174,48 @@ PbdObjectController::applyForces()
             const Vec3d avgForce = m_forceSum / m_forces.size();
 
             // Render only the spring force (not the other forces the body has)
-            m_deviceClient->setForce(avgForce);
+            if (m_hapticServo != nullptr)
+            {
+                publishToolState(avgForce);
+            }
+            else
+            {
+                m_deviceClient->setForce(avgForce);
+            }
         }
         else
         {
             // Render only the spring force (not the other forces the body has)
-            m_deviceClient->setForce(force);
+            if (m_hapticServo != nullptr)
+            {
+                publishToolState(force);
+            }
+            else
+            {
+                m_deviceClient->setForce(force);
+            }
         }
     }
 }
+
+void
+PbdObjectController::publishToolState(const Vec3d& force)
+{
+    const Quatd& currOrientation     = (*m_pbdObject->getPbdBody()->orientations)[0];
+    const Vec3d& currVelocity        = (*m_pbdObject->getPbdBody()->velocities)[0];
+    const Vec3d& currAngularVelocity = (*m_pbdObject->getPbdBody()->angularVelocities)[0];
+    const Vec3d  hapticOffsetLocal   = currOrientation._transformVector(m_hapticOffset);
+
+    // Undo the offsets, scaling and inversion applied to the device tracking data
+    const Quatd invRotationOffset = m_rotationOffset.inverse();
+    const Vec3d toolVelocity      = currVelocity + currAngularVelocity.cross(hapticOffsetLocal);
+
+    HapticServo::ToolState state;
+    state.force = force;
+    state.devicePosition = (invRotationOffset * (getPosition() - m_translationOffset) / m_scaling).cwiseProduct(m_inversionParams);
+    state.velocity       = (invRotationOffset * toolVelocity / m_scaling).cwiseProduct(m_inversionParams);
+    // Linearization of the spring force wrt the device position, approximated as isotropic
+    state.stiffness = m_forceScaling * m_linearKs.maxCoeff() * m_scaling;
+    m_hapticServo->publishToolState(state);
+}
 } // namespace imstk
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 namespace imstk
 {
+class HapticServo;
 class PbdObject;
 
 ///
@@ -23,6 +24,9 @@ class PbdObject;
 ///
 /// The PbdObjectController is not perfectly smooth yet
 ///
+/// When a HapticServo is set the device force is not set every step, instead the
+/// state of the tool is published to the servo which renders the force at its own rate
+///
 class PbdObjectController : public SceneObjectController
 {
 public:
@@ -110,6 +114,14 @@ public:
     void setHapticOffset(const Vec3d& offset) { m_hapticOffset = offset; }
     ///@}
 
+    ///
+    /// \brief Set/Get the servo rendering the device force, when set the tool state is
+    /// published to it every step instead of setting the device force. Default nullptr
+    ///@{
+    std::shared_ptr<HapticServo> getHapticServo() const { return m_hapticServo; }
+    void setHapticServo(std::shared_ptr<HapticServo> hapticServo) { m_hapticServo = hapticServo; }
+    ///@}
+
     ///
     /// \brief Return the device applied force (scaled)
     ///
@@ -152,7 +164,13 @@ public:
     void applyForces() override;
 
 protected:
-    std::shared_ptr<PbdObject> m_pbdObject;
+    ///
+    /// \brief Publish the tool state in device space to the haptic servo
+    ///
+    void publishToolState(const Vec3d& force);
+
+    std::shared_ptr<PbdObject>   m_pbdObject;
+    std::shared_ptr<HapticServo> m_hapticServo;
 
     double m_linearKd  = 10000.0;                                ///< Damping coefficient, linear
     double m_angularKd = 300.0;                                  ///< Damping coefficient, rotational
@@ -0,0 +1,168 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkBoundingVolumeHierarchy.h"
+
+#include <random>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Random triangles with vertices in [0, 10)
+///
+void
+makeRandomTriangles(const int numCells, VecDataArray<double, 3>& vertices, VecDataArray<int, 3>& cells)
+{
+    std::mt19937                           gen(7);
+    std::uniform_real_distribution<double> pos(0.0, 10.0);
+    std::uniform_real_distribution<double> offset(-0.5, 0.5);
+    vertices.resize(numCells * 3);
+    cells.resize(numCells);
+    for (int i = 0; i < numCells; i++)
+    {
+        const Vec3d center(pos(gen), pos(gen), pos(gen));
+        for (int j = 0; j < 3; j++)
+        {
+            vertices[i * 3 + j] = center + Vec3d(offset(gen), offset(gen), offset(gen));
+        }
+        cells[i] = Vec3i(i * 3, i * 3 + 1, i * 3 + 2);
+    }
+}
+
+///
+/// \brief Ids of the cells whose bounds overlap the box, by testing every cell
+///
+std::vector<int>
+queryBruteForce(const BoundingVolumeHierarchy& bvh, const Vec3d& lower, const Vec3d& upper)
+{
+    std::vector<int> results;
+    for (int i = 0; i < bvh.getNumPrimitives(); i++)
+    {
+        if (BoundingVolumeHierarchy::overlaps(bvh.getPrimitiveLower(i), bvh.getPrimitiveUpper(i), lower, upper))
+        {
+            results.push_back(i);
+        }
+    }
+    return results;
+}
+
+std::vector<int>
+query(const BoundingVolumeHierarchy& bvh, const Vec3d& lower, const Vec3d& upper)
+{
+    std::vector<int> results;
+    bvh.query(lower, upper, [&](const int primId) { results.push_back(primId); });
+    std::sort(results.begin(), results.end());
+    return results;
+}
+} // namespace
+
+///
+/// \brief Test that box queries find the same cells as brute force
+///
+TEST(imstkBoundingVolumeHierarchyTest, Query)
+{
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    cells;
+    makeRandomTriangles(500, vertices, cells);
+
+    BoundingVolumeHierarchy bvh;
+    bvh.build(vertices, cells);
+    EXPECT_EQ(500, bvh.getNumPrimitives());
+
+    for (int i = 0; i < 10; i++)
+    {
+        const Vec3d lower = Vec3d::Constant(i);
+        const Vec3d upper = lower + Vec3d(1.0, 2.0, 3.0);
+        EXPECT_EQ(queryBruteForce(bvh, lower, upper), query(bvh, lower, upper));
+    }
+}
+
+///
+/// \brief Test that the nearest cell matches brute force
+///
+TEST(imstkBoundingVolumeHierarchyTest, FindNearest)
+{
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    cells;
+    makeRandomTriangles(500, vertices, cells);
+
+    BoundingVolumeHierarchy bvh;
+    bvh.build(vertices, cells);
+
+    // Distance to the centroid of a cell
+    auto sqrDistToCell = [&](const Vec3d& pos, const int cellId)
+                         {
+                             const Vec3i& cell = cells[cellId];
+                             return (pos - (vertices[cell[0]] + vertices[cell[1]] + vertices[cell[2]]) / 3.0).squaredNorm();
+                         };
+
+    for (int i = 0; i < 20; i++)
+    {
+        const Vec3d pos(i * 0.6, 10.0 - i * 0.5, 5.0);
+
+        int    expectedId = -1;
+        double expectedSqrDist = IMSTK_DOUBLE_MAX;
+        for (int j = 0; j < cells.size(); j++)
+        {
+            const double sqrDist = sqrDistToCell(pos, j);
+            if (sqrDist < expectedSqrDist)
+            {
+                expectedSqrDist = sqrDist;
+                expectedId      = j;
+            }
+        }
+
+        double    minSqrDist = 0.0;
+        const int nearestId  = bvh.findNearest(pos, [&](const int primId) { return sqrDistToCell(pos, primId); }, minSqrDist);
+        EXPECT_EQ(expectedId, nearestId);
+        EXPECT_DOUBLE_EQ(expectedSqrDist, minSqrDist);
+    }
+}
+
+///
+/// \brief Test that refitting after the vertices moved keeps queries exact
+///
+TEST(imstkBoundingVolumeHierarchyTest, Refit)
+{
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    cells;
+    makeRandomTriangles(300, vertices, cells);
+
+    BoundingVolumeHierarchy bvh;
+    bvh.build(vertices, cells);
+    const size_t numNodes = bvh.getNodes().size();
+
+    // Move every cell differently so the hierarchy has to grow
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        vertices[i] += Vec3d((i / 3) % 7, 0.0, -((i / 3) % 5));
+    }
+    bvh.refit(vertices, cells);
+    EXPECT_EQ(numNodes, bvh.getNodes().size());
+
+    Vec3d lower, upper;
+    ASSERT_TRUE(bvh.getBounds(lower, upper));
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        EXPECT_TRUE(BoundingVolumeHierarchy::overlaps(vertices[i], vertices[i], lower, upper));
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        const Vec3d queryLower(i, 2.0, i - 5.0);
+        const Vec3d queryUpper = queryLower + Vec3d::Constant(2.0);
+        EXPECT_EQ(queryBruteForce(bvh, queryLower, queryUpper), query(bvh, queryLower, queryUpper));
+    }
+
+    // Changing the number of cells builds again
+    cells.resize(100);
+    bvh.refit(vertices, cells);
+    EXPECT_EQ(100, bvh.getNumPrimitives());
+}
\ No newline at end of file
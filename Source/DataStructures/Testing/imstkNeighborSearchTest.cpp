@@ -8,6 +8,7 @@
 
 #include "imstkSpatialHashTableSeparateChaining.h"
 #include "imstkGridBasedNeighborSearch.h"
+#include "imstkNeighborList.h"
 #include "imstkVecDataArray.h"
 
 using namespace imstk;
@@ -145,6 +146,20 @@ neighborSearchGridBased(VecDataArray<double, 3>& setA, VecDataArray<double, 3>&
     gridSearch.getNeighbors(neighbors, setA, setB);
 }
 
+///
+/// \brief For each particle in setA, search neighbors in setB using grid-based approach with sorted cells
+///
+void
+neighborSearchGridBasedSorted(VecDataArray<double, 3>& setA, VecDataArray<double, 3>& setB, std::vector<std::vector<size_t>>& neighbors)
+{
+    const double                   radius = 4.000000000000001 * PARTICLE_RADIUS;
+    static GridBasedNeighborSearch gridSearch;
+    static NeighborList            neighborList;
+    gridSearch.setSearchRadius(radius);
+    gridSearch.getNeighbors(neighborList, setA, setB);
+    neighborList.toLists(neighbors);
+}
+
 ///
 /// \brief Verify if two neighbor search results are identical
 ///
@@ -216,15 +231,18 @@ TEST(imstkNeighborSearchTest, CompareGridSearchAndSpatialHashing)
     std::vector<std::vector<size_t>> neighbors0;
     std::vector<std::vector<size_t>> neighbors1;
     std::vector<std::vector<size_t>> neighbors2;
+    std::vector<std::vector<size_t>> neighbors3;
 
     for (int iter = 0; iter < ITERATIONS; ++iter)
     {
         neighborSearchBruteForce(particles, neighbors0);
         neighborSearchGridBased(particles, neighbors1);
         neighborSearchSpatialHashing(particles, neighbors2);
+        neighborSearchGridBasedSorted(particles, particles, neighbors3);
 
         EXPECT_EQ(verify(neighbors1, neighbors0), true);
         EXPECT_EQ(verify(neighbors2, neighbors0), true);
+        EXPECT_EQ(verify(neighbors3, neighbors0), true);
         advancePositions(particles);
     }
 }
@@ -263,6 +281,7 @@ TEST(imstkNeighborSearchTest, TestGridSearchFromDifferentPointSet)
     VecDataArray<double, 3>          setB;
     std::vector<std::vector<size_t>> neighbors0;
     std::vector<std::vector<size_t>> neighbors1;
+    std::vector<std::vector<size_t>> neighbors2;
 
     for (int iter = 0; iter < ITERATIONS; ++iter)
     {
@@ -287,6 +306,40 @@ TEST(imstkNeighborSearchTest, TestGridSearchFromDifferentPointSet)
         // search for neighbors and compare
         neighborSearchBruteForce(setA, setB, neighbors0);
         neighborSearchGridBased(setA, setB, neighbors1);
+        neighborSearchGridBasedSorted(setA, setB, neighbors2);
         EXPECT_EQ(verify(neighbors1, neighbors0), true);
+        EXPECT_EQ(verify(neighbors2, neighbors0), true);
     }
 }
+
+///
+/// \brief The sorted grid search lists neighbors by cell, then by index, and handles an empty setB
+///
+TEST(imstkNeighborSearchTest, TestSortedGridSearchOrder)
+{
+    VecDataArray<double, 3> setA;
+    setA.push_back(Vec3d(0.0, 0.0, 0.0));
+    setA.push_back(Vec3d(5.0, 0.0, 0.0));
+
+    VecDataArray<double, 3> setB;
+    setB.push_back(Vec3d(0.5, 0.0, 0.0));
+    setB.push_back(Vec3d(-0.5, 0.0, 0.0));
+    setB.push_back(Vec3d(0.2, 0.1, 0.0));
+    setB.push_back(Vec3d(3.0, 0.0, 0.0));
+
+    GridBasedNeighborSearch gridSearch(1.0);
+    NeighborList            neighborList;
+    gridSearch.getNeighbors(neighborList, setA, setB);
+
+    ASSERT_EQ(neighborList.getNumPoints(), 2);
+    ASSERT_EQ(neighborList.getNumNeighbors(0), 3);
+    EXPECT_EQ(neighborList.getNeighbors(0)[0], 1);
+    EXPECT_EQ(neighborList.getNeighbors(0)[1], 2);
+    EXPECT_EQ(neighborList.getNeighbors(0)[2], 0);
+    EXPECT_EQ(neighborList.getNumNeighbors(1), 0);
+
+    gridSearch.getNeighbors(neighborList, setA, VecDataArray<double, 3>());
+    ASSERT_EQ(neighborList.getNumPoints(), 2);
+    EXPECT_EQ(neighborList.getNumNeighbors(0), 0);
+    EXPECT_EQ(neighborList.getNumNeighbors(1), 0);
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBoundingVolumeHierarchy.h"
+#include "imstkLogger.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace imstk
+{
+void
+BoundingVolumeHierarchy::build(const std::vector<Vec3d>& primLower, const std::vector<Vec3d>& primUpper)
+{
+    CHECK(primLower.size() == primUpper.size()) << "Primitive lower and upper bounds differ in size";
+    m_primLower = primLower;
+    m_primUpper = primUpper;
+    buildFromBounds();
+}
+
+void
+BoundingVolumeHierarchy::refit(const std::vector<Vec3d>& primLower, const std::vector<Vec3d>& primUpper)
+{
+    CHECK(primLower.size() == m_primIds.size() && primUpper.size() == m_primIds.size())
+        << "Cannot refit BoundingVolumeHierarchy to a different number of primitives";
+    m_primLower = primLower;
+    m_primUpper = primUpper;
+    refitFromBounds();
+}
+
+bool
+BoundingVolumeHierarchy::getBounds(Vec3d& lower, Vec3d& upper) const
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+    lower = m_nodes[0].lower;
+    upper = m_nodes[0].upper;
+    return true;
+}
+
+void
+BoundingVolumeHierarchy::buildFromBounds()
+{
+    const int numPrims = static_cast<int>(m_primLower.size());
+    m_nodes.clear();
+    m_primIds.resize(numPrims);
+    std::iota(m_primIds.begin(), m_primIds.end(), 0);
+    if (numPrims == 0)
+    {
+        return;
+    }
+
+    m_primCenters.resize(numPrims);
+    for (int i = 0; i < numPrims; i++)
+    {
+        m_primCenters[i] = (m_primLower[i] + m_primUpper[i]) * 0.5;
+    }
+
+    // A binary tree with leaves of at least one primitive has fewer than 2n nodes
+    m_nodes.reserve(2 * (numPrims / m_maxLeafSize + 1));
+    buildNode(0, numPrims, 0);
+}
+
+int
+BoundingVolumeHierarchy::buildNode(const int start, const int end, const int depth)
+{
+    const int nodeId = static_cast<int>(m_nodes.size());
+    m_nodes.push_back(Node());
+
+    // Bounds of the primitives and of their centers
+    Vec3d lower       = m_primLower[m_primIds[start]];
+    Vec3d upper       = m_primUpper[m_primIds[start]];
+    Vec3d centerLower = m_primCenters[m_primIds[start]];
+    Vec3d centerUpper = centerLower;
+    for (int i = start + 1; i < end; i++)
+    {
+        const int primId = m_primIds[i];
+        lower       = lower.cwiseMin(m_primLower[primId]);
+        upper       = upper.cwiseMax(m_primUpper[primId]);
+        centerLower = centerLower.cwiseMin(m_primCenters[primId]);
+        centerUpper = centerUpper.cwiseMax(m_primCenters[primId]);
+    }
+    m_nodes[nodeId].lower = lower;
+    m_nodes[nodeId].upper = upper;
+
+    if (end - start <= m_maxLeafSize || depth >= MaxDepth - 2)
+    {
+        m_nodes[nodeId].primStart = start;
+        m_nodes[nodeId].primCount = end - start;
+        return nodeId;
+    }
+
+    // Split at the median center along the longest axis of the centers
+    int axis = 0;
+    (centerUpper - centerLower).maxCoeff(&axis);
+    const int mid = start + (end - start) / 2;
+    std::nth_element(m_primIds.begin() + start, m_primIds.begin() + mid, m_primIds.begin() + end,
+        [&](const int a, const int b) { return m_primCenters[a][axis] < m_primCenters[b][axis]; });
+
+    buildNode(start, mid, depth + 1);
+    const int rightChild = buildNode(mid, end, depth + 1);
+    m_nodes[nodeId].rightChild = rightChild;
+    return nodeId;
+}
+
+void
+BoundingVolumeHierarchy::refitFromBounds()
+{
+    // Children come after their parents, so in reverse order children are done first
+    for (int nodeId = static_cast<int>(m_nodes.size()) - 1; nodeId >= 0; nodeId--)
+    {
+        Node& node = m_nodes[nodeId];
+        if (node.primCount > 0)
+        {
+            node.lower = m_primLower[m_primIds[node.primStart]];
+            node.upper = m_primUpper[m_primIds[node.primStart]];
+            for (int i = node.primStart + 1; i < node.primStart + node.primCount; i++)
+            {
+                node.lower = node.lower.cwiseMin(m_primLower[m_primIds[i]]);
+                node.upper = node.upper.cwiseMax(m_primUpper[m_primIds[i]]);
+            }
+        }
+        else
+        {
+            const Node& left  = m_nodes[nodeId + 1];
+            const Node& right = m_nodes[node.rightChild];
+            node.lower = left.lower.cwiseMin(right.lower);
+            node.upper = left.upper.cwiseMax(right.upper);
+        }
+    }
+}
+} // namespace imstk
\ No newline at end of file
@@ -0,0 +1,268 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkParallelFor.h"
+#include "imstkVecDataArray.h"
+
+#include <array>
+
+namespace imstk
+{
+///
+/// \class BoundingVolumeHierarchy
+///
+/// \brief Binary axis aligned bounding box hierarchy over a set of primitives
+/// (usually the cells of a mesh). Built once top-down with median splits, then
+/// refit every frame from the current primitive bounds without changing its
+/// topology. Refitting keeps queries exact but the hierarchy loosens with large
+/// deformation, build again when the topology of the primitives changes.
+///
+/// Nodes are stored in depth first order, the left child of a node is the next
+/// node, so children always come after their parent.
+///
+class BoundingVolumeHierarchy
+{
+public:
+    struct Node
+    {
+        Vec3d lower;
+        Vec3d upper;
+        int rightChild = -1; ///< Index of the right child, -1 for leaves
+        int primStart  = 0;  ///< Start of the leaf primitives in getPrimitiveIds
+        int primCount  = 0;  ///< Number of primitives of the leaf, 0 for internal nodes
+    };
+
+public:
+    BoundingVolumeHierarchy() = default;
+    virtual ~BoundingVolumeHierarchy() = default;
+
+public:
+    ///
+    /// \brief Build over the cells of a mesh, every cell is bounded by its
+    /// vertices grown by padding
+    ///
+    template<int N>
+    void build(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells, const double padding = 0.0)
+    {
+        computeCellBounds(vertices, cells, padding);
+        buildFromBounds();
+    }
+
+    ///
+    /// \brief Refit to the current vertices of the cells the hierarchy was built
+    /// with. Builds if not yet built or the number of cells changed.
+    ///
+    template<int N>
+    void refit(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells, const double padding = 0.0)
+    {
+        const bool needsBuild = (cells.size() != getNumPrimitives()) || m_nodes.empty();
+        computeCellBounds(vertices, cells, padding);
+        if (needsBuild)
+        {
+            buildFromBounds();
+        }
+        else
+        {
+            refitFromBounds();
+        }
+    }
+
+    ///
+    /// \brief Build from arbitrary primitive bounds
+    ///
+    void build(const std::vector<Vec3d>& primLower, const std::vector<Vec3d>& primUpper);
+
+    ///
+    /// \brief Refit to arbitrary primitive bounds, there must be as many as built with
+    ///
+    void refit(const std::vector<Vec3d>& primLower, const std::vector<Vec3d>& primUpper);
+
+    ///
+    /// \brief Calls func(primId) for every primitive whose bounds overlap the box
+    ///
+    template<typename Func>
+    void query(const Vec3d& lower, const Vec3d& upper, Func&& func) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        std::array<int, MaxDepth> stack;
+        int                       stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const int   nodeId = stack[--stackSize];
+            const Node& node   = m_nodes[nodeId];
+            if (!overlaps(node.lower, node.upper, lower, upper))
+            {
+                continue;
+            }
+
+            if (node.primCount > 0)
+            {
+                for (int i = node.primStart; i < node.primStart + node.primCount; i++)
+                {
+                    const int primId = m_primIds[i];
+                    if (overlaps(m_primLower[primId], m_primUpper[primId], lower, upper))
+                    {
+                        func(primId);
+                    }
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.rightChild;
+                stack[stackSize++] = nodeId + 1;
+            }
+        }
+    }
+
+    ///
+    /// \brief Finds the primitive nearest to pos. func(primId) must return the
+    /// squared distance from pos to the primitive. Subtrees whose bounds are
+    /// farther than the nearest found so far are skipped. Ties go to the smallest
+    /// primitive id, so the result matches a brute force search in id order.
+    /// \param pos position to search from
+    /// \param func returns squared distance to a primitive
+    /// \param minSqrDist squared distance to the nearest primitive
+    /// \return the nearest primitive id, -1 if there are none
+    ///
+    template<typename Func>
+    int findNearest(const Vec3d& pos, Func&& func, double& minSqrDist) const
+    {
+        int nearestId = -1;
+        minSqrDist = IMSTK_DOUBLE_MAX;
+        if (m_nodes.empty())
+        {
+            return nearestId;
+        }
+
+        std::array<std::pair<int, double>, MaxDepth> stack;
+        int                                          stackSize = 0;
+        stack[stackSize++] = { 0, sqrDistToBox(pos, m_nodes[0].lower, m_nodes[0].upper) };
+        while (stackSize > 0)
+        {
+            const std::pair<int, double> entry = stack[--stackSize];
+            if (entry.second > minSqrDist)
+            {
+                continue;
+            }
+
+            const Node& node = m_nodes[entry.first];
+            if (node.primCount > 0)
+            {
+                for (int i = node.primStart; i < node.primStart + node.primCount; i++)
+                {
+                    const int primId = m_primIds[i];
+                    if (sqrDistToBox(pos, m_primLower[primId], m_primUpper[primId]) > minSqrDist)
+                    {
+                        continue;
+                    }
+                    const double sqrDist = func(primId);
+                    if (sqrDist < minSqrDist || (sqrDist == minSqrDist && primId < nearestId))
+                    {
+                        minSqrDist = sqrDist;
+                        nearestId  = primId;
+                    }
+                }
+            }
+            else
+            {
+                // Visit the nearer child first
+                const int    leftId    = entry.first + 1;
+                const int    rightId   = node.rightChild;
+                const double leftDist  = sqrDistToBox(pos, m_nodes[leftId].lower, m_nodes[leftId].upper);
+                const double rightDist = sqrDistToBox(pos, m_nodes[rightId].lower, m_nodes[rightId].upper);
+                if (leftDist < rightDist)
+                {
+                    stack[stackSize++] = { rightId, rightDist };
+                    stack[stackSize++] = { leftId, leftDist };
+                }
+                else
+                {
+                    stack[stackSize++] = { leftId, leftDist };
+                    stack[stackSize++] = { rightId, rightDist };
+                }
+            }
+        }
+        return nearestId;
+    }
+
+    ///
+    /// \brief Bounds of the whole hierarchy, returns false if it is empty
+    ///
+    bool getBounds(Vec3d& lower, Vec3d& upper) const;
+
+    int getNumPrimitives() const { return static_cast<int>(m_primIds.size()); }
+    const std::vector<Node>& getNodes() const { return m_nodes; }
+    const std::vector<int>& getPrimitiveIds() const { return m_primIds; }
+    const Vec3d& getPrimitiveLower(const int primId) const { return m_primLower[primId]; }
+    const Vec3d& getPrimitiveUpper(const int primId) const { return m_primUpper[primId]; }
+
+    ///
+    /// \brief Maximum number of primitives per leaf, default 4
+    ///@{
+    void setMaxLeafSize(const int maxLeafSize) { m_maxLeafSize = std::max(maxLeafSize, 1); }
+    int getMaxLeafSize() const { return m_maxLeafSize; }
+///@}
+
+    static bool overlaps(const Vec3d& lowerA, const Vec3d& upperA, const Vec3d& lowerB, const Vec3d& upperB)
+    {
+        return lowerA[0] <= upperB[0] && upperA[0] >= lowerB[0]
+               && lowerA[1] <= upperB[1] && upperA[1] >= lowerB[1]
+               && lowerA[2] <= upperB[2] && upperA[2] >= lowerB[2];
+    }
+
+    static double sqrDistToBox(const Vec3d& pos, const Vec3d& lower, const Vec3d& upper)
+    {
+        return (pos - pos.cwiseMax(lower).cwiseMin(upper)).squaredNorm();
+    }
+
+protected:
+    template<int N>
+    void computeCellBounds(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells, const double padding)
+    {
+        m_primLower.resize(cells.size());
+        m_primUpper.resize(cells.size());
+        ParallelUtils::parallelFor(cells.size(), [&](const int i)
+            {
+                const Eigen::Matrix<int, N, 1>& cell = cells[i];
+                Vec3d lower = vertices[cell[0]];
+                Vec3d upper = lower;
+                for (int j = 1; j < N; j++)
+                {
+                    lower = lower.cwiseMin(vertices[cell[j]]);
+                    upper = upper.cwiseMax(vertices[cell[j]]);
+                }
+                m_primLower[i] = lower - Vec3d::Constant(padding);
+                m_primUpper[i] = upper + Vec3d::Constant(padding);
+            }, cells.size() > 1000);
+    }
+
+    void buildFromBounds();
+    void refitFromBounds();
+
+    ///
+    /// \brief Recursively builds the subtree of primitives [start, end), returns its node
+    ///
+    int buildNode(const int start, const int end, const int depth);
+
+protected:
+    // Median splits keep the depth at log2 of the number of leaves
+    static constexpr int MaxDepth = 64;
+
+    std::vector<Node>  m_nodes;
+    std::vector<int>   m_primIds;   ///< Primitive ids ordered by leaf
+    std::vector<Vec3d> m_primLower; ///< Per primitive lower bound
+    std::vector<Vec3d> m_primUpper; ///< Per primitive upper bound
+    std::vector<Vec3d> m_primCenters;
+    int m_maxLeafSize = 4;
+};
+} // namespace imstk
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "imstkGridBasedNeighborSearch.h"
 #include "imstkParallelUtils.h"
 
+#include <numeric>
+
 namespace imstk
 {
 void
@@ -114,4 +116,164 @@ GridBasedNeighborSearch::getNeighbors(std::vector<std::vector<size_t>>& result,
             }
     });
 }
+
+template<typename Func>
+void
+GridBasedNeighborSearch::forEachSortedNeighbor(const Vec3d& pos, Func&& func) const
+{
+    if (m_SortedIds.empty())
+    {
+        return;
+    }
+
+    // Cell of pos, points farther than a cell outside the grid have no neighbors
+    Vec3i cellIdx;
+    for (int i = 0; i < 3; i++)
+    {
+        const double cell = std::floor((pos[i] - m_LowerCorner[i]) / m_SearchRadius);
+        if (cell < -1.0 || cell > static_cast<double>(m_Resolution[i]))
+        {
+            return;
+        }
+        cellIdx[i] = static_cast<int>(cell);
+    }
+
+    // The three cells along x of a row are contiguous, as are their sorted points
+    const int xStart = std::max(cellIdx[0] - 1, 0);
+    const int xEnd   = std::min(cellIdx[0] + 1, m_Resolution[0] - 1);
+    if (xStart > xEnd)
+    {
+        return;
+    }
+    for (int z = std::max(cellIdx[2] - 1, 0); z <= std::min(cellIdx[2] + 1, m_Resolution[2] - 1); z++)
+    {
+        for (int y = std::max(cellIdx[1] - 1, 0); y <= std::min(cellIdx[1] + 1, m_Resolution[1] - 1); y++)
+        {
+            const int rowStart = (z * m_Resolution[1] + y) * m_Resolution[0];
+            const int qEnd     = m_CellStarts[rowStart + xEnd + 1];
+            for (int q = m_CellStarts[rowStart + xStart]; q < qEnd; q++)
+            {
+                if ((pos - m_SortedPositions[q]).squaredNorm() < m_SearchRadiusSqr)
+                {
+                    func(q);
+                }
+            }
+        }
+    }
+}
+void
+GridBasedNeighborSearch::getNeighbors(NeighborList& result, const VecDataArray<double, 3>& points)
+{
+    getNeighbors(result, points, points);
+}
+
+void
+GridBasedNeighborSearch::getNeighbors(NeighborList& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB)
+{
+    LOG_IF(FATAL, (std::abs(m_SearchRadius) < 1e-8)) << "Neighbor search radius is zero";
+
+    sortIntoCells(setB);
+
+    // Count the neighbors of every point, then fill them in at their offsets
+    std::vector<int>& offsets = result.getOffsets();
+    std::vector<int>& indices = result.getIndices();
+    offsets.resize(setA.size() + 1);
+    offsets[0] = 0;
+    ParallelUtils::parallelFor(setA.size(),
+        [&](const int p)
+        {
+            int count = 0;
+            forEachSortedNeighbor(setA[p], [&](const int) { count++; });
+            offsets[p + 1] = count;
+        });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    indices.resize(offsets.back());
+    ParallelUtils::parallelFor(setA.size(),
+        [&](const int p)
+        {
+            int* pneighbors = indices.data() + offsets[p];
+            forEachSortedNeighbor(setA[p], [&](const int q) { *pneighbors++ = m_SortedIds[q]; });
+        });
+}
+
+void
+GridBasedNeighborSearch::sortIntoCells(const VecDataArray<double, 3>& setB)
+{
+    const int numPoints = setB.size();
+    if (numPoints == 0)
+    {
+        m_Resolution = Vec3i::Zero();
+        m_CellStarts.assign(1, 0);
+        m_SortedIds.resize(0);
+        m_SortedPositions.resize(0);
+        return;
+    }
+
+    // Fit the grid to the bounding box of setB, expanded to avoid round-off error
+    Vec3d upperCorner;
+    ParallelUtils::findAABB(setB, m_LowerCorner, upperCorner);
+    upperCorner += Vec3d(m_SearchRadius, m_SearchRadius, m_SearchRadius) * 0.1;
+    for (int i = 0; i < 3; i++)
+    {
+        m_Resolution[i] = std::max(static_cast<int>(std::ceil((upperCorner[i] - m_LowerCorner[i]) / m_SearchRadius)), 1);
+    }
+    const int numCells = m_Resolution[0] * m_Resolution[1] * m_Resolution[2];
+
+    // Count the points of every cell
+    if (static_cast<int>(m_CellFill.size()) < numCells)
+    {
+        m_CellFill = std::vector<std::atomic<int>>(numCells);
+    }
+    ParallelUtils::parallelFor(numCells,
+        [&](const int cellId)
+        {
+            m_CellFill[cellId].store(0, std::memory_order_relaxed);
+        });
+    m_PointCells.resize(numPoints);
+    ParallelUtils::parallelFor(numPoints,
+        [&](const int q)
+        {
+            const Vec3d cell = (setB[q] - m_LowerCorner) / m_SearchRadius;
+            int         cellId = 0;
+            for (int i = 2; i >= 0; i--)
+            {
+                cellId = cellId * m_Resolution[i] + std::min(static_cast<int>(cell[i]), m_Resolution[i] - 1);
+            }
+            m_PointCells[q] = cellId;
+            m_CellFill[cellId].fetch_add(1, std::memory_order_relaxed);
+        });
+    m_CellStarts.resize(numCells + 1);
+    m_CellStarts[0] = 0;
+    for (int cellId = 0; cellId < numCells; cellId++)
+    {
+        const int count = m_CellFill[cellId].load(std::memory_order_relaxed);
+        m_CellStarts[cellId + 1] = m_CellStarts[cellId] + count;
+        m_CellFill[cellId].store(m_CellStarts[cellId], std::memory_order_relaxed);
+    }
+
+    // Scatter the points to their cells, then restore index order within cells
+    m_SortedIds.resize(numPoints);
+    ParallelUtils::parallelFor(numPoints,
+        [&](const int q)
+        {
+            m_SortedIds[m_CellFill[m_PointCells[q]].fetch_add(1, std::memory_order_relaxed)] = q;
+        });
+    ParallelUtils::parallelFor(numCells,
+        [&](const int cellId)
+        {
+            if (m_CellStarts[cellId + 1] - m_CellStarts[cellId] > 1)
+            {
+                std::sort(m_SortedIds.begin() + m_CellStarts[cellId], m_SortedIds.begin() + m_CellStarts[cellId + 1]);
+            }
+        });
+
+    m_SortedPositions.resize(numPoints);
+    ParallelUtils::parallelFor(numPoints,
+        [&](const int i)
+        {
+            m_SortedPositions[i] = setB[m_SortedIds[i]];
+        });
+}
+
 } // namespace imstk
\ No newline at end of file
@@ -6,15 +6,23 @@
 
 #pragma once
 
+#include "imstkNeighborList.h"
 #include "imstkSpinLock.h"
 #include "imstkUniformSpatialGrid.h"
 #include "imstkVecDataArray.h"
 
+#include <atomic>
+
 namespace imstk
 {
 ///
 /// \brief Class for searching neighbors using regular grid
 ///
+/// The NeighborList overloads do not use the grid of cell lists. They counting
+/// sort the points by cell into flat arrays instead, which are kept between
+/// searches, and return neighbors in compressed sparse row form. Neighbors are
+/// then ordered by cell and by index within a cell, so results are deterministic.
+///
 class GridBasedNeighborSearch
 {
 public:
@@ -59,6 +67,33 @@ public:
     ///
     void getNeighbors(std::vector<std::vector<size_t>>& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB);
 
+    ///
+    /// \brief Search neighbors for each point within the search radius
+    /// \param result The neighbors of each point
+    /// \param points The given points to search for neighbors
+    ///
+    void getNeighbors(NeighborList& result, const VecDataArray<double, 3>& points);
+
+    ///
+    /// \brief Search neighbors from setB for each point in setA within the search radius. SetA and setB can be different.
+    /// \param result The neighbors of each point in setA
+    /// \param setA The point set for which performing neighbor search
+    /// \param setB The point set where neighbor indices will be collected
+    ///
+    void getNeighbors(NeighborList& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB);
+
+private:
+    ///
+    /// \brief Counting sort the points of setB by the cell they fall in
+    ///
+    void sortIntoCells(const VecDataArray<double, 3>& setB);
+
+    ///
+    /// \brief Calls func(q) for every sorted point q within the search radius of pos
+    ///
+    template<typename Func>
+    void forEachSortedNeighbor(const Vec3d& pos, Func&& func) const;
+
 private:
     double m_SearchRadius    = 0.0;
     double m_SearchRadiusSqr = 0.0;
@@ -71,5 +106,14 @@ private:
         ParallelUtils::SpinLock lock;        // An atomic lock for thread-safe writing
     };
     UniformSpatialGrid<CellData> m_Grid;
+
+    // Points sorted by cell, used by the NeighborList overloads
+    Vec3d m_LowerCorner = Vec3d::Zero();
+    Vec3i m_Resolution  = Vec3i::Zero();
+    std::vector<int>              m_CellStarts;      ///< First sorted point of every cell, one past the last cell included
+    std::vector<int>              m_PointCells;      ///< Cell of every point of setB
+    std::vector<std::atomic<int>> m_CellFill;        ///< Point count, then next free slot, of every cell while sorting
+    std::vector<int>              m_SortedIds;       ///< Point indices of setB sorted by cell
+    std::vector<Vec3d>            m_SortedPositions; ///< Positions of setB sorted by cell
 };
 } // namespace imstk
\ No newline at end of file
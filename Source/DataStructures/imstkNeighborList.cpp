@@ -0,0 +1,37 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkNeighborList.h"
+
+#include <algorithm>
+
+namespace imstk
+{
+void
+NeighborList::fromLists(const std::vector<std::vector<size_t>>& lists)
+{
+    resize(static_cast<int>(lists.size()));
+    for (size_t i = 0; i < lists.size(); i++)
+    {
+        m_offsets[i + 1] = m_offsets[i] + static_cast<int>(lists[i].size());
+    }
+    m_indices.resize(m_offsets.back());
+    for (size_t i = 0; i < lists.size(); i++)
+    {
+        std::copy(lists[i].begin(), lists[i].end(), m_indices.begin() + m_offsets[i]);
+    }
+}
+
+void
+NeighborList::toLists(std::vector<std::vector<size_t>>& lists) const
+{
+    lists.resize(getNumPoints());
+    for (int i = 0; i < getNumPoints(); i++)
+    {
+        lists[i].assign(getNeighbors(i), getNeighbors(i) + getNumNeighbors(i));
+    }
+}
+} // namespace imstk
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class NeighborList
+///
+/// \brief Neighbors of every point of a set in compressed sparse row form. The
+/// neighbors of point i are the indices [offsets[i], offsets[i + 1]), the lists
+/// of all points are stored back to back in a single array. Refilling a list
+/// only allocates when it has to grow.
+///
+class NeighborList
+{
+public:
+    NeighborList() = default;
+    virtual ~NeighborList() = default;
+
+public:
+    ///
+    /// \brief Set the number of points, every point is left without neighbors
+    ///
+    void resize(const int numPoints)
+    {
+        m_offsets.assign(numPoints + 1, 0);
+        m_indices.resize(0);
+    }
+
+    int getNumPoints() const { return m_offsets.empty() ? 0 : static_cast<int>(m_offsets.size()) - 1; }
+
+    ///
+    /// \brief Number of neighbors of point i
+    ///
+    int getNumNeighbors(const int i) const { return m_offsets[i + 1] - m_offsets[i]; }
+
+    ///
+    /// \brief Neighbors of point i, getNumNeighbors(i) long
+    ///
+    const int* getNeighbors(const int i) const { return m_indices.data() + m_offsets[i]; }
+
+    ///
+    /// \brief Get the offset of every point into the indices, one past the last point included
+    ///@{
+    std::vector<int>& getOffsets() { return m_offsets; }
+    const std::vector<int>& getOffsets() const { return m_offsets; }
+    ///@}
+
+    ///
+    /// \brief Get the neighbor indices of all points
+    ///@{
+    std::vector<int>& getIndices() { return m_indices; }
+    const std::vector<int>& getIndices() const { return m_indices; }
+    ///@}
+
+    ///
+    /// \brief Convert from/to a list of neighbor indices per point
+    ///@{
+    void fromLists(const std::vector<std::vector<size_t>>& lists);
+    void toLists(std::vector<std::vector<size_t>>& lists) const;
+///@}
+
+protected:
+    std::vector<int> m_offsets = { 0 };
+    std::vector<int> m_indices;
+};
+} // namespace imstk
\ No newline at end of file
@@ -73,4 +73,25 @@ NeighborSearch::getNeighbors(std::vector<std::vector<size_t>>& result, const Vec
             });
     }
 }
+
+void
+NeighborSearch::getNeighbors(NeighborList& result, const VecDataArray<double, 3>& points)
+{
+    getNeighbors(result, points, points);
+}
+
+void
+NeighborSearch::getNeighbors(NeighborList& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB)
+{
+    if (m_Method == Method::UniformGridBasedSearch)
+    {
+        m_GridBasedSearcher->getNeighbors(result, setA, setB);
+    }
+    else
+    {
+        m_SpatialHashResult.resize(setA.size());
+        getNeighbors(m_SpatialHashResult, setA, setB);
+        result.fromLists(m_SpatialHashResult);
+    }
+}
 } // namespace imstk
\ No newline at end of file
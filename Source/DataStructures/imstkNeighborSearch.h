@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkMath.h"
+#include "imstkNeighborList.h"
 #include "imstkVecDataArray.h"
 
 namespace imstk
@@ -65,11 +66,28 @@ public:
     ///
     void getNeighbors(std::vector<std::vector<size_t>>& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB);
 
+    ///
+    /// \brief Search neighbors for each point within the search radius
+    /// \param result The neighbors of each point
+    /// \param points The given points to search for neighbors
+    ///
+    void getNeighbors(NeighborList& result, const VecDataArray<double, 3>& points);
+
+    ///
+    /// \brief Search neighbors from setB for each point in setA within the search radius. SetA and setB can be different.
+    /// Only the grid based search fills the result directly, spatial hashing is converted from lists.
+    /// \param result The neighbors of each point in setA
+    /// \param setA The point set for which performing neighbor search
+    /// \param setB The point set where neighbor indices will be collected
+    ///
+    void getNeighbors(NeighborList& result, const VecDataArray<double, 3>& setA, const VecDataArray<double, 3>& setB);
+
 private:
     Method m_Method;
     double m_SearchRadius = 0.0;
 
     std::shared_ptr<GridBasedNeighborSearch> m_GridBasedSearcher;
     std::shared_ptr<SpatialHashTableSeparateChaining> m_SpatialHashSearcher;
+    std::vector<std::vector<size_t>> m_SpatialHashResult; ///< Lists converted to a NeighborList
 };
 } // namespace imstk
\ No newline at end of file
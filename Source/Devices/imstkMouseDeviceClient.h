@@ -45,6 +45,11 @@ public:
     {
     }
 
+    MouseEvent(const int signalId) :
+        Event(signalId), m_scrollDx(0.0), m_buttonId(0)
+    {
+    }
+
     ~MouseEvent() override = default;
 
 public:
@@ -134,7 +139,7 @@ protected:
     {
         m_prevPos = m_pos;
         m_pos     = pos;
-        this->postEvent(MouseEvent(MouseDeviceClient::mouseMove()));
+        this->postEvent(MouseEvent(MouseDeviceClient::mouseMoveId()));
     }
 
     ///
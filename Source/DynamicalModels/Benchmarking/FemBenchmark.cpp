@@ -0,0 +1,200 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBackwardEuler.h"
+#include "imstkConjugateGradient.h"
+#include "imstkDirectLinearSolver.h"
+#include "imstkFeDeformableObject.h"
+#include "imstkFemDeformableBodyModel.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkInternalForceModel.h"
+#include "imstkNewtonSolver.h"
+#include "imstkScene.h"
+#include "imstkTetFemAssembler.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+#include <sparseMatrix.h>
+
+using namespace imstk;
+
+///
+/// \brief Implicit (backward euler) FEM step of a tet grid hanging from its top, solved
+/// with a sparse direct solver: LU analyzing every system (0), LU keeping the analysis (1),
+/// LDLT keeping the analysis (2)
+///
+static void
+BM_FemImplicitDirect(benchmark::State& state)
+{
+    const int dim = static_cast<int>(state.range(0));
+    auto      scene = std::make_shared<Scene>("FemBenchmark");
+
+    std::shared_ptr<TetrahedralMesh> tetMesh = GeometryUtils::toTetGrid(
+        Vec3d::Zero(), Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim));
+
+    auto config = std::make_shared<FemModelConfig>();
+    for (int i = 0; i < tetMesh->getNumVertices(); i++)
+    {
+        if (tetMesh->getVertexPosition(i)[1] > 1.99)
+        {
+            config->m_fixedNodeIds.push_back(i);
+        }
+    }
+
+    auto dynaModel = std::make_shared<FemDeformableBodyModel>();
+    dynaModel->configure(config);
+    dynaModel->setTimeStepSizeType(TimeSteppingType::Fixed);
+    dynaModel->setModelGeometry(tetMesh);
+    dynaModel->setTimeIntegrator(std::make_shared<BackwardEuler>(0.01));
+
+    auto deformableObj = std::make_shared<FeDeformableObject>("Grid");
+    deformableObj->setPhysicsGeometry(tetMesh);
+    deformableObj->setDynamicalModel(dynaModel);
+    scene->addSceneObject(deformableObj);
+    scene->initialize();
+
+    // Replace the default iterative linear solver
+    using Factorization = DirectLinearSolver<SparseMatrixd>::Factorization;
+    auto linSolver = std::make_shared<DirectLinearSolver<SparseMatrixd>>();
+    linSolver->setReuseAnalysis(state.range(1) != 0);
+    linSolver->setFactorization(state.range(1) == 2 ? Factorization::LDLT : Factorization::LU);
+    auto nlSolver = std::dynamic_pointer_cast<NewtonSolver<SparseMatrixd>>(dynaModel->getSolver());
+    nlSolver->setLinearSolver(linSolver);
+
+    state.counters["DOFs"] = tetMesh->getNumVertices() * 3;
+    state.counters["Mode"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(0.01);
+    }
+}
+
+BENCHMARK(BM_FemImplicitDirect)
+->Unit(benchmark::kMillisecond)
+->Name("Implicit FEM: Sparse Direct Solver")
+->ArgsProduct({ { 6, 10, 14 }, { 0, 1, 2 } });
+
+///
+/// \brief Internal force and tangent stiffness of a tet grid under a twist, assembled
+/// by Vega (0) or natively in parallel (1), for each FeMethodType
+///
+static void
+BM_FemAssembly(benchmark::State& state)
+{
+    const int dim = static_cast<int>(state.range(0));
+    std::shared_ptr<TetrahedralMesh> tetMesh = GeometryUtils::toTetGrid(
+        Vec3d::Zero(), Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim));
+
+    auto config = std::make_shared<FemModelConfig>();
+    config->m_femMethod = static_cast<FeMethodType>(state.range(1));
+    config->m_useNativeAssembly = (state.range(2) != 0);
+
+    auto dynaModel = std::make_shared<FemDeformableBodyModel>();
+    dynaModel->configure(config);
+    dynaModel->setTimeStepSizeType(TimeSteppingType::Fixed);
+    dynaModel->setModelGeometry(tetMesh);
+    dynaModel->setTimeIntegrator(std::make_shared<BackwardEuler>(0.01));
+    dynaModel->initialize();
+
+    std::shared_ptr<InternalForceModel> forceModel = dynaModel->getInternalForceModel();
+    vega::SparseMatrix*                 vegaMatrix = nullptr;
+    forceModel->getTangentStiffnessMatrixTopology(&vegaMatrix);
+    SparseMatrixd K;
+    FemDeformableBodyModel::initializeEigenMatrixFromVegaMatrix(*vegaMatrix, K);
+    delete vegaMatrix;
+
+    const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+    Vectord                        u(tetMesh->getNumVertices() * 3);
+    for (int i = 0; i < tetMesh->getNumVertices(); i++)
+    {
+        const Mat3d rot = Rotd(vertices[i][1] * 0.2, Vec3d(0.0, 1.0, 0.0)).toRotationMatrix();
+        u.segment<3>(i * 3) = rot * vertices[i] - vertices[i];
+    }
+    Vectord f(u.size());
+
+    state.counters["Elements"] = tetMesh->getNumCells();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        forceModel->getForceAndMatrix(u, f, K);
+    }
+}
+
+BENCHMARK(BM_FemAssembly)
+->Unit(benchmark::kMillisecond)
+->Name("FEM Force and Stiffness Assembly: Vega vs Native")
+->ArgsProduct({ { 10, 20 }, { 0, 1, 2, 3 }, { 0, 1 } });
+
+///
+/// \brief Conjugate gradient solve of a backward euler system M + dt^2 K of a twisted
+/// tet grid, for each ConjugateGradient::Preconditioner, with the assembled K (0) or
+/// the matrix-free product of the TetFemAssembler (1)
+///
+static void
+BM_FemConjugateGradient(benchmark::State& state)
+{
+    const int dim = static_cast<int>(state.range(0));
+    std::shared_ptr<TetrahedralMesh> tetMesh = GeometryUtils::toTetGrid(
+        Vec3d::Zero(), Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim));
+    const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+
+    TetFemAssembler assembler(vertices, *tetMesh->getCells(), TetFemAssembler::Material::StVK, 1.0e6, 0.45);
+    SparseMatrixd   K;
+    assembler.getTangentStiffnessMatrixTopology(K);
+    Vectord u(K.rows());
+    for (int i = 0; i < tetMesh->getNumVertices(); i++)
+    {
+        const Mat3d rot = Rotd(vertices[i][1] * 0.05, Vec3d(0.0, 1.0, 0.0)).toRotationMatrix();
+        u.segment<3>(i * 3) = rot * vertices[i] - vertices[i];
+    }
+    assembler.compute(u, nullptr, &K);
+    assembler.linearize(u);
+
+    // Lumped mass
+    const double  dt = 0.01;
+    SparseMatrixd M(K.rows(), K.cols());
+    M.setIdentity();
+    M *= 1.0e3 * 64.0 / K.rows();
+    const SparseMatrixd A = M + (dt * dt) * K;
+    const Vectord       b = Vectord::LinSpaced(A.rows(), -1.0, 1.0);
+
+    ConjugateGradient solver;
+    solver.setPreconditioner(static_cast<ConjugateGradient::Preconditioner>(state.range(1)));
+    solver.setMaxNumIterations(1000);
+    solver.setTolerance(1.0e-8);
+    if (state.range(2) != 0)
+    {
+        solver.setLinearOperator([&](const Vectord& x, Vectord& y)
+            {
+                assembler.multiplyTangentStiffness(x, y);
+                y *= dt * dt;
+                y.noalias() += M * x;
+            });
+    }
+    solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A, b));
+    Vectord x;
+
+    state.counters["DOFs"] = A.rows();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        solver.solve(x);
+    }
+    state.counters["Iterations"] = solver.getNumIterations();
+}
+
+BENCHMARK(BM_FemConjugateGradient)
+->Unit(benchmark::kMillisecond)
+->Name("FEM Conjugate Gradient: Preconditioners, Assembled vs Matrix-Free")
+->ArgsProduct({ { 10, 20 }, { 0, 1, 2, 3 }, { 0, 1 } });
+
+// Run the benchmark
+BENCHMARK_MAIN();
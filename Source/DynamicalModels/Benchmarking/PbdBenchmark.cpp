@@ -7,12 +7,17 @@
 #include "imstkCapsule.h"
 #include "imstkCollisionHandling.h"
 #include "imstkGeometry.h"
+#include "imstkGeometryUtilities.h"
 #include "imstkMath.h"
 #include "imstkMeshIO.h"
+#include "imstkPbdCollisionHandling.h"
+#include "imstkPbdConstraintContainer.h"
 #include "imstkPbdModel.h"
 #include "imstkPbdModelConfig.h"
 #include "imstkPbdObject.h"
+#include "imstkPbdObjectCellRemoval.h"
 #include "imstkPbdObjectCollision.h"
+#include "imstkPbdSolver.h"
 #include "imstkPointSetToCapsuleCD.h"
 #include "imstkPointwiseMap.h"
 #include "imstkRbdConstraint.h"
@@ -198,6 +203,87 @@ BENCHMARK(BM_DistanceVolume)
 ->Name("Distance and Volume Constraints: Tet Mesh")
 ->ArgsProduct({ { 4, 6, 8, 10, 16, 20 }, { 2, 5, 8 } });
 
+///
+/// \brief Compares solver iterations against substeps at equal cost, iterations x substeps
+/// stays 8. Distance+Volume constraints on a tet mesh hanging from its top. The volume
+/// error after 50 steps measures convergence
+///
+static void
+BM_DistanceVolumeSubsteps(benchmark::State& state)
+{
+    auto   scene = std::make_shared<Scene>("PbdBenchmark");
+    double dt    = 0.05;
+
+    auto prismObj = std::make_shared<PbdObject>("Prism");
+
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0),
+        Vec3i(state.range(0), state.range(0), state.range(0)),
+        Vec3d(0.0, 0.0, 0.0));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+    pbdParams->m_doPartitioning = false;
+    pbdParams->m_gravity     = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_dt          = dt;
+    pbdParams->m_numSubsteps = state.range(1);
+    pbdParams->m_iterations  = 8 / state.range(1);
+    pbdParams->m_linearDampingCoeff = 0.03;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+    prismObj->getPbdBody()->uniformMassValue = 0.05;
+    for (int z = 0; z < state.range(0); z++)
+    {
+        for (int x = 0; x < state.range(0); x++)
+        {
+            const int y = state.range(0) - 1;
+            prismObj->getPbdBody()->fixedNodeIds.push_back(x + state.range(0) * (y + state.range(0) * z));
+        }
+    }
+
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+
+    auto computeVolume = [&]()
+                         {
+                             const VecDataArray<double, 3>& vertices = *prismMesh->getVertexPositions();
+                             const VecDataArray<int, 4>&    indices  = *prismMesh->getCells();
+                             double                         volume   = 0.0;
+                             for (int i = 0; i < indices.size(); i++)
+                             {
+                                 volume += tetVolume(vertices[indices[i][0]], vertices[indices[i][1]],
+                                     vertices[indices[i][2]], vertices[indices[i][3]]);
+                             }
+                             return volume;
+                         };
+    const double initVolume = computeVolume();
+    for (int i = 0; i < 50; i++)
+    {
+        scene->advance(dt);
+    }
+
+    state.counters["DOFs"]        = state.range(0) * state.range(0) * state.range(0);
+    state.counters["Substeps"]    = state.range(1);
+    state.counters["Iterations"]  = 8 / state.range(1);
+    state.counters["VolumeError"] = std::abs(computeVolume() - initVolume) / initVolume;
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+    }
+}
+
+BENCHMARK(BM_DistanceVolumeSubsteps)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Volume Constraints: Iterations vs Substeps")
+->ArgsProduct({ { 8, 16 }, { 1, 2, 4, 8 } });
+
 ///
 /// \brief Time evolution step of PBD using distance+dihedral constraint on surface mesh
 ///
@@ -885,5 +971,227 @@ BENCHMARK(BM_PbdFemContact)
 ->Name("FEM Constraints with contact: Tet Mesh")
 ->ArgsProduct({ { 4, 6, 8, 10, 16, 20 }, { 2, 5, 8 } });
 
+///
+/// \brief Latency of removing cells, and their constraints, from a tet mesh with
+/// Distance+Volume constraints, optionally partitioned. Different cells spread
+/// over the mesh are removed on every apply
+///
+static void
+BM_PbdCellRemoval(benchmark::State& state)
+{
+    const int dim = static_cast<int>(state.range(0));
+
+    std::shared_ptr<PbdObject>       prismObj  = std::make_shared<PbdObject>("Prism");
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0),
+        Vec3i(dim, dim, dim),
+        Vec3d(0.0, 0.0, 0.0));
+
+    std::shared_ptr<PbdModelConfig> pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+    pbdParams->m_doPartitioning = (state.range(2) != 0);
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+    prismObj->getPbdBody()->uniformMassValue = 0.05;
+    prismObj->initialize();
+
+    auto remover = std::make_shared<PbdObjectCellRemoval>(prismObj, PbdObjectCellRemoval::OtherMeshUpdateType::None);
+    remover->initialize();
+    pbdModel->initialize();
+
+    state.counters["Tets"]            = prismMesh->getNumTetrahedra();
+    state.counters["Constraints"]     = static_cast<double>(pbdModel->getConstraints()->getNumConstraints());
+    state.counters["Cells Per Apply"] = state.range(1);
+    state.counters["Partitioned"]     = state.range(2);
+
+    // Visit the cells with a stride coprime to their count so removals are spread out
+    const int numCells    = prismMesh->getNumTetrahedra();
+    const int cellStride  = 7919;
+    int       cellCounter = 0;
+
+    // The first removal builds the constraint lookup, leave it out of the timing
+    remover->removeCellOnApply(cellCounter++);
+    remover->apply();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        for (int i = 0; i < state.range(1); i++)
+        {
+            remover->removeCellOnApply(static_cast<int>((static_cast<std::int64_t>(cellCounter++) * cellStride) % numCells));
+        }
+        remover->apply();
+    }
+}
+
+BENCHMARK(BM_PbdCellRemoval)
+->Unit(benchmark::kMicrosecond)
+->Name("Cell Removal: Tet Mesh")
+->Iterations(100)
+->ArgsProduct({ { 10, 20, 30 }, { 1, 16 }, { 0, 1 } });
+
+///
+/// \brief Latency of PbdCollisionHandling turning a large number of synthetic
+/// vertex-triangle and edge-edge contacts into constraints. The second object is
+/// either pbd simulated or static, in which case its vertices become virtual particles
+///
+static void
+BM_PbdCollisionHandling(benchmark::State& state)
+{
+    const int numContacts = static_cast<int>(state.range(0));
+    const int dim         = 100;
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    auto pbdModel  = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    std::shared_ptr<SurfaceMesh> meshA = GeometryUtils::toTriangleGrid(
+        Vec3d::Zero(), Vec2d(4.0, 4.0), Vec2i(dim, dim));
+    auto objA = std::make_shared<PbdObject>("ObjA");
+    objA->setPhysicsGeometry(meshA);
+    objA->setCollidingGeometry(meshA);
+    objA->setDynamicalModel(pbdModel);
+    objA->getPbdBody()->uniformMassValue = 0.05;
+    objA->initialize();
+
+    std::shared_ptr<SurfaceMesh> meshB = GeometryUtils::toTriangleGrid(
+        Vec3d(0.0, 0.1, 0.0), Vec2d(4.0, 4.0), Vec2i(dim, dim));
+    std::shared_ptr<CollidingObject> objB;
+    if (state.range(1) == 0)
+    {
+        auto pbdObjB = std::make_shared<PbdObject>("ObjB");
+        pbdObjB->setPhysicsGeometry(meshB);
+        pbdObjB->setDynamicalModel(pbdModel);
+        pbdObjB->getPbdBody()->uniformMassValue = 0.05;
+        objB = pbdObjB;
+    }
+    else
+    {
+        objB = std::make_shared<CollidingObject>("ObjB");
+    }
+    objB->setCollidingGeometry(meshB);
+    objB->initialize();
+    pbdModel->initialize();
+
+    // Alternate vertex-triangle and edge-edge contacts spread over the meshes
+    auto      colData      = std::make_shared<CollisionData>();
+    const int numVertices  = meshA->getNumVertices();
+    const int numTriangles = meshB->getNumCells();
+    const int stride       = 7919;
+    colData->geomA = meshA;
+    colData->geomB = meshB;
+    for (int i = 0; i < numContacts; i++)
+    {
+        const int        id = static_cast<int>((static_cast<std::int64_t>(i) * stride) % numVertices);
+        CellIndexElement elemA;
+        CellIndexElement elemB;
+        if (i % 2 == 0)
+        {
+            elemA.ids[0]   = id;
+            elemA.idCount  = 1;
+            elemA.cellType = IMSTK_VERTEX;
+            elemB.ids[0]   = id % numTriangles;
+            elemB.idCount  = 1;
+            elemB.cellType = IMSTK_TRIANGLE;
+        }
+        else
+        {
+            const int v0 = id % (numVertices - dim - 1);
+            elemA.ids[0]   = v0;
+            elemA.ids[1]   = v0 + 1;
+            elemA.idCount  = 2;
+            elemA.cellType = IMSTK_EDGE;
+            elemB.ids[0]   = v0;
+            elemB.ids[1]   = v0 + dim;
+            elemB.idCount  = 2;
+            elemB.cellType = IMSTK_EDGE;
+        }
+        colData->elementsA.push_back(elemA);
+        colData->elementsB.push_back(elemB);
+    }
+
+    auto handler = std::make_shared<PbdCollisionHandling>();
+    handler->setInputObjectA(objA);
+    handler->setInputObjectB(objB);
+    handler->setInputCollisionData(colData);
+
+    state.counters["Contacts"] = numContacts;
+    state.counters["Static B"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        handler->update();
+
+        // What the model does at the end of a step
+        pbdModel->getSolver()->clearConstraintLists();
+        pbdModel->clearVirtualParticles();
+    }
+}
+
+BENCHMARK(BM_PbdCollisionHandling)
+->Unit(benchmark::kMicrosecond)
+->Name("Collision Handling: Surface Mesh")
+->ArgsProduct({ { 1000, 5000, 20000 }, { 0, 1 } });
+
+///
+/// \brief Cost of taking (0) or restoring (1) a PbdModel snapshot of a triangle
+/// grid cloth, dim x dim particles. Items per second are particles per second
+///
+static void
+BM_PbdSnapshot(benchmark::State& state)
+{
+    const int dim = static_cast<int>(state.range(0));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    std::shared_ptr<SurfaceMesh> clothMesh = GeometryUtils::toTriangleGrid(
+        Vec3d::Zero(), Vec2d(4.0, 4.0), Vec2i(dim, dim));
+    auto clothObj = std::make_shared<PbdObject>("Cloth");
+    clothObj->setPhysicsGeometry(clothMesh);
+    clothObj->setDynamicalModel(pbdModel);
+    clothObj->getPbdBody()->uniformMassValue = 0.05;
+    clothObj->initialize();
+    pbdModel->initialize();
+
+    // Take every snapshot of the ring once so none allocates while timed
+    int id = 0;
+    for (int i = 0; i < pbdModel->getNumSnapshots(); i++)
+    {
+        id = pbdModel->takeSnapshot();
+    }
+
+    const int numParticles = clothMesh->getNumVertices();
+    state.counters["Particles"] = numParticles;
+    state.counters["Restore"]   = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+        {
+            benchmark::DoNotOptimize(pbdModel->takeSnapshot());
+        }
+        else
+        {
+            benchmark::DoNotOptimize(pbdModel->restoreSnapshot(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+
+BENCHMARK(BM_PbdSnapshot)
+->Unit(benchmark::kMicrosecond)
+->Name("Snapshot: Surface Mesh")
+->ArgsProduct({ { 100, 317, 1000 }, { 0, 1 } });
+
 // Run the benchmark
-BENCHMARK_MAIN();
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkProjectedGaussSeidelSolver.h"
+#include "imstkRbdContactConstraint.h"
+#include "imstkRigidBodyModel2.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Creates dim x dim columns of numLayers unit boxes stacked on the floor
+///
+std::shared_ptr<RigidBodyModel2>
+makeBoxPile(const int dim, const int numLayers, std::vector<std::shared_ptr<RigidBody>>& bodies)
+{
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_maxNumIterations = 10;
+    for (int z = 0; z < dim; z++)
+    {
+        for (int x = 0; x < dim; x++)
+        {
+            for (int y = 0; y < numLayers; y++)
+            {
+                std::shared_ptr<RigidBody> body = rbdModel->addRigidBody();
+                body->m_mass = 1.0;
+                body->m_intertiaTensor = Mat3d::Identity() / 6.0;
+                body->m_initPos = Vec3d(x * 1.1, y + 0.5, z * 1.1);
+                bodies.push_back(body);
+            }
+        }
+    }
+    rbdModel->initialize();
+    return rbdModel;
+}
+
+///
+/// \brief Adds a contact at every corner of the bottom face of every box, against
+/// the box below it or the floor
+///
+void
+addContacts(RigidBodyModel2& rbdModel, const std::vector<std::shared_ptr<RigidBody>>& bodies, const int numLayers)
+{
+    const Vec3d  n(0.0, 1.0, 0.0);
+    const double dt = rbdModel.getTimeStep();
+    for (size_t i = 0; i < bodies.size(); i++)
+    {
+        const bool                 onFloor = (i % numLayers == 0);
+        std::shared_ptr<RigidBody> below   = onFloor ? nullptr : bodies[i - 1];
+        const Vec3d&               pos     = bodies[i]->getPosition();
+        const double               bottom  = onFloor ? 0.0 : below->getPosition()[1] + 0.5;
+        const double               depth   = std::max(bottom - (pos[1] - 0.5), 0.0);
+        for (int corner = 0; corner < 4; corner++)
+        {
+            const Vec3d contactPt = pos + Vec3d((corner & 1) ? 0.5 : -0.5, -0.5, (corner & 2) ? 0.5 : -0.5);
+            auto        contact   = std::make_shared<RbdContactConstraint>(bodies[i], below, n, contactPt, depth, 0.05,
+                onFloor ? RbdConstraint::Side::A : RbdConstraint::Side::AB);
+            contact->compute(dt);
+            rbdModel.addConstraint(contact);
+        }
+    }
+}
+} // namespace
+
+///
+/// \brief Time per step of a pile of boxes resting on each other. The solver is
+/// assembled (0), assembled with graph coloring (1) or matrix free (2)
+///
+static void
+BM_RbdBoxPile(benchmark::State& state)
+{
+    const int                               dim       = static_cast<int>(state.range(0));
+    const int                               numLayers = 5;
+    std::vector<std::shared_ptr<RigidBody>> bodies;
+    std::shared_ptr<RigidBodyModel2>        rbdModel = makeBoxPile(dim, numLayers, bodies);
+    rbdModel->getConfig()->m_warmStart = (state.range(1) != 0);
+    rbdModel->getConfig()->m_useGraphColoring = (state.range(2) == 1);
+    rbdModel->getConfig()->m_matrixFree       = (state.range(2) == 2);
+
+    auto step = [&]()
+                {
+                    addContacts(*rbdModel, bodies, numLayers);
+                    rbdModel->computeTentativeVelocities();
+                    rbdModel->solveConstraints();
+                    rbdModel->integrate();
+                };
+
+    // Let the pile settle before timing
+    for (int i = 0; i < 100; i++)
+    {
+        step();
+    }
+
+    state.counters["Boxes"]          = static_cast<double>(bodies.size());
+    state.counters["Constraints"]    = static_cast<double>(bodies.size() * 4);
+    state.counters["Warm Start"]     = state.range(1);
+    state.counters["Solver"]         = state.range(2);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        step();
+    }
+
+    // Change of the solution in the last iteration, lower is better converged
+    if (!rbdModel->getConfig()->m_matrixFree)
+    {
+        state.counters["Energy"] = rbdModel->getSolver()->getEnergy();
+    }
+}
+
+BENCHMARK(BM_RbdBoxPile)
+->Unit(benchmark::kMillisecond)
+->Name("RBD Box Pile")
+->ArgsProduct({ { 5, 10 }, { 0, 1 }, { 0, 1, 2 } });
+
+BENCHMARK_MAIN();
\ No newline at end of file
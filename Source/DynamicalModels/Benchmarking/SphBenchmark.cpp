@@ -0,0 +1,122 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollidingObject.h"
+#include "imstkMath.h"
+#include "imstkPlane.h"
+#include "imstkPointSet.h"
+#include "imstkScene.h"
+#include "imstkSphModel.h"
+#include "imstkSphObject.h"
+#include "imstkSphObjectCollision.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates a column of fluid in the corner of a box, which collapses when simulated
+/// \param scene scene to add the fluid and box to
+/// \param dim number of particles along x and z, there are twice as many along y
+/// \param reorderInterval steps between particle reorderings, 0 to never reorder
+/// \param useFusedKernels whether to use the fused density and force kernels
+///
+static std::shared_ptr<SphObject>
+makeDamBreak(std::shared_ptr<Scene> scene, const int dim, const int reorderInterval, const bool useFusedKernels)
+{
+    const double particleRadius = 0.01;
+    const double spacing        = 2.0 * particleRadius;
+    auto         particlesPtr   = std::make_shared<VecDataArray<double, 3>>();
+    particlesPtr->reserve(2 * dim * dim * dim);
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < 2 * dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                particlesPtr->push_back(Vec3d(x + 0.5, y + 0.5, z + 0.5) * spacing);
+            }
+        }
+    }
+    auto fluidGeometry = std::make_shared<PointSet>();
+    fluidGeometry->initialize(particlesPtr);
+
+    auto sphParams = std::make_shared<SphModelConfig>(particleRadius);
+    sphParams->m_bNormalizeDensity = true;
+    sphParams->m_kernelOverParticleRadiusRatio = 4.0;
+    sphParams->m_reorderInterval = reorderInterval;
+    sphParams->m_useFusedKernels = useFusedKernels;
+
+    auto sphModel = std::make_shared<SphModel>();
+    sphModel->setModelGeometry(fluidGeometry);
+    sphModel->configure(sphParams);
+    sphModel->setTimeStepSizeType(TimeSteppingType::Fixed);
+    sphModel->setDefaultTimeStep(0.001);
+
+    auto fluidObj = std::make_shared<SphObject>("Fluid");
+    fluidObj->setCollidingGeometry(fluidGeometry);
+    fluidObj->setDynamicalModel(sphModel);
+    fluidObj->setPhysicsGeometry(fluidGeometry);
+    scene->addSceneObject(fluidObj);
+
+    // Floor and walls of a box three columns wide
+    const double width = dim * spacing;
+    const std::vector<std::pair<Vec3d, Vec3d>> walls =
+    {
+        { Vec3d(0.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0) },
+        { Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0) },
+        { Vec3d(0.0, 0.0, 0.0), Vec3d(0.0, 0.0, 1.0) },
+        { Vec3d(3.0 * width, 0.0, 0.0), Vec3d(-1.0, 0.0, 0.0) },
+        { Vec3d(0.0, 0.0, width), Vec3d(0.0, 0.0, -1.0) }
+    };
+    for (size_t i = 0; i < walls.size(); i++)
+    {
+        auto plane   = std::make_shared<Plane>(walls[i].first, walls[i].second);
+        auto wallObj = std::make_shared<CollidingObject>("Wall" + std::to_string(i));
+        wallObj->setCollidingGeometry(plane);
+        scene->addSceneObject(wallObj);
+        scene->addInteraction(std::make_shared<SphObjectCollision>(fluidObj, wallObj));
+    }
+
+    return fluidObj;
+}
+
+///
+/// \brief Time per step of an SPH dam break, after the column started collapsing
+///
+static void
+BM_SphDamBreak(benchmark::State& state)
+{
+    const int                  dim      = static_cast<int>(state.range(0));
+    auto                       scene    = std::make_shared<Scene>("SphBenchmark");
+    std::shared_ptr<SphObject> fluidObj = makeDamBreak(scene, dim, static_cast<int>(state.range(1)), state.range(2) != 0);
+    scene->initialize();
+
+    // Let the particles mix before timing
+    for (int i = 0; i < 50; i++)
+    {
+        scene->advance(0.001);
+    }
+
+    const int numParticles = fluidObj->getSphModel()->getCurrentState()->getPositions()->size();
+    state.counters["Particles"]        = numParticles;
+    state.counters["Reorder Interval"] = state.range(1);
+    state.counters["Fused Kernels"]    = state.range(2);
+    state.counters["Particles/s"]      = benchmark::Counter(numParticles, benchmark::Counter::kIsIterationInvariantRate);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(0.001);
+    }
+}
+
+BENCHMARK(BM_SphDamBreak)
+->Unit(benchmark::kMillisecond)
+->Name("SPH Dam Break")
+->ArgsProduct({ { 10, 20, 37 }, { 0, 10 }, { 0, 1 } });
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -21,11 +21,18 @@ CorotationalFemForceModel::CorotationalFemForceModel(std::shared_ptr<vega::Volum
 {
     auto tetMesh = std::dynamic_pointer_cast<vega::TetMesh>(mesh);
     m_corotationalLinearFem = std::make_shared<vega::CorotationalLinearFEM>(tetMesh.get());
+    setNativeAssemblySource(mesh,
+        (m_warp == 0) ? TetFemAssembler::Material::Linear : TetFemAssembler::Material::Corotational);
 }
 
 void
 CorotationalFemForceModel::getInternalForce(const Vectord& u, Vectord& internalForce)
 {
+    if (m_useNativeAssembly)
+    {
+        m_nativeAssembler->compute(u, &internalForce, nullptr);
+        return;
+    }
     double* data = const_cast<double*>(u.data());
     m_corotationalLinearFem->ComputeEnergyAndForceAndStiffnessMatrix(data, nullptr, internalForce.data(), nullptr, m_warp);
 }
@@ -33,6 +40,11 @@ CorotationalFemForceModel::getInternalForce(const Vectord& u, Vectord& internalF
 void
 CorotationalFemForceModel::getTangentStiffnessMatrix(const Vectord& u, SparseMatrixd& tangentStiffnessMatrix)
 {
+    if (m_useNativeAssembly)
+    {
+        m_nativeAssembler->compute(u, nullptr, &tangentStiffnessMatrix);
+        return;
+    }
     double* data = const_cast<double*>(u.data());
     m_corotationalLinearFem->ComputeEnergyAndForceAndStiffnessMatrix(data, nullptr, nullptr, m_vegaTangentStiffnessMatrix.get(), m_warp);
     InternalForceModel::updateValuesFromMatrix(m_vegaTangentStiffnessMatrix, tangentStiffnessMatrix.valuePtr());
@@ -47,6 +59,11 @@ CorotationalFemForceModel::getTangentStiffnessMatrixTopology(vega::SparseMatrix*
 void
 CorotationalFemForceModel::getForceAndMatrix(const Vectord& u, Vectord& internalForce, SparseMatrixd& tangentStiffnessMatrix)
 {
+    if (m_useNativeAssembly)
+    {
+        m_nativeAssembler->compute(u, &internalForce, &tangentStiffnessMatrix);
+        return;
+    }
     double* data = const_cast<double*>(u.data());
     m_corotationalLinearFem->ComputeEnergyAndForceAndStiffnessMatrix(data, nullptr, internalForce.data(), m_vegaTangentStiffnessMatrix.get(), m_warp);
     InternalForceModel::updateValuesFromMatrix(m_vegaTangentStiffnessMatrix, tangentStiffnessMatrix.valuePtr());
@@ -56,6 +73,11 @@ void
 CorotationalFemForceModel::setWarp(const int warp)
 {
     m_warp = warp;
+    m_nativeMaterial = (m_warp == 0) ? TetFemAssembler::Material::Linear : TetFemAssembler::Material::Corotational;
+    if (m_nativeAssembler != nullptr)
+    {
+        m_nativeAssembler->setMaterial(m_nativeMaterial);
+    }
 }
 
 void
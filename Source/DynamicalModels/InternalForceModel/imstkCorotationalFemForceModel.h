@@ -54,7 +54,8 @@ public:
     void getForceAndMatrix(const Vectord& u, Vectord& internalForce, SparseMatrixd& tangentStiffnessMatrix) override;
 
     ///
-    /// \brief Turn on/off warp
+    /// \brief Turn on/off warp. Native assembly treats any nonzero warp as 1, the stiffness omits
+    /// the derivative of the rotations
     ///
     void setWarp(const int warp);
 
@@ -5,6 +5,10 @@
 */
 
 #include "imstkInternalForceModel.h"
+#include "imstkLogger.h"
+#include "imstkVecDataArray.h"
+
+#include <volumetricMesh.h>
 
 namespace imstk
 {
@@ -36,4 +40,76 @@ InternalForceModel::getForceAndMatrix(const Vectord& u, Vectord& internalForce,
     this->getInternalForce(u, internalForce);
     this->getTangentStiffnessMatrix(u, tangentStiffnessMatrix);
 }
+
+void
+InternalForceModel::setUseNativeAssembly(const bool useNativeAssembly)
+{
+    if (useNativeAssembly && getNativeAssembler() == nullptr)
+    {
+        LOG(WARNING) << "Native assembly is not supported by this force model, using Vega";
+        return;
+    }
+    m_useNativeAssembly = useNativeAssembly;
+}
+
+std::shared_ptr<TetFemAssembler>
+InternalForceModel::getNativeAssembler()
+{
+    // Copying the mesh and coloring its elements is only worth it when assembling natively
+    if (m_nativeAssembler == nullptr && m_nativeMesh != nullptr)
+    {
+        m_nativeAssembler = createNativeAssembler(m_nativeMesh, m_nativeMaterial);
+        if (m_nativeAssembler == nullptr)
+        {
+            // Unsupported mesh, don't try again
+            m_nativeMesh = nullptr;
+        }
+    }
+    return m_nativeAssembler;
+}
+
+void
+InternalForceModel::setNativeAssemblySource(std::shared_ptr<vega::VolumetricMesh> mesh,
+                                            const TetFemAssembler::Material material)
+{
+    m_nativeMesh      = mesh;
+    m_nativeMaterial  = material;
+    m_nativeAssembler = nullptr;
+}
+
+std::shared_ptr<TetFemAssembler>
+InternalForceModel::createNativeAssembler(std::shared_ptr<vega::VolumetricMesh> mesh,
+                                          const TetFemAssembler::Material material)
+{
+    if (mesh->getNumElementVertices() != 4)
+    {
+        LOG(WARNING) << "Native assembly only supports tetrahedral meshes";
+        return nullptr;
+    }
+
+    VecDataArray<double, 3> vertices(mesh->getNumVertices());
+    for (int i = 0; i < mesh->getNumVertices(); i++)
+    {
+        const auto& pos = mesh->getVertex(i);
+        vertices[i] = Vec3d(pos[0], pos[1], pos[2]);
+    }
+    VecDataArray<int, 4> tets(mesh->getNumElements());
+    for (int i = 0; i < mesh->getNumElements(); i++)
+    {
+        tets[i] = Vec4i(mesh->getVertexIndex(i, 0), mesh->getVertexIndex(i, 1),
+            mesh->getVertexIndex(i, 2), mesh->getVertexIndex(i, 3));
+    }
+
+    // Default parameters of VegaMeshIO, overridden by the element materials
+    auto assembler = std::make_shared<TetFemAssembler>(vertices, tets, material, 1.0e7, 0.4);
+    for (int i = 0; i < mesh->getNumElements(); i++)
+    {
+        auto enuMaterial = dynamic_cast<const vega::VolumetricMesh::ENuMaterial*>(mesh->getElementMaterial(i));
+        if (enuMaterial != nullptr)
+        {
+            assembler->setElementMaterial(i, enuMaterial->getE(), enuMaterial->getNu());
+        }
+    }
+    return assembler;
+}
 } // namespace imstk
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include "imstkMath.h"
 #include "imstkInternalForceModelTypes.h"
+#include "imstkTetFemAssembler.h"
 
 #ifdef WIN32
 #pragma warning( push )
@@ -19,6 +20,11 @@
 #pragma warning( pop )
 #endif
 
+namespace vega
+{
+class VolumetricMesh;
+} // namespace vega
+
 namespace imstk
 {
 ///
@@ -63,5 +69,37 @@ public:
     /// \brief Specify tangent stiffness matrix
     ///
     virtual void setTangentStiffness(std::shared_ptr<vega::SparseMatrix> K) = 0;
+
+    ///
+    /// \brief Get/Set whether the force and stiffness are computed by the native parallel
+    /// TetFemAssembler instead of Vega, only for models that support it. Default false
+    ///@{
+    void setUseNativeAssembly(const bool useNativeAssembly);
+    bool getUseNativeAssembly() const { return m_useNativeAssembly; }
+    ///@}
+
+    ///
+    /// \brief Returns the native assembler, built on first use. Null if the model
+    /// doesn't support native assembly
+    ///
+    std::shared_ptr<TetFemAssembler> getNativeAssembler();
+
+protected:
+    ///
+    /// \brief Sets the mesh and material the native assembler is built from once
+    /// needed. Called on construction by the models supporting native assembly
+    ///
+    void setNativeAssemblySource(std::shared_ptr<vega::VolumetricMesh> mesh, const TetFemAssembler::Material material);
+
+    ///
+    /// \brief Creates a native assembler from a tetrahedral vega mesh and its element materials
+    ///
+    static std::shared_ptr<TetFemAssembler> createNativeAssembler(std::shared_ptr<vega::VolumetricMesh> mesh,
+                                                                  const TetFemAssembler::Material material);
+
+    std::shared_ptr<vega::VolumetricMesh> m_nativeMesh      = nullptr;                           ///< Null if native assembly is not supported
+    TetFemAssembler::Material             m_nativeMaterial  = TetFemAssembler::Material::Linear; ///< Material of the native assembler
+    std::shared_ptr<TetFemAssembler>      m_nativeAssembler = nullptr;                           ///< Built on first use
+    bool m_useNativeAssembly = false;
 };
 } // namespace imstk
\ No newline at end of file
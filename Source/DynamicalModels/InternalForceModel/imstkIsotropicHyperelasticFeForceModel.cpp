@@ -28,6 +28,7 @@ IsotropicHyperelasticFeForceModel::IsotropicHyperelasticFeForceModel(const Hyper
             tetMesh.get(),
             enableCompressionResistance,
             compressionResistance);
+        setNativeAssemblySource(mesh, TetFemAssembler::Material::StVK);
         break;
 
     case HyperElasticMaterialType::NeoHookean:
@@ -35,6 +36,7 @@ IsotropicHyperelasticFeForceModel::IsotropicHyperelasticFeForceModel(const Hyper
             tetMesh.get(),
             enableCompressionResistance,
             compressionResistance);
+        setNativeAssemblySource(mesh, TetFemAssembler::Material::NeoHookean);
         break;
 
     case HyperElasticMaterialType::MooneyRivlin:
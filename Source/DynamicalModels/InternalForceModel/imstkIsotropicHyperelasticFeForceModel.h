@@ -22,7 +22,9 @@ namespace imstk
 ///
 /// \class IsotropicHyperelasticFeForceModel
 ///
-/// \brief Force model for the isotropic hyperelastic material
+/// \brief Force model for the isotropic hyperelastic material. StVK and NeoHookean
+/// materials support native assembly, which neither handles inverted elements nor
+/// applies the compression resistance
 ///
 class IsotropicHyperelasticFeForceModel : public InternalForceModel
 {
@@ -40,6 +42,11 @@ public:
     ///
     inline void getInternalForce(const Vectord& u, Vectord& internalForce) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, &internalForce, nullptr);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_isotropicHyperelasticFem->ComputeForces(data, internalForce.data());
     }
@@ -49,6 +56,11 @@ public:
     ///
     inline void getTangentStiffnessMatrix(const Vectord& u, SparseMatrixd& tangentStiffnessMatrix) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, nullptr, &tangentStiffnessMatrix);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_isotropicHyperelasticFem->GetTangentStiffnessMatrix(data, m_vegaTangentStiffnessMatrix.get());
         InternalForceModel::updateValuesFromMatrix(m_vegaTangentStiffnessMatrix, tangentStiffnessMatrix.valuePtr());
@@ -67,6 +79,11 @@ public:
     ///
     inline void getForceAndMatrix(const Vectord& u, Vectord& internalForce, SparseMatrixd& tangentStiffnessMatrix) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, &internalForce, &tangentStiffnessMatrix);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_isotropicHyperelasticFem->GetForceAndTangentStiffnessMatrix(data, internalForce.data(), m_vegaTangentStiffnessMatrix.get());
         InternalForceModel::updateValuesFromMatrix(m_vegaTangentStiffnessMatrix, tangentStiffnessMatrix.valuePtr());
@@ -38,6 +38,8 @@ LinearFemForceModel::LinearFemForceModel(std::shared_ptr<vega::VolumetricMesh> m
     double* zero = (double*)calloc(m_stiffnessMatrix->GetNumRows(), sizeof(double));
     stVKStiffnessMatrix->ComputeStiffnessMatrix(zero, m_stiffnessMatrix.get());
     free(zero);
+
+    setNativeAssemblySource(mesh, TetFemAssembler::Material::Linear);
 };
 
 LinearFemForceModel::~LinearFemForceModel()
@@ -33,6 +33,11 @@ public:
     ///
     inline void getInternalForce(const Vectord& u, Vectord& internalForce) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, &internalForce, nullptr);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_stiffnessMatrix->MultiplyVector(data, internalForce.data());
     }
@@ -47,6 +52,11 @@ public:
     ///
     inline void getTangentStiffnessMatrix(const Vectord& u, SparseMatrixd& tangentStiffnessMatrix) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, nullptr, &tangentStiffnessMatrix);
+            return;
+        }
         InternalForceModel::updateValuesFromMatrix(m_stiffnessMatrix, tangentStiffnessMatrix.valuePtr());
     }
 
@@ -25,5 +25,6 @@ StvkForceModel::StvkForceModel(std::shared_ptr<vega::VolumetricMesh> mesh,
     vega::StVKElementABCD* precomputedIntegrals = vega::StVKElementABCDLoader::load(tetMesh.get());
     m_stVKInternalForces      = std::make_shared<vega::StVKInternalForces>(tetMesh.get(), precomputedIntegrals, withGravity, gravity);
     m_vegaStVKStiffnessMatrix = std::make_shared<vega::StVKStiffnessMatrix>(m_stVKInternalForces.get());
+    setNativeAssemblySource(mesh, TetFemAssembler::Material::StVK);
 }
 } // namespace imstk
\ No newline at end of file
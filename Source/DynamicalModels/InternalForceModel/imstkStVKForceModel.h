@@ -35,6 +35,11 @@ public:
     ///
     inline void getInternalForce(const Vectord& u, Vectord& internalForce) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, &internalForce, nullptr);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_stVKInternalForces->ComputeForces(data, internalForce.data());
     }
@@ -52,11 +57,29 @@ public:
     ///
     inline void getTangentStiffnessMatrix(const Vectord& u, SparseMatrixd& tangentStiffnessMatrix) override
     {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, nullptr, &tangentStiffnessMatrix);
+            return;
+        }
         double* data = const_cast<double*>(u.data());
         m_vegaStVKStiffnessMatrix->ComputeStiffnessMatrix(data, m_vegaTangentStiffnessMatrix.get());
         InternalForceModel::updateValuesFromMatrix(m_vegaTangentStiffnessMatrix, tangentStiffnessMatrix.valuePtr());
     }
 
+    ///
+    /// \brief Get the internal force and tangent stiffness matrix, in a single pass when natively assembled
+    ///
+    inline void getForceAndMatrix(const Vectord& u, Vectord& internalForce, SparseMatrixd& tangentStiffnessMatrix) override
+    {
+        if (m_useNativeAssembly)
+        {
+            m_nativeAssembler->compute(u, &internalForce, &tangentStiffnessMatrix);
+            return;
+        }
+        InternalForceModel::getForceAndMatrix(u, internalForce, tangentStiffnessMatrix);
+    }
+
     ///
     /// \brief Speficy tangent stiffness matrix
     ///
@@ -0,0 +1,444 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkTetFemAssembler.h"
+#include "imstkLogger.h"
+#include "imstkParallelFor.h"
+#include "imstkVecDataArray.h"
+
+#include <Eigen/SVD>
+
+namespace imstk
+{
+TetFemAssembler::TetFemAssembler(const VecDataArray<double, 3>& restVertices,
+                                 const VecDataArray<int, 4>& tets,
+                                 const Material material,
+                                 const double youngModulus,
+                                 const double poissonRatio) : m_material(material)
+{
+    const int numTets = tets.size();
+    m_tets.resize(numTets);
+    m_invRestShapes.resize(numTets);
+    m_volumes.resize(numTets);
+    m_mu.resize(numTets);
+    m_lambda.resize(numTets);
+
+    ParallelUtils::parallelFor(numTets, [&](const int i)
+        {
+            const Vec4i& tet = tets[i];
+            m_tets[i] = { tet[0], tet[1], tet[2], tet[3] };
+
+            Mat3d restShape;
+            restShape.col(0) = restVertices[tet[1]] - restVertices[tet[0]];
+            restShape.col(1) = restVertices[tet[2]] - restVertices[tet[0]];
+            restShape.col(2) = restVertices[tet[3]] - restVertices[tet[0]];
+            m_volumes[i] = std::abs(restShape.determinant()) / 6.0;
+            if (m_volumes[i] > 0.0)
+            {
+                m_invRestShapes[i] = restShape.inverse();
+            }
+            else
+            {
+                // Degenerate elements contribute nothing
+                m_invRestShapes[i] = Mat3d::Zero();
+            }
+            setElementMaterial(i, youngModulus, poissonRatio);
+        });
+
+    computeColors(restVertices.size());
+}
+
+void
+TetFemAssembler::setElementMaterial(const int elementId, const double youngModulus, const double poissonRatio)
+{
+    m_mu[elementId]     = youngModulus / (2.0 * (1.0 + poissonRatio));
+    m_lambda[elementId] = youngModulus * poissonRatio / ((1.0 + poissonRatio) * (1.0 - 2.0 * poissonRatio));
+}
+
+void
+TetFemAssembler::computeColors(const int numVertices)
+{
+    std::vector<std::vector<int>> vertexElements(numVertices);
+    for (int i = 0; i < getNumElements(); i++)
+    {
+        for (const int vertexId : m_tets[i])
+        {
+            vertexElements[vertexId].push_back(i);
+        }
+    }
+
+    // Greedily give each element the first color unused by its neighbors
+    std::vector<int> elementColors(m_tets.size(), -1);
+    std::vector<int> colorMarks; // Element that last marked the color as used
+    m_colors.clear();
+    for (int i = 0; i < getNumElements(); i++)
+    {
+        for (const int vertexId : m_tets[i])
+        {
+            for (const int neighborId : vertexElements[vertexId])
+            {
+                if (elementColors[neighborId] != -1)
+                {
+                    colorMarks[elementColors[neighborId]] = i;
+                }
+            }
+        }
+
+        int color = 0;
+        while (color < static_cast<int>(colorMarks.size()) && colorMarks[color] == i)
+        {
+            color++;
+        }
+        if (color == static_cast<int>(colorMarks.size()))
+        {
+            colorMarks.push_back(-1);
+            m_colors.emplace_back();
+        }
+        elementColors[i] = color;
+        m_colors[color].push_back(i);
+    }
+}
+
+void
+TetFemAssembler::getTangentStiffnessMatrixTopology(SparseMatrixd& tangentStiffnessMatrix) const
+{
+    int numDofs = 0;
+    for (const std::array<int, 4>& tet : m_tets)
+    {
+        for (const int vertexId : tet)
+        {
+            numDofs = std::max(numDofs, vertexId * 3 + 3);
+        }
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(m_tets.size() * 144);
+    for (const std::array<int, 4>& tet : m_tets)
+    {
+        for (int a = 0; a < 4; a++)
+        {
+            for (int b = 0; b < 4; b++)
+            {
+                for (int r = 0; r < 3; r++)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        triplets.emplace_back(tet[a] * 3 + r, tet[b] * 3 + c, 0.0);
+                    }
+                }
+            }
+        }
+    }
+
+    tangentStiffnessMatrix.resize(numDofs, numDofs);
+    tangentStiffnessMatrix.setFromTriplets(triplets.begin(), triplets.end());
+    tangentStiffnessMatrix.makeCompressed();
+}
+
+void
+TetFemAssembler::computeBlockOffsets(const SparseMatrixd& tangentStiffnessMatrix)
+{
+    CHECK(tangentStiffnessMatrix.isCompressed()) << "TetFemAssembler requires a compressed stiffness matrix";
+
+    const SparseMatrixd::StorageIndex* outerIndices = tangentStiffnessMatrix.outerIndexPtr();
+    const SparseMatrixd::StorageIndex* innerIndices = tangentStiffnessMatrix.innerIndexPtr();
+
+    m_blockOffsets.resize(m_tets.size() * 48);
+    ParallelUtils::parallelFor(getNumElements(), [&](const int i)
+        {
+            const std::array<int, 4>& tet = m_tets[i];
+            for (int a = 0; a < 4; a++)
+            {
+                for (int b = 0; b < 4; b++)
+                {
+                    const SparseMatrixd::StorageIndex col = tet[b] * 3;
+                    for (int r = 0; r < 3; r++)
+                    {
+                        const int row = tet[a] * 3 + r;
+                        const SparseMatrixd::StorageIndex* rowEnd = innerIndices + outerIndices[row + 1];
+                        const SparseMatrixd::StorageIndex* iter   = std::lower_bound(innerIndices + outerIndices[row], rowEnd, col);
+                        CHECK(rowEnd - iter >= 3 && iter[0] == col && iter[1] == col + 1 && iter[2] == col + 2)
+                            << "Stiffness matrix pattern is missing the block of vertices "
+                            << tet[a] << ", " << tet[b];
+                        m_blockOffsets[((i * 4 + a) * 4 + b) * 3 + r] = static_cast<int>(iter - innerIndices);
+                    }
+                }
+            }
+        });
+
+    m_patternNumRows     = tangentStiffnessMatrix.rows();
+    m_patternNumNonZeros = tangentStiffnessMatrix.nonZeros();
+}
+
+void
+TetFemAssembler::computeStress(const int elementId, const Mat3d& F, Mat3d& P, Mat9d* dPdF) const
+{
+    const double mu     = m_mu[elementId];
+    const double lambda = m_lambda[elementId];
+    const Mat3d  I      = Mat3d::Identity();
+
+    // Derivative of the stress, one column per entry of F
+    auto computeDerivative = [&](auto&& dStress)
+                             {
+                                 for (int q = 0; q < 9; q++)
+                                 {
+                                     Mat3d dF = Mat3d::Zero();
+                                     dF(q % 3, q / 3) = 1.0;
+                                     const Mat3d dP = dStress(dF);
+                                     dPdF->col(q) = Eigen::Map<const Eigen::Matrix<double, 9, 1>>(dP.data());
+                                 }
+                             };
+
+    switch (m_material)
+    {
+    case Material::Linear:
+    {
+        P = mu * (F + F.transpose() - 2.0 * I) + lambda * (F.trace() - 3.0) * I;
+        if (dPdF != nullptr)
+        {
+            computeDerivative([&](const Mat3d& dF) -> Mat3d
+                {
+                    return mu * (dF + dF.transpose()) + lambda * dF.trace() * I;
+                });
+        }
+        break;
+    }
+    case Material::Corotational:
+    {
+        // Rotation of the polar decomposition F = RS
+        Eigen::JacobiSVD<Mat3d> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        Mat3d                   U = svd.matrixU();
+        const Mat3d             V = svd.matrixV();
+        if ((U * V.transpose()).determinant() < 0.0)
+        {
+            U.col(2) *= -1.0;
+        }
+        const Mat3d R = U * V.transpose();
+        const Mat3d S = R.transpose() * F;
+
+        P = R * (mu * (S + S.transpose() - 2.0 * I) + lambda * (S.trace() - 3.0) * I);
+        if (dPdF != nullptr)
+        {
+            computeDerivative([&](const Mat3d& dF) -> Mat3d
+                {
+                    const Mat3d dS = R.transpose() * dF;
+                    return R * (mu * (dS + dS.transpose()) + lambda * dS.trace() * I);
+                });
+        }
+        break;
+    }
+    case Material::StVK:
+    {
+        const Mat3d E = 0.5 * (F.transpose() * F - I);
+        const Mat3d S = 2.0 * mu * E + lambda * E.trace() * I;
+        P = F * S;
+        if (dPdF != nullptr)
+        {
+            computeDerivative([&](const Mat3d& dF) -> Mat3d
+                {
+                    const Mat3d dE = 0.5 * (dF.transpose() * F + F.transpose() * dF);
+                    return dF * S + F * (2.0 * mu * dE + lambda * dE.trace() * I);
+                });
+        }
+        break;
+    }
+    case Material::NeoHookean:
+    {
+        const double J = F.determinant();
+        if (std::abs(J) < 1.0e-12)
+        {
+            P = Mat3d::Zero();
+            if (dPdF != nullptr)
+            {
+                dPdF->setZero();
+            }
+            break;
+        }
+        const Mat3d  invF  = F.inverse();
+        const Mat3d  invFT = invF.transpose();
+        const double logJ  = std::log(std::max(J, 1.0e-6));
+
+        P = mu * (F - invFT) + lambda * logJ * invFT;
+        if (dPdF != nullptr)
+        {
+            computeDerivative([&](const Mat3d& dF) -> Mat3d
+                {
+                    return mu * dF + (mu - lambda * logJ) * invFT * dF.transpose() * invFT
+                           + lambda * (invF * dF).trace() * invFT;
+                });
+        }
+        break;
+    }
+    }
+}
+
+void
+TetFemAssembler::computeShapeGradients(const int elementId, std::array<Vec3d, 4>& grads) const
+{
+    const Mat3d& invDm = m_invRestShapes[elementId];
+    grads[1] = invDm.row(0).transpose();
+    grads[2] = invDm.row(1).transpose();
+    grads[3] = invDm.row(2).transpose();
+    grads[0] = -(grads[1] + grads[2] + grads[3]);
+}
+
+Mat3d
+TetFemAssembler::computeDeformationGradient(const int elementId, const std::array<Vec3d, 4>& grads, const Vectord& u) const
+{
+    // Identity plus the gradient of the displacement
+    const std::array<int, 4>& tet = m_tets[elementId];
+    Mat3d                     F   = Mat3d::Identity();
+    for (int a = 0; a < 4; a++)
+    {
+        F += u.segment<3>(tet[a] * 3) * grads[a].transpose();
+    }
+    return F;
+}
+
+void
+TetFemAssembler::computeElement(const int elementId, const Vectord& u, Vec12d& f, Mat12d* K) const
+{
+    const double volume = m_volumes[elementId];
+
+    std::array<Vec3d, 4> grads;
+    computeShapeGradients(elementId, grads);
+    const Mat3d F = computeDeformationGradient(elementId, grads, u);
+
+    Mat3d P;
+    Mat9d dPdF;
+    computeStress(elementId, F, P, (K != nullptr) ? &dPdF : nullptr);
+
+    for (int a = 0; a < 4; a++)
+    {
+        f.segment<3>(a * 3) = volume * P * grads[a];
+    }
+
+    if (K != nullptr)
+    {
+        for (int b = 0; b < 4; b++)
+        {
+            for (int l = 0; l < 3; l++)
+            {
+                // Change of stress for a unit displacement of dof l of vertex b
+                Eigen::Matrix<double, 9, 1> dPVec = Eigen::Matrix<double, 9, 1>::Zero();
+                for (int m = 0; m < 3; m++)
+                {
+                    dPVec += dPdF.col(l + 3 * m) * grads[b][m];
+                }
+                const Eigen::Map<const Mat3d> dP(dPVec.data());
+                for (int a = 0; a < 4; a++)
+                {
+                    K->block<3, 1>(a * 3, b * 3 + l) = volume * dP * grads[a];
+                }
+            }
+        }
+    }
+}
+
+void
+TetFemAssembler::compute(const Vectord& u, Vectord* internalForce, SparseMatrixd* tangentStiffnessMatrix)
+{
+    if (internalForce != nullptr)
+    {
+        internalForce->resize(u.size());
+        internalForce->setZero();
+    }
+    double* values = nullptr;
+    if (tangentStiffnessMatrix != nullptr)
+    {
+        if (tangentStiffnessMatrix->rows() != m_patternNumRows
+            || tangentStiffnessMatrix->nonZeros() != m_patternNumNonZeros)
+        {
+            computeBlockOffsets(*tangentStiffnessMatrix);
+        }
+        values = tangentStiffnessMatrix->valuePtr();
+        std::fill_n(values, tangentStiffnessMatrix->nonZeros(), 0.0);
+    }
+
+    // Elements of a color share no vertex, they scatter without synchronization
+    for (const std::vector<int>& color : m_colors)
+    {
+        ParallelUtils::parallelFor(color.size(), [&](const size_t i)
+            {
+                const int elementId = color[i];
+                Vec12d    f;
+                Mat12d    K;
+                computeElement(elementId, u, f, (values != nullptr) ? &K : nullptr);
+
+                const std::array<int, 4>& tet = m_tets[elementId];
+                if (internalForce != nullptr)
+                {
+                    for (int a = 0; a < 4; a++)
+                    {
+                        internalForce->segment<3>(tet[a] * 3) += f.segment<3>(a * 3);
+                    }
+                }
+                if (values != nullptr)
+                {
+                    const int* offsets = &m_blockOffsets[elementId * 48];
+                    for (int a = 0; a < 4; a++)
+                    {
+                        for (int b = 0; b < 4; b++)
+                        {
+                            for (int r = 0; r < 3; r++)
+                            {
+                                double* rowValues = values + offsets[(a * 4 + b) * 3 + r];
+                                rowValues[0] += K(a * 3 + r, b * 3);
+                                rowValues[1] += K(a * 3 + r, b * 3 + 1);
+                                rowValues[2] += K(a * 3 + r, b * 3 + 2);
+                            }
+                        }
+                    }
+                }
+            });
+    }
+}
+
+void
+TetFemAssembler::linearize(const Vectord& u)
+{
+    m_dPdFs.resize(m_tets.size());
+    ParallelUtils::parallelFor(getNumElements(), [&](const int i)
+        {
+            std::array<Vec3d, 4> grads;
+            computeShapeGradients(i, grads);
+            Mat3d P;
+            computeStress(i, computeDeformationGradient(i, grads, u), P, &m_dPdFs[i]);
+        });
+}
+
+void
+TetFemAssembler::multiplyTangentStiffness(const Vectord& x, Vectord& y) const
+{
+    CHECK(m_dPdFs.size() == m_tets.size()) << "TetFemAssembler::linearize must be called before multiplying";
+
+    y.setZero(x.size());
+    for (const std::vector<int>& color : m_colors)
+    {
+        ParallelUtils::parallelFor(color.size(), [&](const size_t i)
+            {
+                const int                 elementId = color[i];
+                const std::array<int, 4>& tet       = m_tets[elementId];
+                std::array<Vec3d, 4>      grads;
+                computeShapeGradients(elementId, grads);
+
+                // Change of the deformation gradient and stress along x
+                Mat3d dF = Mat3d::Zero();
+                for (int a = 0; a < 4; a++)
+                {
+                    dF += x.segment<3>(tet[a] * 3) * grads[a].transpose();
+                }
+                const Eigen::Matrix<double, 9, 1> dPVec = m_dPdFs[elementId] * Eigen::Map<const Eigen::Matrix<double, 9, 1>>(dF.data());
+                const Eigen::Map<const Mat3d>     dP(dPVec.data());
+
+                for (int a = 0; a < 4; a++)
+                {
+                    y.segment<3>(tet[a] * 3) += m_volumes[elementId] * dP * grads[a];
+                }
+            });
+    }
+}
+} // namespace imstk
@@ -0,0 +1,145 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <array>
+
+namespace imstk
+{
+template<typename T, int N> class VecDataArray;
+
+///
+/// \class TetFemAssembler
+///
+/// \brief Native assembly of the internal force and tangent stiffness of linear
+/// tetrahedral finite elements. Elements are computed in parallel, they are colored
+/// such that no two elements of a color share a vertex so each color scatters its
+/// contributions without synchronization. The stiffness is written directly into
+/// the values of a preallocated row major matrix.
+///
+/// Follows Vega's conventions: the internal force is the gradient of the elastic
+/// energy wrt the displacement, the stiffness its hessian. Gravity is not included.
+///
+class TetFemAssembler
+{
+public:
+    ///
+    /// \brief Constitutive model of the elements
+    ///
+    enum class Material
+    {
+        Linear,       ///< Linear elasticity (small strain)
+        Corotational, ///< Linear elasticity in the rotated frame of the element, stiffness omits the rotation derivative
+        StVK,         ///< Saint Venant-Kirchhoff
+        NeoHookean    ///< Compressible neo-hookean, inverted elements are not handled
+    };
+
+    TetFemAssembler(const VecDataArray<double, 3>& restVertices,
+                    const VecDataArray<int, 4>& tets,
+                    const Material material,
+                    const double youngModulus,
+                    const double poissonRatio);
+    virtual ~TetFemAssembler() = default;
+
+    ///
+    /// \brief Get/Set the constitutive model
+    ///@{
+    void setMaterial(const Material material) { m_material = material; }
+    Material getMaterial() const { return m_material; }
+    ///@}
+
+    ///
+    /// \brief Set the elastic parameters of an element
+    ///
+    void setElementMaterial(const int elementId, const double youngModulus, const double poissonRatio);
+
+    int getNumElements() const { return static_cast<int>(m_tets.size()); }
+
+    ///
+    /// \brief Returns the number of colors, ie: the number of sequential parallel passes
+    ///
+    int getNumColors() const { return static_cast<int>(m_colors.size()); }
+
+    ///
+    /// \brief Builds the stiffness matrix pattern, full 3x3 blocks for every pair of vertices
+    /// sharing an element
+    ///
+    void getTangentStiffnessMatrixTopology(SparseMatrixd& tangentStiffnessMatrix) const;
+
+    ///
+    /// \brief Computes the internal force and/or the tangent stiffness at displacement \p u,
+    /// either output may be null. The values of \p tangentStiffnessMatrix are overwritten, its
+    /// pattern must be compressed and contain the pattern of getTangentStiffnessMatrixTopology
+    ///
+    void compute(const Vectord& u, Vectord* internalForce, SparseMatrixd* tangentStiffnessMatrix);
+
+    ///
+    /// \brief Caches the stress derivatives of the elements at displacement \p u,
+    /// the linearization used by multiplyTangentStiffness
+    ///
+    void linearize(const Vectord& u);
+
+    ///
+    /// \brief Computes y = Kx without assembling K, the tangent stiffness at the
+    /// displacement of the last linearize
+    ///
+    void multiplyTangentStiffness(const Vectord& x, Vectord& y) const;
+
+protected:
+    using Vec12d = Eigen::Matrix<double, 12, 1>;
+    using Mat12d = Eigen::Matrix<double, 12, 12>;
+    using Mat9d  = Eigen::Matrix<double, 9, 9>;
+
+    ///
+    /// \brief Computes the gradients of the shape functions of an element
+    ///
+    void computeShapeGradients(const int elementId, std::array<Vec3d, 4>& grads) const;
+
+    ///
+    /// \brief Computes the deformation gradient of an element at displacement \p u
+    ///
+    Mat3d computeDeformationGradient(const int elementId, const std::array<Vec3d, 4>& grads, const Vectord& u) const;
+
+    ///
+    /// \brief Greedy coloring of the elements
+    ///
+    void computeColors(const int numVertices);
+
+    ///
+    /// \brief Computes the offsets of the element blocks in the values of the matrix
+    ///
+    void computeBlockOffsets(const SparseMatrixd& tangentStiffnessMatrix);
+
+    ///
+    /// \brief Computes the first Piola-Kirchhoff stress of element \p elementId at deformation gradient
+    /// \p F and, if \p dPdF not null, its derivative wrt F (column major flattening)
+    ///
+    void computeStress(const int elementId, const Mat3d& F, Mat3d& P, Mat9d* dPdF) const;
+
+    ///
+    /// \brief Computes the force and/or stiffness of an element
+    ///
+    void computeElement(const int elementId, const Vectord& u, Vec12d& f, Mat12d* K) const;
+
+    Material m_material;
+
+    std::vector<std::array<int, 4>> m_tets;
+    StdVectorOfMat3d    m_invRestShapes; ///< Inverse of the rest edge matrix per element
+    std::vector<double> m_volumes;
+    std::vector<double> m_mu;            ///< Lame's second parameter per element
+    std::vector<double> m_lambda;        ///< Lame's first parameter per element
+
+    std::vector<std::vector<int>> m_colors;        ///< Elements per color
+    std::vector<int>      m_blockOffsets;          ///< Value offset of each block row, 48 per element
+    SparseMatrixd::Index  m_patternNumRows = -1;   ///< Pattern the offsets were computed for
+    SparseMatrixd::Index  m_patternNumNonZeros = -1;
+
+    std::vector<Mat9d, Eigen::aligned_allocator<Mat9d>> m_dPdFs; ///< Stress derivatives per element of the last linearize
+};
+} // namespace imstk
@@ -13,6 +13,7 @@
 #include "imstkNewtonSolver.h"
 #include "imstkPointSet.h"
 #include "imstkTaskGraph.h"
+#include "imstkTetFemAssembler.h"
 #include "imstkTimeIntegrator.h"
 #include "imstkTypes.h"
 #include "imstkVecDataArray.h"
@@ -161,6 +162,7 @@ FemDeformableBodyModel::initialize()
 
         // Create a linear solver
         auto linSolver = std::make_shared<ConjugateGradient>();
+        linSolver->setWarmStart(m_FEModelConfig->m_warmStart);
 
         if (linSolver->getType() == imstk::LinearSolver<imstk::SparseMatrixd>::Type::GaussSeidel
             && isFixedBCImplemented())
@@ -172,10 +174,22 @@ FemDeformableBodyModel::initialize()
         auto nlSolver = std::make_shared<NewtonSolver<SparseMatrixd>>();
         nlSolver->setToSemiImplicit();
         nlSolver->setLinearSolver(linSolver);
+        nlSolver->setUseModifiedNewton(m_FEModelConfig->m_useModifiedNewton);
+        nlSolver->setMaxJacobianAge(m_FEModelConfig->m_maxJacobianAge);
+        nlSolver->setForcingTermPolicy(m_FEModelConfig->m_forcingTermPolicy);
+        nlSolver->setForcingTerm(m_FEModelConfig->m_forcingTerm);
         nlSolver->setSystem(nlSystem);
         setSolver(nlSolver);
     }
 
+    if (m_FEModelConfig->m_dataTracker)
+    {
+        m_solver->m_dataTracker = m_FEModelConfig->m_dataTracker;
+        m_FEModelConfig->m_dataTracker->configureProbe(DataTracker::Physics::SolverTime_ms, DataTracker::ePhysics::SolverTime_ms);
+        m_FEModelConfig->m_dataTracker->configureProbe(DataTracker::Physics::NumIterations, DataTracker::ePhysics::NumIterations);
+        m_FEModelConfig->m_dataTracker->configureProbe(DataTracker::Physics::NumJacobianUpdates, DataTracker::ePhysics::NumJacobianUpdates);
+    }
+
     auto physicsMesh = std::dynamic_pointer_cast<AbstractCellMesh>(this->getModelGeometry());
     m_vegaPhysicsMesh = VegaMeshIO::convertVolumetricMeshToVegaMesh(physicsMesh);
     //m_vegaPhysicsMesh = physicsMesh->getAttachedVegaMesh();
@@ -190,6 +204,11 @@ FemDeformableBodyModel::initialize()
         return false;
     }
 
+    if (m_FEModelConfig->m_useMatrixFreeStiffness)
+    {
+        this->initializeMatrixFreeStiffness();
+    }
+
     this->loadInitialStates();
 
     m_Feff.resize(m_numDof);
@@ -311,6 +330,11 @@ FemDeformableBodyModel::initializeForceModel()
         return false;
     }   //switch
 
+    if (m_FEModelConfig->m_useNativeAssembly)
+    {
+        m_internalForceModel->setUseNativeAssembly(true);
+    }
+
     return true;
 }
 
@@ -447,12 +471,12 @@ FemDeformableBodyModel::computeImplicitSystemRHS(kinematicState&       stateAtT,
     {
     case StateUpdateType::DeltaVelocity:
 
-        m_internalForceModel->getTangentStiffnessMatrix(u, m_K);
-        m_Feff = m_K * -(uPrev - u + v * dT);
+        this->updateTangentStiffness(u);
+        m_Feff = multiplyTangentStiffness(-(uPrev - u + v * dT));
 
         if (m_damped)
         {
-            m_Feff -= m_C * v;
+            m_Feff -= multiplyDamping(v);
         }
 
         m_internalForceModel->getInternalForce(u, m_Finternal);
@@ -480,18 +504,18 @@ FemDeformableBodyModel::computeSemiImplicitSystemRHS(kinematicState&       state
     //auto& v     = newState.getQDot();
 
     // Do checks if there are uninitialized matrices
-    m_internalForceModel->getTangentStiffnessMatrix(u, m_K);
+    this->updateTangentStiffness(u);
     const double dT = m_timeIntegrator->getTimestepSize();
 
     switch (updateType)
     {
     case StateUpdateType::DeltaVelocity:
 
-        m_Feff = m_K * (vPrev * -dT);
+        m_Feff = multiplyTangentStiffness(vPrev * -dT);
 
         if (m_damped)
         {
-            m_Feff -= m_C * vPrev;
+            m_Feff -= multiplyDamping(vPrev);
         }
 
         m_internalForceModel->getInternalForce(u, m_Finternal);
@@ -519,7 +543,7 @@ FemDeformableBodyModel::computeImplicitSystemLHS(const kinematicState& imstkNotU
     {
     case StateUpdateType::DeltaVelocity:
         this->updateMassMatrix();
-        m_internalForceModel->getTangentStiffnessMatrix(newState.getQ(), m_K);
+        this->updateTangentStiffness(newState.getQ());
         this->updateDampingMatrix();
 
         m_Keff = m_M;
@@ -527,7 +551,10 @@ FemDeformableBodyModel::computeImplicitSystemLHS(const kinematicState& imstkNotU
         {
             m_Keff += dT * m_C;
         }
-        m_Keff += (dT * dT) * m_K;
+        if (m_matrixFreeAssembler == nullptr)
+        {
+            m_Keff += (dT * dT) * m_K;
+        }
 
         break;
 
@@ -549,7 +576,7 @@ FemDeformableBodyModel::computeSemiImplicitSystemRHSAndLHS(kinematicState&
     case StateUpdateType::DeltaVelocity:
         // LHS
         this->updateMassMatrix();
-        m_internalForceModel->getForceAndMatrix(newState.getQ(), m_Finternal, m_K);
+        this->updateForceAndTangentStiffness(newState.getQ());
         this->updateDampingMatrix();
 
         m_Keff = m_M;
@@ -557,14 +584,17 @@ FemDeformableBodyModel::computeSemiImplicitSystemRHSAndLHS(kinematicState&
         {
             m_Keff += dT * m_C;
         }
-        m_Keff += (dT * dT) * m_K;
+        if (m_matrixFreeAssembler == nullptr)
+        {
+            m_Keff += (dT * dT) * m_K;
+        }
 
         // RHS
-        m_Feff = m_K * (vPrev * -dT);
+        m_Feff = multiplyTangentStiffness(vPrev * -dT);
 
         if (m_damped)
         {
-            m_Feff -= m_C * vPrev;
+            m_Feff -= multiplyDamping(vPrev);
         }
 
         m_Feff -= m_Finternal;
@@ -596,7 +626,7 @@ FemDeformableBodyModel::computeImplicitSystemRHSAndLHS(kinematicState&       sta
     case StateUpdateType::DeltaVelocity:
         // LHS
         this->updateMassMatrix();
-        m_internalForceModel->getForceAndMatrix(u, m_Finternal, m_K);
+        this->updateForceAndTangentStiffness(u);
         this->updateDampingMatrix();
 
         m_Keff = m_M;
@@ -604,14 +634,17 @@ FemDeformableBodyModel::computeImplicitSystemRHSAndLHS(kinematicState&       sta
         {
             m_Keff += dT * m_C;
         }
-        m_Keff += (dT * dT) * m_K;
+        if (m_matrixFreeAssembler == nullptr)
+        {
+            m_Keff += (dT * dT) * m_K;
+        }
 
         // RHS
-        m_Feff = m_K * -(uPrev - u + v * dT);
+        m_Feff = multiplyTangentStiffness(-(uPrev - u + v * dT));
 
         if (m_damped)
         {
-            m_Feff -= m_C * v;
+            m_Feff -= multiplyDamping(v);
         }
 
         m_Feff -= m_Finternal;
@@ -648,18 +681,126 @@ FemDeformableBodyModel::updateDampingMatrix()
         {
             m_C = dampingMassCoefficient * m_M;
 
-            if (dampingStiffnessCoefficient > 0)
+            if (dampingStiffnessCoefficient > 0 && m_matrixFreeAssembler == nullptr)
             {
                 m_C += m_K * dampingStiffnessCoefficient;
             }
         }
         else if (dampingStiffnessCoefficient > 0)
         {
-            m_C = m_K * dampingStiffnessCoefficient;
+            if (m_matrixFreeAssembler == nullptr)
+            {
+                m_C = m_K * dampingStiffnessCoefficient;
+            }
+            else
+            {
+                // Keeps the pattern of Keff
+                m_C = 0.0 * m_M;
+            }
         }
     }
 }
 
+void
+FemDeformableBodyModel::updateTangentStiffness(const Vectord& u)
+{
+    if (m_matrixFreeAssembler != nullptr)
+    {
+        m_matrixFreeAssembler->linearize(u);
+    }
+    else
+    {
+        m_internalForceModel->getTangentStiffnessMatrix(u, m_K);
+    }
+}
+
+void
+FemDeformableBodyModel::updateForceAndTangentStiffness(const Vectord& u)
+{
+    if (m_matrixFreeAssembler != nullptr)
+    {
+        m_internalForceModel->getInternalForce(u, m_Finternal);
+        m_matrixFreeAssembler->linearize(u);
+    }
+    else
+    {
+        m_internalForceModel->getForceAndMatrix(u, m_Finternal, m_K);
+    }
+}
+
+Vectord
+FemDeformableBodyModel::multiplyTangentStiffness(const Vectord& x) const
+{
+    if (m_matrixFreeAssembler == nullptr)
+    {
+        return m_K * x;
+    }
+    Vectord y;
+    m_matrixFreeAssembler->multiplyTangentStiffness(x, y);
+    return y;
+}
+
+Vectord
+FemDeformableBodyModel::multiplyDamping(const Vectord& x) const
+{
+    if (m_matrixFreeAssembler == nullptr)
+    {
+        return m_C * x;
+    }
+
+    // m_C only holds the mass part
+    const double dampingStiffnessCoefficient = m_FEModelConfig->m_dampingStiffnessCoefficient;
+    Vectord      y = m_C * x;
+    if (dampingStiffnessCoefficient > 0)
+    {
+        y += dampingStiffnessCoefficient * multiplyTangentStiffness(x);
+    }
+    return y;
+}
+
+void
+FemDeformableBodyModel::multiplyEffectiveStiffness(const Vectord& x, Vectord& y)
+{
+    // Keff = M + dT * C + dT^2 * K, only the mass parts are assembled
+    const double dT = m_timeIntegrator->getTimestepSize();
+    double       stiffnessScale = dT * dT;
+    if (m_damped && m_FEModelConfig->m_dampingStiffnessCoefficient > 0)
+    {
+        stiffnessScale += dT * m_FEModelConfig->m_dampingStiffnessCoefficient;
+    }
+
+    m_matrixFreeInput = x;
+    if (m_implementFixedBC)
+    {
+        applyBoundaryConditions(m_matrixFreeInput);
+    }
+    m_matrixFreeAssembler->multiplyTangentStiffness(m_matrixFreeInput, y);
+    if (m_implementFixedBC)
+    {
+        applyBoundaryConditions(y);
+    }
+    y *= stiffnessScale;
+    y.noalias() += m_Keff * x;
+}
+
+void
+FemDeformableBodyModel::initializeMatrixFreeStiffness()
+{
+    auto nlSolver = std::dynamic_pointer_cast<NewtonSolver<SparseMatrixd>>(m_solver);
+    auto cgSolver = nlSolver ? std::dynamic_pointer_cast<ConjugateGradient>(nlSolver->getLinearSolver()) : nullptr;
+    if (!m_internalForceModel->getUseNativeAssembly() || cgSolver == nullptr)
+    {
+        LOG(WARNING) << "Matrix-free stiffness requires native assembly and a ConjugateGradient solver, assembling the stiffness";
+        return;
+    }
+
+    m_matrixFreeAssembler = m_internalForceModel->getNativeAssembler();
+    cgSolver->setLinearOperator([this](const Vectord& x, Vectord& y)
+        {
+            multiplyEffectiveStiffness(x, y);
+        });
+}
+
 void
 FemDeformableBodyModel::applyBoundaryConditions(SparseMatrixd& M, const bool withCompliance) const
 {
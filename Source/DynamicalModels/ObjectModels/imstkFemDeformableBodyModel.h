@@ -9,6 +9,7 @@
 #include "imstkDynamicalModel.h"
 #include "imstkInternalForceModelTypes.h"
 #include "imstkVectorizedState.h"
+#include "imstkNewtonSolver.h"
 #include "imstkNonLinearSystem.h"
 
 #include <sparseMatrix.h>
@@ -23,6 +24,7 @@ namespace imstk
 class InternalForceModel;
 class TimeIntegrator;
 class SolverBase;
+class TetFemAssembler;
 class VegaMeshIO;
 template<typename T, int N> class VecDataArray;
 
@@ -47,6 +49,22 @@ struct FemModelConfig
     double m_compressionResistance       = 500.0;
     double m_inversionThreshold = -std::numeric_limits<double>::max();
     double m_gravity = 9.81;
+
+    // Compute the internal force and stiffness with the parallel TetFemAssembler instead of Vega
+    bool m_useNativeAssembly = false;
+
+    // Never assemble the tangent stiffness, the ConjugateGradient solver multiplies it element
+    // by element. Requires native assembly and a ConjugateGradient linear solver
+    bool m_useMatrixFreeStiffness = false;
+
+    // Newton iterations of the default solver, see NewtonSolver
+    bool   m_useModifiedNewton = false; // Reuse the Jacobian across iterations and frames
+    size_t m_maxJacobianAge    = 10;
+    ForcingTermPolicy m_forcingTermPolicy = ForcingTermPolicy::None;
+    double m_forcingTerm = 0.9;
+    bool   m_warmStart   = false;       // Start the linear solves from the last increment
+
+    std::shared_ptr<DataTracker> m_dataTracker; // Tracks the solver time, iterations and Jacobian updates
 };
 
 ///
@@ -174,6 +192,32 @@ public:
     ///
     void updateDampingMatrix();
 
+    ///
+    /// \brief Updates the tangent stiffness, and the internal force for the second, at
+    /// displacement \p u. Only linearizes the elements when matrix-free
+    ///@{
+    void updateTangentStiffness(const Vectord& u);
+    void updateForceAndTangentStiffness(const Vectord& u);
+    ///@}
+
+    ///
+    /// \brief Returns the product of the tangent stiffness/damping matrix with \p x
+    ///@{
+    Vectord multiplyTangentStiffness(const Vectord& x) const;
+    Vectord multiplyDamping(const Vectord& x) const;
+    ///@}
+
+    ///
+    /// \brief Computes y = Keff x when matrix-free, the assembled mass and damping
+    /// part of Keff plus the unassembled stiffness part
+    ///
+    void multiplyEffectiveStiffness(const Vectord& x, Vectord& y);
+
+    ///
+    /// \brief Sets the matrix-free product as the operator of the linear solver
+    ///
+    void initializeMatrixFreeStiffness();
+
     ///
     /// \brief Applies boundary conditions to matrix and a vector
     ///
@@ -297,6 +341,9 @@ protected:
     SparseMatrixd m_K;                                                            ///< Tangent (derivative of internal force w.r.t displacements) stiffness matrix
     SparseMatrixd m_Keff;                                                         ///< Effective stiffness matrix (dependent on internal force model and time integrator)
 
+    std::shared_ptr<TetFemAssembler> m_matrixFreeAssembler = nullptr;             ///< Multiplies the stiffness when matrix-free, null otherwise
+    Vectord m_matrixFreeInput;                                                    ///< Input of the matrix-free product with boundary conditions
+
     Vectord m_Finternal;                                                          ///< Vector of internal forces
     Vectord m_Feff;                                                               ///< Vector of effective forces
     Vectord m_Fcontact;                                                           ///< Vector of contact forces
@@ -15,6 +15,67 @@
 #include "imstkPbdSolver.h"
 #include "imstkTaskGraph.h"
 
+namespace
+{
+///
+/// \brief Returns true if the array is mapped to count values of the storage array at offset
+///
+template<typename T>
+bool
+isMappedTo(T& arr, T& storageArr, const int offset, const int count)
+{
+    return arr.size() == count && arr.getPointer() == storageArr.getPointer() + offset;
+}
+
+///
+/// \brief Copies the array into the storage array at offset, then maps it there
+///
+template<typename T>
+void
+mapTo(T& arr, T& storageArr, const int offset)
+{
+    const int count = arr.size();
+    std::copy_n(arr.getPointer(), count, storageArr.getPointer() + offset);
+    arr.setData(storageArr.getPointer() + offset, count);
+}
+
+///
+/// \brief Copies a mapped array into its own memory
+///
+template<typename T>
+void
+unmap(T& arr)
+{
+    T owned(arr.size());
+    std::copy_n(arr.getPointer(), arr.size(), owned.getPointer());
+    // Assigning an unmapped array unmaps it, keeping the array object
+    arr = owned;
+}
+
+///
+/// \brief Returns true if every array a snapshot captures of the body holds size values
+///
+bool
+hasSnapshotArrays(const imstk::PbdBody& body, const int size)
+{
+    if (body.prevVertices == nullptr || body.vertices == nullptr || body.velocities == nullptr
+        || body.masses == nullptr || body.invMasses == nullptr
+        || body.prevVertices->size() != size || body.vertices->size() != size || body.velocities->size() != size
+        || body.masses->size() != size || body.invMasses->size() != size)
+    {
+        return false;
+    }
+    if (body.getOriented())
+    {
+        const size_t orientedSize = static_cast<size_t>(size);
+        return body.prevOrientations != nullptr && body.orientations != nullptr && body.angularVelocities != nullptr
+               && body.prevOrientations->size() == orientedSize && body.orientations->size() == orientedSize
+               && body.angularVelocities->size() == size;
+    }
+    return true;
+}
+} // namespace
+
 namespace imstk
 {
 PbdModel::PbdModel() : AbstractDynamicalModel(DynamicalModelType::PositionBasedDynamics),
@@ -72,6 +133,13 @@ PbdModel::PbdModel() : AbstractDynamicalModel(DynamicalModelType::PositionBasedD
         [&]() { updateVelocity(); });
 }
 
+PbdModel::~PbdModel()
+{
+    // Geometries sharing the arrays of the bodies may outlive the model, give
+    // them their own copy before the contiguous storage is freed
+    releaseParticleStorage();
+}
+
 void
 PbdModel::resetToInitialState()
 {
@@ -96,6 +164,155 @@ PbdModel::resetToInitialState()
     }
 }
 
+void
+PbdModel::setNumSnapshots(const int numSnapshots)
+{
+    CHECK(numSnapshots > 0) << "PbdModel must keep at least one snapshot";
+    m_snapshots.clear();
+    m_snapshots.resize(numSnapshots);
+    m_numSnapshotsTaken = 0;
+}
+
+int
+PbdModel::takeSnapshot()
+{
+    // The virtual particle bodies 0 and 1 are not captured
+    const size_t numBodies = m_state.m_bodies.size();
+    for (size_t i = 2; i < numBodies; i++)
+    {
+        const PbdBody& body = *m_state.m_bodies[i];
+        const int      size = (body.vertices == nullptr) ? 0 : body.vertices->size();
+        if (size != 0 && !hasSnapshotArrays(body, size))
+        {
+            LOG(WARNING) << "PbdModel can't take a snapshot, arrays of body " << i << " differ in size";
+            return -1;
+        }
+    }
+
+    PbdStateSnapshot& snapshot = m_snapshots[m_numSnapshotsTaken % m_snapshots.size()];
+    snapshot.id = m_numSnapshotsTaken++;
+
+    // Lay out the bodies
+    snapshot.bodySizes.assign(numBodies, 0);
+    snapshot.bodyOffsets.assign(numBodies, 0);
+    snapshot.orientedOffsets.assign(numBodies, -1);
+    int numParticles = 0;
+    int numOriented  = 0;
+    for (size_t i = 2; i < numBodies; i++)
+    {
+        const PbdBody& body = *m_state.m_bodies[i];
+        const int      size = (body.vertices == nullptr) ? 0 : body.vertices->size();
+        snapshot.bodySizes[i]   = size;
+        snapshot.bodyOffsets[i] = numParticles;
+        numParticles += size;
+        if (body.getOriented())
+        {
+            snapshot.orientedOffsets[i] = numOriented;
+            numOriented += size;
+        }
+    }
+
+    // Capacity is kept, these only allocate when the particle count grows
+    snapshot.prevVertices.resize(numParticles);
+    snapshot.vertices.resize(numParticles);
+    snapshot.velocities.resize(numParticles);
+    snapshot.masses.resize(numParticles);
+    snapshot.invMasses.resize(numParticles);
+    snapshot.prevOrientations.resize(numOriented);
+    snapshot.orientations.resize(numOriented);
+    snapshot.angularVelocities.resize(numOriented);
+
+    for (size_t i = 2; i < numBodies; i++)
+    {
+        const PbdBody& body   = *m_state.m_bodies[i];
+        const int      size   = snapshot.bodySizes[i];
+        const int      offset = snapshot.bodyOffsets[i];
+        if (size == 0)
+        {
+            continue;
+        }
+        std::copy_n(body.prevVertices->getPointer(), size, snapshot.prevVertices.data() + offset);
+        std::copy_n(body.vertices->getPointer(), size, snapshot.vertices.data() + offset);
+        std::copy_n(body.velocities->getPointer(), size, snapshot.velocities.data() + offset);
+        std::copy_n(body.masses->getPointer(), size, snapshot.masses.data() + offset);
+        std::copy_n(body.invMasses->getPointer(), size, snapshot.invMasses.data() + offset);
+
+        const int orientedOffset = snapshot.orientedOffsets[i];
+        if (orientedOffset != -1)
+        {
+            std::copy_n(body.prevOrientations->data(), size, snapshot.prevOrientations.data() + orientedOffset);
+            std::copy_n(body.orientations->data(), size, snapshot.orientations.data() + orientedOffset);
+            std::copy_n(body.angularVelocities->getPointer(), size, snapshot.angularVelocities.data() + orientedOffset);
+        }
+    }
+    return snapshot.id;
+}
+
+bool
+PbdModel::hasSnapshot(const int id) const
+{
+    return id >= 0 && id < m_numSnapshotsTaken
+           && id >= m_numSnapshotsTaken - static_cast<int>(m_snapshots.size());
+}
+
+bool
+PbdModel::restoreSnapshot(const int id)
+{
+    if (!hasSnapshot(id))
+    {
+        LOG(WARNING) << "PbdModel snapshot " << id << " was not taken or was overwritten";
+        return false;
+    }
+    const PbdStateSnapshot& snapshot  = m_snapshots[id % m_snapshots.size()];
+    const size_t            numBodies = m_state.m_bodies.size();
+
+    // Check the layout first to never partially restore
+    bool layoutMatches = (snapshot.bodySizes.size() == numBodies);
+    for (size_t i = 2; i < numBodies && layoutMatches; i++)
+    {
+        const PbdBody& body = *m_state.m_bodies[i];
+        const int      size = (body.vertices == nullptr) ? 0 : body.vertices->size();
+        layoutMatches = (size == snapshot.bodySizes[i]) && (body.getOriented() == (snapshot.orientedOffsets[i] != -1))
+                        && (size == 0 || hasSnapshotArrays(body, size));
+    }
+    if (!layoutMatches)
+    {
+        LOG(WARNING) << "PbdModel snapshot " << id << " does not match the bodies, they changed since";
+        return false;
+    }
+
+    for (size_t i = 2; i < numBodies; i++)
+    {
+        PbdBody&  body   = *m_state.m_bodies[i];
+        const int size   = snapshot.bodySizes[i];
+        const int offset = snapshot.bodyOffsets[i];
+        if (size == 0)
+        {
+            continue;
+        }
+        std::copy_n(snapshot.prevVertices.data() + offset, size, body.prevVertices->getPointer());
+        std::copy_n(snapshot.vertices.data() + offset, size, body.vertices->getPointer());
+        std::copy_n(snapshot.velocities.data() + offset, size, body.velocities->getPointer());
+        std::copy_n(snapshot.masses.data() + offset, size, body.masses->getPointer());
+        std::copy_n(snapshot.invMasses.data() + offset, size, body.invMasses->getPointer());
+
+        const int orientedOffset = snapshot.orientedOffsets[i];
+        if (orientedOffset != -1)
+        {
+            std::copy_n(snapshot.prevOrientations.data() + orientedOffset, size, body.prevOrientations->data());
+            std::copy_n(snapshot.orientations.data() + orientedOffset, size, body.orientations->data());
+            std::copy_n(snapshot.angularVelocities.data() + orientedOffset, size, body.angularVelocities->getPointer());
+        }
+
+        // These are usually shared with the geometry, let its users know they changed
+        body.vertices->postModified();
+        body.velocities->postModified();
+        body.masses->postModified();
+        body.invMasses->postModified();
+    }
+    return true;
+}
+
 void
 PbdModel::configure(std::shared_ptr<PbdModelConfig> config)
 {
@@ -116,6 +333,8 @@ PbdModel::removeBody(std::shared_ptr<PbdBody> body)
 {
     auto iter = std::find(m_state.m_bodies.begin(), m_state.m_bodies.end(), body);
     CHECK(iter != m_state.m_bodies.end()) << "removeBody called but could not find PbdyBody in PbdState";
+    // The removed body would stay mapped to the storage, which is rebuilt without it
+    releaseParticleStorage();
     m_state.m_bodies.erase(iter);
     m_modified = true;
 }
@@ -174,6 +393,33 @@ PbdModel::addVirtualParticle(
         velocity, Vec3d::Zero(), persist);
 }
 
+PbdParticleId
+PbdModel::addVirtualParticles(const int count, const bool persist)
+{
+    const int virtualBufferId = static_cast<int>(persist);
+    PbdBody&  body  = *m_state.m_bodies[virtualBufferId];
+    const int start = body.vertices->size();
+    resizeBodyParticles(body, start + count);
+    std::fill_n(body.velocities->getPointer() + start, count, Vec3d::Zero());
+    std::fill_n(body.masses->getPointer() + start, count, 0.0);
+    std::fill_n(body.invMasses->getPointer() + start, count, 0.0);
+    if (body.getOriented())
+    {
+        std::fill(body.prevOrientations->begin() + start, body.prevOrientations->end(), Quatd::Identity());
+        std::fill(body.orientations->begin() + start, body.orientations->end(), Quatd::Identity());
+        std::fill_n(body.angularVelocities->getPointer() + start, count, Vec3d::Zero());
+        std::fill(body.inertias->begin() + start, body.inertias->end(), Mat3d::Identity());
+        std::fill(body.invInertias->begin() + start, body.invInertias->end(), Mat3d::Identity());
+    }
+    return { virtualBufferId, start };
+}
+
+void
+PbdModel::resizeVirtualParticles(const int count, const bool persist)
+{
+    resizeBodyParticles(*m_state.m_bodies[static_cast<int>(persist)], count);
+}
+
 void
 PbdModel::clearVirtualParticles()
 {
@@ -232,6 +478,9 @@ PbdModel::initialize()
         m_config->m_dataTracker->configureProbe(DataTracker::Physics::AverageC, DataTracker::ePhysics::AverageC);
     }
 
+    // Map the bodies before anything else couples with their arrays
+    updateParticleStorage();
+
     return true;
 }
 
@@ -275,20 +524,88 @@ PbdModel::getTimeStep() const
     return m_config->m_dt;
 }
 
+double
+PbdModel::getSubstepTimeStep() const
+{
+    return m_config->m_dt / std::max(m_config->m_numSubsteps, 1u);
+}
+
 void
 PbdModel::integratePosition()
 {
     // resize 0 virtual particles (avoids reallocation)
     clearVirtualParticles();
+    updateParticleStorage();
+    integrateBodyPositions();
+}
+
+void
+PbdModel::integrateBodyPositions()
+{
     int bodyCount = m_state.m_bodies.size() - 2;
 
+    PbdParticleStorage* storage = m_state.m_particleStorage.get();
+    if (storage != nullptr)
+    {
+        integratePosition(*storage);
+    }
+
     // There are two virtual particles buffer, skip the first two
     ParallelUtils::parallelFor(bodyCount,
         [&](const int i) {
-            integratePosition(*m_state.m_bodies[i + 2]);
+            if (storage == nullptr || storage->bodyOffsets[i + 2] == -1)
+            {
+                integratePosition(*m_state.m_bodies[i + 2]);
+            }
             });
 }
 
+void
+PbdModel::integratePosition(PbdParticleStorage& storage)
+{
+    // Gather the per body terms once
+    const size_t        numBodies = m_state.m_bodies.size();
+    std::vector<Vec3d>  gravities(numBodies, Vec3d::Zero());
+    std::vector<Vec3d>  externalForces(numBodies, Vec3d::Zero());
+    std::vector<double> linearVelocityDamps(numBodies, 1.0);
+    for (size_t i = 0; i < numBodies; i++)
+    {
+        if (storage.bodyOffsets[i] != -1)
+        {
+            const PbdBody& body = *m_state.m_bodies[i];
+            gravities[i]           = static_cast<double>(body.bodyGravity) * m_config->m_gravity;
+            externalForces[i]      = body.externalForce;
+            linearVelocityDamps[i] = 1.0 - m_config->getLinearDamping(body.bodyHandle);
+        }
+    }
+
+    VecDataArray<double, 3>& pos       = storage.vertices;
+    VecDataArray<double, 3>& prevPos   = storage.prevVertices;
+    VecDataArray<double, 3>& vel       = storage.velocities;
+    const DataArray<double>& invMasses = storage.invMasses;
+    const std::vector<int>&  bodyIds   = storage.bodyIds;
+
+    const int    numParticles = storage.getNumParticles();
+    const double dt = getSubstepTimeStep();
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int i)
+        {
+            if (std::abs(invMasses[i]) > 0.0)
+            {
+                const int   bodyId = bodyIds[i];
+                const Vec3d accel  = gravities[bodyId] + externalForces[bodyId] * invMasses[i];
+                vel[i] += accel * dt;
+                vel[i] *= linearVelocityDamps[bodyId];
+
+                // Cap velocity to increase stability
+                vel[i] = vel[i].cwiseMax(-m_velocityThreshold).cwiseMin(m_velocityThreshold);
+
+                prevPos[i] = pos[i];
+                pos[i]    += vel[i] * dt;
+            }
+        }, numParticles > 50); // Only run parallel when more than 50 pts
+}
+
 void
 PbdModel::integratePosition(PbdBody& body)
 {
@@ -303,7 +620,7 @@ PbdModel::integratePosition(PbdBody& body)
     CHECK(numParticles == vel.size()) << "PbdModel data corrupt";
     CHECK(numParticles == invMasses.size()) << "PbdModel data corrupt";
 
-    const double dt = m_config->m_dt;
+    const double dt = getSubstepTimeStep();
     const double linearVelocityDamp = 1.0 - m_config->getLinearDamping(body.bodyHandle);
     ParallelUtils::parallelFor(numParticles,
         [&](const int i)
@@ -373,11 +690,36 @@ PbdModel::integratePosition(PbdBody& body)
 
 void
 PbdModel::updateVelocity()
+{
+    updateBodyVelocities();
+    m_pbdSolver->clearConstraintLists();
+
+    // External forces act over all the substeps of the step
+    for (size_t i = 2; i < m_state.m_bodies.size(); i++)
+    {
+        m_state.m_bodies[i]->externalForce  = Vec3d::Zero();
+        m_state.m_bodies[i]->externalTorque = Vec3d::Zero();
+    }
+}
+
+void
+PbdModel::updateBodyVelocities()
 {
     int bodyCount = m_state.m_bodies.size() - 2;
+
+    // Bodies may not be added or reallocated during the solve, the storage is still valid
+    PbdParticleStorage* storage = m_state.m_particleStorage.get();
+    if (storage != nullptr)
+    {
+        updateVelocity(*storage);
+    }
+
     ParallelUtils::parallelFor(bodyCount,
         [&](const int i) {
-            updateVelocity(*m_state.m_bodies[i + 2]);
+            if (storage == nullptr || storage->bodyOffsets[i + 2] == -1)
+            {
+                updateVelocity(*m_state.m_bodies[i + 2]);
+            }
                 });
 
     // Correctly velocities for friction and restitution
@@ -386,10 +728,9 @@ PbdModel::updateVelocity()
     {
         for (auto& colConstraint : *colConstraintList)
         {
-            colConstraint->correctVelocity(m_state, m_config->m_dt);
+            colConstraint->correctVelocity(m_state, getSubstepTimeStep());
         }
     }
-    m_pbdSolver->clearConstraintLists();
 }
 
 void
@@ -408,7 +749,7 @@ PbdModel::updateVelocity(PbdBody& body)
         CHECK(numParticles == vel.size()) << "PbdModel data corrupt";
         CHECK(numParticles == invMasses.size()) << "PbdModel data corrupt";
 
-        const double invDt = 1.0 / m_config->m_dt;
+        const double invDt = 1.0 / getSubstepTimeStep();
         ParallelUtils::parallelFor(numParticles,
             [&](const int i)
             {
@@ -444,9 +785,200 @@ PbdModel::updateVelocity(PbdBody& body)
                 }, numParticles > 50);
         }
     }
+}
 
-    body.externalForce  = Vec3d::Zero();
-    body.externalTorque = Vec3d::Zero();
+void
+PbdModel::updateVelocity(PbdParticleStorage& storage)
+{
+    if (m_config->m_dt > 0.0)
+    {
+        const VecDataArray<double, 3>& pos       = storage.vertices;
+        const VecDataArray<double, 3>& prevPos   = storage.prevVertices;
+        VecDataArray<double, 3>&       vel       = storage.velocities;
+        const DataArray<double>&       invMasses = storage.invMasses;
+
+        const int    numParticles = storage.getNumParticles();
+        const double invDt = 1.0 / getSubstepTimeStep();
+        ParallelUtils::parallelFor(numParticles,
+            [&](const int i)
+            {
+                if (std::abs(invMasses[i]) > 0.0)
+                {
+                    vel[i] = (pos[i] - prevPos[i]) * invDt;
+                }
+            }, numParticles > 50);
+    }
+}
+
+void
+PbdModel::updateParticleStorage()
+{
+    if (!m_config->m_doContiguousStorage)
+    {
+        if (m_state.m_particleStorage != nullptr)
+        {
+            releaseParticleStorage();
+        }
+        return;
+    }
+
+    if (m_state.m_particleStorage == nullptr || !getParticleStorageValid())
+    {
+        buildParticleStorage();
+    }
+}
+
+bool
+PbdModel::getStorable(const int bodyIndex) const
+{
+    // The virtual particle bodies are resized every step
+    if (bodyIndex < 2)
+    {
+        return false;
+    }
+
+    const PbdBody& body = *m_state.m_bodies[bodyIndex];
+    if (body.bodyType != PbdBody::Type::DEFORMABLE
+        || body.vertices == nullptr || body.prevVertices == nullptr || body.velocities == nullptr
+        || body.masses == nullptr || body.invMasses == nullptr)
+    {
+        return false;
+    }
+    const int numParticles = body.vertices->size();
+    return numParticles > 0
+           && body.prevVertices->size() == numParticles && body.velocities->size() == numParticles
+           && body.masses->size() == numParticles && body.invMasses->size() == numParticles;
+}
+
+bool
+PbdModel::getParticleStorageValid() const
+{
+    PbdParticleStorage& storage = *m_state.m_particleStorage;
+    if (storage.bodyOffsets.size() != m_state.m_bodies.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < static_cast<int>(m_state.m_bodies.size()); i++)
+    {
+        const int offset = storage.bodyOffsets[i];
+        if (getStorable(i) != (offset != -1))
+        {
+            return false;
+        }
+        if (offset != -1)
+        {
+            const PbdBody& body  = *m_state.m_bodies[i];
+            const int      count = storage.bodySizes[i];
+            if (!isMappedTo(*body.vertices, storage.vertices, offset, count)
+                || !isMappedTo(*body.prevVertices, storage.prevVertices, offset, count)
+                || !isMappedTo(*body.velocities, storage.velocities, offset, count)
+                || !isMappedTo(*body.masses, storage.masses, offset, count)
+                || !isMappedTo(*body.invMasses, storage.invMasses, offset, count))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void
+PbdModel::releaseParticleStorage()
+{
+    if (m_state.m_particleStorage == nullptr)
+    {
+        return;
+    }
+
+    PbdParticleStorage& storage = *m_state.m_particleStorage;
+    for (size_t i = 0; i < m_state.m_bodies.size() && i < storage.bodyOffsets.size(); i++)
+    {
+        const int offset = storage.bodyOffsets[i];
+        if (offset == -1)
+        {
+            continue;
+        }
+
+        // Bodies may have replaced some of their arrays since, only unmap those still mapped
+        PbdBody&  body  = *m_state.m_bodies[i];
+        const int count = storage.bodySizes[i];
+        if (body.vertices != nullptr && isMappedTo(*body.vertices, storage.vertices, offset, count))
+        {
+            unmap(*body.vertices);
+            body.vertices->postModified();
+        }
+        if (body.prevVertices != nullptr && isMappedTo(*body.prevVertices, storage.prevVertices, offset, count))
+        {
+            unmap(*body.prevVertices);
+        }
+        if (body.velocities != nullptr && isMappedTo(*body.velocities, storage.velocities, offset, count))
+        {
+            unmap(*body.velocities);
+        }
+        if (body.masses != nullptr && isMappedTo(*body.masses, storage.masses, offset, count))
+        {
+            unmap(*body.masses);
+        }
+        if (body.invMasses != nullptr && isMappedTo(*body.invMasses, storage.invMasses, offset, count))
+        {
+            unmap(*body.invMasses);
+        }
+    }
+    m_state.m_particleStorage = nullptr;
+}
+
+void
+PbdModel::buildParticleStorage()
+{
+    // Give every body its own arrays back first, simplest way to deal with bodies
+    // that are partially remapped or not storable anymore. Rebuilds are rare.
+    if (m_state.m_particleStorage != nullptr)
+    {
+        releaseParticleStorage();
+    }
+
+    auto storage = std::make_shared<PbdParticleStorage>();
+    storage->bodyOffsets.resize(m_state.m_bodies.size(), -1);
+    storage->bodySizes.resize(m_state.m_bodies.size(), 0);
+    int numParticles = 0;
+    for (int i = 0; i < static_cast<int>(m_state.m_bodies.size()); i++)
+    {
+        if (getStorable(i))
+        {
+            storage->bodyOffsets[i] = numParticles;
+            storage->bodySizes[i]   = m_state.m_bodies[i]->vertices->size();
+            numParticles += storage->bodySizes[i];
+        }
+    }
+
+    storage->prevVertices.resize(numParticles);
+    storage->vertices.resize(numParticles);
+    storage->velocities.resize(numParticles);
+    storage->masses.resize(numParticles);
+    storage->invMasses.resize(numParticles);
+    storage->bodyIds.resize(numParticles);
+    for (int i = 0; i < static_cast<int>(m_state.m_bodies.size()); i++)
+    {
+        const int offset = storage->bodyOffsets[i];
+        if (offset == -1)
+        {
+            continue;
+        }
+
+        PbdBody& body = *m_state.m_bodies[i];
+        mapTo(*body.prevVertices, storage->prevVertices, offset);
+        mapTo(*body.vertices, storage->vertices, offset);
+        mapTo(*body.velocities, storage->velocities, offset);
+        mapTo(*body.masses, storage->masses, offset);
+        mapTo(*body.invMasses, storage->invMasses, offset);
+        std::fill_n(storage->bodyIds.begin() + offset, storage->bodySizes[i], i);
+
+        // The vertices are usually shared with the geometry, let its users know they moved
+        body.vertices->postModified();
+    }
+
+    m_state.m_particleStorage = storage;
 }
 
 void
@@ -454,10 +986,55 @@ PbdModel::solveConstraints()
 {
     m_pbdSolver->setPbdBodies(&m_state);
     m_pbdSolver->setConstraints(getConstraints());
-    m_pbdSolver->setTimeStep(m_config->m_dt);
+    m_pbdSolver->setTimeStep(getSubstepTimeStep());
     m_pbdSolver->setIterations(m_config->m_iterations);
     m_pbdSolver->setSolverType(m_config->m_solverType);
+    m_pbdSolver->setUseBatching(m_config->m_doBatching);
     m_pbdSolver->solve();
+
+    // The first substep is run by the task graph, with collision detection and
+    // handling in between the integration and solve, run the remaining ones here
+    const bool redetect = (m_config->m_collisionSubstepPolicy == PbdModelConfig::CollisionSubstepPolicy::Redetect);
+    const int  numStepVirtualParticles = m_state.m_bodies[0]->vertices->size();
+    for (unsigned int i = 1; i < m_config->m_numSubsteps; i++)
+    {
+        updateBodyVelocities();
+        integrateBodyPositions();
+        if (redetect)
+        {
+            // Drop the virtual particles of the previous substep's handling so they
+            // don't pile up, those added before the solve may still be in use
+            resizeVirtualParticles(numStepVirtualParticles);
+
+            // Handlers add their constraint lists again, the solver keeps each once
+            for (auto iter = m_collisionSubstepNodes.begin(); iter != m_collisionSubstepNodes.end();)
+            {
+                if (std::shared_ptr<TaskNode> node = iter->lock())
+                {
+                    node->execute();
+                    iter++;
+                }
+                else
+                {
+                    iter = m_collisionSubstepNodes.erase(iter);
+                }
+            }
+        }
+        m_pbdSolver->solve();
+    }
+}
+
+void
+PbdModel::addCollisionSubstepNode(std::shared_ptr<TaskNode> node)
+{
+    for (const std::weak_ptr<TaskNode>& existing : m_collisionSubstepNodes)
+    {
+        if (existing.lock() == node)
+        {
+            return;
+        }
+    }
+    m_collisionSubstepNodes.push_back(node);
 }
 
 void
@@ -42,7 +42,7 @@ class PbdModel : public AbstractDynamicalModel
 {
 public:
     PbdModel();
-    ~PbdModel() override = default;
+    ~PbdModel() override;
 
     void resetToInitialState() override;
 
@@ -84,6 +84,19 @@ public:
         const Vec3d& velocity = Vec3d::Zero(),
         const bool persist    = false);
 
+    ///
+    /// \brief Add count zero mass particles to the virtual pool at once and return the
+    /// first. Their positions may then be set concurrently, the pool is not resized
+    /// until the next addition.
+    ///
+    PbdParticleId addVirtualParticles(const int count, const bool persist = false);
+
+    ///
+    /// \brief Resize the virtual particles, ie: to drop unused particles reserved
+    /// with addVirtualParticles
+    ///
+    void resizeVirtualParticles(const int count, const bool persist = false);
+
     ///
     /// \brief Resize 0 the virtual particles
     ///
@@ -105,6 +118,11 @@ public:
     void setTimeStep(const double timeStep) override;
     double getTimeStep() const override;
 
+    ///
+    /// \brief Returns the time step of a substep, see PbdModelConfig::m_numSubsteps
+    ///
+    double getSubstepTimeStep() const;
+
     ///
     /// \brief Set/Get filter value for velocity, default is 10 in meters/second
     ///@{
@@ -122,6 +140,7 @@ public:
     ///@{
     void integratePosition();
     void integratePosition(PbdBody& body);
+    void integratePosition(PbdParticleStorage& storage);
     ///@}
 
     ///
@@ -129,13 +148,70 @@ public:
     ///@{
     void updateVelocity();
     void updateVelocity(PbdBody& body);
+    void updateVelocity(PbdParticleStorage& storage);
+    ///@}
+
+    ///
+    /// \brief Builds the contiguous particle storage of the deformable bodies when
+    /// enabled (see PbdModelConfig::m_doContiguousStorage) and rebuilds it when bodies
+    /// were added, removed or reallocated their arrays. Releases it when disabled.
+    /// Called every step, may be called to update the storage immediately after a change
+    ///
+    void updateParticleStorage();
+
+    ///
+    /// \brief Gives back every body still mapped to the contiguous storage its own arrays.
+    /// Must be called before resizing the arrays of a body (ie: topology changes), the
+    /// storage is rebuilt on the next step
+    ///
+    void releaseParticleStorage();
+
+    ///
+    /// \brief Set/Get the number of snapshots kept, the oldest is overwritten by
+    /// a new one once all are taken. Setting it drops the snapshots taken. Default 4
+    ///@{
+    void setNumSnapshots(const int numSnapshots);
+    int getNumSnapshots() const { return static_cast<int>(m_snapshots.size()); }
     ///@}
 
     ///
-    /// \brief Solve the internal constraints
+    /// \brief Copies the dynamic state of the bodies (positions, velocities, masses,
+    /// inverse masses, orientations) into the next snapshot of the ring. Snapshot buffers
+    /// are reused, they only allocate until every snapshot was taken once at the current
+    /// particle count. Virtual particles are not captured, neither are constraints
+    /// (XPBD lambdas are reset every solve)
+    /// \return id of the snapshot, to restore it with, -1 if the arrays of a body differ in size
+    ///
+    int takeSnapshot();
+
+    ///
+    /// \brief Returns true if the snapshot with id is still kept
+    ///
+    bool hasSnapshot(const int id) const;
+
+    ///
+    /// \brief Copies the snapshot with id back into the bodies, in O(particles), and posts
+    /// modified on the restored arrays. Fails if the snapshot was overwritten or any array
+    /// of the bodies changed size since
+    /// \return true if restored
+    ///
+    bool restoreSnapshot(const int id);
+
+    ///
+    /// \brief Solve the internal constraints. With substeps (see PbdModelConfig::m_numSubsteps)
+    /// also runs the substeps after the first: velocity update, integration, collision
+    /// (see addCollisionSubstepNode) and solve
     ///
     void solveConstraints();
 
+    ///
+    /// \brief Add a node to run after integrating every substep but the first, with
+    /// PbdModelConfig::CollisionSubstepPolicy::Redetect, ie: the collision detection and
+    /// handling of an interaction. Nodes run in order of addition, they are held weakly
+    /// and dropped once destroyed
+    ///
+    void addCollisionSubstepNode(std::shared_ptr<TaskNode> node);
+
     ///
     /// \brief Initialize the PBD model
     ///
@@ -169,6 +245,32 @@ protected:
     ///
     void resizeBodyParticles(PbdBody& body, const int particleCount);
 
+    ///
+    /// \brief Integrates the positions of all bodies over a substep
+    ///
+    void integrateBodyPositions();
+
+    ///
+    /// \brief Updates the velocities of all bodies from a substep, corrects them
+    /// for friction and restitution of the collision constraints
+    ///
+    void updateBodyVelocities();
+
+    ///
+    /// \brief Returns true if the body should be kept in the contiguous storage
+    ///
+    bool getStorable(const int bodyIndex) const;
+
+    ///
+    /// \brief Returns true if every storable body is mapped to the contiguous storage
+    ///
+    bool getParticleStorageValid() const;
+
+    ///
+    /// \brief Copies the storable bodies into new contiguous storage and maps them onto it
+    ///
+    void buildParticleStorage();
+
     ///
     /// \brief Setup the computational graph of Pbd
     ///
@@ -182,10 +284,15 @@ protected:
     PbdState m_initialState;
     PbdState m_state;
 
+    std::vector<PbdStateSnapshot> m_snapshots = std::vector<PbdStateSnapshot>(4); ///< Ring of snapshots
+    int m_numSnapshotsTaken = 0;
+
     std::shared_ptr<PbdSolver>      m_pbdSolver = nullptr;     ///< PBD solver
     std::shared_ptr<PbdModelConfig> m_config    = nullptr;     ///< Model parameters, must be set before simulation
     std::shared_ptr<PbdConstraintContainer> m_constraints;     ///< The set of constraints to update/use
 
+    std::vector<std::weak_ptr<TaskNode>> m_collisionSubstepNodes; ///< Run on substeps with CollisionSubstepPolicy::Redetect
+
     ///< Computational Nodes
     ///@{
     std::shared_ptr<TaskNode> m_integrationPositionNode = nullptr;
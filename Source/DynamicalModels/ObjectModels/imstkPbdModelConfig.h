@@ -42,6 +42,15 @@ public:
         ConstantDensity
     };
 
+    ///
+    /// \brief Gives how collisions are treated on the substeps after the first, see m_numSubsteps
+    ///
+    enum class CollisionSubstepPolicy
+    {
+        Reuse,   ///< Detect once per step, the contact constraints found are projected on every substep
+        Redetect ///< Re-run collision detection and handling after integrating every substep
+    };
+
 public:
     ///
     /// \brief Enables a constraint of type defined by ConstraintGenType with
@@ -146,7 +155,11 @@ public:
 
     unsigned int m_iterations = 10;           ///< Internal constraints pbd solver iterations
     double       m_dt     = 0.01;             ///< Time step size
+    unsigned int m_numSubsteps = 1;           ///< Integrate, solve and velocity update passes per step of m_dt, pair with few m_iterations
+    CollisionSubstepPolicy m_collisionSubstepPolicy = CollisionSubstepPolicy::Reuse; ///< Collision on substeps after the first
     bool m_doPartitioning = true;             ///< Does graph coloring to solve in parallel
+    bool m_doBatching     = false;            ///< Solves distance, volume, & dihedral constraints through SoA batches
+    bool m_doContiguousStorage = false;       ///< Stores deformable particles of all bodies contiguously, integrated in one pass
 
     Vec3d m_gravity = Vec3d(0.0, -9.81, 0.0); ///< Gravity acceleration
 
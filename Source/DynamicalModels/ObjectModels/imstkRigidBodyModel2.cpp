@@ -223,6 +223,7 @@ RigidBodyModel2::solveConstraints()
     // Solves the current constraints of the system, then discards them
     if (m_constraints.size() == 0)
     {
+        m_prevImpulses.clear();
         return;
     }
     if (m_config->m_maxNumConstraints != -1 && static_cast<int>(m_constraints.size()) > m_config->m_maxNumConstraints * 2)
@@ -230,6 +231,13 @@ RigidBodyModel2::solveConstraints()
         m_constraints.resize(m_config->m_maxNumConstraints * 2);
     }
 
+    if (m_config->m_matrixFree)
+    {
+        solveConstraintsMatrixFree();
+        m_constraints.clear();
+        return;
+    }
+
     //printf("solving\n");
 
     std::shared_ptr<RigidBodyState2> state    = getCurrentState();
@@ -345,10 +353,31 @@ RigidBodyModel2::solveConstraints()
     std::cout << "b: " << std::endl << b << std::endl;*/
 
     m_pgsSolver->setA(&A);
-    //pgsSolver.setGuess(F); // Not using warm starting
     m_pgsSolver->setMaxIterations(m_config->m_maxNumIterations);
     m_pgsSolver->setEpsilon(m_config->m_epsilon);
-    F = J.transpose() * m_pgsSolver->solve(b, cu);   // Reaction force,torque
+    m_pgsSolver->setUseGraphColoring(m_config->m_useGraphColoring);
+    if (m_config->m_warmStart)
+    {
+        computeConstraintKeys();
+        Eigen::VectorXd guess(m_constraints.size());
+        for (size_t i = 0; i < m_constraintKeys.size(); i++)
+        {
+            auto prevImpulse = m_prevImpulses.find(m_constraintKeys[i]);
+            guess[i] = (prevImpulse != m_prevImpulses.end()) ? prevImpulse->second : 0.0;
+        }
+        m_pgsSolver->setGuess(guess);
+    }
+    const Eigen::VectorXd& impulses = m_pgsSolver->solve(b, cu);
+    F = J.transpose() * impulses;   // Reaction force,torque
+
+    if (m_config->m_warmStart)
+    {
+        m_prevImpulses.clear();
+        for (size_t i = 0; i < m_constraintKeys.size(); i++)
+        {
+            m_prevImpulses[m_constraintKeys[i]] = impulses[i];
+        }
+    }
 
     // Apply reaction impulse
     j = 0;
@@ -363,6 +392,168 @@ RigidBodyModel2::solveConstraints()
     m_constraints.clear();
 }
 
+void
+RigidBodyModel2::solveConstraintsMatrixFree()
+{
+    std::shared_ptr<RigidBodyState2> state    = getCurrentState();
+    const std::vector<bool>&         isStatic = state->getIsStatic();
+    const std::vector<double>&       invMasses = state->getInvMasses();
+    const StdVectorOfMat3d&          invInteriaTensors   = state->getInvIntertiaTensors();
+    const StdVectorOfVec3d&          tentativeVelocities = state->getTentatveVelocities();
+    const StdVectorOfVec3d&          tentativeAngularVelocities = state->getTentativeAngularVelocities();
+    StdVectorOfVec3d&                forces  = state->getForces();
+    StdVectorOfVec3d&                torques = state->getTorques();
+    const double                     dt      = m_config->m_dt;
+
+    // Setup the rows, b = vu/dt - J * (V/dt + Minv * Fext), diagonal of A = J * Minv * J^T
+    const size_t numConstraints = m_constraints.size();
+    m_rows.resize(numConstraints);
+    size_t j = 0;
+    for (const std::shared_ptr<RbdConstraint>& constraint : m_constraints)
+    {
+        ConstraintRow& row = m_rows[j++];
+        row.body1 = (constraint->m_obj1 != nullptr) ? m_locations[constraint->m_obj1.get()] : -1;
+        row.body2 = (constraint->m_obj2 != nullptr) ? m_locations[constraint->m_obj2.get()] : -1;
+        row.J1Lin = constraint->J.col(0);
+        row.J1Ang = constraint->J.col(1);
+        row.J2Lin = constraint->J.col(2);
+        row.J2Ang = constraint->J.col(3);
+        row.lower = constraint->range[0];
+        row.upper = constraint->range[1];
+
+        double diag = 0.0;
+        row.b = constraint->vu / dt;
+        auto addBody = [&](const StorageIndex body, const Vec3d& JLin, const Vec3d& JAng, Vec3d& MinvJLin, Vec3d& MinvJAng)
+                       {
+                           MinvJLin = Vec3d::Zero();
+                           MinvJAng = Vec3d::Zero();
+                           if (body == -1 || isStatic[body])
+                           {
+                               return;
+                           }
+                           // Angular block of the assembled inverse mass is the transposed inverse inertia
+                           MinvJLin = invMasses[body] * JLin;
+                           MinvJAng = invInteriaTensors[body].transpose() * JAng;
+                           diag    += JLin.dot(MinvJLin) + JAng.dot(MinvJAng);
+                           row.b   -= JLin.dot(tentativeVelocities[body] / dt + invMasses[body] * forces[body])
+                                      + JAng.dot(tentativeAngularVelocities[body] / dt + invInteriaTensors[body].transpose() * torques[body]);
+                       };
+        addBody(row.body1, row.J1Lin, row.J1Ang, row.MinvJ1Lin, row.MinvJ1Ang);
+        addBody(row.body2, row.J2Lin, row.J2Ang, row.MinvJ2Lin, row.MinvJ2Ang);
+        row.invDiag = 1.0 / diag;
+    }
+
+    // Initial impulses, zero or warm started
+    m_impulses.setZero(numConstraints);
+    if (m_config->m_warmStart)
+    {
+        computeConstraintKeys();
+        for (size_t i = 0; i < numConstraints; i++)
+        {
+            auto prevImpulse = m_prevImpulses.find(m_constraintKeys[i]);
+            if (prevImpulse != m_prevImpulses.end())
+            {
+                m_impulses[i] = prevImpulse->second;
+            }
+        }
+    }
+
+    // Velocity change of every body due to the impulses, Minv * J^T * impulses
+    m_deltaVelocities.assign(state->size(), Vec3d::Zero());
+    m_deltaAngularVelocities.assign(state->size(), Vec3d::Zero());
+    auto applyImpulse = [&](const ConstraintRow& row, const double impulse)
+                        {
+                            if (row.body1 != -1)
+                            {
+                                m_deltaVelocities[row.body1]        += row.MinvJ1Lin * impulse;
+                                m_deltaAngularVelocities[row.body1] += row.MinvJ1Ang * impulse;
+                            }
+                            if (row.body2 != -1)
+                            {
+                                m_deltaVelocities[row.body2]        += row.MinvJ2Lin * impulse;
+                                m_deltaAngularVelocities[row.body2] += row.MinvJ2Ang * impulse;
+                            }
+                        };
+    for (size_t i = 0; i < numConstraints; i++)
+    {
+        applyImpulse(m_rows[i], m_impulses[i]);
+    }
+
+    const double relaxation = m_pgsSolver->getRelaxation();
+    for (unsigned int iter = 0; iter < m_config->m_maxNumIterations; iter++)
+    {
+        m_prevIterImpulses = m_impulses;
+        for (size_t i = 0; i < numConstraints; i++)
+        {
+            const ConstraintRow& row = m_rows[i];
+
+            // Row of A times the impulses, J * Minv * J^T * impulses
+            double Ax = 0.0;
+            if (row.body1 != -1)
+            {
+                Ax += row.J1Lin.dot(m_deltaVelocities[row.body1]) + row.J1Ang.dot(m_deltaAngularVelocities[row.body1]);
+            }
+            if (row.body2 != -1)
+            {
+                Ax += row.J2Lin.dot(m_deltaVelocities[row.body2]) + row.J2Ang.dot(m_deltaAngularVelocities[row.body2]);
+            }
+
+            // Same relaxed and projected update as the assembled solve
+            const double prevImpulse = m_impulses[i];
+            const double delta       = (row.b - (Ax - prevImpulse / row.invDiag)) * row.invDiag;
+            double       impulse     = prevImpulse + relaxation * (delta - prevImpulse);
+            impulse       = std::min(row.upper, std::max(row.lower, impulse));
+            m_impulses[i] = impulse;
+            applyImpulse(row, impulse - prevImpulse);
+        }
+
+        if ((m_impulses - m_prevIterImpulses).norm() < m_config->m_epsilon)
+        {
+            break;
+        }
+    }
+
+    if (m_config->m_warmStart)
+    {
+        m_prevImpulses.clear();
+        for (size_t i = 0; i < numConstraints; i++)
+        {
+            m_prevImpulses[m_constraintKeys[i]] = m_impulses[i];
+        }
+    }
+
+    // Apply reaction impulse, J^T * impulses
+    for (size_t i = 0; i < numConstraints; i++)
+    {
+        const ConstraintRow& row = m_rows[i];
+        if (row.body1 != -1)
+        {
+            forces[row.body1]  += row.J1Lin * m_impulses[i];
+            torques[row.body1] += row.J1Ang * m_impulses[i];
+        }
+        if (row.body2 != -1)
+        {
+            forces[row.body2]  += row.J2Lin * m_impulses[i];
+            torques[row.body2] += row.J2Ang * m_impulses[i];
+        }
+    }
+}
+
+void
+RigidBodyModel2::computeConstraintKeys()
+{
+    std::unordered_map<ConstraintKey, int, ConstraintKeyHash> counts;
+    m_constraintKeys.clear();
+    m_constraintKeys.reserve(m_constraints.size());
+    for (const std::shared_ptr<RbdConstraint>& constraint : m_constraints)
+    {
+        const RbdConstraint& c   = *constraint;
+        ConstraintKey        key = { c.m_obj1.get(), c.m_obj2.get(), std::type_index(typeid(c)), 0 };
+        key.ordinal = counts[key]++;
+        m_constraintKeys.push_back(key);
+    }
+}
+
 void
 RigidBodyModel2::integrate()
 {
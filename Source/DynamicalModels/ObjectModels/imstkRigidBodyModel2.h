@@ -10,6 +10,7 @@
 #include "imstkRigidBodyState2.h"
 
 #include <list>
+#include <typeindex>
 #include <unordered_map>
 
 namespace imstk
@@ -28,6 +29,9 @@ struct RigidBodyModel2Config
     double m_angularVelocityDamping = 1.0;
     double m_epsilon = 1e-4;
     int m_maxNumConstraints = -1;
+    bool m_warmStart = false;        ///< Start the solve from the impulses of matching constraints of the previous step
+    bool m_useGraphColoring = false; ///< Solve independent constraints in parallel
+    bool m_matrixFree = false;       ///< Solve per constraint on the body velocities, without assembling the system
 };
 
 ///
@@ -121,6 +125,19 @@ protected:
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
+    ///
+    /// \brief Computes the keys of the current constraints for warm starting
+    ///
+    void computeConstraintKeys();
+
+    ///
+    /// \brief Projected gauss seidel over the current constraints, without assembling
+    /// J or A. Every constraint row applies its impulse to the velocity change of its
+    /// bodies, which the next rows read, so an iteration costs the number of constraints.
+    /// Uses the iterations, epsilon and relaxation of the assembled solve
+    ///
+    void solveConstraintsMatrixFree();
+
     std::shared_ptr<RigidBodyModel2Config> m_config;
 
     std::shared_ptr<TaskNode> m_computeTentativeVelocities;
@@ -136,5 +153,57 @@ protected:
     size_t m_maxBodiesParallel = 10; // After 10 bodies, parallel for's are used
 
     Eigen::VectorXd F;               // Reaction forces
+
+    ///
+    /// \brief Identifies a constraint across steps. Constraints are recreated every
+    /// step, the n-th constraint of a type between the same bodies is taken to be the
+    /// same constraint as the n-th one of the previous step
+    ///
+    struct ConstraintKey
+    {
+        const RigidBody* obj1;
+        const RigidBody* obj2;
+        std::type_index  type;
+        int ordinal;
+
+        bool operator==(const ConstraintKey& other) const
+        {
+            return obj1 == other.obj1 && obj2 == other.obj2 && type == other.type && ordinal == other.ordinal;
+        }
+    };
+    struct ConstraintKeyHash
+    {
+        size_t operator()(const ConstraintKey& key) const
+        {
+            size_t seed = std::hash<const RigidBody*>()(key.obj1);
+            seed ^= std::hash<const RigidBody*>()(key.obj2) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= key.type.hash_code() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<int>()(key.ordinal) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+    ///
+    /// \brief A constraint row of the matrix free solve. Jacobian and its product
+    /// with the inverse mass of both bodies, linear and angular parts
+    ///
+    struct ConstraintRow
+    {
+        StorageIndex body1 = -1;
+        StorageIndex body2 = -1;
+        Vec3d J1Lin, J1Ang, J2Lin, J2Ang;
+        Vec3d MinvJ1Lin, MinvJ1Ang, MinvJ2Lin, MinvJ2Ang;
+        double invDiag = 0.0;
+        double b       = 0.0;
+        double lower   = 0.0;
+        double upper   = 0.0;
+    };
+    std::vector<ConstraintRow> m_rows;
+    Eigen::VectorXd  m_impulses;
+    Eigen::VectorXd  m_prevIterImpulses;
+    StdVectorOfVec3d m_deltaVelocities;        ///< Linear velocity change of every body due to the impulses
+    StdVectorOfVec3d m_deltaAngularVelocities; ///< Angular velocity change of every body due to the impulses
+
+    std::vector<ConstraintKey> m_constraintKeys;                               ///< Keys of the constraints being solved
+    std::unordered_map<ConstraintKey, double, ConstraintKeyHash> m_prevImpulses; ///< Solution of the previous step by key
 };
-} // namespace imstk
+} // namespace imstk
\ No newline at end of file
@@ -10,8 +10,43 @@
 #include "imstkTaskGraph.h"
 #include "imstkVTKMeshIO.h"
 
+#include <numeric>
+
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Spreads the lower 21 bits of x to every third bit
+///
+uint64_t
+spreadBits(uint64_t x)
+{
+    x &= 0x1fffff;
+    x  = (x | x << 32) & 0x1f00000000ffff;
+    x  = (x | x << 16) & 0x1f0000ff0000ff;
+    x  = (x | x << 8) & 0x100f00f00f00f00f;
+    x  = (x | x << 4) & 0x10c30c30c30c30c3;
+    x  = (x | x << 2) & 0x1249249249249249;
+    return x;
+}
+
+///
+/// \brief Permute array in place so that element i takes the value of element order[i]
+///
+template<typename ArrayType>
+void
+permute(ArrayType& array, const std::vector<int>& order)
+{
+    const ArrayType copy = array;
+    ParallelUtils::parallelFor(static_cast<int>(order.size()),
+        [&](const int i)
+        {
+            array[i] = copy[order[i]];
+        });
+}
+} // namespace
+
 SphModelConfig::SphModelConfig(const double particleRadius)
 {
     // \todo Warning in all paths?
@@ -92,6 +127,10 @@ SphModel::SphModel() : DynamicalModel<SphState>(DynamicalModelType::SmoothedPart
 
     m_collectNeighborDensityNode = m_taskGraph->addFunction("SPHModel_CollectNeighborDensity", std::bind(&SphModel::collectNeighborDensity, this));
 
+    m_computeDensityFusedNode = m_taskGraph->addFunction("SPHModel_ComputeDensityFused", std::bind(&SphModel::computeDensityFused, this));
+
+    m_computeForcesFusedNode = m_taskGraph->addFunction("SPHModel_ComputeForcesFused", std::bind(&SphModel::computeForcesFused, this));
+
     m_computeTimeStepSizeNode =
         m_taskGraph->addFunction("SPHModel_ComputeTimestep", std::bind(&SphModel::computeTimeStepSize, this));
 
@@ -182,31 +221,70 @@ SphModel::initialize()
     m_pointSetGeometry->setVertexAttribute("Diffuse Velocities", m_currentState->getDiffuseVelocities());
     m_pointSetGeometry->setVertexAttribute("Normals", m_currentState->getNormals());
     m_pointSetGeometry->setVertexAttribute("Accels", m_currentState->getAccelerations());
+    m_pointSetGeometry->setVertexAttribute("Particle Ids", m_currentState->getParticleIds());
+    m_particleIndices.clear();
 
     return true;
 }
 
+void
+SphModel::resetToInitialState()
+{
+    // The initial state is in creation order, put the boundary conditions back in it too
+    if (!m_particleIndices.empty() && m_sphBoundaryConditions)
+    {
+        const DataArray<int>& particleIds = *m_currentState->getParticleIds();
+        permute(m_sphBoundaryConditions->getParticleTypes(), m_particleIndices);
+        for (size_t& bufferIndex : m_sphBoundaryConditions->getBufferIndices())
+        {
+            bufferIndex = static_cast<size_t>(particleIds[static_cast<int>(bufferIndex)]);
+        }
+    }
+    m_particleIndices.clear();
+
+    this->m_currentState->setState(this->m_initialState);
+}
+
+int
+SphModel::getParticleIndex(const int particleId) const
+{
+    return m_particleIndices.empty() ? particleId : m_particleIndices[particleId];
+}
+
 void
 SphModel::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink)
 {
     // Setup graph connectivity
     m_taskGraph->addEdge(source, m_findParticleNeighborsNode);
-    m_taskGraph->addEdge(m_findParticleNeighborsNode, m_computeDensityNode);
-    m_taskGraph->addEdge(m_computeDensityNode, m_normalizeDensityNode);
-    m_taskGraph->addEdge(m_normalizeDensityNode, m_collectNeighborDensityNode);
-
-    // Pressure, Surface Tension, and time step size can be done in parallel
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computePressureAccelNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeSurfaceTensionNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeViscosityNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeTimeStepSizeNode);
-
-    m_taskGraph->addEdge(m_computePressureAccelNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeSurfaceTensionNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeViscosityNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_integrateNode);
-
-    m_taskGraph->addEdge(m_integrateNode, m_updateVelocityNode);
+    if (m_modelParameters->m_useFusedKernels)
+    {
+        // Densities, then all forces, time step size can be done in parallel
+        m_taskGraph->addEdge(m_findParticleNeighborsNode, m_computeDensityFusedNode);
+        m_taskGraph->addEdge(m_computeDensityFusedNode, m_computeForcesFusedNode);
+        m_taskGraph->addEdge(m_computeDensityFusedNode, m_computeTimeStepSizeNode);
+
+        m_taskGraph->addEdge(m_computeForcesFusedNode, m_updateVelocityNode);
+        m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_updateVelocityNode);
+    }
+    else
+    {
+        m_taskGraph->addEdge(m_findParticleNeighborsNode, m_computeDensityNode);
+        m_taskGraph->addEdge(m_computeDensityNode, m_normalizeDensityNode);
+        m_taskGraph->addEdge(m_normalizeDensityNode, m_collectNeighborDensityNode);
+
+        // Pressure, Surface Tension, and time step size can be done in parallel
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computePressureAccelNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeSurfaceTensionNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeViscosityNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeTimeStepSizeNode);
+
+        m_taskGraph->addEdge(m_computePressureAccelNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeSurfaceTensionNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeViscosityNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_integrateNode);
+
+        m_taskGraph->addEdge(m_integrateNode, m_updateVelocityNode);
+    }
     m_taskGraph->addEdge(m_updateVelocityNode, m_moveParticlesNode);
     m_taskGraph->addEdge(m_moveParticlesNode, sink);
 }
@@ -239,9 +317,95 @@ SphModel::computeCFLTimeStepSize()
     return timestep;
 }
 
+void
+SphModel::reorderParticles()
+{
+    std::shared_ptr<SphState> state = getCurrentState();
+    const VecDataArray<double, 3>& positions = *state->getPositions();
+    const int numParticles = positions.size();
+    if (numParticles < 2)
+    {
+        return;
+    }
+
+    // Sort by the Morton code of the kernel radius sized cell of every particle,
+    // the particle index breaks ties so the order is deterministic
+    Vec3d lowerCorner;
+    Vec3d upperCorner;
+    ParallelUtils::findAABB(positions, lowerCorner, upperCorner);
+    const double invCellSize = 1.0 / m_modelParameters->m_kernelRadius;
+    m_reorderKeys.resize(numParticles);
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int p)
+        {
+            const Vec3d cell = ((positions[p] - lowerCorner) * invCellSize).cwiseMin(static_cast<double>(0x1fffff));
+            m_reorderKeys[p] = { spreadBits(static_cast<uint64_t>(cell[0]))
+                                 | (spreadBits(static_cast<uint64_t>(cell[1])) << 1)
+                                 | (spreadBits(static_cast<uint64_t>(cell[2])) << 2), p };
+        });
+    std::sort(m_reorderKeys.begin(), m_reorderKeys.end());
+
+    m_reorderPermutation.resize(numParticles);
+    bool isSorted = true;
+    for (int i = 0; i < numParticles; i++)
+    {
+        m_reorderPermutation[i] = m_reorderKeys[i].second;
+        isSorted = isSorted && (m_reorderPermutation[i] == i);
+    }
+    if (isSorted)
+    {
+        return;
+    }
+
+    // Permute everything stored per particle. Neighbors are searched again after this
+    permute(*state->getPositions(), m_reorderPermutation);
+    permute(*state->getVelocities(), m_reorderPermutation);
+    permute(*state->getHalfStepVelocities(), m_reorderPermutation);
+    permute(*state->getFullStepVelocities(), m_reorderPermutation);
+    permute(*state->getDensities(), m_reorderPermutation);
+    permute(*state->getNormals(), m_reorderPermutation);
+    permute(*state->getAccelerations(), m_reorderPermutation);
+    permute(*state->getDiffuseVelocities(), m_reorderPermutation);
+    permute(*state->getParticleIds(), m_reorderPermutation);
+    permute(*m_pressureAccels, m_reorderPermutation);
+    permute(*m_surfaceTensionAccels, m_reorderPermutation);
+    permute(*m_viscousAccels, m_reorderPermutation);
+    permute(*m_neighborVelContr, m_reorderPermutation);
+    permute(*m_particleShift, m_reorderPermutation);
+
+    const DataArray<int>& particleIds = *state->getParticleIds();
+    m_particleIndices.resize(numParticles);
+    for (int i = 0; i < numParticles; i++)
+    {
+        m_particleIndices[particleIds[i]] = i;
+    }
+
+    if (m_sphBoundaryConditions)
+    {
+        permute(m_sphBoundaryConditions->getParticleTypes(), m_reorderPermutation);
+
+        // Buffer indices refer to particles by index, map them from the old to the new index
+        std::vector<int> newIndices(numParticles);
+        for (int i = 0; i < numParticles; i++)
+        {
+            newIndices[m_reorderPermutation[i]] = i;
+        }
+        for (size_t& bufferIndex : m_sphBoundaryConditions->getBufferIndices())
+        {
+            bufferIndex = static_cast<size_t>(newIndices[bufferIndex]);
+        }
+    }
+    state->getPositions()->postModified();
+}
+
 void
 SphModel::findParticleNeighbors()
 {
+    if (m_modelParameters->m_reorderInterval > 0 && m_timeStepCount % m_modelParameters->m_reorderInterval == 0)
+    {
+        reorderParticles();
+    }
+
     m_neighborSearcher->getNeighbors(getCurrentState()->getFluidNeighborLists(), *getCurrentState()->getPositions());
 
     if (m_modelParameters->m_bDensityWithBoundary)   // if considering boundary particles for computing fluid density
@@ -255,41 +419,68 @@ SphModel::findParticleNeighbors()
 void
 SphModel::computeNeighborRelativePositions()
 {
-    auto computeRelativePositions = [&](const Vec3d& ppos, const std::vector<size_t>& neighborList,
-                                        const VecDataArray<double, 3>& allPositions, std::vector<NeighborInfo>& neighborInfo)
+    auto computeRelativePositions = [&](const Vec3d& ppos, const int* neighborList, const int numNeighbors,
+                                        const VecDataArray<double, 3>& allPositions, NeighborInfo* neighborInfo)
                                     {
-                                        for (const size_t q : neighborList)
+                                        for (int i = 0; i < numNeighbors; ++i)
                                         {
-                                            const Vec3d& qpos = allPositions[q];
+                                            const Vec3d& qpos = allPositions[neighborList[i]];
                                             const Vec3d  r    = ppos - qpos;
-                                            neighborInfo.push_back({ r, m_modelParameters->m_restDensity });
+                                            neighborInfo[i] = { r, m_modelParameters->m_restDensity };
                                         }
                                     };
 
     std::shared_ptr<VecDataArray<double, 3>> positionsPtr = getCurrentState()->getPositions();
     const VecDataArray<double, 3>&           positions = *positionsPtr;
 
-    std::vector<std::vector<NeighborInfo>>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const NeighborList&        fluidNeighborLists    = getCurrentState()->getFluidNeighborLists();
+    const NeighborList&        boundaryNeighborLists = getCurrentState()->getBoundaryNeighborLists();
+    std::vector<NeighborInfo>& neighborInfos = getCurrentState()->getNeighborInfo();
+    std::vector<int>&          infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
+
+    auto isBuffer = [&](const int p)
+                    {
+                        return m_sphBoundaryConditions
+                               && m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer;
+                    };
+
+    // Lay out the fluid then boundary neighbors of every particle back to back
+    const int numParticles = static_cast<int>(getCurrentState()->getNumParticles());
+    infoOffsets.resize(numParticles + 1);
+    infoOffsets[0] = 0;
+    for (int p = 0; p < numParticles; ++p)
+    {
+        int numNeighbors = 0;
+        if (!isBuffer(p))
+        {
+            numNeighbors = fluidNeighborLists.getNumNeighbors(p);
+            if (m_modelParameters->m_bDensityWithBoundary)
+            {
+                numNeighbors += boundaryNeighborLists.getNumNeighbors(p);
+            }
+        }
+        infoOffsets[p + 1] = infoOffsets[p] + numNeighbors;
+    }
+    neighborInfos.resize(infoOffsets[numParticles]);
 
-    ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int p)
         {
-            if (m_sphBoundaryConditions
-                && m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer)
+            if (isBuffer(p))
             {
                 return;
             }
 
-            const Vec3d& ppos = positions[p];
-            std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            neighborInfo.resize(0);
-            neighborInfo.reserve(48);
+            const Vec3d&  ppos = positions[p];
+            NeighborInfo* neighborInfo = neighborInfos.data() + infoOffsets[p];
 
-            computeRelativePositions(ppos, getCurrentState()->getFluidNeighborLists()[p], *getCurrentState()->getPositions(), neighborInfo);
+            const int numFluidNeighbors = fluidNeighborLists.getNumNeighbors(p);
+            computeRelativePositions(ppos, fluidNeighborLists.getNeighbors(p), numFluidNeighbors, positions, neighborInfo);
             // if considering boundary particles then also cache relative positions with them
             if (m_modelParameters->m_bDensityWithBoundary)
             {
-                computeRelativePositions(ppos, getCurrentState()->getBoundaryNeighborLists()[p], *getCurrentState()->getBoundaryParticlePositions(), neighborInfo);
+                computeRelativePositions(ppos, boundaryNeighborLists.getNeighbors(p), boundaryNeighborLists.getNumNeighbors(p),
+                    *getCurrentState()->getBoundaryParticlePositions(), neighborInfo + numFluidNeighbors);
             }
       });
 }
@@ -303,28 +494,29 @@ SphModel::collectNeighborDensity()
     std::shared_ptr<DataArray<double>> densitiesPtr = getCurrentState()->getDensities();
     DataArray<double>&                 densities    = *densitiesPtr;
 
-    const std::vector<std::vector<size_t>>&                 neighborLists = getCurrentState()->getFluidNeighborLists();
+    const NeighborList&                                     neighborLists = getCurrentState()->getFluidNeighborLists();
+    std::vector<NeighborInfo>&                              neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&                                 infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
     const std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
 
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions && particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer)
             {
                 return;
             }
 
-            auto& neighborInfo = getCurrentState()->getNeighborInfo()[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 return; // the particle has no neighbor
             }
 
-            const auto& fluidNeighborList = neighborLists[p];
-            for (size_t i = 0; i < fluidNeighborList.size(); ++i)
+            NeighborInfo* neighborInfo      = neighborInfos.data() + infoOffsets[p];
+            const int*    fluidNeighborList = neighborLists.getNeighbors(p);
+            for (int i = 0; i < neighborLists.getNumNeighbors(p); ++i)
             {
-                auto q = fluidNeighborList[i];
-                neighborInfo[i].density = densities[q];
+                neighborInfo[i].density = densities[fluidNeighborList[i]];
             }
       });
 }
@@ -335,26 +527,26 @@ SphModel::computeDensity()
     std::shared_ptr<DataArray<double>> densitiesPtr = getCurrentState()->getDensities();
     DataArray<double>&                 densities    = *densitiesPtr;
 
-    const std::vector<std::vector<NeighborInfo>>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<NeighborInfo>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&          infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
 
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions && m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer)
             {
                 return;
             }
 
-            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 return; // the particle has no neighbor
             }
 
             double pdensity = 0.0;
-            for (const auto& qInfo : neighborInfo)
+            for (int i = infoOffsets[p]; i < infoOffsets[p + 1]; ++i)
             {
-                pdensity += m_kernels.W(qInfo.relativePos);
+                pdensity += m_kernels.W(neighborInfos[i].relativePos);
             }
             pdensity    *= m_modelParameters->m_particleMass;
             densities[p] = pdensity;
@@ -384,34 +576,38 @@ SphModel::normalizeDensity()
     std::shared_ptr<DataArray<double>> densitiesPtr = getCurrentState()->getDensities();
     DataArray<double>&                 densities    = *densitiesPtr;
 
-    const std::vector<std::vector<size_t>>&                 neighborLists = getCurrentState()->getFluidNeighborLists();
-    const std::vector<std::vector<NeighborInfo>>&           neighborInfos = getCurrentState()->getNeighborInfo();
+    const NeighborList&                                     neighborLists = getCurrentState()->getFluidNeighborLists();
+    const std::vector<NeighborInfo>&                        neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&                                 infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
     const std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
 
+    // Neighbors are normalized with their densities before normalization, whatever order particles are processed in
+    m_unnormalizedDensities.assign(densities.getPointer(), densities.getPointer() + densities.size());
+
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions && particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer)
             {
                 return;
             }
 
-            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 return; // the particle has no neighbor
             }
 
-            const auto& fluidNeighborList = neighborLists[p];
-            double tmp = 0.0;
+            const NeighborInfo* neighborInfo      = neighborInfos.data() + infoOffsets[p];
+            const int*          fluidNeighborList = neighborLists.getNeighbors(p);
+            double              tmp = 0.0;
 
-            for (size_t i = 0; i < fluidNeighborList.size(); ++i)
+            for (int i = 0; i < neighborLists.getNumNeighbors(p); ++i)
             {
                 const auto& qInfo = neighborInfo[i];
 
                 // because we're not done with density computation, qInfo does not contain desity of particle q yet
                 const auto q = fluidNeighborList[i];
-                const auto qdensity = densities[q];
+                const auto qdensity = m_unnormalizedDensities[q];
                 tmp += m_kernels.W(qInfo.relativePos) / qdensity;
             }
 
@@ -426,11 +622,12 @@ SphModel::computePressureAcceleration()
     const DataArray<double>&           densities      = *densitiesPtr;
     VecDataArray<double, 3>&           pressureAccels = *m_pressureAccels;
 
-    const std::vector<std::vector<NeighborInfo>>&           neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<NeighborInfo>&                        neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&                                 infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
     const std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
 
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions && particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer)
             {
@@ -438,8 +635,7 @@ SphModel::computePressureAcceleration()
             }
 
             Vec3d accel = Vec3d::Zero();
-            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 pressureAccels[p] = accel;
                 return;
@@ -448,9 +644,9 @@ SphModel::computePressureAcceleration()
             const auto pdensity  = densities[p];
             const auto ppressure = getParticlePressure(pdensity);
 
-            for (size_t idx = 0; idx < neighborInfo.size(); ++idx)
+            for (int idx = infoOffsets[p]; idx < infoOffsets[p + 1]; ++idx)
             {
-                const auto& qInfo    = neighborInfo[idx];
+                const auto& qInfo    = neighborInfos[idx];
                 const auto r         = qInfo.relativePos;
                 const auto qdensity  = qInfo.density;
                 const auto qpressure = getParticlePressure(qdensity);
@@ -473,11 +669,12 @@ SphModel::computeViscosity()
     VecDataArray<double, 3>&       particleShift      = *m_particleShift;
     const VecDataArray<double, 3>& halfStepVelocities = *getCurrentState()->getHalfStepVelocities();
 
-    const std::vector<std::vector<NeighborInfo>>& neighborInfos = getCurrentState()->getNeighborInfo();
-    const std::vector<std::vector<size_t>>&       neighborLists = getCurrentState()->getFluidNeighborLists();
+    const std::vector<NeighborInfo>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&          infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
+    const NeighborList&              neighborLists = getCurrentState()->getFluidNeighborLists();
 
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions
                 && (m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer
@@ -486,8 +683,7 @@ SphModel::computeViscosity()
                 return;
             }
 
-            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 neighborVelContr[p] = Vec3d::Zero();
                 viscousAccels[p]    = Vec3d::Zero();
@@ -498,11 +694,12 @@ SphModel::computeViscosity()
             double neighborVelContributionsDenominator = 0.0;
             Vec3d particleShifts = Vec3d::Zero();
 
-            const Vec3d& pvel = halfStepVelocities[p];
-            const std::vector<size_t>& fluidNeighborList = neighborLists[p];
+            const Vec3d&        pvel = halfStepVelocities[p];
+            const NeighborInfo* neighborInfo      = neighborInfos.data() + infoOffsets[p];
+            const int*          fluidNeighborList = neighborLists.getNeighbors(p);
 
             Vec3d diffuseFluid = Vec3d::Zero();
-            for (size_t i = 0; i < fluidNeighborList.size(); ++i)
+            for (int i = 0; i < neighborLists.getNumNeighbors(p); ++i)
             {
                 const auto q        = fluidNeighborList[i];
                 const auto& qvel    = halfStepVelocities[q];
@@ -532,11 +729,12 @@ SphModel::computeSurfaceTension()
 {
     VecDataArray<double, 3>& surfaceNormals = *getCurrentState()->getNormals();
 
-    const std::vector<std::vector<NeighborInfo>>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<NeighborInfo>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<int>&          infoOffsets   = getCurrentState()->getNeighborInfoOffsets();
 
     // First, compute surface normal for all particles
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions && m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer)
             {
@@ -544,16 +742,15 @@ SphModel::computeSurfaceTension()
             }
 
             Vec3d n(0.0, 0.0, 0.0);
-            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
-            if (neighborInfo.size() <= 1)
+            if (infoOffsets[p + 1] - infoOffsets[p] <= 1)
             {
                 surfaceNormals[p] = n;
                 return;
             }
 
-            for (size_t i = 0; i < neighborInfo.size(); ++i)
+            for (int i = infoOffsets[p]; i < infoOffsets[p + 1]; ++i)
             {
-                const auto& qInfo   = neighborInfo[i];
+                const auto& qInfo   = neighborInfos[i];
                 const auto r        = qInfo.relativePos;
                 const auto qdensity = qInfo.density;
                 n += (1.0 / qdensity) * m_kernels.gradW(r);
@@ -566,11 +763,11 @@ SphModel::computeSurfaceTension()
     VecDataArray<double, 3>& surfaceTensionAccels = *m_surfaceTensionAccels;
     const DataArray<double>& densities = *getCurrentState()->getDensities();
 
-    const std::vector<std::vector<size_t>>& neighborLists = getCurrentState()->getFluidNeighborLists();
+    const NeighborList& neighborLists = getCurrentState()->getFluidNeighborLists();
 
     // Second, compute surface tension acceleration
     ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
-        [&](const size_t p)
+        [&](const int p)
         {
             if (m_sphBoundaryConditions
                 && (m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer
@@ -579,20 +776,21 @@ SphModel::computeSurfaceTension()
                 return;
             }
 
-            const std::vector<size_t>& fluidNeighborList = neighborLists[p];
-            if (fluidNeighborList.size() <= 1)
+            const int numFluidNeighbors = neighborLists.getNumNeighbors(p);
+            if (numFluidNeighbors <= 1)
             {
                 return; // the particle has no neighbor
             }
 
-            const Vec3d& ni          = surfaceNormals[p];
-            const double pdensity    = densities[p];
-            const auto& neighborInfo = neighborInfos[p];
+            const Vec3d&        ni = surfaceNormals[p];
+            const double        pdensity          = densities[p];
+            const NeighborInfo* neighborInfo      = neighborInfos.data() + infoOffsets[p];
+            const int*          fluidNeighborList = neighborLists.getNeighbors(p);
 
             Vec3d accel = Vec3d::Zero();
-            for (size_t i = 0; i < fluidNeighborList.size(); ++i)
+            for (int i = 0; i < numFluidNeighbors; ++i)
             {
-                const size_t q = fluidNeighborList[i];
+                const int q = fluidNeighborList[i];
                 if (p == q)
                 {
                     continue;
@@ -644,6 +842,237 @@ SphModel::sumAccels()
       });
 }
 
+void
+SphModel::computeDensityFused()
+{
+    std::shared_ptr<VecDataArray<double, 3>> positionsPtr = getCurrentState()->getPositions();
+    const VecDataArray<double, 3>&           positions = *positionsPtr;
+    const VecDataArray<double, 3>&           boundaryPositions = *getCurrentState()->getBoundaryParticlePositions();
+    DataArray<double>&                       densities      = *getCurrentState()->getDensities();
+    VecDataArray<double, 3>&                 surfaceNormals = *getCurrentState()->getNormals();
+
+    const NeighborList& fluidNeighborLists    = getCurrentState()->getFluidNeighborLists();
+    const NeighborList& boundaryNeighborLists = getCurrentState()->getBoundaryNeighborLists();
+    const bool          withBoundary = m_modelParameters->m_bDensityWithBoundary;
+    const double        restDensity  = m_modelParameters->m_restDensity;
+    const double        particleMass = m_modelParameters->m_particleMass;
+
+    auto isBuffer = [&](const int p)
+                    {
+                        return m_sphBoundaryConditions
+                               && m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer;
+                    };
+    auto hasNeighbors = [&](const int p)
+                        {
+                            const int numNeighbors = fluidNeighborLists.getNumNeighbors(p)
+                                                     + (withBoundary ? boundaryNeighborLists.getNumNeighbors(p) : 0);
+                            return numNeighbors > 1;
+                        };
+
+    const int numParticles = static_cast<int>(getCurrentState()->getNumParticles());
+
+    // Densities
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int p)
+        {
+            if (isBuffer(p) || !hasNeighbors(p))
+            {
+                return;
+            }
+
+            const Vec3d& ppos = positions[p];
+            const int*   fluidNeighborList = fluidNeighborLists.getNeighbors(p);
+            double       pdensity = 0.0;
+            for (int i = 0; i < fluidNeighborLists.getNumNeighbors(p); ++i)
+            {
+                pdensity += m_kernels.W(ppos - positions[fluidNeighborList[i]]);
+            }
+            if (withBoundary)
+            {
+                const int* boundaryNeighborList = boundaryNeighborLists.getNeighbors(p);
+                for (int i = 0; i < boundaryNeighborLists.getNumNeighbors(p); ++i)
+                {
+                    pdensity += m_kernels.W(ppos - boundaryPositions[boundaryNeighborList[i]]);
+                }
+            }
+            densities[p] = pdensity * particleMass;
+        });
+
+    // Normalization reads the densities of all fluid neighbors, so it needs its own pass
+    if (m_modelParameters->m_bNormalizeDensity)
+    {
+        m_unnormalizedDensities.assign(densities.getPointer(), densities.getPointer() + densities.size());
+
+        ParallelUtils::parallelFor(numParticles,
+            [&](const int p)
+            {
+                if (isBuffer(p) || !hasNeighbors(p))
+                {
+                    return;
+                }
+
+                const Vec3d& ppos = positions[p];
+                const int*   fluidNeighborList = fluidNeighborLists.getNeighbors(p);
+                double       tmp = 0.0;
+                for (int i = 0; i < fluidNeighborLists.getNumNeighbors(p); ++i)
+                {
+                    const int q = fluidNeighborList[i];
+                    tmp += m_kernels.W(ppos - positions[q]) / m_unnormalizedDensities[q];
+                }
+                densities[p] /= (tmp * particleMass);
+            });
+    }
+
+    // Surface normals, from the final densities. Boundary particles are at rest density
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int p)
+        {
+            if (isBuffer(p))
+            {
+                return;
+            }
+
+            Vec3d n(0.0, 0.0, 0.0);
+            if (!hasNeighbors(p))
+            {
+                surfaceNormals[p] = n;
+                return;
+            }
+
+            const Vec3d& ppos = positions[p];
+            const int*   fluidNeighborList = fluidNeighborLists.getNeighbors(p);
+            for (int i = 0; i < fluidNeighborLists.getNumNeighbors(p); ++i)
+            {
+                const int q = fluidNeighborList[i];
+                n += (1.0 / densities[q]) * m_kernels.gradW(ppos - positions[q]);
+            }
+            if (withBoundary)
+            {
+                const int* boundaryNeighborList = boundaryNeighborLists.getNeighbors(p);
+                for (int i = 0; i < boundaryNeighborLists.getNumNeighbors(p); ++i)
+                {
+                    n += (1.0 / restDensity) * m_kernels.gradW(ppos - boundaryPositions[boundaryNeighborList[i]]);
+                }
+            }
+
+            n *= m_modelParameters->m_kernelRadius * particleMass;
+            surfaceNormals[p] = n;
+        });
+}
+
+void
+SphModel::computeForcesFused()
+{
+    const VecDataArray<double, 3>& positions = *getCurrentState()->getPositions();
+    const VecDataArray<double, 3>& boundaryPositions  = *getCurrentState()->getBoundaryParticlePositions();
+    const VecDataArray<double, 3>& halfStepVelocities = *getCurrentState()->getHalfStepVelocities();
+    const VecDataArray<double, 3>& surfaceNormals     = *getCurrentState()->getNormals();
+    const DataArray<double>&       densities = *getCurrentState()->getDensities();
+    VecDataArray<double, 3>&       accels    = *getCurrentState()->getAccelerations();
+
+    VecDataArray<double, 3>& pressureAccels       = *m_pressureAccels;
+    VecDataArray<double, 3>& viscousAccels        = *m_viscousAccels;
+    VecDataArray<double, 3>& surfaceTensionAccels = *m_surfaceTensionAccels;
+    VecDataArray<double, 3>& neighborVelContr     = *m_neighborVelContr;
+    VecDataArray<double, 3>& particleShift = *m_particleShift;
+
+    const NeighborList& fluidNeighborLists    = getCurrentState()->getFluidNeighborLists();
+    const NeighborList& boundaryNeighborLists = getCurrentState()->getBoundaryNeighborLists();
+    const bool          withBoundary = m_modelParameters->m_bDensityWithBoundary;
+    const double        restDensity  = m_modelParameters->m_restDensity;
+    const double        particleMass = m_modelParameters->m_particleMass;
+
+    ParallelUtils::parallelFor(getCurrentState()->getNumParticles(),
+        [&](const int p)
+        {
+            // Wall particles do not move, only their densities and normals are used by their neighbors
+            if (m_sphBoundaryConditions
+                && (m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer
+                    || m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Wall))
+            {
+                return;
+            }
+
+            const int numFluidNeighbors    = fluidNeighborLists.getNumNeighbors(p);
+            const int numBoundaryNeighbors = withBoundary ? boundaryNeighborLists.getNumNeighbors(p) : 0;
+            if (numFluidNeighbors + numBoundaryNeighbors <= 1)
+            {
+                pressureAccels[p]       = Vec3d::Zero();
+                viscousAccels[p]        = Vec3d::Zero();
+                surfaceTensionAccels[p] = Vec3d::Zero();
+                neighborVelContr[p]     = Vec3d::Zero();
+                accels[p] = Vec3d::Zero();
+                return;
+            }
+
+            const Vec3d& ppos      = positions[p];
+            const Vec3d& pvel      = halfStepVelocities[p];
+            const Vec3d& ni        = surfaceNormals[p];
+            const double pdensity  = densities[p];
+            const double ppressure = getParticlePressure(pdensity);
+            const double pPressureTerm = ppressure / (pdensity * pdensity);
+
+            Vec3d  pressureAccel = Vec3d::Zero();
+            Vec3d  diffuseFluid  = Vec3d::Zero();
+            Vec3d  surfaceTensionAccel = Vec3d::Zero();
+            Vec3d  neighborVelContributionsNumerator   = Vec3d::Zero();
+            double neighborVelContributionsDenominator = 0.0;
+            Vec3d  particleShifts = Vec3d::Zero();
+
+            const int* fluidNeighborList = fluidNeighborLists.getNeighbors(p);
+            for (int i = 0; i < numFluidNeighbors; ++i)
+            {
+                const int    q        = fluidNeighborList[i];
+                const Vec3d  r        = ppos - positions[q];
+                const double qdensity = densities[q];
+                const Vec3d  gradW    = m_kernels.gradW(r);
+                const double W        = m_kernels.W(r);
+
+                // Pressure
+                const double qpressure = getParticlePressure(qdensity);
+                pressureAccel -= (pPressureTerm + qpressure / (qdensity * qdensity)) * gradW;
+
+                // Viscosity and XSPH velocity correction
+                const Vec3d& qvel = halfStepVelocities[q];
+                diffuseFluid += (1.0 / qdensity) * m_kernels.laplace(r) * (qvel - pvel);
+                neighborVelContributionsNumerator   += (qvel - pvel) * W;
+                neighborVelContributionsDenominator += W;
+                particleShifts += gradW;
+
+                // Surface tension, cohesion and curvature
+                if (p != q)
+                {
+                    const double K_ij = 2.0 * restDensity / (pdensity + qdensity);
+                    const double d2   = r.squaredNorm();
+                    if (d2 > 1.0e-20)
+                    {
+                        surfaceTensionAccel -= K_ij * particleMass * (r / std::sqrt(d2)) * m_kernels.cohesionW(r);
+                    }
+                    surfaceTensionAccel -= K_ij * (ni - surfaceNormals[q]);
+                }
+            }
+
+            // Boundary particles only contribute pressure, at rest density
+            const int*   boundaryNeighborList = boundaryNeighborLists.getNeighbors(p);
+            const double boundaryPressureTerm = getParticlePressure(restDensity) / (restDensity * restDensity);
+            for (int i = 0; i < numBoundaryNeighbors; ++i)
+            {
+                const Vec3d r = ppos - boundaryPositions[boundaryNeighborList[i]];
+                pressureAccel -= (pPressureTerm + boundaryPressureTerm) * m_kernels.gradW(r);
+            }
+
+            const double particleRadius = m_modelParameters->m_particleRadius;
+            particleShifts *= 4 / 3 * PI * particleRadius * particleRadius * particleRadius * 0.5 * m_modelParameters->m_kernelRadius * pvel.norm();
+
+            pressureAccels[p]       = pressureAccel * particleMass;
+            viscousAccels[p]        = diffuseFluid * m_modelParameters->m_dynamicViscosityCoeff * particleMass;
+            surfaceTensionAccels[p] = surfaceTensionAccel * m_modelParameters->m_surfaceTensionStiffness;
+            neighborVelContr[p]     = neighborVelContributionsNumerator * m_modelParameters->m_eta / neighborVelContributionsDenominator;
+            particleShift[p]        = -particleShifts;
+            accels[p] = pressureAccels[p] + surfaceTensionAccels[p] + viscousAccels[p];
+        });
+}
+
 void
 SphModel::updateVelocity(const double timestep)
 {
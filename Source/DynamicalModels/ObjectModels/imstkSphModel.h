@@ -72,6 +72,12 @@ public:
 
     // neighbor search
     NeighborSearch::Method m_neighborSearchMethod = NeighborSearch::Method::UniformGridBasedSearch;
+
+    // memory layout
+    int m_reorderInterval = 0; ///< sort particles in memory by grid cell every this many steps, 0 to keep creation order
+
+    // kernels
+    bool m_useFusedKernels = false; ///< compute density, then all forces, in single passes over the neighbors without caching neighbor information
 };
 
 ///
@@ -97,7 +103,7 @@ public:
     ///
     /// \brief Reset the current state to the initial state
     ///
-    void resetToInitialState() override { this->m_currentState->setState(this->m_initialState); }
+    void resetToInitialState() override;
 
     ///
     /// \brief Get the simulation parameters
@@ -135,6 +141,12 @@ public:
     ///
     void findNearestParticleToVertex(const VecDataArray<double, 3>& points, const std::vector<std::vector<size_t>>& indices);
 
+    ///
+    /// \brief Returns the current index of the particle with the given id, its index when
+    /// created. Particles move in memory when SphModelConfig::m_reorderInterval is set
+    ///
+    int getParticleIndex(const int particleId) const;
+
     void setBoundaryConditions(std::shared_ptr<SphBoundaryConditions> sphBoundaryConditions) { m_sphBoundaryConditions = sphBoundaryConditions; }
     std::shared_ptr<SphBoundaryConditions> getBoundaryConditions() { return m_sphBoundaryConditions; }
 
@@ -150,6 +162,8 @@ public:
     std::shared_ptr<TaskNode> getComputeViscosityNode() const { return m_computeViscosityNode; }
     std::shared_ptr<TaskNode> getUpdateVelocityNode() const { return m_updateVelocityNode; }
     std::shared_ptr<TaskNode> getMoveParticlesNode() const { return m_moveParticlesNode; }
+    std::shared_ptr<TaskNode> getComputeDensityFusedNode() const { return m_computeDensityFusedNode; }
+    std::shared_ptr<TaskNode> getComputeForcesFusedNode() const { return m_computeForcesFusedNode; }
 
 protected:
     ///
@@ -168,6 +182,12 @@ private:
     ///
     double computeCFLTimeStepSize();
 
+    ///
+    /// \brief Sort the particles in memory by the Morton code of their grid cell, so
+    /// that neighbors are mostly close in memory. Permutes every per particle array
+    ///
+    void reorderParticles();
+
     ///
     /// \brief Find the neighbors for each particle
     ///
@@ -226,6 +246,18 @@ private:
     ///
     void moveParticles(const double timestep);
 
+    ///
+    /// \brief Compute particle densities, normalized if enabled, then surface normals,
+    /// with relative positions computed on the fly. Used with SphModelConfig::m_useFusedKernels
+    ///
+    void computeDensityFused();
+
+    ///
+    /// \brief Compute pressure, viscosity and surface tension accelerations and their sum
+    /// in a single pass over the neighbors. Used with SphModelConfig::m_useFusedKernels
+    ///
+    void computeForcesFused();
+
 //void computePressureOutlet();
 
 protected:
@@ -241,6 +273,8 @@ protected:
     std::shared_ptr<TaskNode> m_moveParticlesNode          = nullptr;
     std::shared_ptr<TaskNode> m_normalizeDensityNode       = nullptr;
     std::shared_ptr<TaskNode> m_collectNeighborDensityNode = nullptr;
+    std::shared_ptr<TaskNode> m_computeDensityFusedNode    = nullptr;
+    std::shared_ptr<TaskNode> m_computeForcesFusedNode     = nullptr;
 
 private:
     std::shared_ptr<PointSet> m_pointSetGeometry;
@@ -266,5 +300,11 @@ private:
     std::shared_ptr<SphBoundaryConditions> m_sphBoundaryConditions = nullptr;
 
     std::vector<size_t> m_minIndices;
+
+    std::vector<double> m_unnormalizedDensities; ///< Densities before normalizeDensity
+
+    std::vector<std::pair<uint64_t, int>> m_reorderKeys; ///< Morton code and index of every particle
+    std::vector<int> m_reorderPermutation;               ///< Index every particle takes its values from
+    std::vector<int> m_particleIndices;                  ///< Current index of every particle id, empty until reordered
 };
 } // namespace imstk
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "imstkLogger.h"
 #include "imstkVecDataArray.h"
 
+#include <numeric>
+
 namespace imstk
 {
 SphState::SphState(const int numElements) :
@@ -19,7 +21,8 @@ SphState::SphState(const int numElements) :
     m_densities(std::make_shared<DataArray<double>>(numElements)),
     m_normals(std::make_shared<VecDataArray<double, 3>>(numElements)),
     m_acceleration(std::make_shared<VecDataArray<double, 3>>(numElements)),
-    m_diffuseVelocities(std::make_shared<VecDataArray<double, 3>>(numElements))
+    m_diffuseVelocities(std::make_shared<VecDataArray<double, 3>>(numElements)),
+    m_particleIds(std::make_shared<DataArray<int>>(numElements))
 {
     std::fill_n(m_densities->getPointer(), m_densities->size(), 1.0);
     std::fill_n(m_acceleration->getPointer(), m_acceleration->size(), Vec3d(0, 0, 0));
@@ -27,9 +30,10 @@ SphState::SphState(const int numElements) :
     std::fill_n(m_velocities->getPointer(), m_velocities->size(), Vec3d(0.0, 0.0, 0.0));
     std::fill_n(m_halfStepVelocities->getPointer(), m_halfStepVelocities->size(), Vec3d(0.0, 0.0, 0.0));
     std::fill_n(m_fullStepVelocities->getPointer(), m_fullStepVelocities->size(), Vec3d(0.0, 0.0, 0.0));
+    std::iota(m_particleIds->getPointer(), m_particleIds->getPointer() + m_particleIds->size(), 0);
 
-    m_neighborInfo.resize(static_cast<size_t>(numElements));
-    m_neighborLists.resize(static_cast<size_t>(numElements));
+    m_neighborInfoOffsets.assign(static_cast<size_t>(numElements) + 1, 0);
+    m_neighborLists.resize(numElements);
 }
 
 void
@@ -44,10 +48,12 @@ SphState::setState(std::shared_ptr<SphState> rhs)
     *m_normals           = *rhs->getNormals();
     *m_acceleration      = *rhs->getAccelerations();
     *m_diffuseVelocities = *rhs->getDiffuseVelocities();
+    *m_particleIds       = *rhs->getParticleIds();
 
     m_neighborLists = rhs->getFluidNeighborLists();
     m_boundaryParticleNeighborLists = rhs->getBoundaryNeighborLists();
     m_neighborInfo = rhs->getNeighborInfo();
+    m_neighborInfoOffsets = rhs->getNeighborInfoOffsets();
 
     m_positions->postModified();
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkMath.h"
+#include "imstkNeighborList.h"
 
 namespace imstk
 {
@@ -97,24 +98,38 @@ public:
     std::shared_ptr<VecDataArray<double, 3>> getDiffuseVelocities() const { return m_diffuseVelocities; }
 
     ///
-    /// \brief Returns the vector of neighbor fluid particles
+    /// \brief Returns the id of every particle, its index when created. Particles keep
+    /// their id when SphModel reorders them in memory
+    ///
+    std::shared_ptr<DataArray<int>> getParticleIds() const { return m_particleIds; }
+
+    ///
+    /// \brief Returns the neighbor fluid particles of every particle
+    ///@{
+    NeighborList& getFluidNeighborLists() { return m_neighborLists; }
+    const NeighborList& getFluidNeighborLists() const { return m_neighborLists; }
+    ///@}
+
+    ///
+    /// \brief Returns the neighbor boundary particles of every particle
     ///@{
-    std::vector<std::vector<size_t>>& getFluidNeighborLists() { return m_neighborLists; }
-    const std::vector<std::vector<size_t>>& getFluidNeighborLists() const { return m_neighborLists; }
+    NeighborList& getBoundaryNeighborLists() { return m_boundaryParticleNeighborLists; }
+    const NeighborList& getBoundaryNeighborLists() const { return m_boundaryParticleNeighborLists; }
     ///@}
 
     ///
-    /// \brief Returns the vector of neighbor of boundary particles
+    /// \brief Returns the neighbor information ( {relative position, density} ) of all particles, which is cached for other computation.
+    /// The information of particle p starts at getNeighborInfoOffsets()[p], fluid neighbors first, then boundary neighbors
     ///@{
-    std::vector<std::vector<size_t>>& getBoundaryNeighborLists() { return m_boundaryParticleNeighborLists; }
-    const std::vector<std::vector<size_t>>& getBoundaryNeighborLists() const { return m_boundaryParticleNeighborLists; }
+    std::vector<NeighborInfo>& getNeighborInfo() { return m_neighborInfo; }
+    const std::vector<NeighborInfo>& getNeighborInfo() const { return m_neighborInfo; }
     ///@}
 
     ///
-    /// \brief Returns the vector of neighbor information ( {relative position, density} ), which is cached for other computation
+    /// \brief Returns the offset of the neighbor information of every particle, one past the last particle included
     ///@{
-    std::vector<std::vector<NeighborInfo>>& getNeighborInfo() { return m_neighborInfo; }
-    const std::vector<std::vector<NeighborInfo>>& getNeighborInfo() const { return m_neighborInfo; }
+    std::vector<int>& getNeighborInfoOffsets() { return m_neighborInfoOffsets; }
+    const std::vector<int>& getNeighborInfoOffsets() const { return m_neighborInfoOffsets; }
     ///@}
 
     ///
@@ -134,9 +149,11 @@ private:
     std::shared_ptr<VecDataArray<double, 3>> m_normals;                     ///<  surface normals
     std::shared_ptr<VecDataArray<double, 3>> m_acceleration;                ///<  acceleration
     std::shared_ptr<VecDataArray<double, 3>> m_diffuseVelocities;           ///<  velocity diffusion, used for computing viscosity
+    std::shared_ptr<DataArray<int>>          m_particleIds;                 ///<  id of each particle, its index when created
 
-    std::vector<std::vector<size_t>>       m_neighborLists;                 ///<  store a list of neighbors for each particle, updated each time step
-    std::vector<std::vector<size_t>>       m_boundaryParticleNeighborLists; ///<  store a list of boundary particle neighbors for each particle, updated each time step
-    std::vector<std::vector<NeighborInfo>> m_neighborInfo;                  ///<  store a list of Vec4d(Vec3d(relative position), density) for neighbors, including boundary particle
+    NeighborList              m_neighborLists;                 ///<  store a list of neighbors for each particle, updated each time step
+    NeighborList              m_boundaryParticleNeighborLists; ///<  store a list of boundary particle neighbors for each particle, updated each time step
+    std::vector<NeighborInfo> m_neighborInfo;                  ///<  store a list of Vec4d(Vec3d(relative position), density) for neighbors, including boundary particle
+    std::vector<int>          m_neighborInfoOffsets;           ///<  offset of the neighbor information of each particle
 };
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,345 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Adds a deformable chain of particles hanging from its first, fixed, particle
+///
+std::shared_ptr<PbdBody>
+addChain(PbdModel& model, const int numParticles, const Vec3d& start)
+{
+    std::shared_ptr<PbdBody> body = model.addBody();
+    body->vertices     = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    body->velocities   = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    body->masses       = std::make_shared<DataArray<double>>(numParticles);
+    body->invMasses    = std::make_shared<DataArray<double>>(numParticles);
+    body->velocities->fill(Vec3d::Zero());
+    body->masses->fill(1.0);
+    body->invMasses->fill(1.0);
+    (*body->invMasses)[0] = 0.0;
+    for (int i = 0; i < numParticles; i++)
+    {
+        (*body->vertices)[i] = start + Vec3d(0.1 * i, 0.0, 0.0);
+    }
+    body->prevVertices = std::make_shared<VecDataArray<double, 3>>(*body->vertices);
+
+    const int bodyIndex = static_cast<int>(model.getBodies().m_bodies.size()) - 1;
+    for (int i = 0; i < numParticles - 1; i++)
+    {
+        auto constraint = std::make_shared<PbdDistanceConstraint>();
+        constraint->initConstraint(0.1, { bodyIndex, i }, { bodyIndex, i + 1 }, 1.0e5);
+        model.getConstraints()->addConstraint(constraint);
+    }
+    return body;
+}
+
+///
+/// \brief Adds a free unit rigid body
+///
+std::shared_ptr<PbdBody>
+addRigid(PbdModel& model, const Vec3d& pos)
+{
+    std::shared_ptr<PbdBody> rigid = model.addBody();
+    rigid->setRigid(pos);
+    rigid->prevVertices     = std::make_shared<VecDataArray<double, 3>>(*rigid->vertices);
+    rigid->prevOrientations = std::make_shared<StdVectorOfQuatd>(*rigid->orientations);
+    rigid->setRigidVelocity(Vec3d::Zero());
+    rigid->masses      = std::make_shared<DataArray<double>>(1);
+    rigid->invMasses   = std::make_shared<DataArray<double>>(1);
+    rigid->invInertias = std::make_shared<StdVectorOfMat3d>(1, Mat3d::Identity());
+    (*rigid->masses)[0]    = 1.0;
+    (*rigid->invMasses)[0] = 1.0;
+    return rigid;
+}
+
+///
+/// \brief Simulates two chains and a rigid body
+/// \return positions of all particles of the chains
+///
+std::vector<Vec3d>
+simulateChains(const bool contiguousStorage, const int numSteps)
+{
+    auto config = std::make_shared<PbdModelConfig>();
+    config->m_doContiguousStorage = contiguousStorage;
+    config->m_dt = 0.01;
+    auto model = std::make_shared<PbdModel>();
+    model->configure(config);
+
+    std::shared_ptr<PbdBody> chainA = addChain(*model, 100, Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<PbdBody> rigid  = addRigid(*model, Vec3d(0.0, 1.0, 0.0));
+    std::shared_ptr<PbdBody> chainB = addChain(*model, 60, Vec3d(0.0, 0.0, 1.0));
+    chainB->bodyGravity = false;
+
+    model->initialize();
+
+    for (int i = 0; i < numSteps; i++)
+    {
+        chainB->externalForce = Vec3d(0.0, 0.0, 1.0);
+        model->integratePosition();
+        model->solveConstraints();
+        model->updateVelocity();
+    }
+
+    std::vector<Vec3d> results(chainA->vertices->begin(), chainA->vertices->end());
+    results.insert(results.end(), chainB->vertices->begin(), chainB->vertices->end());
+    results.push_back(rigid->getRigidPosition());
+    return results;
+}
+} // namespace
+
+///
+/// \brief Test simulating with contiguous storage gives the same results
+///
+TEST(imstkPbdModelTest, TestContiguousStorageResults)
+{
+    const std::vector<Vec3d> expected = simulateChains(false, 20);
+    const std::vector<Vec3d> results  = simulateChains(true, 20);
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT_TRUE(results[i].isApprox(expected[i], 1.0e-12)) << "particle " << i;
+    }
+}
+
+///
+/// \brief Test the bodies share memory with the storage, and it is rebuilt
+/// when a body reallocates and released when disabled
+///
+TEST(imstkPbdModelTest, TestContiguousStorageMapping)
+{
+    auto config = std::make_shared<PbdModelConfig>();
+    config->m_doContiguousStorage = true;
+    auto model = std::make_shared<PbdModel>();
+    model->configure(config);
+
+    std::shared_ptr<PbdBody>                 chainA = addChain(*model, 10, Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<PbdBody>                 chainB = addChain(*model, 5, Vec3d(0.0, 0.0, 1.0));
+    std::shared_ptr<VecDataArray<double, 3>> verticesA = chainA->vertices;
+    model->initialize();
+
+    PbdState& state = model->getBodies();
+    ASSERT_NE(state.m_particleStorage, nullptr);
+    EXPECT_EQ(state.m_particleStorage->getNumParticles(), 15);
+    EXPECT_EQ(state.getGlobalParticleId({ 0, 0 }), -1);
+    EXPECT_EQ(state.getGlobalParticleId({ 2, 3 }), 3);
+    EXPECT_EQ(state.getGlobalParticleId({ 3, 2 }), 12);
+    EXPECT_EQ(&state.getPosition({ 3, 2 }), &state.m_particleStorage->vertices[12]);
+    EXPECT_EQ(chainA->vertices, verticesA);
+    EXPECT_EQ((*verticesA)[9], Vec3d(0.9, 0.0, 0.0));
+
+    // Replace an array, ie: as a topology change would
+    chainB->vertices = std::make_shared<VecDataArray<double, 3>>(6);
+    chainB->vertices->fill(Vec3d(1.0, 2.0, 3.0));
+    chainB->prevVertices = std::make_shared<VecDataArray<double, 3>>(*chainB->vertices);
+    chainB->velocities   = std::make_shared<VecDataArray<double, 3>>(6);
+    chainB->masses       = std::make_shared<DataArray<double>>(6);
+    chainB->invMasses    = std::make_shared<DataArray<double>>(6);
+    model->updateParticleStorage();
+    EXPECT_EQ(state.m_particleStorage->getNumParticles(), 16);
+    EXPECT_EQ(&state.getPosition({ 3, 5 }), &state.m_particleStorage->vertices[15]);
+    EXPECT_EQ(state.getPosition({ 3, 5 }), Vec3d(1.0, 2.0, 3.0));
+    EXPECT_EQ((*verticesA)[9], Vec3d(0.9, 0.0, 0.0));
+
+    // Reset copies the initial state into the mapped arrays
+    (*verticesA)[9] = Vec3d::Zero();
+    model->resetToInitialState();
+    EXPECT_EQ(&(*verticesA)[9], &state.m_particleStorage->vertices[9]);
+    EXPECT_EQ((*verticesA)[9], Vec3d(0.9, 0.0, 0.0));
+
+    config->m_doContiguousStorage = false;
+    model->updateParticleStorage();
+    EXPECT_EQ(state.m_particleStorage, nullptr);
+    EXPECT_EQ(chainA->vertices, verticesA);
+    EXPECT_EQ((*verticesA)[9], Vec3d(0.9, 0.0, 0.0));
+    verticesA->push_back(Vec3d::Zero());
+    EXPECT_EQ(verticesA->size(), 11);
+}
+
+///
+/// \brief Test arrays shared with geometry stay valid once their body is
+/// removed or the model is destroyed
+///
+TEST(imstkPbdModelTest, TestContiguousStorageLifetime)
+{
+    auto config = std::make_shared<PbdModelConfig>();
+    config->m_doContiguousStorage = true;
+    config->m_dt = 0.01;
+    auto model = std::make_shared<PbdModel>();
+    model->configure(config);
+
+    std::shared_ptr<PbdBody>                 chainA    = addChain(*model, 10, Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<PbdBody>                 chainB    = addChain(*model, 5, Vec3d(0.0, 0.0, 1.0));
+    std::shared_ptr<VecDataArray<double, 3>> verticesA = chainA->vertices;
+    std::shared_ptr<VecDataArray<double, 3>> verticesB = chainB->vertices;
+    model->initialize();
+    model->integratePosition();
+    model->solveConstraints();
+    model->updateVelocity();
+    ASSERT_NE(model->getBodies().m_particleStorage, nullptr);
+
+    // A removed body keeps its values in its own memory when the storage is rebuilt
+    const std::vector<Vec3d> expectedB(verticesB->begin(), verticesB->end());
+    model->removeBody(chainB);
+    model->updateParticleStorage();
+    EXPECT_EQ(model->getBodies().m_particleStorage->getNumParticles(), 10);
+    EXPECT_EQ(std::vector<Vec3d>(verticesB->begin(), verticesB->end()), expectedB);
+    verticesB->push_back(Vec3d::Zero());
+    EXPECT_EQ(verticesB->size(), 6);
+
+    // Destroying the model leaves the geometry with its own copy of the values
+    const std::vector<Vec3d> expectedA(verticesA->begin(), verticesA->end());
+    chainA = nullptr;
+    chainB = nullptr;
+    model  = nullptr;
+    EXPECT_EQ(std::vector<Vec3d>(verticesA->begin(), verticesA->end()), expectedA);
+    verticesA->push_back(Vec3d::Zero());
+    EXPECT_EQ(verticesA->size(), 11);
+}
+
+///
+/// \brief Test restoring a snapshot rolls the bodies back and the ring
+/// only keeps the latest snapshots
+///
+TEST(imstkPbdModelTest, TestSnapshot)
+{
+    auto config = std::make_shared<PbdModelConfig>();
+    config->m_dt = 0.01;
+    auto model = std::make_shared<PbdModel>();
+    model->configure(config);
+
+    std::shared_ptr<PbdBody> chain = addChain(*model, 20, Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<PbdBody> rigid = addRigid(*model, Vec3d(0.0, 1.0, 0.0));
+    model->setNumSnapshots(2);
+    model->initialize();
+
+    auto step = [&]()
+                {
+                    rigid->externalTorque = Vec3d(1.0, 0.0, 0.0);
+                    model->integratePosition();
+                    model->solveConstraints();
+                    model->updateVelocity();
+                };
+    step();
+
+    const int                     id = model->takeSnapshot();
+    const VecDataArray<double, 3> vertices   = *chain->vertices;
+    const VecDataArray<double, 3> velocities = *chain->velocities;
+    const Quatd                   orientation = rigid->getRigidOrientation();
+    for (int i = 0; i < 10; i++)
+    {
+        step();
+    }
+    (*chain->masses)[5]    = 0.0;
+    (*chain->invMasses)[5] = 0.0;
+    EXPECT_FALSE(chain->vertices->at(19).isApprox(vertices[19]));
+    EXPECT_FALSE(rigid->getRigidOrientation().isApprox(orientation));
+
+    // Users of the geometry are told the vertices changed
+    int numModified = 0;
+    connect<Event>(chain->vertices, &AbstractDataArray::modified, [&](Event*) { numModified++; });
+
+    ASSERT_TRUE(model->restoreSnapshot(id));
+    for (int i = 0; i < 20; i++)
+    {
+        EXPECT_EQ((*chain->vertices)[i], vertices[i]);
+        EXPECT_EQ((*chain->velocities)[i], velocities[i]);
+    }
+    EXPECT_EQ((*chain->masses)[5], 1.0);
+    EXPECT_EQ((*chain->invMasses)[5], 1.0);
+    EXPECT_TRUE(rigid->getRigidOrientation().isApprox(orientation));
+    EXPECT_EQ(numModified, 1);
+
+    // Stepping from the restored state repeats the steps
+    const int id2 = model->takeSnapshot();
+    step();
+    const Vec3d end = (*chain->vertices)[19];
+    ASSERT_TRUE(model->restoreSnapshot(id2));
+    step();
+    EXPECT_EQ((*chain->vertices)[19], end);
+
+    // Ring of 2, the first snapshot is overwritten
+    model->takeSnapshot();
+    EXPECT_FALSE(model->hasSnapshot(id));
+    EXPECT_FALSE(model->restoreSnapshot(id));
+    EXPECT_TRUE(model->hasSnapshot(id2));
+
+    // Snapshots can't be restored once any array changed size
+    chain->masses->push_back(1.0);
+    EXPECT_FALSE(model->restoreSnapshot(id2));
+    chain->masses->resize(20);
+    EXPECT_TRUE(model->restoreSnapshot(id2));
+    chain->vertices->push_back(Vec3d::Zero());
+    EXPECT_FALSE(model->restoreSnapshot(id2));
+}
+
+///
+/// \brief Test substeps apply external forces over the whole step and, at
+/// equal solver cost, converge further than iterations
+///
+TEST(imstkPbdModelTest, TestSubsteps)
+{
+    auto stepChain = [](const unsigned int numSubsteps, const unsigned int numIterations)
+                     {
+                         auto config = std::make_shared<PbdModelConfig>();
+                         config->m_dt = 0.01;
+                         config->m_numSubsteps = numSubsteps;
+                         config->m_iterations  = numIterations;
+                         config->m_linearDampingCoeff = 0.0;
+                         auto model = std::make_shared<PbdModel>();
+                         model->configure(config);
+
+                         std::shared_ptr<PbdBody> chain = addChain(*model, 20, Vec3d(0.0, 0.0, 0.0));
+                         model->initialize();
+                         for (int i = 0; i < 10; i++)
+                         {
+                             model->integratePosition();
+                             model->solveConstraints();
+                             model->updateVelocity();
+                         }
+
+                         // Total stretch of the chain
+                         double stretch = 0.0;
+                         for (int i = 0; i < 19; i++)
+                         {
+                             stretch += std::abs(((*chain->vertices)[i + 1] - (*chain->vertices)[i]).norm() - 0.1);
+                         }
+                         return stretch;
+                     };
+    const double iterationsStretch = stepChain(1, 8);
+    const double substepsStretch   = stepChain(8, 1);
+    EXPECT_LT(substepsStretch, iterationsStretch);
+
+    // A single free particle pushed by an external force
+    auto config = std::make_shared<PbdModelConfig>();
+    config->m_dt = 0.01;
+    config->m_numSubsteps = 4;
+    config->m_gravity     = Vec3d::Zero();
+    config->m_linearDampingCoeff = 0.0;
+    auto model = std::make_shared<PbdModel>();
+    model->configure(config);
+    std::shared_ptr<PbdBody> body = addChain(*model, 1, Vec3d::Zero());
+    (*body->invMasses)[0] = 0.5;
+    model->initialize();
+    EXPECT_DOUBLE_EQ(model->getSubstepTimeStep(), 0.0025);
+
+    body->externalForce = Vec3d(1.0, 0.0, 0.0);
+    model->integratePosition();
+    model->solveConstraints();
+    model->updateVelocity();
+    EXPECT_TRUE((*body->velocities)[0].isApprox(Vec3d(0.005, 0.0, 0.0)));
+    EXPECT_TRUE((*body->vertices)[0].isApprox(Vec3d(0.0025 * 0.0025 * 0.5 * (1 + 2 + 3 + 4), 0.0, 0.0)));
+    EXPECT_TRUE(body->externalForce.isZero());
+}
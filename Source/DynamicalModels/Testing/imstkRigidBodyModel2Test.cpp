@@ -0,0 +1,100 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkRbdContactConstraint.h"
+#include "imstkRbdFrictionConstraint.h"
+#include "imstkRigidBodyModel2.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Simulates two spinning columns of three boxes on the floor, with contacts
+/// at the corners of every box and friction
+/// \return positions and orientations of the boxes
+///
+std::vector<std::pair<Vec3d, Quatd>>
+simulateBoxes(const bool matrixFree, const bool warmStart, const int numSteps)
+{
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_matrixFree = matrixFree;
+    rbdModel->getConfig()->m_warmStart  = warmStart;
+
+    const int                               numLayers = 3;
+    std::vector<std::shared_ptr<RigidBody>> bodies;
+    for (int x = 0; x < 2; x++)
+    {
+        for (int y = 0; y < numLayers; y++)
+        {
+            std::shared_ptr<RigidBody> body = rbdModel->addRigidBody();
+            body->m_mass = 1.0 + y;
+            body->m_intertiaTensor      = Vec3d(0.2, 0.3, 0.4).asDiagonal();
+            body->m_initPos             = Vec3d(x * 2.0, y + 0.49, 0.0);
+            body->m_initAngularVelocity = Vec3d(0.1 * y, 0.5, -0.2 * x);
+            bodies.push_back(body);
+        }
+    }
+    rbdModel->initialize();
+
+    std::vector<std::pair<Vec3d, Quatd>> results;
+    for (int i = 0; i < numSteps; i++)
+    {
+        const double dt = rbdModel->getTimeStep();
+        for (size_t j = 0; j < bodies.size(); j++)
+        {
+            const bool                 onFloor = (j % numLayers == 0);
+            std::shared_ptr<RigidBody> below   = onFloor ? nullptr : bodies[j - 1];
+            const RbdConstraint::Side  side    = onFloor ? RbdConstraint::Side::A : RbdConstraint::Side::AB;
+            const Vec3d&               pos     = bodies[j]->getPosition();
+            const double               bottom  = onFloor ? 0.0 : below->getPosition()[1] + 0.5;
+            const double               depth   = std::max(bottom - (pos[1] - 0.5), 0.0);
+            for (int corner = 0; corner < 4; corner++)
+            {
+                const Vec3d contactPt = pos + Vec3d((corner & 1) ? 0.5 : -0.5, -0.5, (corner & 2) ? 0.5 : -0.5);
+                auto        contact   = std::make_shared<RbdContactConstraint>(bodies[j], below,
+                    Vec3d(0.0, 1.0, 0.0), contactPt, depth, 0.05, side);
+                contact->compute(dt);
+                rbdModel->addConstraint(contact);
+            }
+            auto friction = std::make_shared<RbdFrictionConstraint>(bodies[j], below,
+                pos - Vec3d(0.0, 0.5, 0.0), Vec3d(0.0, 1.0, 0.0), depth, 0.5, side);
+            friction->compute(dt);
+            rbdModel->addConstraint(friction);
+        }
+        rbdModel->computeTentativeVelocities();
+        rbdModel->solveConstraints();
+        rbdModel->integrate();
+    }
+
+    for (const std::shared_ptr<RigidBody>& body : bodies)
+    {
+        results.push_back({ body->getPosition(), body->getOrientation() });
+    }
+    return results;
+}
+} // namespace
+
+///
+/// \brief Test that the matrix free solve matches the assembled solve
+///
+TEST(imstkRigidBodyModel2Test, TestMatrixFreeSolve)
+{
+    for (const bool warmStart : { false, true })
+    {
+        const std::vector<std::pair<Vec3d, Quatd>> expected   = simulateBoxes(false, warmStart, 50);
+        const std::vector<std::pair<Vec3d, Quatd>> matrixFree = simulateBoxes(true, warmStart, 50);
+
+        ASSERT_EQ(expected.size(), matrixFree.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_NEAR((expected[i].first - matrixFree[i].first).norm(), 0.0, 1.0e-10);
+            EXPECT_NEAR(expected[i].second.angularDistance(matrixFree[i].second), 0.0, 1.0e-8);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDataArray.h"
+#include "imstkPointSet.h"
+#include "imstkSequentialTaskGraphController.h"
+#include "imstkSphModel.h"
+#include "imstkTaskGraph.h"
+#include "imstkVecDataArray.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Simulates a falling block of fluid for a number of steps
+/// \return positions of the particles by id
+///
+VecDataArray<double, 3>
+simulateBlock(const int reorderInterval, const bool useFusedKernels, const int numSteps, std::shared_ptr<SphModel>& sphModel)
+{
+    // Lattice spacing is not a fraction of the kernel radius, so no neighbor lies exactly on it
+    const double particleRadius = 0.01;
+    auto         particlesPtr   = std::make_shared<VecDataArray<double, 3>>();
+    for (int z = 0; z < 6; z++)
+    {
+        for (int y = 0; y < 12; y++)
+        {
+            for (int x = 0; x < 6; x++)
+            {
+                particlesPtr->push_back(Vec3d(x, y, z) * 0.0213);
+            }
+        }
+    }
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(particlesPtr);
+
+    auto sphParams = std::make_shared<SphModelConfig>(particleRadius);
+    sphParams->m_bNormalizeDensity = true;
+    sphParams->m_reorderInterval   = reorderInterval;
+    sphParams->m_useFusedKernels   = useFusedKernels;
+
+    sphModel = std::make_shared<SphModel>();
+    sphModel->setModelGeometry(pointSet);
+    sphModel->configure(sphParams);
+    sphModel->setTimeStepSizeType(TimeSteppingType::Fixed);
+    sphModel->setDefaultTimeStep(0.001);
+    sphModel->initialize();
+    std::static_pointer_cast<AbstractDynamicalModel>(sphModel)->initGraphEdges();
+
+    // Only the nodes of the selected kernels are connected
+    auto controller = std::make_shared<SequentialTaskGraphController>();
+    controller->setTaskGraph(TaskGraph::removeUnusedNodes(sphModel->getTaskGraph()));
+    controller->initialize();
+    for (int i = 0; i < numSteps; i++)
+    {
+        controller->execute();
+    }
+
+    const VecDataArray<double, 3>& positions = *sphModel->getCurrentState()->getPositions();
+    VecDataArray<double, 3>        positionsById(positions.size());
+    for (int id = 0; id < positions.size(); id++)
+    {
+        positionsById[id] = positions[sphModel->getParticleIndex(id)];
+    }
+    return positionsById;
+}
+} // namespace
+
+///
+/// \brief Test that reordering particles in memory does not change the simulation
+///
+TEST(imstkSphModelTest, TestReorderParticles)
+{
+    std::shared_ptr<SphModel>     sphModel;
+    const VecDataArray<double, 3> expected  = simulateBlock(0, false, 12, sphModel);
+    const VecDataArray<double, 3> reordered = simulateBlock(5, false, 12, sphModel);
+
+    ASSERT_EQ(expected.size(), reordered.size());
+    for (int id = 0; id < expected.size(); id++)
+    {
+        EXPECT_NEAR((expected[id] - reordered[id]).norm(), 0.0, 1.0e-12);
+    }
+
+    // Ids follow the particles
+    const DataArray<int>& particleIds = *sphModel->getCurrentState()->getParticleIds();
+    bool                  isReordered = false;
+    for (int i = 0; i < particleIds.size(); i++)
+    {
+        EXPECT_EQ(sphModel->getParticleIndex(particleIds[i]), i);
+        isReordered = isReordered || (particleIds[i] != i);
+    }
+    EXPECT_TRUE(isReordered);
+
+    // Reset puts the particles back in creation order
+    sphModel->resetToInitialState();
+    for (int i = 0; i < particleIds.size(); i++)
+    {
+        EXPECT_EQ(particleIds[i], i);
+        EXPECT_EQ(sphModel->getParticleIndex(i), i);
+    }
+}
+
+///
+/// \brief Test that the fused kernels simulate the same as the separate kernels
+///
+TEST(imstkSphModelTest, TestFusedKernels)
+{
+    std::shared_ptr<SphModel>     sphModel;
+    const VecDataArray<double, 3> expected = simulateBlock(0, false, 20, sphModel);
+    const VecDataArray<double, 3> fused    = simulateBlock(0, true, 20, sphModel);
+
+    ASSERT_EQ(expected.size(), fused.size());
+    for (int id = 0; id < expected.size(); id++)
+    {
+        EXPECT_NEAR((expected[id] - fused[id]).norm(), 0.0, 1.0e-10);
+    }
+
+    // Also with reordering
+    const VecDataArray<double, 3> fusedReordered = simulateBlock(5, true, 20, sphModel);
+    for (int id = 0; id < expected.size(); id++)
+    {
+        EXPECT_NEAR((expected[id] - fusedReordered[id]).norm(), 0.0, 1.0e-10);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkGeometryUtilities.h"
+#include "imstkTetFemAssembler.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+using namespace imstk;
+
+namespace
+{
+const std::vector<TetFemAssembler::Material> materials = {
+    TetFemAssembler::Material::Linear,
+    TetFemAssembler::Material::Corotational,
+    TetFemAssembler::Material::StVK,
+    TetFemAssembler::Material::NeoHookean
+};
+
+std::shared_ptr<TetFemAssembler>
+makeAssembler(const TetFemAssembler::Material material, std::shared_ptr<TetrahedralMesh>& tetMesh)
+{
+    tetMesh = GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(1.0, 1.0, 1.0), Vec3i(3, 4, 3));
+    return std::make_shared<TetFemAssembler>(*tetMesh->getVertexPositions(),
+        *tetMesh->getCells(), material, 1.0e3, 0.4);
+}
+} // namespace
+
+///
+/// \brief Test the assembled stiffness is the derivative of the assembled force
+///
+TEST(imstkTetFemAssemblerTest, TestStiffnessMatchesForce)
+{
+    for (const TetFemAssembler::Material material : materials)
+    {
+        std::shared_ptr<TetrahedralMesh> tetMesh;
+        auto                             assembler = makeAssembler(material, tetMesh);
+        EXPECT_GT(assembler->getNumColors(), 1);
+
+        SparseMatrixd K;
+        assembler->getTangentStiffnessMatrixTopology(K);
+        const int numDofs = tetMesh->getNumVertices() * 3;
+        ASSERT_EQ(K.rows(), numDofs);
+
+        std::srand(0);
+        const Vectord u = Vectord::Random(numDofs) * 0.005;
+        Vectord       f;
+        assembler->compute(u, &f, &K);
+
+        // Central differences of the force along a random direction
+        const Vectord du = Vectord::Random(numDofs);
+        const double  h  = 1.0e-6;
+        Vectord       fPlus, fMinus;
+        assembler->compute(u + h * du, &fPlus, nullptr);
+        assembler->compute(u - h * du, &fMinus, nullptr);
+        const Vectord dfNumerical = (fPlus - fMinus) / (2.0 * h);
+        const Vectord df = K * du;
+
+        // The corotational stiffness omits the derivative of the rotation, small at small strains
+        const double tolerance = (material == TetFemAssembler::Material::Corotational) ? 0.05 : 1.0e-5;
+        EXPECT_LT((df - dfNumerical).norm(), tolerance * dfNumerical.norm()) << "Material " << static_cast<int>(material);
+        EXPECT_LT((Matrixd(K) - Matrixd(K).transpose()).norm(), 1.0e-9 * K.norm()) << "Material " << static_cast<int>(material);
+    }
+}
+
+///
+/// \brief Test no force at rest, and no force under rotation for rotation invariant materials
+///
+TEST(imstkTetFemAssemblerTest, TestRestAndRotation)
+{
+    for (const TetFemAssembler::Material material : materials)
+    {
+        std::shared_ptr<TetrahedralMesh> tetMesh;
+        auto                             assembler = makeAssembler(material, tetMesh);
+
+        const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+        const int                      numDofs  = tetMesh->getNumVertices() * 3;
+        Vectord                        f;
+        assembler->compute(Vectord::Zero(numDofs), &f, nullptr);
+        EXPECT_LT(f.norm(), 1.0e-9) << "Material " << static_cast<int>(material);
+
+        if (material != TetFemAssembler::Material::Linear)
+        {
+            const Mat3d rot = Rotd(0.7, Vec3d(1.0, 2.0, 3.0).normalized()).toRotationMatrix();
+            Vectord     u(numDofs);
+            for (int i = 0; i < vertices.size(); i++)
+            {
+                u.segment<3>(i * 3) = rot * vertices[i] - vertices[i];
+            }
+            assembler->compute(u, &f, nullptr);
+            EXPECT_LT(f.norm(), 1.0e-9) << "Material " << static_cast<int>(material);
+        }
+    }
+}
+
+///
+/// \brief Test the matrix-free product equals the product with the assembled stiffness
+///
+TEST(imstkTetFemAssemblerTest, TestMultiplyTangentStiffness)
+{
+    for (const TetFemAssembler::Material material : materials)
+    {
+        std::shared_ptr<TetrahedralMesh> tetMesh;
+        auto                             assembler = makeAssembler(material, tetMesh);
+
+        SparseMatrixd K;
+        assembler->getTangentStiffnessMatrixTopology(K);
+        std::srand(1);
+        const Vectord u = Vectord::Random(K.rows()) * 0.05;
+        const Vectord x = Vectord::Random(K.rows());
+        assembler->compute(u, nullptr, &K);
+
+        Vectord y;
+        assembler->linearize(u);
+        assembler->multiplyTangentStiffness(x, y);
+        EXPECT_LT((y - K * x).norm(), 1.0e-10 * (K * x).norm()) << "Material " << static_cast<int>(material);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkSphere.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshDistanceTransform.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Signed distance transform of a sphere, narrow banded and full, on a cubic image
+///
+static void
+BM_SurfaceMeshDistanceTransform(benchmark::State& state)
+{
+    auto mesh = GeometryUtils::toUVSphereSurfaceMesh(std::make_shared<Sphere>(Vec3d::Zero(), 1.0), 128, 128);
+
+    SurfaceMeshDistanceTransform toSdf;
+    toSdf.setInputMesh(mesh);
+    toSdf.setBounds(Vec3d(-1.5, -1.5, -1.5), Vec3d(1.5, 1.5, 1.5));
+    toSdf.setDimensions(state.range(0), state.range(0), state.range(0));
+    toSdf.setNarrowBanded(state.range(1) != 0);
+
+    state.counters["Triangles"] = mesh->getNumTriangles();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        toSdf.update();
+    }
+}
+
+BENCHMARK(BM_SurfaceMeshDistanceTransform)
+->Unit(benchmark::kMillisecond)
+->Name("SurfaceMeshDistanceTransform: Image Dimension, Narrow Banded")
+->ArgsProduct({ { 64, 128, 256 }, { 1, 0 } });
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -6,9 +6,11 @@
 
 #include "gtest/gtest.h"
 
+#include "imstkDataArray.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkImageData.h"
 #include "imstkOrientedBox.h"
+#include "imstkSphere.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkSurfaceMeshDistanceTransform.h"
 
@@ -61,4 +63,57 @@ TEST(SurfaceMeshDistanceTransformTest, FilterWithoutBounds)
 
     EXPECT_EQ(dimensions, image->getDimensions());
     EXPECT_TRUE(bounds.isApprox(image->getBounds()));
-}
\ No newline at end of file
+}
+
+///
+/// \brief Test the narrow banded and full transforms of a sphere against the
+/// analytic distance
+///
+TEST(SurfaceMeshDistanceTransformTest, SphereDistances)
+{
+    const double radius = 1.0;
+    auto         mesh   = GeometryUtils::toUVSphereSurfaceMesh(std::make_shared<Sphere>(Vec3d::Zero(), radius), 64, 64);
+
+    for (const bool narrowBanded : { true, false })
+    {
+        auto toSdf = std::make_shared<SurfaceMeshDistanceTransform>();
+        toSdf->setInputMesh(mesh);
+        toSdf->setBounds(Vec3d(-1.5, -1.5, -1.5), Vec3d(1.5, 1.5, 1.5));
+        toSdf->setDimensions(30, 30, 30);
+        toSdf->setNarrowBanded(narrowBanded);
+        toSdf->setDilateSize(2);
+        toSdf->update();
+
+        auto         image   = toSdf->getOutputImage();
+        auto         scalars = std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+        const Vec3d  spacing = image->getSpacing();
+        const Vec3d  shift   = image->getOrigin() + spacing * 0.5;
+        const double band    = 2.0 * spacing.maxCoeff();
+        for (int z = 0; z < 30; z++)
+        {
+            for (int y = 0; y < 30; y++)
+            {
+                for (int x = 0; x < 30; x++)
+                {
+                    const double expected = (Vec3d(x, y, z).cwiseProduct(spacing) + shift).norm() - radius;
+                    const double dist     = (*scalars)[image->getScalarIndex(x, y, z)];
+                    if (std::abs(expected) < band)
+                    {
+                        // Exact up to the tessellation of the sphere
+                        EXPECT_NEAR(dist, expected, 0.005);
+                    }
+                    else if (!narrowBanded)
+                    {
+                        // First order fast sweeping out of the band
+                        EXPECT_NEAR(dist, expected, spacing.maxCoeff());
+                    }
+                    else if (std::abs(expected) > 2.0 * band)
+                    {
+                        // Band is grown from the bounds of the triangles, far enough out of it
+                        EXPECT_EQ(dist, expected < 0.0 ? -10000.0 : 10000.0);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -5,176 +5,344 @@
 */
 
 #include "imstkSurfaceMeshDistanceTransform.h"
+#include "imstkCollisionUtils.h"
 #include "imstkDataArray.h"
-#include "imstkGeometryUtilities.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
-#include "imstkLooseOctree.h"
-#include "imstkParallelUtils.h"
+#include "imstkParallelFor.h"
 #include "imstkSurfaceMesh.h"
-#include "imstkTimer.h"
-#include "imstkSurfaceMeshImageMask.h"
-#include <stack>
-#include <vtkDistancePolyDataFilter.h>
-#include <vtkImageData.h>
-#include <vtkImplicitPolyDataDistance.h>
-#include <vtkOctreePointLocator.h>
-#include <vtkPointData.h>
-#include <vtkPolyData.h>
-#include <vtkSelectEnclosedPoints.h>
+
+#include <unordered_map>
 
 namespace imstk
 {
+namespace
+{
 ///
-/// \brief Only works with binary image
-/// returns 0 if neighborhood is equivalent to val
-/// returns 1 if neighborhood is filled with 1's
-/// returns -1 if neighborhood is filled with 0's
+/// \brief Triangles of a mesh with their hierarchy and the angle weighted
+/// pseudonormals of their faces, edges and vertices. The sign of the distance
+/// is given by the pseudonormal of the feature the closest point lies on.
 ///
-//static int isNeighborhoodEquivalent(const Vec3i& pt, const Vec3i& dim, const double val, const double* imgPtr, const int dilateSize)
-//{
-//    const Vec3i min = (pt - Vec3i(dilateSize, dilateSize, dilateSize)).cwiseMax(Vec3i(0, 0, 0)).cwiseMin(dim - Vec3i(1, 1, 1));
-//    const Vec3i max = (pt + Vec3i(dilateSize, dilateSize, dilateSize)).cwiseMax(Vec3i(0, 0, 0)).cwiseMin(dim - Vec3i(1, 1, 1));
-//
-//    // Take the max of the neighborhood
-//    for (int z = min[2]; z < max[2] + 1; z++)
-//    {
-//        for (int y = min[1]; y < max[1] + 1; y++)
-//        {
-//            for (int x = min[0]; x < max[0] + 1; x++)
-//            {
-//                const int index = ImageData::getScalarIndex(x, y, z, dim, 1);
-//                if (val != imgPtr[index])
-//                {
-//                    return false;
-//                }
-//            }
-//        }
-//    }
-//    return 0;
-//}
-static bool
-isNeighborhoodEquivalent(const Vec3i& pt, const Vec3i& dim, const float val, const float* imgPtr, const int dilateSize)
+struct SignedDistanceMesh
+{
+    SignedDistanceMesh(const VecDataArray<double, 3>& vertices,
+                       const VecDataArray<int, 3>&    cells,
+                       const BoundingVolumeHierarchy& bvh);
+
+    ///
+    /// \brief Returns the signed distance to pos, negative inside
+    ///
+    double signedDistance(const Vec3d& pos) const;
+
+    const VecDataArray<double, 3>& vertices;
+    const VecDataArray<int, 3>&    cells;
+    const BoundingVolumeHierarchy& bvh;
+
+    StdVectorOfVec3d faceNormals;
+    StdVectorOfVec3d vertexNormals;
+    std::vector<std::array<Vec3d, 3>> edgeNormals; ///< Per face, of the edges ab, bc, ca
+};
+
+SignedDistanceMesh::SignedDistanceMesh(const VecDataArray<double, 3>& meshVertices,
+                                       const VecDataArray<int, 3>&    meshCells,
+                                       const BoundingVolumeHierarchy& meshBvh) :
+    vertices(meshVertices), cells(meshCells), bvh(meshBvh)
 {
-    const Vec3i min = (pt - Vec3i(dilateSize, dilateSize, dilateSize)).cwiseMax(Vec3i(0, 0, 0)).cwiseMin(dim - Vec3i(1, 1, 1));
-    const Vec3i max = (pt + Vec3i(dilateSize, dilateSize, dilateSize)).cwiseMax(Vec3i(0, 0, 0)).cwiseMin(dim - Vec3i(1, 1, 1));
+    const int numFaces = cells.size();
+    faceNormals.resize(numFaces);
+    edgeNormals.resize(numFaces);
+    vertexNormals.assign(vertices.size(), Vec3d::Zero());
+
+    ParallelUtils::parallelFor(numFaces, [&](const int i)
+        {
+            const Vec3i& cell = cells[i];
+            faceNormals[i]    = (vertices[cell[1]] - vertices[cell[0]]).cross(vertices[cell[2]] - vertices[cell[0]]).normalized();
+        });
 
-    // Take the max of the neighborhood
-    for (int z = min[2]; z < max[2] + 1; z++)
+    // Vertex pseudonormals weight the normals of the faces by their angle at the vertex,
+    // edge pseudonormals sum the normals of the two faces of the edge
+    std::unordered_map<std::uint64_t, Vec3d> edgeSums;
+    edgeSums.reserve(numFaces * 3 / 2);
+    const auto edgeKey = [](const int a, const int b)
+                         {
+                             return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | static_cast<std::uint64_t>(std::max(a, b));
+                         };
+    for (int i = 0; i < numFaces; i++)
     {
-        for (int y = min[1]; y < max[1] + 1; y++)
+        const Vec3i& cell = cells[i];
+        for (int j = 0; j < 3; j++)
         {
-            for (int x = min[0]; x < max[0] + 1; x++)
-            {
-                const size_t index = ImageData::getScalarIndex(x, y, z, dim, 1);
-                if (val != imgPtr[index])
-                {
-                    return false;
-                }
-            }
+            const int    a     = cell[j];
+            const int    b     = cell[(j + 1) % 3];
+            const int    c     = cell[(j + 2) % 3];
+            const double angle = std::acos(std::max(-1.0, std::min(1.0,
+                (vertices[b] - vertices[a]).normalized().dot((vertices[c] - vertices[a]).normalized()))));
+            vertexNormals[a] += angle * faceNormals[i];
+
+            auto iter = edgeSums.emplace(edgeKey(a, b), Vec3d::Zero()).first;
+            iter->second += faceNormals[i];
         }
     }
-    return true;
+    ParallelUtils::parallelFor(numFaces, [&](const int i)
+        {
+            const Vec3i& cell = cells[i];
+            for (int j = 0; j < 3; j++)
+            {
+                edgeNormals[i][j] = edgeSums.at(edgeKey(cell[j], cell[(j + 1) % 3]));
+            }
+        });
 }
 
-// Narrow band is WIP, it works but is slow
-static void
-computeNarrowBandedDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const int dilateSize,
-                      const double tolerance)
+double
+SignedDistanceMesh::signedDistance(const Vec3d& pos) const
 {
-    // Rasterize a mask from the polygon
-    std::shared_ptr<SurfaceMeshImageMask> imageMask = std::make_shared<SurfaceMeshImageMask>();
-    imageMask->setInputMesh(surfMesh);
-    imageMask->setReferenceImage(imageData);
-    imageMask->update();
-
-    auto               inputScalarsPtr  = std::dynamic_pointer_cast<DataArray<float>>(imageMask->getOutputImage()->getScalars());
-    DataArray<float>&  inputScalars     = *inputScalarsPtr;
-    float*             inputImgPtr      = inputScalars.getPointer();
-    auto               outputScalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars());
-    DataArray<double>& outputScalars    = *outputScalarsPtr;
-    double*            outputImgPtr     = outputScalars.getPointer();
-
-    // Separate polygons used to avoid race conditions
-    vtkSmartPointer<vtkPolyData>                 inputPolyData = GeometryUtils::copyToVtkPolyData(surfMesh);
-    vtkSmartPointer<vtkImplicitPolyDataDistance> distFunc      = vtkSmartPointer<vtkImplicitPolyDataDistance>::New();
-    distFunc->SetInput(inputPolyData);
-    distFunc->SetTolerance(tolerance);
-
-    std::fill_n(outputImgPtr, outputScalars.size(), 10000.0);
-
-    // Iterate the image testing for boundary pixels (ie any 0 adjacent to a 1)
-    const Vec3i& dim     = imageData->getDimensions();
-    const Vec3d  shift   = imageData->getOrigin() + imageData->getSpacing() * 0.5;
-    const Vec3d& spacing = imageData->getSpacing();
-    int          i       = 0;
-    for (int z = 0; z < dim[2]; z++)
+    int       caseType = 0;
+    double    minSqrDist;
+    const int faceId = bvh.findNearest(pos, [&](const int i)
+        {
+            const Vec3i& cell = cells[i];
+            return (CollisionUtils::closestPointOnTriangle(pos,
+                vertices[cell[0]], vertices[cell[1]], vertices[cell[2]], caseType) - pos).squaredNorm();
+        }, minSqrDist);
+    if (faceId == -1)
     {
-        for (int y = 0; y < dim[1]; y++)
+        return IMSTK_DOUBLE_MAX;
+    }
+
+    const Vec3i& cell      = cells[faceId];
+    const Vec3d  closestPt = CollisionUtils::closestPointOnTriangle(pos,
+        vertices[cell[0]], vertices[cell[1]], vertices[cell[2]], caseType);
+    const Vec3d& normal = (caseType < 3) ? vertexNormals[cell[caseType]] :
+                          ((caseType < 6) ? edgeNormals[faceId][caseType - 3] : faceNormals[faceId]);
+    const double dist = std::sqrt(minSqrDist);
+    return (pos - closestPt).dot(normal) < 0.0 ? -dist : dist;
+}
+
+///
+/// \brief Freezes the voxels within bandWidth of the bounds of a triangle and computes
+/// their exact distances. Layers along z are independent so each is done in parallel.
+///
+void
+computeBand(const SignedDistanceMesh& mesh, const Vec3i& dim, const Vec3d& spacing, const Vec3d& shift,
+            const double bandWidth, const double tolerance, double* imgPtr, std::vector<char>& frozen)
+{
+    const Vec3d band = Vec3d::Constant(bandWidth);
+    ParallelUtils::parallelFor(dim[2], [&](const int z)
         {
-            for (int x = 0; x < dim[0]; x++, i++)
+            const double posZ = z * spacing[2] + shift[2];
+            const Vec3d  layerLower(-IMSTK_DOUBLE_MAX, -IMSTK_DOUBLE_MAX, posZ - bandWidth);
+            const Vec3d  layerUpper(IMSTK_DOUBLE_MAX, IMSTK_DOUBLE_MAX, posZ + bandWidth);
+            mesh.bvh.query(layerLower, layerUpper, [&](const int faceId)
             {
-                const float val = inputImgPtr[i];
-                const Vec3i pt  = Vec3i(x, y, z);
+                // Voxels of the layer within the bounds of the face grown by the band
+                const Vec3d lower = (mesh.bvh.getPrimitiveLower(faceId) - band - shift).cwiseQuotient(spacing);
+                const Vec3d upper = (mesh.bvh.getPrimitiveUpper(faceId) + band - shift).cwiseQuotient(spacing);
+                const int xMin    = std::max(0, static_cast<int>(std::ceil(lower[0])));
+                const int xMax    = std::min(dim[0] - 1, static_cast<int>(std::floor(upper[0])));
+                const int yMin    = std::max(0, static_cast<int>(std::ceil(lower[1])));
+                const int yMax    = std::min(dim[1] - 1, static_cast<int>(std::floor(upper[1])));
+                for (int y = yMin; y <= yMax && xMin <= xMax; y++)
+                {
+                    const size_t index = ImageData::getScalarIndex(xMin, y, z, dim, 1);
+                    std::fill_n(&frozen[index], xMax - xMin + 1, 1);
+                }
+            });
 
-                // If neighborhood is homogenous then its not touching the boundary
-                if (!isNeighborhoodEquivalent(pt, dim, val, inputImgPtr, dilateSize))
+            size_t index = ImageData::getScalarIndex(0, 0, z, dim, 1);
+            for (int y = 0; y < dim[1]; y++)
+            {
+                for (int x = 0; x < dim[0]; x++, index++)
                 {
-                    const Vec3d pos = pt.cast<double>().cwiseProduct(spacing) + shift;
-                    outputImgPtr[i] = distFunc->FunctionValue(pos.data());
+                    if (frozen[index])
+                    {
+                        const double dist = mesh.signedDistance(Vec3d(x, y, z).cwiseProduct(spacing) + shift);
+                        imgPtr[index] = (std::abs(dist) < tolerance) ? 0.0 : dist;
+                    }
                 }
-                // If value is 1 (we are inside)
-                else if (val == 1.0)
+            }
+        });
+}
+
+///
+/// \brief Sets the voxels out of the band to +/-farValue. A row of voxels can only cross
+/// the surface within the band, so the voxels between band voxels of a row take the sign
+/// of their band neighbor, rows missing the band take the sign of one of their voxels.
+///
+void
+propagateSign(const SignedDistanceMesh& mesh, const Vec3i& dim, const Vec3d& spacing, const Vec3d& shift,
+              const std::vector<char>& frozen, const double farValue, double* imgPtr)
+{
+    ParallelUtils::parallelFor(dim[1] * dim[2], [&](const int row)
+        {
+            const size_t rowStart = static_cast<size_t>(row) * dim[0];
+            int          lastBand = -1;
+            for (int x = 0; x <= dim[0]; x++)
+            {
+                if (x < dim[0] && !frozen[rowStart + x])
                 {
-                    outputImgPtr[i] = -10000.0;
+                    continue;
                 }
 
-                if (i % 1000000 == 0)
+                // Fill the voxels since the last band voxel
+                double sign;
+                if (lastBand != -1)
+                {
+                    sign = imgPtr[rowStart + lastBand];
+                }
+                else if (x < dim[0])
                 {
-                    double p = static_cast<double>(i) / (dim[0] * dim[1] * dim[2]);
-                    std::cout << "Progress " << p << "\n";
+                    sign = imgPtr[rowStart + x];
                 }
+                else
+                {
+                    const Vec3d pos = Vec3d(0, row % dim[1], row / dim[1]).cwiseProduct(spacing) + shift;
+                    sign = mesh.signedDistance(pos);
+                }
+                std::fill(imgPtr + rowStart + lastBand + 1, imgPtr + rowStart + x, std::copysign(farValue, sign));
+                lastBand = x;
             }
+        });
+}
+
+///
+/// \brief Solves the upwind discretization of |grad u| = 1 given the smallest neighbor
+/// magnitude along each axis, IMSTK_DOUBLE_MAX when unknown
+///
+double
+solveEikonal(const Vec3d& neighbors, const Vec3d& spacing)
+{
+    std::array<int, 3> order = { 0, 1, 2 };
+    if (neighbors[order[1]] < neighbors[order[0]])
+    {
+        std::swap(order[0], order[1]);
+    }
+    if (neighbors[order[2]] < neighbors[order[1]])
+    {
+        std::swap(order[1], order[2]);
+    }
+    if (neighbors[order[1]] < neighbors[order[0]])
+    {
+        std::swap(order[0], order[1]);
+    }
+
+    // Add the axes in increasing order while the solution exceeds their neighbor
+    double u      = neighbors[order[0]] + spacing[order[0]];
+    double sumW   = 0.0;
+    double sumWA  = 0.0;
+    double sumWA2 = 0.0;
+    for (int i = 0; i < 3; i++)
+    {
+        const double a = neighbors[order[i]];
+        if (a == IMSTK_DOUBLE_MAX || (i > 0 && u <= a))
+        {
+            break;
         }
+        const double w = 1.0 / (spacing[order[i]] * spacing[order[i]]);
+        sumW   += w;
+        sumWA  += w * a;
+        sumWA2 += w * a * a;
+        const double discriminant = sumWA * sumWA - sumW * (sumWA2 - 1.0);
+        if (discriminant < 0.0)
+        {
+            break;
+        }
+        u = (sumWA + std::sqrt(discriminant)) / sumW;
     }
+    return u;
 }
 
-static void
-computeFullDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const double tolerance)
+///
+/// \brief Propagates the distances of the frozen voxels to the others with the 8 orderings
+/// of fast sweeping. The image is split in blocks, in a sweep ordering the blocks of a plane
+/// x + y + z of blocks only depend on blocks of previous planes, so they are swept in parallel,
+/// each serially for locality. Signs are taken from the nearest neighbor.
+///
+void
+fastSweep(const Vec3i& dim, const Vec3d& spacing, const std::vector<char>& frozen, double* imgPtr)
 {
-    // Get the optimal number of threads
-    const int numThreads = static_cast<int>(ParallelUtils::ThreadManager::getThreadPoolSize());
+    const std::array<size_t, 3> strides = { 1, static_cast<size_t>(dim[0]), static_cast<size_t>(dim[0]) * dim[1] };
+    const double                minStep = spacing.minCoeff() / std::sqrt(3.0);
+    const auto                  update  = [&](const Vec3i& pt)
+                                          {
+                                              const size_t index = ImageData::getScalarIndex(pt[0], pt[1], pt[2], dim, 1);
+                                              if (frozen[index])
+                                              {
+                                                  return;
+                                              }
 
-    const Vec3i& dim     = imageData->getDimensions();
-    const Vec3d  spacing = imageData->getSpacing();
-    const Vec3d  shift   = imageData->getOrigin() + spacing * 0.5;
+                                              // Smallest magnitude neighbor along each axis
+                                              Vec3d  neighbors = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+                                              for (int axis = 0; axis < 3; axis++)
+                                              {
+                                                  if (pt[axis] > 0)
+                                                  {
+                                                      const double val = imgPtr[index - strides[axis]];
+                                                      neighbors[axis] = std::abs(val);
+                                                  }
+                                                  if (pt[axis] < dim[axis] - 1)
+                                                  {
+                                                      const double val = imgPtr[index + strides[axis]];
+                                                      if (std::abs(val) < neighbors[axis])
+                                                      {
+                                                          neighbors[axis] = std::abs(val);
+                                                      }
+                                                  }
+                                              }
+                                              // The solution exceeds the smallest neighbor by at least minStep
+                                              const int axis = static_cast<int>(std::min_element(neighbors.data(), neighbors.data() + 3) - neighbors.data());
+                                              if (neighbors[axis] == IMSTK_DOUBLE_MAX || neighbors[axis] + minStep >= std::abs(imgPtr[index]))
+                                              {
+                                                  return;
+                                              }
 
-    auto               scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars());
-    DataArray<double>& scalars    = *scalarsPtr.get();
+                                              const double u = solveEikonal(neighbors, spacing);
+                                              if (u < std::abs(imgPtr[index]))
+                                              {
+                                                  // Sign of the nearest neighbor
+                                                  const double sign = (pt[axis] > 0 && std::abs(imgPtr[index - strides[axis]]) == neighbors[axis]) ?
+                                                                      imgPtr[index - strides[axis]] : imgPtr[index + strides[axis]];
+                                                  imgPtr[index] = std::copysign(u, sign);
+                                              }
+                                          };
 
-    // Split the work up along z
-    ParallelUtils::parallelFor(numThreads, [&](const int& i)
+    const int   blockSize = 16;
+    const Vec3i numBlocks = (dim + Vec3i::Constant(blockSize - 1)) / blockSize;
+    const int   numPlanes = numBlocks.sum() - 2;
+    for (int sweep = 0; sweep < 8; sweep++)
+    {
+        // Coordinates are mirrored along the flipped axes
+        const Vec3i flip((sweep & 1) != 0, (sweep & 2) != 0, (sweep & 4) != 0);
+        const auto  toImage = [&](const int i, const int axis) { return flip[axis] ? dim[axis] - 1 - i : i; };
+        for (int plane = 0; plane < numPlanes; plane++)
         {
-            // Separate polygons used to avoid race conditions
-            vtkSmartPointer<vtkPolyData> inputPolyData = GeometryUtils::copyToVtkPolyData(surfMesh);
-            vtkSmartPointer<vtkImplicitPolyDataDistance> distFunc = vtkSmartPointer<vtkImplicitPolyDataDistance>::New();
-            distFunc->SetInput(inputPolyData);
-            distFunc->SetTolerance(tolerance);
-
-            for (int z = i; z < dim[2]; z += numThreads)
+            std::vector<Vec3i> blocks;
+            for (int k = std::max(0, plane - (numBlocks[0] - 1) - (numBlocks[1] - 1)); k <= std::min(numBlocks[2] - 1, plane); k++)
             {
-                int j = z * dim[0] * dim[1];
-                for (int y = 0; y < dim[1]; y++)
+                for (int j = std::max(0, plane - k - (numBlocks[0] - 1)); j <= std::min(numBlocks[1] - 1, plane - k); j++)
                 {
-                    for (int x = 0; x < dim[0]; x++, j++)
-                    {
-                        double pos[3] = { x* spacing[0] + shift[0], y * spacing[1] + shift[1], z * spacing[2] + shift[2] };
-                        scalars[j]    = distFunc->FunctionValue(pos);
-                    }
+                    blocks.push_back(Vec3i(plane - k - j, j, k));
                 }
             }
-        });
+
+            ParallelUtils::parallelFor(static_cast<int>(blocks.size()), [&](const int blockId)
+                {
+                    const Vec3i begin = blocks[blockId] * blockSize;
+                    const Vec3i end   = (begin + Vec3i::Constant(blockSize)).cwiseMin(dim);
+                    for (int k = begin[2]; k < end[2]; k++)
+                    {
+                        for (int j = begin[1]; j < end[1]; j++)
+                        {
+                            for (int i = begin[0]; i < end[0]; i++)
+                            {
+                                update(Vec3i(toImage(i, 0), toImage(j, 1), toImage(k, 2)));
+                            }
+                        }
+                    }
+                }, blocks.size() > 1);
+        }
+    }
 }
+} // namespace
 
 SurfaceMeshDistanceTransform::SurfaceMeshDistanceTransform()
 {
@@ -201,20 +369,30 @@ void
 SurfaceMeshDistanceTransform::setupDistFunc()
 {
     std::shared_ptr<SurfaceMesh> inputSurfaceMesh = std::dynamic_pointer_cast<SurfaceMesh>(getInput(0));
-    vtkSmartPointer<vtkPolyData> inputPolyData    = GeometryUtils::copyToVtkPolyData(inputSurfaceMesh);
-
-    m_distFunc = vtkSmartPointer<vtkImplicitPolyDataDistance>::New();
-    m_distFunc->SetInput(inputPolyData);
+    m_bvh.build(*inputSurfaceMesh->getVertexPositions(), *inputSurfaceMesh->getCells());
 }
 
 Vec3d
 SurfaceMeshDistanceTransform::getNearestPoint(const Vec3d& pos)
 {
-    m_distFunc->SetTolerance(m_Tolerance);
-    Vec3d closestPt = Vec3d::Zero();
-    Vec3d p = pos;
-    m_distFunc->EvaluateFunctionAndGetClosestPoint(p.data(), closestPt.data());
-    return closestPt;
+    std::shared_ptr<SurfaceMesh>   inputSurfaceMesh = std::dynamic_pointer_cast<SurfaceMesh>(getInput(0));
+    const VecDataArray<double, 3>& vertices = *inputSurfaceMesh->getVertexPositions();
+    const VecDataArray<int, 3>&    cells    = *inputSurfaceMesh->getCells();
+
+    int          caseType = 0;
+    double       minSqrDist;
+    const int    faceId = m_bvh.findNearest(pos, [&](const int i)
+        {
+            const Vec3i& cell = cells[i];
+            return (CollisionUtils::closestPointOnTriangle(pos,
+                vertices[cell[0]], vertices[cell[1]], vertices[cell[2]], caseType) - pos).squaredNorm();
+        }, minSqrDist);
+    if (faceId == -1)
+    {
+        return Vec3d::Zero();
+    }
+    const Vec3i& cell = cells[faceId];
+    return CollisionUtils::closestPointOnTriangle(pos, vertices[cell[0]], vertices[cell[1]], vertices[cell[2]], caseType);
 }
 
 void
@@ -263,19 +441,37 @@ SurfaceMeshDistanceTransform::requestUpdate()
     const Vec3d origin  = Vec3d(bounds[0], bounds[2], bounds[4]);
     outputImageData->allocate(IMSTK_DOUBLE, 1, m_Dimensions, spacing, origin);
 
-    /* StopWatch timer;
-     timer.start();*/
+    setupDistFunc();
+    const SignedDistanceMesh mesh(*inputSurfaceMesh->getVertexPositions(), *inputSurfaceMesh->getCells(), m_bvh);
+
+    auto          scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(outputImageData->getScalars());
+    double*       imgPtr     = scalarsPtr->getPointer();
+    const Vec3d   shift      = origin + spacing * 0.5;
+    const double  farValue   = 10000.0;
+    std::fill_n(imgPtr, scalarsPtr->size(), IMSTK_DOUBLE_MAX);
 
+    // Exact distances in the band, then propagated out of it
+    std::vector<char> frozen(scalarsPtr->size(), 0);
+    const double      bandWidth = std::max(m_DilateSize, 1) * spacing.maxCoeff();
+    computeBand(mesh, m_Dimensions, spacing, shift, bandWidth, m_Tolerance, imgPtr, frozen);
     if (m_NarrowBanded)
     {
-        computeNarrowBandedDT(outputImageData, inputSurfaceMesh, m_DilateSize,
-            m_Tolerance);
+        propagateSign(mesh, m_Dimensions, spacing, shift, frozen, farValue, imgPtr);
     }
     else
     {
-        computeFullDT(outputImageData, inputSurfaceMesh, m_Tolerance);
-    }
+        fastSweep(m_Dimensions, spacing, frozen, imgPtr);
 
-    //printf("time: %f\n", timer.getTimeElapsed());
+        // Voxels not reached, only when the band is empty, are computed directly
+        ParallelUtils::parallelFor(static_cast<int>(scalarsPtr->size()), [&](const int i)
+            {
+                if (imgPtr[i] == IMSTK_DOUBLE_MAX)
+                {
+                    const Vec3d pos = Vec3d(i % m_Dimensions[0], (i / m_Dimensions[0]) % m_Dimensions[1],
+                        i / (m_Dimensions[0] * m_Dimensions[1])).cwiseProduct(spacing) + shift;
+                    imgPtr[i] = mesh.signedDistance(pos);
+                }
+            });
+    }
 }
 } // namespace imstk
\ No newline at end of file
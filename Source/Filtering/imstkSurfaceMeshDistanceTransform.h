@@ -6,13 +6,10 @@
 
 #pragma once
 
+#include "imstkBoundingVolumeHierarchy.h"
 #include "imstkGeometryAlgorithm.h"
 #include "imstkMath.h"
 
-#include <vtkSmartPointer.h>
-
-class vtkImplicitPolyDataDistance;
-
 namespace imstk
 {
 class ImageData;
@@ -21,9 +18,12 @@ class SurfaceMesh;
 ///
 /// \class SurfaceMeshDistanceTransform
 ///
-/// \brief This filter computes exact signed distance fields using octrees
-/// and pseudonormal computations. One might need to adjust the tolerance
-/// depending on dataset scale.
+/// \brief This filter computes signed distance fields, negative inside, of a closed
+/// and consistently oriented SurfaceMesh. Distances within a band around the surface
+/// are exact, found with a bounding volume hierarchy of the triangles and signed with
+/// angle weighted pseudonormals. The narrow banded transform sets the voxels out of
+/// the band to +/-10000, the full transform propagates the band to the rest of the
+/// image with a parallel fast sweeping of the eikonal equation (first order).
 /// The bounds for the image can be set in the filter, when none are set
 /// the bounding box of the mesh is used, the margin.  When providing your own bounds a
 /// box larger than the original object might be necessary depending on shape
@@ -41,10 +41,14 @@ public:
 
     std::shared_ptr<ImageData> getOutputImage();
 
+    ///
+    /// \brief Builds the hierarchy of the input mesh used by getNearestPoint,
+    /// also built on update
+    ///
     void setupDistFunc();
 
     ///
-    /// \brief Get the nearest point
+    /// \brief Get the nearest point on the input mesh
     ///
     Vec3d getNearestPoint(const Vec3d& pos);
 
@@ -75,16 +79,18 @@ public:
     ///@}
 
     ///
-    /// \brief Width of the band
+    /// \brief Half width of the band of exact distances in voxels, at least 1
     ///@{
     imstkSetMacro(DilateSize, int);
     imstkGetMacro(DilateSize, int);
     ///@}
 
+    ///
+    /// \brief Distances below the tolerance are snapped to zero
     ///@{
     imstkSetMacro(Tolerance, double);
     imstkGetMacro(Tolerance, double);
-///@}
+    ///@}
 
 protected:
     void requestUpdate() override;
@@ -95,8 +101,8 @@ private:
     double m_Tolerance  = 1.0e-10;
 
     bool m_NarrowBanded = false;
-    int  m_DilateSize   = 4; ///< Only for narrow banded
+    int  m_DilateSize   = 4;
 
-    vtkSmartPointer<vtkImplicitPolyDataDistance> m_distFunc;
+    BoundingVolumeHierarchy m_bvh; ///< Hierarchy of the triangles of the input mesh
 };
 } // namespace imstk
\ No newline at end of file
@@ -200,7 +200,7 @@ public:
     void postModified()
     {
         m_boundsDirty = true;
-        this->postEvent(Event(Geometry::modified()));
+        this->postEvent(Event(Geometry::modifiedId()));
     }
 
     virtual void updatePostTransformData() const { }
@@ -0,0 +1,128 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkCollidingObject.h"
+#include "imstkCollisionDetectionAlgorithm.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdObjectCollision.h"
+#include "imstkPlane.h"
+#include "imstkPointSet.h"
+#include "imstkScene.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Scene of points falling onto the y = 0 plane, with 4 substeps point i
+/// crosses the plane on substep i + 1
+///
+struct PointsOnPlaneScene
+{
+    PointsOnPlaneScene(const PbdModelConfig::CollisionSubstepPolicy policy, const unsigned int numSubsteps)
+    {
+        model = std::make_shared<PbdModel>();
+        model->getConfig()->m_dt          = 0.01;
+        model->getConfig()->m_numSubsteps = numSubsteps;
+        model->getConfig()->m_collisionSubstepPolicy = policy;
+        model->getConfig()->m_linearDampingCoeff     = 0.0;
+
+        auto vertices = std::make_shared<VecDataArray<double, 3>>(numPoints);
+        for (int i = 0; i < numPoints; i++)
+        {
+            (*vertices)[i] = Vec3d(0.1 * i, 0.015 + 0.025 * i, 0.0);
+        }
+        auto pointSet = std::make_shared<PointSet>();
+        pointSet->initialize(vertices);
+
+        pointsObj = std::make_shared<PbdObject>("Points");
+        pointsObj->setPhysicsGeometry(pointSet);
+        pointsObj->setCollidingGeometry(pointSet);
+        pointsObj->setDynamicalModel(model);
+        pointsObj->getPbdBody()->uniformMassValue = 1.0;
+
+        auto planeObj = std::make_shared<CollidingObject>("Plane");
+        planeObj->setCollidingGeometry(std::make_shared<Plane>(Vec3d::Zero(), Vec3d(0.0, 1.0, 0.0)));
+
+        collision = std::make_shared<PbdObjectCollision>(pointsObj, planeObj, "PointSetToPlaneCD");
+
+        scene = std::make_shared<Scene>("Scene");
+        scene->addSceneObject(pointsObj);
+        scene->addSceneObject(planeObj);
+        scene->addInteraction(collision);
+        scene->initialize();
+
+        // Moves about 0.025 per substep of 4
+        for (Vec3d& velocity : *pointsObj->getPbdBody()->velocities)
+        {
+            velocity = Vec3d(0.0, -10.0, 0.0);
+        }
+    }
+
+    static constexpr int numPoints = 4;
+
+    std::shared_ptr<PbdModel>           model;
+    std::shared_ptr<PbdObject>          pointsObj;
+    std::shared_ptr<PbdObjectCollision> collision;
+    std::shared_ptr<Scene> scene;
+};
+} // namespace
+
+///
+/// \brief Test contacts found on later substeps with CollisionSubstepPolicy::Redetect
+/// are resolved, without growing the virtual particles every substep and with the
+/// external forces still applied once per step
+///
+TEST(imstkPbdObjectCollisionTest, TestSubstepsRedetect)
+{
+    // Reusing the contacts of the step start, only the first point is stopped
+    {
+        PointsOnPlaneScene reuse(PbdModelConfig::CollisionSubstepPolicy::Reuse, 4);
+        reuse.scene->advance(0.01);
+        const VecDataArray<double, 3>& vertices = *reuse.pointsObj->getPbdBody()->vertices;
+        EXPECT_NEAR(vertices[0][1], 0.0, 1.0e-3);
+        for (int i = 1; i < PointsOnPlaneScene::numPoints; i++)
+        {
+            EXPECT_LT(vertices[i][1], -0.005);
+        }
+    }
+
+    PointsOnPlaneScene redetect(PbdModelConfig::CollisionSubstepPolicy::Redetect, 4);
+    std::shared_ptr<PbdBody>                     body = redetect.pointsObj->getPbdBody();
+    std::shared_ptr<CollisionDetectionAlgorithm> cd   = redetect.collision->getCollisionDetection();
+    const PbdBody&                               virtualBody = *redetect.model->getBodies().m_bodies[0];
+
+    // The contacts are detected on every substep, all the points stop at the plane
+    redetect.scene->advance(0.01);
+    for (const Vec3d& vertex : *body->vertices)
+    {
+        EXPECT_NEAR(vertex[1], 0.0, 1.0e-3);
+    }
+
+    // Only the virtual particles of the last substep's handling are kept with
+    // the one of the single contact at the step start
+    EXPECT_GT(cd->getCollisionData()->elementsA.size(), 0u);
+    EXPECT_EQ(virtualBody.vertices->size(), 1 + static_cast<int>(cd->getCollisionData()->elementsA.size()));
+
+    // A force along the plane is applied once over the step, not once per substep,
+    // and not again on the next step
+    body->externalForce = Vec3d(1.0, 0.0, 0.0);
+    redetect.scene->advance(0.01);
+    EXPECT_EQ(body->externalForce, Vec3d::Zero());
+    for (const Vec3d& velocity : *body->velocities)
+    {
+        EXPECT_NEAR(velocity[0], 0.01, 1.0e-10);
+    }
+    redetect.scene->advance(0.01);
+    for (const Vec3d& velocity : *body->velocities)
+    {
+        EXPECT_NEAR(velocity[0], 0.01, 1.0e-10);
+    }
+}
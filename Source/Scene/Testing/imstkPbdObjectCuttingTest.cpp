@@ -0,0 +1,93 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkCollidingObject.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdObjectCutting.h"
+#include "imstkPlane.h"
+#include "imstkSurfaceMesh.h"
+
+using namespace imstk;
+
+///
+/// \brief Test cutting a cloth whose particles are kept in the contiguous
+/// storage of the model, the cut must add vertices and the storage must be
+/// rebuilt over them
+///
+TEST(imstkPbdObjectCuttingTest, TestCutContiguousStorage)
+{
+    auto model = std::make_shared<PbdModel>();
+    model->getConfig()->m_doContiguousStorage = true;
+    model->getConfig()->m_dt = 0.01;
+
+    // 6x6 grid on the xz plane, columns at x = -0.5, -0.3, ..., 0.5
+    std::shared_ptr<SurfaceMesh> clothMesh =
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(6, 6));
+    const int numVertices = clothMesh->getNumVertices();
+
+    auto tissueObj = std::make_shared<PbdObject>("Tissue");
+    tissueObj->setPhysicsGeometry(clothMesh);
+    tissueObj->setCollidingGeometry(clothMesh);
+    tissueObj->setDynamicalModel(model);
+    tissueObj->getPbdBody()->fixedNodeIds     = { 0, 5 };
+    tissueObj->getPbdBody()->uniformMassValue = 0.01;
+    model->getConfig()->enableConstraint(PbdModelConfig::ConstraintGenType::Distance,
+        1.0e4, tissueObj->getPbdBody()->bodyHandle);
+
+    // Cut along x = 0, between the vertex columns
+    auto cutObj = std::make_shared<CollidingObject>("Cutter");
+    cutObj->setCollidingGeometry(std::make_shared<Plane>(Vec3d::Zero(), Vec3d(1.0, 0.0, 0.0)));
+
+    auto cutting = std::make_shared<PbdObjectCutting>(tissueObj, cutObj);
+    cutting->setEpsilon(0.01);
+
+    tissueObj->initialize();
+    model->initialize();
+
+    auto step = [&]()
+                {
+                    model->integratePosition();
+                    model->solveConstraints();
+                    model->updateVelocity();
+                };
+    step();
+
+    const int bodyHandle = tissueObj->getPbdBody()->bodyHandle;
+    PbdState& state      = model->getBodies();
+    ASSERT_NE(state.m_particleStorage, nullptr);
+    ASSERT_NE(state.getGlobalParticleId({ bodyHandle, 0 }), -1);
+
+    cutting->apply();
+
+    // The cut added vertices, the body, the geometry and its cells agree on them
+    std::shared_ptr<SurfaceMesh> cutMesh = std::dynamic_pointer_cast<SurfaceMesh>(tissueObj->getPhysicsGeometry());
+    const int                    numCutVertices = cutMesh->getNumVertices();
+    EXPECT_GT(numCutVertices, numVertices);
+    EXPECT_EQ(tissueObj->getPbdBody()->vertices, cutMesh->getVertexPositions());
+    EXPECT_EQ(tissueObj->getPbdBody()->prevVertices->size(), numCutVertices);
+    EXPECT_EQ(tissueObj->getPbdBody()->invMasses->size(), numCutVertices);
+    for (const Vec3i& tri : *cutMesh->getCells())
+    {
+        EXPECT_TRUE((tri.array() >= 0).all() && (tri.array() < numCutVertices).all());
+    }
+
+    // Stepping maps the cut body back onto rebuilt storage
+    step();
+    ASSERT_NE(state.m_particleStorage, nullptr);
+    EXPECT_EQ(state.m_particleStorage->getNumParticles(), numCutVertices);
+    const int globalId = state.getGlobalParticleId({ bodyHandle, numCutVertices - 1 });
+    ASSERT_NE(globalId, -1);
+    EXPECT_EQ(&(*cutMesh->getVertexPositions())[numCutVertices - 1], &state.m_particleStorage->vertices[globalId]);
+    for (const Vec3d& vertex : *cutMesh->getVertexPositions())
+    {
+        EXPECT_TRUE(vertex.allFinite());
+    }
+}
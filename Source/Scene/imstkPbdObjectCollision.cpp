@@ -187,6 +187,21 @@ PbdObjectCollision::setupConnections(std::shared_ptr<PbdObject> obj1, std::share
     m_taskGraph->addNode(obj2->getTaskGraph()->getSink());
 
     std::shared_ptr<PbdModel> pbdModel = obj1->getPbdModel();
+
+    // Run by the model on the substeps after the first, see PbdModelConfig::m_collisionSubstepPolicy.
+    // The previous geometry of CCD stays the one of the step start
+    m_collisionSubstepNode = std::make_shared<TaskNode>([this]()
+        {
+            if (getEnabled())
+            {
+                updateCollisionGeometry();
+                m_colDetect->update();
+                updateCHA();
+            }
+        },
+        obj1->getName() + "_vs_" + obj2->getName() + "_CollisionSubstep");
+    pbdModel->addCollisionSubstepNode(m_collisionSubstepNode);
+
     m_taskGraph->addNode(pbdModel->getSolveNode());
     m_taskGraph->addNode(pbdModel->getIntegratePositionNode());
     m_taskGraph->addNode(pbdModel->getUpdateVelocityNode());
@@ -83,6 +83,7 @@ public:
 
 protected:
     std::shared_ptr<TaskNode> m_updatePrevGeometryCCDNode = nullptr;
+    std::shared_ptr<TaskNode> m_collisionSubstepNode      = nullptr; ///< Detects and handles again on model substeps
 
 private:
     /// Called from the constructor
@@ -42,6 +42,10 @@ PbdObjectCutting::apply()
     m_addConstraintVertices->clear();
     m_removeConstraintVertices->clear();
 
+    // Mapped arrays can't grow and copies of them still alias the contiguous
+    // storage, unmap before the cutter copies and refines the mesh
+    pbdModel->releaseParticleStorage();
+
     // Perform cutting
     if (auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(m_objA->getPhysicsGeometry()))
     {
@@ -107,6 +111,9 @@ PbdObjectCutting::addVertices(std::shared_ptr<SurfaceMesh> pbdMesh,
         return;
     }
 
+    // Vertices of the body may be mapped to the contiguous storage, which can't grow
+    m_objA->getPbdModel()->releaseParticleStorage();
+
     vertices->reserve(nVertices + nNewVertices);
     initialVertices->reserve(nVertices + nNewVertices);
     for (int i = 0; i < nNewVertices; ++i)
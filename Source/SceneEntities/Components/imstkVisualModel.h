@@ -79,7 +79,7 @@ public:
     void setRenderDelegateCreated(Renderer* ren, bool created) { m_renderDelegateCreated[ren] = created; }
     ///@}
 
-    void postModified() { this->postEvent(Event(VisualModel::modified())); }
+    void postModified() { this->postEvent(Event(VisualModel::modifiedId())); }
 
 protected:
     std::string m_delegateHint;
@@ -11,6 +11,8 @@
 #include "imstkPbdObject.h"
 #include "imstkPointSet.h"
 
+#include <algorithm>
+
 namespace imstk
 {
 std::shared_ptr<PbdModel>
@@ -317,61 +319,19 @@ PbdObject::computeCellConstraintMap()
     CHECK(constraintsPtr != nullptr) << "PbdObject \"" << m_name
                                      << "\" does not have constraints in computeCellConstraintMap";
 
-    const std::vector<std::shared_ptr<PbdConstraint>>& constraints = constraintsPtr->getConstraints();
-
-    //For each cell, find all associated constraints
-    std::vector<int> cellVertIds(vertsPerCell);
+    //For each cell, find all associated constraints through the constraints of its vertices
     for (int cellId = 0; cellId < cellMesh->getNumCells(); cellId++)
     {
-        // Get all the vertex ids for this cell
-        // The whole range gets overwritten for each iteration
+        std::vector<std::shared_ptr<PbdConstraint>>& cellConstraints = m_pbdBody->cellConstraintMap[cellId];
         for (int vertId = 0; vertId < vertsPerCell; vertId++)
         {
-            cellVertIds[vertId] = (*cellVerts)[cellId * vertsPerCell + vertId];
-        }
-
-        // Search all constraints for those that involve the same vertices as the cell
-        for (auto& constraint : constraints)
-        {
-            const std::vector<PbdParticleId>& cVertexIds = constraint->getParticles(); ///< Vertices that are part of the constraint
-            std::unordered_set<int>           constraintVertIds;
-
-            // Check that constraint involves this body and get associated vertices
-            bool isBody = false;
-            for (int cVertId = 0; cVertId < cVertexIds.size(); cVertId++)
-            {
-                if (cVertexIds[cVertId].first == bodyId)
-                {
-                    constraintVertIds.insert(cVertexIds[cVertId].second);
-                    isBody = true;
-                }
-            }
-            if (isBody == false)
+            const PbdParticleId pid = { bodyId, (*cellVerts)[cellId * vertsPerCell + vertId] };
+            for (const std::shared_ptr<PbdConstraint>& constraint : constraintsPtr->getParticleConstraints(pid))
             {
-                continue;
-            }
-
-            // Check if cell vertices exists in the constraint
-            for (int cellVertId = 0; cellVertId < vertsPerCell; cellVertId++)
-            {
-                std::unordered_set<int>::const_iterator indx = constraintVertIds.find(cellVertIds[cellVertId]);
-
-                if (indx != constraintVertIds.end())
+                // Make sure constraint has not already been added
+                if (std::find(cellConstraints.begin(), cellConstraints.end(), constraint) == cellConstraints.end())
                 {
-                    // Make sure constraint has not already been added
-                    bool exists = false;
-                    for (int j = 0; j < m_pbdBody->cellConstraintMap[cellId].size(); j++)
-                    {
-                        if (constraint == m_pbdBody->cellConstraintMap[cellId][j])
-                        {
-                            exists = true;
-                        }
-                    }
-                    if (exists == false)
-                    {
-                        std::shared_ptr<PbdConstraint> cpy = constraint;
-                        m_pbdBody->cellConstraintMap[cellId].push_back(std::move(cpy));
-                    }
+                    cellConstraints.push_back(constraint);
                 }
             }
         }
@@ -305,97 +305,92 @@ PbdObjectCellRemoval::removeConstraints()
     const int vertsPerCell = m_mesh->getAbstractCells()->getNumberOfComponents();
     auto      cellVerts    = std::dynamic_pointer_cast<DataArray<int>>(m_mesh->getAbstractCells());  // underlying 1D array
 
-    // Constraint Data
-    std::shared_ptr<PbdConstraintContainer>            constraintsPtr = m_obj->getPbdModel()->getConstraints();
-    const std::vector<std::shared_ptr<PbdConstraint>>& constraints    = constraintsPtr->getConstraints();
-
-    for (int i = 0; i < m_cellsToRemove.size(); i++)
+    // Cells to remove using each vertex
+    std::unordered_map<int, std::vector<int>> vertexToRemovedCells;
+    for (const int cellId : m_cellsToRemove)
     {
-        int cellId = m_cellsToRemove[i];
-
-        // Find and remove the associated constraints
-        for (auto j = constraints.begin(); j != constraints.end();)
+        for (int vertId = 0; vertId < vertsPerCell; vertId++)
         {
-            const std::vector<PbdParticleId>& vertexIds = (*j)->getParticles();
-
-            // Check that constraint involves this body and get associated vertices
-            bool isBody = false;
-            for (int cVertId = 0; cVertId < vertexIds.size(); cVertId++)
-            {
-                if (vertexIds[cVertId].first == bodyId)
-                {
-                    isBody = true;
-                    break;
-                }
-            }
-
-            // Skip if body is not involved
-            if (isBody == false)
-            {
-                j++;
-                continue;
-            }
+            vertexToRemovedCells[(*cellVerts)[cellId * vertsPerCell + vertId]].push_back(cellId);
+        }
+    }
+    auto isCellVertex = [&](const int cellId, const int vertexId)
+                        {
+                            for (int vertId = 0; vertId < vertsPerCell; vertId++)
+                            {
+                                if ((*cellVerts)[cellId * vertsPerCell + vertId] == vertexId)
+                                {
+                                    return true;
+                                }
+                            }
+                            return false;
+                        };
+
+    // Only the constraints of the removed cells vertices may be removed, visit just those
+    std::vector<PbdParticleId> particles;
+    particles.reserve(vertexToRemovedCells.size());
+    for (const auto& vertexCells : vertexToRemovedCells)
+    {
+        particles.push_back({ bodyId, vertexCells.first });
+    }
+    m_obj->getPbdModel()->getConstraints()->removeConstraintsIf(particles, [&](const PbdConstraint& constraint)
+        {
+            const std::vector<PbdParticleId>& vertexIds = constraint.getParticles();
 
             // Check if the constraint involves ONLY the body of interest
             // This is used for removing constraints that connect two or more bodies
             bool isOnlyBody = true;
-            for (int cVertId = 0; cVertId < vertexIds.size(); cVertId++)
+            for (const PbdParticleId& pid : vertexIds)
             {
-                if (vertexIds[cVertId].first != bodyId)
+                if (pid.first != bodyId)
                 {
                     isOnlyBody = false;
                     break;
                 }
             }
 
-            // Sets for comparing constraint vertices to cell vertices
-            std::unordered_set<int> constraintVertIds;
-            std::unordered_set<int> cellVertIds;
-            // Fill in sets
-            for (int vertId = 0; vertId < vertsPerCell; vertId++)
+            // Only cells using one of the constraint's vertices of this body may remove it
+            for (const PbdParticleId& pid : vertexIds)
             {
-                cellVertIds.insert((*cellVerts)[cellId * vertsPerCell + vertId]);
-            }
-
-            for (int cVertId = 0; cVertId < vertexIds.size(); cVertId++)
-            {
-                constraintVertIds.insert(vertexIds[cVertId].second);
-            }
-
-            // Check if cell nodes are a subset of the nodes used for the constraint
-            bool isSubset = true;
-            for (const auto& elem : constraintVertIds)
-            {
-                if (cellVertIds.find(elem) == cellVertIds.end())
+                if (pid.first != bodyId)
                 {
-                    isSubset = false;
-                    break;
+                    continue;
+                }
+                auto iter = vertexToRemovedCells.find(pid.second);
+                if (iter == vertexToRemovedCells.end())
+                {
+                    continue;
                 }
-            }
 
-            // Handle constraints connecting two bodies when an associated cell is deleted.
-            bool isMultiBodyConstraint = false;
-            if (isOnlyBody == false)
-            {
-                for (int cVertId = 0; cVertId < vertexIds.size(); cVertId++)
+                for (const int cellId : iter->second)
                 {
-                    if (vertexIds[cVertId].first == bodyId && cellVertIds.find(vertexIds[cVertId].second) != cellVertIds.end())
+                    // Handle constraints connecting two bodies when an associated cell is deleted.
+                    if (!isOnlyBody)
                     {
-                        isMultiBodyConstraint = true;
+                        return true;
                     }
-                }
-            }
 
-            if (isSubset == true || (isMultiBodyConstraint && isSubset == false))
-            {
-                j = constraintsPtr->eraseConstraint(j);
-            }
-            else
-            {
-                j++;
+                    // Check if constraint nodes are a subset of the nodes of the cell
+                    bool isSubset = true;
+                    for (const PbdParticleId& otherPid : vertexIds)
+                    {
+                        if (!isCellVertex(cellId, otherPid.second))
+                        {
+                            isSubset = false;
+                            break;
+                        }
+                    }
+                    if (isSubset)
+                    {
+                        return true;
+                    }
+                }
             }
-        }
+            return false;
+        });
 
+    for (const int cellId : m_cellsToRemove)
+    {
         // Set removed cell to dummy vertex
         for (int k = 0; k < vertsPerCell; k++)
         {
@@ -415,8 +410,9 @@ PbdObjectCellRemoval::removeConstraints()
 void
 PbdObjectCellRemoval::fixup()
 {
+    // Only the linked meshes need fixing, don't visit every tetrahedron without them
     auto volumeMesh = std::dynamic_pointer_cast<TetrahedralMesh>(m_mesh);
-    if (volumeMesh == nullptr)
+    if (volumeMesh == nullptr || m_linkedMeshData.empty())
     {
         return;
     }
@@ -577,4 +573,4 @@ PbdObjectCellRemoval::addDummyVertex(std::shared_ptr<AbstractCellMesh> mesh)
         }
     }
 }
-} // namespace imstk
+} // namespace imstk
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkModule.h"
+#include "imstkSimulationManager.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Adaptive module whose update takes a fixed amount of time,
+/// stops the driver after a number of updates
+///
+class DummyModule : public Module
+{
+public:
+    DummyModule(ModuleDriver* driver, const double updateTime, const int numUpdates) :
+        m_driver(driver), m_updateTime(updateTime), m_numUpdatesToStop(numUpdates)
+    {
+        m_executionType = ExecutionType::ADAPTIVE;
+    }
+
+    const std::string getTypeName() const override { return "DummyModule"; }
+
+    bool initModule() override { return true; }
+
+    void updateModule() override
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(m_updateTime));
+        if (++m_numUpdates >= m_numUpdatesToStop)
+        {
+            m_driver->requestStatus(ModuleDriverStopped);
+        }
+    }
+
+    int m_numUpdates = 0;
+
+protected:
+    ModuleDriver* m_driver;
+    double m_updateTime;
+    int    m_numUpdatesToStop;
+};
+} // namespace
+
+///
+/// \brief Test a module slower than real time has its extra steps dropped
+///
+TEST(imstkSimulationManagerTest, TestMaxNumSteps)
+{
+    auto driver = std::make_shared<SimulationManager>();
+    driver->setDesiredDt(0.001);
+    driver->setMaxNumSteps(2);
+    auto module = std::make_shared<DummyModule>(driver.get(), 5.0, 20);
+    driver->addModule(module);
+
+    driver->start();
+
+    // Steps remaining in the iteration are still taken after the stop request
+    EXPECT_GE(module->m_numUpdates, 20);
+    EXPECT_EQ(driver->getTotalNumSteps(), module->m_numUpdates);
+    EXPECT_LE(driver->getNumSteps(), 2);
+    EXPECT_GT(driver->getTotalNumDroppedSteps(), 0);
+}
+
+///
+/// \brief Test the loop idles between steps when the module is faster than real time
+///
+TEST(imstkSimulationManagerTest, TestIdle)
+{
+    for (auto idleType : { SimulationManager::IdleType::Yield, SimulationManager::IdleType::Sleep })
+    {
+        auto driver = std::make_shared<SimulationManager>();
+        driver->setDesiredDt(0.005);
+        driver->setIdleType(idleType);
+        auto module = std::make_shared<DummyModule>(driver.get(), 0.0, 20);
+        driver->addModule(module);
+
+        driver->start();
+
+        EXPECT_GE(module->m_numUpdates, 20);
+        EXPECT_EQ(driver->getTotalNumDroppedSteps(), 0);
+        // 20 steps of 5ms leaves most of the time idle
+        EXPECT_GT(driver->getTotalIdleTime(), 0.05);
+    }
+}
@@ -5,6 +5,7 @@
 */
 
 #include "imstkSimulationManager.h"
+#include "imstkLogger.h"
 #include "imstkMacros.h"
 #include "imstkTimer.h"
 #include "imstkViewer.h"
@@ -75,11 +76,19 @@ SimulationManager::start()
     {
         const double desiredDt_ms = m_desiredDt * 1000.0; // ms
         m_numSteps = 0;
+        m_totalNumSteps        = 0;
+        m_totalNumDroppedSteps = 0;
+        m_totalIdleTime        = 0.0;
         double    accumulator = 0.0;
         StopWatch timer;
         timer.start();
         bool running = true;
 
+        // Dropped steps are reported at most once per reportInterval_ms
+        const double reportInterval_ms = 1000.0;
+        double       reportTime = 0.0;
+        long long    numDroppedSinceReport = 0;
+
         // Mark all as running but async modules
         for (auto module : m_viewers)
         {
@@ -108,11 +117,16 @@ SimulationManager::start()
 
             if (newState == ModuleDriverPaused)
             {
+                if (m_idleType != IdleType::Spin)
+                {
+                    idle(desiredDt_ms);
+                }
                 continue;
             }
 
             // Accumulate the real time passed
             accumulator += passedTime;
+            reportTime  += passedTime;
 
             // Compute number of steps we can take (total time previously took / desired time step)
             {
@@ -122,6 +136,22 @@ SimulationManager::start()
                 accumulator = accumulator - m_numSteps * desiredDt_ms;
                 m_dt = desiredDt_ms;
 
+                // Drop the steps beyond the cap, we can't keep up with real time
+                if (m_maxNumSteps > 0 && m_numSteps > m_maxNumSteps)
+                {
+                    const int numDropped = m_numSteps - m_maxNumSteps;
+                    m_numSteps = m_maxNumSteps;
+                    m_totalNumDroppedSteps += numDropped;
+                    numDroppedSinceReport  += numDropped;
+                }
+
+                // Nothing due yet, give the cpu back until the next step is
+                if (m_numSteps == 0 && m_idleType != IdleType::Spin)
+                {
+                    idle(desiredDt_ms - accumulator);
+                    continue;
+                }
+
                 // Flatten out the remainder over our desired dt
                 if (m_useRemainderTimeDivide)
                 {
@@ -134,7 +164,17 @@ SimulationManager::start()
                 m_dt *= 0.001; // ms->s
             }
 
-            //printf("%d steps at %f\n", m_numSteps, m_dt);
+            m_totalNumSteps += m_numSteps;
+            if (reportTime >= reportInterval_ms)
+            {
+                if (numDroppedSinceReport > 0)
+                {
+                    LOG(WARNING) << "SimulationManager can't keep up with real time, dropped " <<
+                        numDroppedSinceReport << " steps in the last " << reportTime * 0.001 << "s";
+                }
+                reportTime = 0.0;
+                numDroppedSinceReport = 0;
+            }
 
             // Optional smoothening + loss here
 
@@ -253,6 +293,42 @@ SimulationManager::runModuleParallel(std::shared_ptr<Module> module)
     }
 }
 
+void
+SimulationManager::setMaxNumSteps(const int maxNumSteps)
+{
+    CHECK(maxNumSteps >= 0) << "Max number of steps must be non-negative, 0 for no limit";
+    m_maxNumSteps = maxNumSteps;
+}
+
+void
+SimulationManager::setSleepMargin(const double ms)
+{
+    CHECK(ms >= 0.0);
+    m_sleepMargin = ms;
+}
+
+void
+SimulationManager::idle(const double ms)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point begin = Clock::now();
+    const Clock::time_point end   = begin +
+                                    std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+
+    // Sleeps may overshoot by the scheduler granularity, so sleep until shortly
+    // before and yield the rest of the way
+    if (m_idleType == IdleType::Sleep && ms > m_sleepMargin)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms - m_sleepMargin));
+    }
+    while (Clock::now() < end && simState != ModuleDriverStopped)
+    {
+        std::this_thread::yield();
+    }
+
+    m_totalIdleTime = m_totalIdleTime + std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
 void
 SimulationManager::requestStop(Event* e)
 {
@@ -8,6 +8,7 @@
 
 #include "imstkModuleDriver.h"
 
+#include <atomic>
 #include <unordered_map>
 
 namespace imstk
@@ -25,6 +26,11 @@ class Viewer;
 /// This is the preferred driver.
 /// todo: Timestep smoothening
 ///
+/// The substeps per iteration may be capped (see setMaxNumSteps), time beyond
+/// the cap is dropped so a simulation that can't keep up with real time falls
+/// behind instead of spiraling into ever longer catch up iterations. When no step
+/// is due the loop may yield or sleep until the next one (see setIdleType).
+///
 /// Events: Posts `EventType::Start` just before the beginning of the loop,
 /// posts `EventType::Stop` just after the processing loops is being exited
 class SimulationManager : public ModuleDriver
@@ -37,6 +43,16 @@ public:
         STL
     };
 
+    ///
+    /// \brief What the loop does when no step is due yet
+    ///
+    enum class IdleType
+    {
+        Spin,  ///< Keep iterating, updating sequential modules & viewers every iteration
+        Yield, ///< Yield the thread until the next step is due
+        Sleep  ///< Sleep until shortly before the next step is due, then yield
+    };
+
     SimulationManager() = default;
     ~SimulationManager() override = default;
 
@@ -106,11 +122,64 @@ public:
     bool getUseRemainderTimeDivide() const { return m_useRemainderTimeDivide; }
 /// @}
 
+    ///
+    /// \brief Set/Get the maximum number of steps per iteration, 0 for no limit.
+    /// When more steps are due the extra ones are dropped, counted and reported.
+    /// default 0
+    /// @{
+    void setMaxNumSteps(const int maxNumSteps);
+    int getMaxNumSteps() const { return m_maxNumSteps; }
+/// @}
+
+    ///
+    /// \brief Set/Get what the loop does when no step is due. Spin keeps updating
+    /// sequential modules & viewers every iteration, Yield and Sleep pace them with
+    /// the steps and give the cpu back in the meantime.
+    /// default Spin
+    /// @{
+    void setIdleType(const IdleType idleType) { m_idleType = idleType; }
+    IdleType getIdleType() const { return m_idleType; }
+/// @}
+
+    ///
+    /// \brief Set/Get the time before a step is due at which IdleType::Sleep stops
+    /// sleeping and yields instead, as sleeps may overshoot, ms
+    /// default 1.0
+    /// @{
+    void setSleepMargin(const double ms);
+    double getSleepMargin() const { return m_sleepMargin; }
+/// @}
+
+    ///
+    /// \brief Get the number of steps of the last iteration
+    ///
+    int getNumSteps() const { return m_numSteps; }
+
+    ///
+    /// \brief Get the number of steps taken since start
+    ///
+    long long getTotalNumSteps() const { return m_totalNumSteps; }
+
+    ///
+    /// \brief Get the number of steps dropped since start
+    ///
+    long long getTotalNumDroppedSteps() const { return m_totalNumDroppedSteps; }
+
+    ///
+    /// \brief Get the time spent idle (yielding/sleeping) since start, seconds
+    ///
+    double getTotalIdleTime() const { return m_totalIdleTime; }
+
 protected:
     void requestStop(Event* e);
 
     void runModuleParallel(std::shared_ptr<Module> module);
 
+    ///
+    /// \brief Yields or sleeps for the given time according to the idle type, ms
+    ///
+    void idle(const double ms);
+
     std::vector<std::shared_ptr<Viewer>> m_viewers;
 
     std::unordered_map<Module*, bool> m_running;
@@ -122,7 +191,15 @@ protected:
     ThreadingType m_threadType = ThreadingType::STL;
     double m_desiredDt = 0.003;             ///< Desired timestep
     double m_dt       = 0.0;                ///< Actual timestep
-    int    m_numSteps = 0;
+    std::atomic<int> m_numSteps = { 0 };
     bool   m_useRemainderTimeDivide = true; ///< Whether to divide out remainder time or not
+
+    int      m_maxNumSteps = 0;             ///< Max steps per iteration, 0 for no limit
+    IdleType m_idleType    = IdleType::Spin;
+    double   m_sleepMargin = 1.0;           ///< Time before a step is due to stop sleeping, ms
+
+    std::atomic<long long> m_totalNumSteps = { 0 };
+    std::atomic<long long> m_totalNumDroppedSteps = { 0 };
+    std::atomic<double>    m_totalIdleTime = { 0.0 }; ///< s
 };
 };                                          // namespace imstk
@@ -0,0 +1,175 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkConjugateGradient.h"
+#include "imstkLinearProjectionConstraint.h"
+#include "imstkLinearSystem.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Returns a badly scaled symmetric positive definite matrix with 3 coupled
+/// dofs per node, nodes connected as a 1d laplacian
+///
+SparseMatrixd
+makeNodalMatrix(const int numNodes)
+{
+    const int                           n = numNodes * 3;
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; i++)
+    {
+        triplets.push_back({ i, i, 3.0 });
+        if (i >= 3)
+        {
+            triplets.push_back({ i, i - 3, -1.0 });
+        }
+        if (i < n - 3)
+        {
+            triplets.push_back({ i, i + 3, -1.0 });
+        }
+        // Coupling within the node
+        const int node = i / 3;
+        for (int j = node * 3; j < node * 3 + 3; j++)
+        {
+            if (j != i)
+            {
+                triplets.push_back({ i, j, 0.5 });
+            }
+        }
+    }
+    SparseMatrixd matrix(n, n);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+
+    // Scale the rows and columns, ill conditioning the diagonal
+    Vectord scale(n);
+    for (int i = 0; i < n; i++)
+    {
+        scale[i] = 1.0 + 10.0 * ((i / 3) % 7);
+    }
+    return scale.asDiagonal() * matrix * scale.asDiagonal();
+}
+} // namespace
+
+///
+/// \brief Test every preconditioner solves the system, and the preconditioned
+/// solves take fewer iterations
+///
+TEST(imstkConjugateGradientTest, TestPreconditioners)
+{
+    using Preconditioner = ConjugateGradient::Preconditioner;
+    const SparseMatrixd A = makeNodalMatrix(100);
+    const Vectord       b = Vectord::LinSpaced(A.rows(), -1.0, 1.0);
+
+    std::vector<size_t> numIterations;
+    for (const Preconditioner preconditioner : { Preconditioner::None, Preconditioner::Jacobi,
+                                                 Preconditioner::BlockJacobi, Preconditioner::IncompleteCholesky })
+    {
+        ConjugateGradient solver;
+        solver.setPreconditioner(preconditioner);
+        solver.setMaxNumIterations(1000);
+        solver.setTolerance(1.0e-10);
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A, b));
+
+        Vectord x;
+        solver.solve(x);
+        EXPECT_LT((A * x - b).norm(), 1.0e-8 * b.norm()) << "Preconditioner " << static_cast<int>(preconditioner);
+        EXPECT_LT(solver.getResidual(x), 1.0e-10);
+        numIterations.push_back(solver.getNumIterations());
+    }
+    EXPECT_LT(numIterations[1], numIterations[0]);
+    EXPECT_LT(numIterations[2], numIterations[0]);
+    EXPECT_LT(numIterations[3], numIterations[0]);
+}
+
+///
+/// \brief Test the matrix-free operator gives the solution of the matrix
+///
+TEST(imstkConjugateGradientTest, TestLinearOperator)
+{
+    const SparseMatrixd A = makeNodalMatrix(50);
+    const Vectord       b = Vectord::Ones(A.rows());
+
+    ConjugateGradient solver;
+    solver.setMaxNumIterations(1000);
+    solver.setTolerance(1.0e-10);
+    solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A, b));
+    Vectord x;
+    solver.solve(x);
+
+    // No matrix given, unpreconditioned
+    const SparseMatrixd empty;
+    int                 numProducts = 0;
+    solver.setLinearOperator([&](const Vectord& in, Vectord& out)
+        {
+            out = A * in;
+            numProducts++;
+        });
+    solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(empty, b));
+    Vectord xOperator;
+    solver.solve(xOperator);
+
+    EXPECT_GT(numProducts, 0);
+    EXPECT_LT((x - xOperator).norm(), 1.0e-6 * x.norm());
+}
+
+///
+/// \brief Test the projected solve keeps the constrained node fixed
+///
+TEST(imstkConjugateGradientTest, TestLinearProjection)
+{
+    const SparseMatrixd A = makeNodalMatrix(20);
+    const Vectord       b = Vectord::Ones(A.rows());
+
+    std::vector<LinearProjectionConstraint> fixed;
+    fixed.emplace_back(5, true);
+
+    for (const auto preconditioner : { ConjugateGradient::Preconditioner::None, ConjugateGradient::Preconditioner::BlockJacobi })
+    {
+        ConjugateGradient solver;
+        solver.setPreconditioner(preconditioner);
+        solver.setMaxNumIterations(1000);
+        solver.setTolerance(1.0e-10);
+        solver.setLinearProjectors(&fixed);
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A, b));
+
+        Vectord x;
+        solver.solve(x);
+        EXPECT_TRUE(x.segment<3>(15).isZero());
+
+        // Residual vanishes out of the constrained node
+        Vectord residual = A * x - b;
+        residual.segment<3>(15).setZero();
+        EXPECT_LT(residual.norm(), 1.0e-8 * b.norm());
+    }
+}
+
+///
+/// \brief Test a warm started solve starting at the solution doesn't iterate
+///
+TEST(imstkConjugateGradientTest, TestWarmStart)
+{
+    const SparseMatrixd A = makeNodalMatrix(50);
+    const Vectord       b = Vectord::Ones(A.rows());
+
+    ConjugateGradient solver;
+    solver.setMaxNumIterations(1000);
+    solver.setTolerance(1.0e-8);
+    solver.setWarmStart(true);
+    solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A, b));
+
+    Vectord x;
+    solver.solve(x);
+    EXPECT_GT(solver.getNumIterations(), 0u);
+
+    const Vectord solution = x;
+    solver.solve(x);
+    EXPECT_EQ(solver.getNumIterations(), 0u);
+    EXPECT_LT((x - solution).norm(), 1.0e-12 * solution.norm());
+}
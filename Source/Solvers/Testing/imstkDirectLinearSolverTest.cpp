@@ -0,0 +1,86 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDirectLinearSolver.h"
+#include "imstkLinearSystem.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Returns the symmetric positive definite matrix of a 1d laplacian
+/// scaled by stiffness plus the identity
+///
+SparseMatrixd
+makeLaplacian(const int n, const double stiffness)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; i++)
+    {
+        triplets.push_back({ i, i, 1.0 + 2.0 * stiffness });
+        if (i > 0)
+        {
+            triplets.push_back({ i, i - 1, -stiffness });
+        }
+        if (i < n - 1)
+        {
+            triplets.push_back({ i, i + 1, -stiffness });
+        }
+    }
+    SparseMatrixd matrix(n, n);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return matrix;
+}
+} // namespace
+
+///
+/// \brief Test both decompositions solve the system and new systems of the
+/// same pattern are only factorized
+///
+TEST(imstkDirectLinearSolverTest, TestReuseAnalysis)
+{
+    using Factorization = DirectLinearSolver<SparseMatrixd>::Factorization;
+    for (const Factorization factorization : { Factorization::LU, Factorization::LDLT })
+    {
+        const int     n = 50;
+        const Vectord b = Vectord::LinSpaced(n, -1.0, 1.0);
+        DirectLinearSolver<SparseMatrixd> solver;
+        solver.setFactorization(factorization);
+
+        // Matrices must outlive the systems referring to them
+        const SparseMatrixd A0 = makeLaplacian(n, 1.0);
+        const SparseMatrixd A1 = makeLaplacian(n, 10.0);
+        const SparseMatrixd A2 = makeLaplacian(n + 1, 1.0);
+        const Vectord       b2 = Vectord::Ones(n + 1);
+
+        Vectord x;
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A0, b));
+        solver.solve(x);
+        EXPECT_LT((A0 * x - b).norm(), 1.0e-10);
+
+        // Same pattern, new values
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A1, b));
+        solver.solve(x);
+        EXPECT_LT((A1 * x - b).norm(), 1.0e-10);
+        EXPECT_EQ(solver.getNumAnalyses(), 1);
+        EXPECT_EQ(solver.getNumFactorizations(), 2);
+
+        // New pattern
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A2, b2));
+        solver.solve(x);
+        EXPECT_LT((A2 * x - b2).norm(), 1.0e-10);
+        EXPECT_EQ(solver.getNumAnalyses(), 2);
+
+        // Analysis not kept
+        solver.setReuseAnalysis(false);
+        solver.setSystem(std::make_shared<LinearSystem<SparseMatrixd>>(A2, b2));
+        EXPECT_EQ(solver.getNumAnalyses(), 3);
+        EXPECT_EQ(solver.getNumFactorizations(), 4);
+    }
+}
@@ -76,3 +76,62 @@ TEST(imstkNewtonSolverTest, Solve)
     nlSolver->solveGivenState(x);
     EXPECT_NEAR(0.0, (x - xe).norm(), 0.00000001);
 }
+
+TEST(imstkNewtonSolverTest, SolveModifiedNewton)
+{
+    const int N  = 2;
+    auto      x  = Vectord(N);
+    auto      xe = Vectord(N);
+    auto      y  = Vectord(N);
+    auto      A  = Matrixd(N, N);
+
+    x[0]  = 3.0;
+    x[1]  = 30.0;
+    xe[0] = 1.0;
+    xe[1] = 10.0;
+
+    auto func = [&y](const Vectord& x, const bool) -> const Vectord& {
+                    y[0] = x[0] * x[0] - 1.0;
+                    y[1] = x[1] * x[1] - 100.0;
+                    return y;
+                };
+    int  numJacobians = 0;
+    auto funcJacobian = [&A, &numJacobians](const Vectord& x) -> const Matrixd& {
+                            A(0, 0) = 2 * x[0];
+                            A(0, 1) = 0.0;
+                            A(1, 0) = 0.0;
+                            A(1, 1) = 2 * x[1];
+                            numJacobians++;
+                            return A;
+                        };
+    auto updateX = [&x](const Vectord& du, const bool)
+                   {
+                       x -= du;
+                   };
+
+    imstkNew<NonLinearSystem<Matrixd>> nlSystem(func, funcJacobian);
+    nlSystem->setUnknownVector(x);
+    nlSystem->setUpdateFunction(updateX);
+    nlSystem->setUpdatePreviousStatesFunction([]() {});
+
+    imstkNew<NewtonSolver<Matrixd>> nlSolver;
+    nlSolver->setMaxIterations(100);
+    nlSolver->setRelativeTolerance(1e-8);
+    nlSolver->setSystem(nlSystem);
+    nlSolver->setLinearSolver(std::make_shared<DirectLinearSolver<Matrixd>>());
+    nlSolver->setUseModifiedNewton(true);
+
+    nlSolver->solve();
+    EXPECT_NEAR(0.0, (x - xe).norm(), 1e-8);
+
+    // Jacobians are reused, only recomputed when the convergence stalls
+    EXPECT_EQ(nlSolver->getNumJacobianUpdates(), static_cast<size_t>(numJacobians));
+    EXPECT_LT(nlSolver->getNumJacobianUpdates(), nlSolver->getNumIterations());
+
+    // The next solve starts with the last Jacobian
+    numJacobians = 0;
+    x[0]         = 1.01;
+    nlSolver->solve();
+    EXPECT_NEAR(0.0, (x - xe).norm(), 1e-8);
+    EXPECT_EQ(numJacobians, 0);
+}
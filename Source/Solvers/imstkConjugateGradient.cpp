@@ -7,14 +7,15 @@
 #include "imstkConjugateGradient.h"
 #include "imstkLinearProjectionConstraint.h"
 #include "imstkLogger.h"
+#include "imstkParallelFor.h"
+
+#include <unordered_map>
 
 namespace imstk
 {
 ConjugateGradient::ConjugateGradient()
 {
     m_type = Type::ConjugateGradient;
-    m_cgSolver.setMaxIterations(m_maxIterations);
-    m_cgSolver.setTolerance(m_tolerance);
 }
 
 ConjugateGradient::ConjugateGradient(const SparseMatrixd& A, const Vectord& rhs) : ConjugateGradient()
@@ -50,24 +51,21 @@ ConjugateGradient::solve(Vectord& x)
         return;
     }
 
-    if (!(m_FixedLinearProjConstraints || m_DynamicLinearProjConstraints))
-    {
-        x = m_cgSolver.solve(m_linearSystem->getRHSVector());
-    }
-    else
-    {
-        this->modifiedCGSolve(x);
-    }
+    this->modifiedCGSolve(x);
 }
 
 void
 ConjugateGradient::modifiedCGSolve(Vectord& x)
 {
     const auto& b = m_linearSystem->getRHSVector();
-    const auto& A = m_linearSystem->getMatrix();
+    updateProjectors();
 
-    // Set the initial guess to zero
-    x.setZero();
+    // Set the initial guess to zero, unless warm started
+    const bool warmStart = m_warmStart && x.size() == b.size();
+    if (!warmStart)
+    {
+        x.setZero(b.size());
+    }
     if (m_DynamicLinearProjConstraints)
     {
         applyLinearProjectionFilter(x, *m_DynamicLinearProjConstraints, true);
@@ -78,91 +76,235 @@ ConjugateGradient::modifiedCGSolve(Vectord& x)
         applyLinearProjectionFilter(x, *m_FixedLinearProjConstraints, true);
     }
 
-    auto res = b;
-    if (m_DynamicLinearProjConstraints)
+    m_r = b;
+    applyProjectors(m_r);
+    const double delta0 = m_r.squaredNorm();
+    if (warmStart)
     {
-        applyLinearProjectionFilter(res, *m_DynamicLinearProjConstraints, false);
+        multiply(x, m_q);
+        applyProjectors(m_q);
+        m_r -= m_q;
     }
-    if (m_FixedLinearProjConstraints)
-    {
-        applyLinearProjectionFilter(res, *m_FixedLinearProjConstraints, false);
-    }
-    auto       c     = res;
-    auto       delta = res.dot(res);
-    const auto eps   = m_tolerance * m_tolerance * delta;
-    double     alpha = 0.0;
-    Vectord    q;
-    size_t     iterNum = 0;
+    applyPreconditioner(m_r, m_z);
+    applyProjectors(m_z);
+    m_p = m_z;
+
+    double       rz    = m_r.dot(m_z);
+    double       delta = m_r.squaredNorm();
+    const double eps    = m_tolerance * m_tolerance * delta0;
+    m_numIterations = 0;
 
-    while (delta > eps)
+    while (delta > eps && m_numIterations < m_maxIterations)
     {
-        q = A * c;
-        if (m_DynamicLinearProjConstraints)
-        {
-            applyLinearProjectionFilter(q, *m_DynamicLinearProjConstraints, false);
-        }
-        if (m_FixedLinearProjConstraints)
-        {
-            applyLinearProjectionFilter(q, *m_FixedLinearProjConstraints, false);
-        }
-        double dotval = c.dot(q);
-        if (dotval != 0.0)
-        {
-            alpha = delta / dotval;
-        }
-        else
+        multiply(m_p, m_q);
+        applyProjectors(m_q);
+        const double dotval = m_p.dot(m_q);
+        if (dotval == 0.0)
         {
             LOG(WARNING) << "Warning: denominator zero. Terminating MCG iteration!";
-            return;
+            break;
         }
-        x   += alpha * c;
-        res -= alpha * q;
-        const double deltaPrev = delta;
-        delta = res.dot(res);
-        c    *= delta / deltaPrev;
-        c    += res;
-        if (m_DynamicLinearProjConstraints)
+        const double alpha = rz / dotval;
+        x   += alpha * m_p;
+        m_r -= alpha * m_q;
+        delta = m_r.squaredNorm();
+
+        applyPreconditioner(m_r, m_z);
+        applyProjectors(m_z);
+        const double rzPrev = rz;
+        rz   = m_r.dot(m_z);
+        m_p *= rz / rzPrev;
+        m_p += m_z;
+        m_numIterations++;
+    }
+    m_error = (delta0 > 0.0) ? std::sqrt(delta / delta0) : 0.0;
+}
+
+void
+ConjugateGradient::multiply(const Vectord& x, Vectord& y) const
+{
+    if (m_linearOperator)
+    {
+        m_linearOperator(x, y);
+        return;
+    }
+
+    const SparseMatrixd& A = m_linearSystem->getMatrix();
+    y.resize(A.rows());
+    ParallelUtils::parallelFor(A.outerSize(), [&](const Eigen::Index row)
         {
-            applyLinearProjectionFilter(c, *m_DynamicLinearProjConstraints, false);
-        }
-        if (m_FixedLinearProjConstraints)
+            double sum = 0.0;
+            for (SparseMatrixd::InnerIterator iter(A, row); iter; ++iter)
+            {
+                sum += iter.value() * x[iter.index()];
+            }
+            y[row] = sum;
+        });
+}
+
+void
+ConjugateGradient::updatePreconditioner()
+{
+    const SparseMatrixd& A = m_linearSystem->getMatrix();
+    m_activePreconditioner = m_preconditioner;
+    if (A.rows() == 0 || A.rows() != A.cols())
+    {
+        // Matrix-free without a matrix to precondition with
+        m_activePreconditioner = Preconditioner::None;
+        return;
+    }
+    if (m_activePreconditioner == Preconditioner::BlockJacobi && A.rows() % 3 != 0)
+    {
+        LOG(WARNING) << "Block Jacobi preconditioner requires 3 dofs per node, using Jacobi";
+        m_activePreconditioner = Preconditioner::Jacobi;
+    }
+    if (m_activePreconditioner == Preconditioner::IncompleteCholesky)
+    {
+        m_incompleteCholesky.compute(A);
+        if (m_incompleteCholesky.info() != Eigen::Success)
         {
-            applyLinearProjectionFilter(c, *m_FixedLinearProjConstraints, false);
+            LOG(WARNING) << "Incomplete Cholesky factorization failed, using Jacobi";
+            m_activePreconditioner = Preconditioner::Jacobi;
         }
+    }
 
-        if (++iterNum >= m_maxIterations)
+    // Zero diagonals, such as those of rows removed by boundary conditions, are left unscaled
+    if (m_activePreconditioner == Preconditioner::Jacobi)
+    {
+        m_invDiagonal = A.diagonal();
+        for (Eigen::Index i = 0; i < m_invDiagonal.size(); i++)
         {
-            //LOG(WARNING) << "ConjugateGradient::modifiedCGSolve - The solver did not converge after max. iterations";
-            break;
+            m_invDiagonal[i] = (m_invDiagonal[i] != 0.0) ? 1.0 / m_invDiagonal[i] : 1.0;
         }
     }
+    else if (m_activePreconditioner == Preconditioner::BlockJacobi)
+    {
+        m_invBlocks.resize(A.rows() / 3);
+        ParallelUtils::parallelFor(m_invBlocks.size(), [&](const size_t i)
+            {
+                const Eigen::Index start = static_cast<Eigen::Index>(i * 3);
+                Mat3d              block = Mat3d::Zero();
+                for (int r = 0; r < 3; r++)
+                {
+                    for (SparseMatrixd::InnerIterator iter(A, start + r); iter; ++iter)
+                    {
+                        if (iter.index() >= start && iter.index() < start + 3)
+                        {
+                            block(r, iter.index() - start) = iter.value();
+                        }
+                    }
+                }
+
+                bool invertible = false;
+                block.computeInverseWithCheck(m_invBlocks[i], invertible);
+                if (!invertible)
+                {
+                    m_invBlocks[i] = Mat3d::Identity();
+                    for (int r = 0; r < 3; r++)
+                    {
+                        if (block(r, r) != 0.0)
+                        {
+                            m_invBlocks[i](r, r) = 1.0 / block(r, r);
+                        }
+                    }
+                }
+            });
+    }
+}
+
+void
+ConjugateGradient::applyPreconditioner(const Vectord& r, Vectord& z)
+{
+    switch (m_activePreconditioner)
+    {
+    case Preconditioner::Jacobi:
+        z = m_invDiagonal.cwiseProduct(r);
+        break;
+    case Preconditioner::BlockJacobi:
+        z.resize(r.size());
+        ParallelUtils::parallelFor(m_invBlocks.size(), [&](const size_t i)
+            {
+                z.segment<3>(i * 3) = m_invBlocks[i] * r.segment<3>(i * 3);
+            });
+        break;
+    case Preconditioner::IncompleteCholesky:
+        z = m_incompleteCholesky.solve(r);
+        break;
+    default:
+        z = r;
+        break;
+    }
+}
+
+void
+ConjugateGradient::updateProjectors()
+{
+    m_projectors.clear();
+    if (!(m_FixedLinearProjConstraints || m_DynamicLinearProjConstraints))
+    {
+        return;
+    }
+
+    // Dynamic projectors apply first, the fixed ones after
+    std::unordered_map<size_t, size_t> nodeToProjector;
+    auto                               gather = [&](const std::vector<LinearProjectionConstraint>* constraints)
+                                                {
+                                                    if (constraints == nullptr)
+                                                    {
+                                                        return;
+                                                    }
+                                                    for (const auto& constraint : *constraints)
+                                                    {
+                                                        auto iter = nodeToProjector.find(constraint.getNodeId());
+                                                        if (iter == nodeToProjector.end())
+                                                        {
+                                                            nodeToProjector[constraint.getNodeId()] = m_projectors.size();
+                                                            m_projectors.push_back({ constraint.getNodeId(), constraint.getProjector() });
+                                                        }
+                                                        else
+                                                        {
+                                                            Mat3d& projector = m_projectors[iter->second].second;
+                                                            projector = constraint.getProjector() * projector;
+                                                        }
+                                                    }
+                                                };
+    gather(m_DynamicLinearProjConstraints);
+    gather(m_FixedLinearProjConstraints);
+}
+
+void
+ConjugateGradient::applyProjectors(Vectord& x) const
+{
+    for (const auto& projector : m_projectors)
+    {
+        const auto threeI = 3 * projector.first;
+        x.segment<3>(threeI) = projector.second * x.segment<3>(threeI);
+    }
 }
 
 double
 ConjugateGradient::getResidual(const Vectord&)
 {
-    return m_cgSolver.error();
+    return m_error;
 }
 
 void
 ConjugateGradient::setTolerance(const double epsilon)
 {
     IterativeLinearSolver::setTolerance(epsilon);
-    m_cgSolver.setTolerance(epsilon);
 }
 
 void
 ConjugateGradient::setMaxNumIterations(const size_t maxIter)
 {
     IterativeLinearSolver::setMaxNumIterations(maxIter);
-    m_cgSolver.setMaxIterations(maxIter);
 }
 
 void
 ConjugateGradient::setSystem(std::shared_ptr<LinearSystem<SparseMatrixd>> newSystem)
 {
     LinearSolver<SparseMatrixd>::setSystem(newSystem);
-    m_cgSolver.compute(m_linearSystem->getMatrix());
+    updatePreconditioner();
 }
 
 void
@@ -10,6 +10,8 @@
 
 #include <Eigen/IterativeLinearSolvers>
 
+#include <functional>
+
 namespace imstk
 {
 class LinearProjectionConstraint;
@@ -17,11 +19,30 @@ class LinearProjectionConstraint;
 ///
 /// \class ConjugateGradient
 ///
-/// \brief Conjugate gradient sparse linear solver for Spd matrices
+/// \brief Preconditioned conjugate gradient sparse linear solver for Spd matrices.
+/// Supports linear projection filters (modified CG), in which case the preconditioned
+/// residual is filtered too, and a matrix-free operator replacing the products with
+/// the system matrix. Work vectors persist across solves.
 ///
 class ConjugateGradient : public IterativeLinearSolver
 {
 public:
+    ///
+    /// \brief Preconditioners, built from the system matrix on setSystem
+    ///
+    enum class Preconditioner
+    {
+        None,
+        Jacobi,            ///< Inverse of the diagonal
+        BlockJacobi,       ///< Inverse of the 3x3 diagonal block of each node
+        IncompleteCholesky ///< Zero fill-in incomplete Cholesky
+    };
+
+    ///
+    /// \brief Function computing y = Ax
+    ///
+    using LinearOperator = std::function<void (const Vectord& x, Vectord& y)>;
+
     ConjugateGradient();
     ConjugateGradient(const SparseMatrixd& A, const Vectord& rhs);
     ~ConjugateGradient() override = default;
@@ -51,15 +72,44 @@ public:
     void solve(Vectord& x, const double tolerance);
 
     ///
-    /// \brief Return the error calculated by the solver.
+    /// \brief Return the relative residual norm reached by the last solve.
     ///
     double getResidual(const Vectord& x) override;
 
+    ///
+    /// \brief Returns the number of iterations of the last solve
+    ///
+    size_t getNumIterations() const { return m_numIterations; }
+
     ///
     /// \brief Sets the system. System of linear equations.
     ///
     void setSystem(std::shared_ptr<LinearSystemType> newSystem) override;
 
+    ///
+    /// \brief Get/Set the preconditioner, applies from the next setSystem. Default Jacobi
+    ///@{
+    void setPreconditioner(const Preconditioner preconditioner) { m_preconditioner = preconditioner; }
+    Preconditioner getPreconditioner() const { return m_preconditioner; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the operator used instead of the system matrix for products,
+    /// the system matrix is then only used to build the preconditioner, it may be empty.
+    /// Null to use the system matrix. Default null
+    ///@{
+    void setLinearOperator(LinearOperator linearOperator) { m_linearOperator = linearOperator; }
+    const LinearOperator& getLinearOperator() const { return m_linearOperator; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether solve starts from the given x, when of the system size,
+    /// instead of zero. Default false
+    ///@{
+    void setWarmStart(const bool warmStart) { m_warmStart = warmStart; }
+    bool getWarmStart() const { return m_warmStart; }
+    ///@}
+
     ///
     /// \brief set/get the maximum number of iterations for the iterative solver.
     ///
@@ -111,14 +161,56 @@ public:
 
 private:
     ///
-    /// \brief Modified Conjugate gradient solver
+    /// \brief Modified preconditioned conjugate gradient solver
     ///
     void modifiedCGSolve(Vectord& x);
 
-    ///< Pointer to the Eigen's Conjugate gradient solver
-    Eigen::ConjugateGradient<SparseMatrixd> m_cgSolver;
+    ///
+    /// \brief Builds the preconditioner from the system matrix
+    ///
+    void updatePreconditioner();
+
+    ///
+    /// \brief Computes z = M^-1 r
+    ///
+    void applyPreconditioner(const Vectord& r, Vectord& z);
+
+    ///
+    /// \brief Computes y = Ax, in parallel over the rows of the system matrix
+    ///
+    void multiply(const Vectord& x, Vectord& y) const;
+
+    ///
+    /// \brief Gathers the fixed and dynamic projectors, combining those of the same node
+    ///
+    void updateProjectors();
+
+    ///
+    /// \brief Applies the gathered projectors to x
+    ///
+    void applyProjectors(Vectord& x) const;
+
+    Preconditioner m_preconditioner = Preconditioner::Jacobi;
+    Preconditioner m_activePreconditioner = Preconditioner::None; ///< Preconditioner built for the current system
+    Vectord          m_invDiagonal;
+    StdVectorOfMat3d m_invBlocks;
+    Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::AMDOrdering<int>> m_incompleteCholesky;
+
+    LinearOperator m_linearOperator = nullptr;
+    bool m_warmStart = false;
+
+    std::vector<std::pair<size_t, Mat3d>> m_projectors; ///< Combined projector per node
+
+    // Workspace
+    Vectord m_r;
+    Vectord m_z;
+    Vectord m_p;
+    Vectord m_q;
+
+    size_t m_numIterations = 0;
+    double m_error = 0.0;
 
     std::vector<LinearProjectionConstraint>* m_FixedLinearProjConstraints   = nullptr;
     std::vector<LinearProjectionConstraint>* m_DynamicLinearProjConstraints = nullptr;
 };
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
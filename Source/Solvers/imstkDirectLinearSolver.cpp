@@ -7,6 +7,8 @@
 #include "imstkDirectLinearSolver.h"
 #include "imstkLogger.h"
 
+#include <algorithm>
+
 namespace imstk
 {
 DirectLinearSolver<Matrixd>::
@@ -25,10 +27,11 @@ setSystem(std::shared_ptr<LinearSystem<Matrixd>> newSystem)
 }
 
 DirectLinearSolver<SparseMatrixd>::
-DirectLinearSolver(const SparseMatrixd& matrix, const Vectord& b)
+DirectLinearSolver(const SparseMatrixd& matrix, const Vectord& b, const Factorization factorization) :
+    m_factorization(factorization)
 {
     m_linearSystem = std::make_shared<LinearSystem<SparseMatrixd>>(matrix, b);
-    m_solver.compute(matrix);
+    factorize(matrix);
 }
 
 void
@@ -36,7 +39,74 @@ DirectLinearSolver<SparseMatrixd>::
 setSystem(std::shared_ptr<LinearSystem<SparseMatrixd>> newSystem)
 {
     LinearSolver<SparseMatrixd>::setSystem(newSystem);
-    m_solver.compute(m_linearSystem->getMatrix());
+    factorize(m_linearSystem->getMatrix());
+}
+
+void
+DirectLinearSolver<SparseMatrixd>::setFactorization(const Factorization factorization)
+{
+    if (m_factorization != factorization)
+    {
+        m_factorization = factorization;
+        m_analyzed      = false;
+    }
+}
+
+bool
+DirectLinearSolver<SparseMatrixd>::getPatternChanged(const SparseMatrixd& matrix) const
+{
+    // Only compressed matrices are compared, their index arrays fully give the pattern
+    if (!m_analyzed || !matrix.isCompressed()
+        || static_cast<size_t>(matrix.outerSize() + 1) != m_outerIndices.size()
+        || static_cast<size_t>(matrix.nonZeros()) != m_innerIndices.size())
+    {
+        return true;
+    }
+    return !std::equal(m_outerIndices.begin(), m_outerIndices.end(), matrix.outerIndexPtr())
+           || !std::equal(m_innerIndices.begin(), m_innerIndices.end(), matrix.innerIndexPtr());
+}
+
+void
+DirectLinearSolver<SparseMatrixd>::factorize(const SparseMatrixd& matrix)
+{
+    if (!m_reuseAnalysis || getPatternChanged(matrix))
+    {
+        if (m_factorization == Factorization::LDLT)
+        {
+            m_ldltSolver.analyzePattern(matrix);
+        }
+        else
+        {
+            m_luSolver.analyzePattern(matrix);
+        }
+        m_numAnalyses++;
+
+        m_analyzed = matrix.isCompressed();
+        if (m_analyzed)
+        {
+            m_outerIndices.assign(matrix.outerIndexPtr(), matrix.outerIndexPtr() + matrix.outerSize() + 1);
+            m_innerIndices.assign(matrix.innerIndexPtr(), matrix.innerIndexPtr() + matrix.nonZeros());
+        }
+    }
+
+    Eigen::ComputationInfo info;
+    if (m_factorization == Factorization::LDLT)
+    {
+        m_ldltSolver.factorize(matrix);
+        info = m_ldltSolver.info();
+    }
+    else
+    {
+        m_luSolver.factorize(matrix);
+        info = m_luSolver.info();
+    }
+    m_numFactorizations++;
+
+    if (info != Eigen::Success)
+    {
+        LOG(WARNING) << "DirectLinearSolver failed to factorize the system"
+                     << (m_factorization == Factorization::LDLT ? ", LDLT requires it to be symmetric positive definite" : "");
+    }
 }
 
 void
@@ -46,7 +116,14 @@ DirectLinearSolver<SparseMatrixd>::solve(const Vectord& rhs, Vectord& x)
     {
         LOG(FATAL) << "Linear system has not been set";
     }
-    x = m_solver.solve(rhs);
+    if (m_factorization == Factorization::LDLT)
+    {
+        x = m_ldltSolver.solve(rhs);
+    }
+    else
+    {
+        x = m_luSolver.solve(rhs);
+    }
 }
 
 void
@@ -56,10 +133,7 @@ DirectLinearSolver<SparseMatrixd>::solve(Vectord& x)
     {
         LOG(FATAL) << "Linear system has not been set";
     }
-    x.setZero();
-
-    auto b = m_linearSystem->getRHSVector();
-    x = m_solver.solve(b);
+    solve(m_linearSystem->getRHSVector(), x);
 }
 
 void
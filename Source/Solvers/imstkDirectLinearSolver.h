@@ -14,6 +14,7 @@
 #pragma warning( disable : 4127 )
 #endif
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 #include <Eigen/SparseLU>
 #ifdef WIN32
 #pragma warning( pop )
@@ -72,11 +73,24 @@ private:
 
 ///
 /// \brief Sparse direct solvers. Solves a sparse system of equations using a sparse LU
-///     decomposition.
+///     or, for symmetric positive definite systems, a sparse Cholesky (LDLT) decomposition.
+///     The symbolic analysis of the matrix only depends on its sparsity pattern, it is kept
+///     while new systems share the pattern (ie: FEM tangent stiffness) so that they are
+///     only numerically factorized.
 ///
 template<>
 class DirectLinearSolver<SparseMatrixd>: public LinearSolver<SparseMatrixd>
 {
+public:
+    ///
+    /// \brief Decomposition used to factorize the matrix
+    ///
+    enum class Factorization
+    {
+        LU,  ///< Sparse LU with COLAMD ordering, for any square system
+        LDLT ///< Simplicial Cholesky LDLT with AMD ordering, for symmetric positive definite systems
+    };
+
 public:
     ///
     /// \brief Default constructor/destructor
@@ -87,7 +101,8 @@ public:
     ///
     /// \brief Constructor
     ///
-    DirectLinearSolver(const SparseMatrixd& matrix, const Vectord& b);
+    DirectLinearSolver(const SparseMatrixd& matrix, const Vectord& b,
+                       const Factorization factorization = Factorization::LU);
 
     ///
     /// \brief Sets the system. System of linear equations.
@@ -104,7 +119,60 @@ public:
     ///
     void solve(const Vectord& rhs, Vectord& x);
 
+    ///
+    /// \brief Returns true if the solver is iterative
+    ///
+    bool isIterative() const override { return false; }
+
+    ///
+    /// \brief Get/Set the decomposition, LDLT is faster but the system must be symmetric
+    /// positive definite. Takes effect on the next system set. Default LU
+    ///@{
+    void setFactorization(const Factorization factorization);
+    Factorization getFactorization() const { return m_factorization; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether the symbolic analysis is kept for systems of the same
+    /// sparsity pattern. When off every system is analyzed. Default on
+    ///@{
+    void setReuseAnalysis(const bool reuseAnalysis) { m_reuseAnalysis = reuseAnalysis; }
+    bool getReuseAnalysis() const { return m_reuseAnalysis; }
+    ///@}
+
+    ///
+    /// \brief Returns the number of symbolic analyses done
+    ///
+    int getNumAnalyses() const { return m_numAnalyses; }
+
+    ///
+    /// \brief Returns the number of numeric factorizations done
+    ///
+    int getNumFactorizations() const { return m_numFactorizations; }
+
 private:
-    Eigen::SparseLU<SparseMatrixd, Eigen::COLAMDOrdering<MatrixType::StorageIndex>> m_solver;
+    ///
+    /// \brief Factorizes the matrix, analyzing it first if its pattern differs from
+    /// the one analyzed
+    ///
+    void factorize(const SparseMatrixd& matrix);
+
+    ///
+    /// \brief Returns true if the sparsity pattern of the matrix differs from the one analyzed
+    ///
+    bool getPatternChanged(const SparseMatrixd& matrix) const;
+
+    Factorization m_factorization = Factorization::LU;
+    bool m_reuseAnalysis = true;
+
+    Eigen::SparseLU<SparseMatrixd, Eigen::COLAMDOrdering<MatrixType::StorageIndex>> m_luSolver;
+    Eigen::SimplicialLDLT<SparseMatrixd> m_ldltSolver;
+
+    bool m_analyzed = false;                                  ///< Whether the analyzed pattern below is valid
+    std::vector<SparseMatrixd::StorageIndex> m_outerIndices;  ///< Row starts of the analyzed pattern
+    std::vector<SparseMatrixd::StorageIndex> m_innerIndices;  ///< Column indices of the analyzed pattern
+
+    int m_numAnalyses       = 0;
+    int m_numFactorizations = 0;
 };
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
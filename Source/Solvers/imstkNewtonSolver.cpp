@@ -96,30 +96,65 @@ NewtonSolver<SystemMatrix>::solve()
         return;
     }
 
+    if (this->m_dataTracker)
+    {
+        this->m_dataTracker->getStopWatch(DataTracker::ePhysics::SolverTime_ms).start();
+    }
+
     size_t      iterNum;
-    const auto& u      = this->m_nonLinearSystem->getUnknownVector();
-    Vectord     du     = u; // make this a class member in future
-    double      error0 = MAX_D;
+    const auto& u = this->m_nonLinearSystem->getUnknownVector();
+    if (m_du.size() != u.size())
+    {
+        m_du.setZero(u.size());
+    }
+    double error0    = MAX_D;
+    double errorPrev = MAX_D;
+    m_numIterations      = 0;
+    m_numJacobianUpdates = 0;
 
     double epsilon = m_relativeTolerance * m_relativeTolerance;
+    if (m_forcingTermPolicy != ForcingTermPolicy::None)
+    {
+        m_linearSolver->setTolerance(m_forcingTerm);
+    }
     for (iterNum = 0; iterNum < m_maxIterations; ++iterNum)
     {
-        double error = updateJacobian(u);
+        double error;
+        if (m_useModifiedNewton && m_jacobianAge < m_maxJacobianAge)
+        {
+            error = updateResidual(u);
+
+            // The reused Jacobian stalled
+            if (m_jacobianAge > 0 && iterNum > 0 && error > m_jacobianStallRatio * errorPrev)
+            {
+                error = updateJacobian(u);
+            }
+        }
+        else
+        {
+            error = updateJacobian(u);
+        }
 
         if (iterNum == 0)
         {
             error0 = error;
         }
+        else if (m_forcingTermPolicy == ForcingTermPolicy::EisenstatWalker)
+        {
+            this->updateForcingTerm(error / errorPrev, epsilon * error0, errorPrev);
+            m_linearSolver->setTolerance(m_forcingTerm);
+        }
 
-        // std::cout << "Num. of Newton Iterations: " << iterNum << "\tError ratio: " << error/error0 << ", " << error << " " << error0 << std::endl;
         if (error / error0 < epsilon && iterNum > 0)
         {
-            // std::cout << "Num. of Newton Iterations: " << iterNum << "\tError ratio: " << error/error0 << ", " << error << " " << error0 << std::endl;
             break;
         }
 
-        m_linearSolver->solve(du);
-        this->m_nonLinearSystem->m_FUpdate(du, this->m_isSemiImplicit);
+        m_linearSolver->solve(m_du);
+        m_jacobianAge++;
+        this->m_nonLinearSystem->m_FUpdate(m_du, this->m_isSemiImplicit);
+        errorPrev = error;
+        m_numIterations++;
     }
 
     this->m_nonLinearSystem->m_FUpdatePrevState();
@@ -128,6 +163,13 @@ NewtonSolver<SystemMatrix>::solve()
     {
         LOG(WARNING) << "NewtonMethod::solve - The solver did not converge after max. iterations";
     }
+
+    if (this->m_dataTracker)
+    {
+        this->m_dataTracker->probeElapsedTime_s(DataTracker::ePhysics::SolverTime_ms);
+        this->m_dataTracker->probe(DataTracker::ePhysics::NumIterations, static_cast<double>(m_numIterations));
+        this->m_dataTracker->probe(DataTracker::ePhysics::NumJacobianUpdates, static_cast<double>(m_numJacobianUpdates));
+    }
 }
 
 template<typename SystemMatrix>
@@ -159,9 +201,36 @@ NewtonSolver<SystemMatrix>::updateJacobian(const Vectord& x)
         return -1;
     }
 
-    auto linearSystem = std::make_shared<typename LinearSolverType::LinearSystemType>(A, b);
+    m_jacobianSystem = std::make_shared<typename LinearSolverType::LinearSystemType>(A, b);
     //linearSystem->setLinearProjectors(this->m_nonLinearSystem->getLinearProjectors()); /// \todo Left for near future reference. Clear in future.
-    m_linearSolver->setSystem(linearSystem);
+    m_linearSolver->setSystem(m_jacobianSystem);
+    m_jacobianAge = 0;
+    m_numJacobianUpdates++;
+
+    return std::sqrt(b.dot(b));
+}
+
+template<typename SystemMatrix>
+double
+NewtonSolver<SystemMatrix>::updateResidual(const Vectord& x)
+{
+    if (!this->m_nonLinearSystem)
+    {
+        LOG(WARNING) << "NewtonMethod::updateResidual - nonlinear system is not set to the nonlinear solver";
+        return -1;
+    }
+    if (m_jacobianSystem == nullptr)
+    {
+        return updateJacobian(x);
+    }
+
+    // The linear system refers to the rhs, the Jacobian is only kept if the function
+    // writes the same vector
+    const Vectord& b = this->m_nonLinearSystem->m_F(x, this->m_isSemiImplicit);
+    if (&b != &m_jacobianSystem->getRHSVector() || b.size() != m_jacobianSystem->getMatrix().rows())
+    {
+        return updateJacobian(x);
+    }
 
     return std::sqrt(b.dot(b));
 }
@@ -11,6 +11,17 @@
 
 namespace imstk
 {
+///
+/// \brief Policy of the forcing term of the inexact newton method, the relative tolerance
+/// NewtonSolver::solve gives the linear solver
+///
+enum class ForcingTermPolicy
+{
+    None,           ///< The tolerance of the linear solver is left untouched
+    Constant,       ///< The forcing term
+    EisenstatWalker ///< The forcing term, updated by NewtonSolver::updateForcingTerm every iteration
+};
+
 ///
 /// \class NewtonSolver
 ///
@@ -65,6 +76,7 @@ public:
     void setLinearSolver(std::shared_ptr<LinearSolverType> newLinearSolver)
     {
         m_linearSolver = newLinearSolver;
+        invalidateJacobian();
     }
 
     ///
@@ -80,6 +92,19 @@ public:
     ///
     double updateJacobian(const Vectord& x);
 
+    ///
+    /// \brief Update the residual only, keeping the Jacobian of the linear solver. Falls back to
+    /// updateJacobian when the system has no Jacobian to keep
+    ///
+    /// \param x Current iterate
+    ///
+    double updateResidual(const Vectord& x);
+
+    ///
+    /// \brief Forces the Jacobian to be recomputed at the next iteration
+    ///
+    void invalidateJacobian() { m_jacobianSystem = nullptr; }
+
     ///
     /// \brief Get JacobianMatrix. Returns jacobian matrix
     ///
@@ -181,6 +206,45 @@ public:
     ///
     double getForcingTerm() const { return m_forcingTerm; }
 
+    ///
+    /// \brief Get/Set the policy of the forcing term in solve(). Default None
+    ///@{
+    void setForcingTermPolicy(const ForcingTermPolicy policy) { m_forcingTermPolicy = policy; }
+    ForcingTermPolicy getForcingTermPolicy() const { return m_forcingTermPolicy; }
+    ///@}
+
+    ///
+    /// \brief Get/Set modified newton. solve() then keeps the Jacobian, and so the factorization
+    /// or preconditioner of the linear solver, across iterations and frames. It is recomputed
+    /// after MaxJacobianAge linear solves, or when an iteration reduces the residual norm by
+    /// less than the JacobianStallRatio. Default false
+    ///@{
+    void setUseModifiedNewton(const bool useModifiedNewton) { m_useModifiedNewton = useModifiedNewton; }
+    bool getUseModifiedNewton() const { return m_useModifiedNewton; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the maximum number of linear solves with one Jacobian in modified newton. Default 10
+    ///@{
+    void setMaxJacobianAge(const size_t maxJacobianAge) { m_maxJacobianAge = maxJacobianAge; }
+    size_t getMaxJacobianAge() const { return m_maxJacobianAge; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the ratio of consecutive residual norms above which a reused Jacobian
+    /// is recomputed in modified newton. Default 0.5
+    ///@{
+    void setJacobianStallRatio(const double ratio) { m_jacobianStallRatio = ratio; }
+    double getJacobianStallRatio() const { return m_jacobianStallRatio; }
+    ///@}
+
+    ///
+    /// \brief Returns the number of iterations/Jacobian updates of the last solve()
+    ///@{
+    size_t getNumIterations() const { return m_numIterations; }
+    size_t getNumJacobianUpdates() const { return m_numJacobianUpdates; }
+    ///@}
+
     ///
     /// \brief Set the Newton solver to be fully implicit
     ///
@@ -208,5 +272,16 @@ private:
     size_t m_maxIterations;                           ///< Maximum number of nonlinear iterations
     bool   m_useArmijo;                               ///< True if Armijo liner search is desired
     std::vector<double> m_fnorms;                     ///< Consecutive function norms
+
+    ForcingTermPolicy m_forcingTermPolicy = ForcingTermPolicy::None;
+    bool   m_useModifiedNewton  = false;
+    size_t m_maxJacobianAge     = 10;
+    double m_jacobianStallRatio = 0.5;
+
+    std::shared_ptr<typename LinearSolverType::LinearSystemType> m_jacobianSystem; ///< System of the last Jacobian update
+    size_t  m_jacobianAge = 0;                        ///< Number of linear solves with the current Jacobian
+    Vectord m_du;                                     ///< Last increment, initial guess of the next linear solve
+    size_t  m_numIterations      = 0;
+    size_t  m_numJacobianUpdates = 0;
 };
 } // namespace imstk
\ No newline at end of file
@@ -8,13 +8,15 @@
 #include "imstkLogger.h"
 #include "imstkParallelUtils.h"
 #include "imstkPbdCollisionConstraint.h"
+#include "imstkPbdConstraintBatch.h"
 #include "imstkPbdConstraintContainer.h"
 
 namespace imstk
 {
 PbdSolver::PbdSolver() :
     m_constraints(std::make_shared<PbdConstraintContainer>()),
-    m_constraintLists(std::make_shared<std::list<std::vector<PbdConstraint*>*>>())
+    m_constraintLists(std::make_shared<std::list<std::vector<PbdConstraint*>*>>()),
+    m_batches(std::make_shared<PbdConstraintBatches>())
 {
 }
 
@@ -33,21 +35,36 @@ PbdSolver::solve()
     double averageC      = 0.0;
     double averageLambda = 0.0;
     numConstraints += constraints.size();
-    // Zero out the Lagrange multiplier
-    for (const auto& constraint : constraints)
+    if (m_useBatching)
     {
-        constraint->zeroOutLambda();
+        if (!m_batches->isBuiltFrom(*m_constraints))
+        {
+            m_batches->build(*m_constraints);
+        }
+        for (const auto& constraintPartition : partitionedConstraints)
+        {
+            numConstraints += constraintPartition.size();
+        }
+        m_batches->beginSolve();
     }
-
-    // Zero out paritioned constraints
-    for (const auto& constraintPartition : partitionedConstraints)
+    else
     {
-        numConstraints += constraints.size();
-        ParallelUtils::parallelFor(constraintPartition.size(),
-            [&](const size_t idx)
-            {
-                constraintPartition[idx]->zeroOutLambda();
-            });
+        // Zero out the Lagrange multiplier
+        for (const auto& constraint : constraints)
+        {
+            constraint->zeroOutLambda();
+        }
+
+        // Zero out paritioned constraints
+        for (const auto& constraintPartition : partitionedConstraints)
+        {
+            numConstraints += constraints.size();
+            ParallelUtils::parallelFor(constraintPartition.size(),
+                [&](const size_t idx)
+                {
+                    constraintPartition[idx]->zeroOutLambda();
+                });
+        }
     }
 
     // Zero out insertion/collision constraints
@@ -65,36 +82,59 @@ PbdSolver::solve()
     while (i++ < m_iterations)
     {
         // Project collision and all external constraints
+        auto partitionsIter = m_constraintListPartitions.begin();
         for (auto constraintList : *m_constraintLists)
         {
             const std::vector<PbdConstraint*>& constraintVec = *constraintList;
-            for (size_t j = 0; j < constraintVec.size(); j++)
+            const std::vector<size_t>*         offsets       = *partitionsIter++;
+            size_t                             sequentialStart = 0;
+            if (offsets != nullptr && !offsets->empty())
+            {
+                for (size_t k = 0; k + 1 < offsets->size(); k++)
+                {
+                    ParallelUtils::parallelFor((*offsets)[k], (*offsets)[k + 1],
+                        [&](const size_t idx)
+                        {
+                            constraintVec[idx]->projectConstraint(*m_state, m_dt, m_solverType);
+                        });
+                }
+                sequentialStart = offsets->back();
+            }
+            for (size_t j = sequentialStart; j < constraintVec.size(); j++)
             {
                 constraintVec[j]->projectConstraint(*m_state, m_dt, m_solverType);
             }
         }
 
         // Project all internal body constraints
-        for (const auto& constraint : constraints)
+        if (m_useBatching)
         {
-            constraint->projectConstraint(*m_state, m_dt, m_solverType);
+            m_batches->projectConstraints(*m_state, m_dt, m_solverType);
         }
-
-        for (const auto& constraintPartition : partitionedConstraints)
+        else
         {
-            ParallelUtils::parallelFor(constraintPartition.size(),
-                [&](const size_t idx)
-                {
-                    constraintPartition[idx]->projectConstraint(*m_state, m_dt, m_solverType);
-                });
-            //// Sequential
-            //for (size_t k = 0; k < constraintPartition.size(); k++)
-            //{
-            //    constraintPartition[k]->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
-            //}
+            for (const auto& constraint : constraints)
+            {
+                constraint->projectConstraint(*m_state, m_dt, m_solverType);
+            }
+
+            for (const auto& constraintPartition : partitionedConstraints)
+            {
+                ParallelUtils::parallelFor(constraintPartition.size(),
+                    [&](const size_t idx)
+                    {
+                        constraintPartition[idx]->projectConstraint(*m_state, m_dt, m_solverType);
+                    });
+            }
         }
     }
 
+    if (m_useBatching)
+    {
+        // Write lambda & C back to the constraints
+        m_batches->endSolve();
+    }
+
     if (m_dataTracker)
     {
         m_dataTracker->probeElapsedTime_s(DataTracker::ePhysics::SolverTime_ms);
@@ -11,6 +11,7 @@
 
 namespace imstk
 {
+class PbdConstraintBatches;
 class PbdConstraintContainer;
 
 ///
@@ -39,11 +40,26 @@ public:
 
     ///
     /// \brief Add a constraint list to this solver to be solved, for quick addition/removal
-    /// particularly collision.
+    /// particularly collision. If partition offsets are given, constraints
+    /// [offsets[i], offsets[i + 1]) share no particle and are projected in parallel,
+    /// the remaining [offsets.back(), size) sequentially. See PbdConstraintColoring.
+    /// A list added again, ie: handled again on a substep, is kept once with the new offsets
     ///
-    void addConstraints(std::vector<PbdConstraint*>* constraints)
+    void addConstraints(std::vector<PbdConstraint*>* constraints,
+                        const std::vector<size_t>*   partitionOffsets = nullptr)
     {
+        auto partitionsIter = m_constraintListPartitions.begin();
+        for (auto constraintList : *m_constraintLists)
+        {
+            if (constraintList == constraints)
+            {
+                *partitionsIter = partitionOffsets;
+                return;
+            }
+            partitionsIter++;
+        }
         m_constraintLists->push_back(constraints);
+        m_constraintListPartitions.push_back(partitionOffsets);
     }
 
     ///
@@ -66,6 +82,16 @@ public:
     ///
     void setSolverType(const PbdConstraint::SolverType& type) { m_solverType = type; }
 
+    ///
+    /// \brief Set/Get whether the internal constraints are solved through
+    /// structure-of-arrays batches with non-virtual kernels. Distance, volume and
+    /// dihedral constraints are batched, other types fall back to virtual projection.
+    /// Batches are rebuilt whenever the constraint container is modified.
+    ///@{
+    void setUseBatching(const bool useBatching) { m_useBatching = useBatching; }
+    bool getUseBatching() const { return m_useBatching; }
+    ///@}
+
     ///
     /// \brief Solve the non linear system of equations G(x)=0 using Newton's method.
     ///
@@ -79,7 +105,11 @@ public:
     ///
     /// \brief Clear all collision constraints
     ///
-    void clearConstraintLists() { m_constraintLists->clear(); }
+    void clearConstraintLists()
+    {
+        m_constraintLists->clear();
+        m_constraintListPartitions.clear();
+    }
 
 private:
     size_t m_iterations = 20;                                        ///< Number of NL Gauss-Seidel iterations for constraints
@@ -89,8 +119,12 @@ private:
 
     ///< For quick addition
     std::shared_ptr<std::list<std::vector<PbdConstraint*>*>> m_constraintLists = nullptr;
+    std::list<const std::vector<size_t>*> m_constraintListPartitions; ///< Partition offsets of each list, nullptr if sequential
 
     PbdState* m_state = nullptr;
     PbdConstraint::SolverType m_solverType = PbdConstraint::SolverType::xPBD;
+
+    bool m_useBatching = false;
+    std::shared_ptr<PbdConstraintBatches> m_batches = nullptr; ///< Batched mirror of m_constraints
 };
 } // namespace imstk
\ No newline at end of file
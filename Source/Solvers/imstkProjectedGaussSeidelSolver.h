@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkMath.h"
+#include "imstkParallelFor.h"
 
 namespace imstk
 {
@@ -15,16 +16,29 @@ namespace imstk
 ///
 /// \brief Solves a linear system using the projected gauss seidel method.
 /// Only good for diagonally dominant systems, must have elements on diagonals though.
-/// The initial guess (start) is always zero, convergence value may be specified
-/// with epsilon, relaxation decreases the step size (useful when may rows exist in
-/// A)
+/// The initial guess (start) is zero unless one is given with setGuess, convergence
+/// value may be specified with epsilon, relaxation decreases the step size (useful
+/// when may rows exist in A)
+///
+/// Rows are swept in compressed row order so an iteration costs the number of
+/// nonzeros of A. With graph coloring rows that do not reference each other are
+/// grouped and every group is swept in parallel, which changes the order rows are
+/// updated in but not the solution converged to.
 ///
 template<typename Scalar>
 class ProjectedGaussSeidelSolver
 {
 public:
-    // Sets the vector to be used for the solve
-    //void setGuess(Matrix<Scalar, -1, 1>& g) { x = g; }
+    using RowMajorMatrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+    using Vector         = Eigen::Matrix<Scalar, -1, 1>;
+
+public:
+    ///
+    /// \brief Sets the initial guess of the next solve, ie: the solution of the
+    /// previous frame for warm starting. Ignored if it does not match the size of b
+    ///
+    void setGuess(const Vector& g) { m_guess = g; }
+
     void setA(Eigen::SparseMatrix<Scalar>* A) { this->m_A = A; }
 
     ///
@@ -36,6 +50,7 @@ public:
     /// \brief Similar to step size can be used to avoid overshooting the solution
     ///
     void setRelaxation(const Scalar relaxation) { this->m_relaxation = relaxation; }
+    Scalar getRelaxation() const { return m_relaxation; }
 
     ///
     /// \brief Stops when energy=(x_i+1-x_i).norm() < epsilon, when the solution isn't
@@ -43,70 +58,182 @@ public:
     ///
     void setEpsilon(const Scalar epsilon) { this->m_epsilon = epsilon; }
 
+    ///
+    /// \brief Sweep independent rows in parallel, default false
+    ///
+    void setUseGraphColoring(const bool useGraphColoring) { this->m_useGraphColoring = useGraphColoring; }
+
     ///
     /// \brief Energy is defined as energy=(x_i+1-x_i).norm()
     ///
     const double getEnergy() const { return m_conv; }
 
-    Eigen::Matrix<Scalar, -1, 1>& solve(const Eigen::Matrix<Scalar, -1, 1>& b, const Eigen::Matrix<Scalar, -1, 2>& cu)
+    ///
+    /// \brief Number of colors of the last solve with graph coloring
+    ///
+    int getNumColors() const { return static_cast<int>(m_colorOffsets.size()) - 1; }
+
+    Vector& solve(const Vector& b, const Eigen::Matrix<Scalar, -1, 2>& cu)
     {
-        const Eigen::SparseMatrix<Scalar>& A = *m_A;
+        // Rows are visited in order, so store them contiguously
+        m_rowA = *m_A;
+        const Eigen::Index numRows = m_rowA.rows();
+
+        // Start from the guess if given
+        if (m_guess.size() == b.rows())
+        {
+            m_x = m_guess;
+        }
+        else
+        {
+            m_x.setZero(b.rows());
+        }
+        m_guess.resize(0);
 
-        // Allocate new results
-        m_x = Eigen::Matrix<Scalar, -1, 1>(b.rows());
-        m_x.setZero();
+        // PGS can't converge for non-diagonal elements so its assumed
+        // we have these
+        m_invDiag.resize(numRows);
+        for (Eigen::Index r = 0; r < numRows; r++)
+        {
+            m_invDiag[r] = static_cast<Scalar>(1.0) / m_rowA.coeff(r, r);
+        }
 
-        m_conv = 0.0;
+        if (m_useGraphColoring)
+        {
+            colorRows();
+        }
 
-        // Naive implementation of PGS
-        // Consider graph coloring and TBB parallizing
-        Eigen::Matrix<Scalar, -1, 1> xOld;
+        m_conv = 0.0;
         for (unsigned int i = 0; i < m_maxIterations; i++)
         {
-            xOld = m_x;
-            for (Eigen::Index r = 0; r < A.rows(); r++)
+            m_xOld = m_x;
+            if (m_useGraphColoring)
             {
-                Scalar delta = 0.0;
-
-                // Sum up rows (skip r)
-                for (Eigen::Index c = 0; c < r; c++)
+                for (int color = 0; color < getNumColors(); color++)
                 {
-                    delta += A.coeff(r, c) * m_x[c];
+                    const int start = m_colorOffsets[color];
+                    ParallelUtils::parallelFor(m_colorOffsets[color + 1] - start,
+                        [&](const int j) { updateRow(m_colorRows[start + j], b, cu); });
                 }
-                for (Eigen::Index c = r + 1; c < A.cols(); c++)
+            }
+            else
+            {
+                for (Eigen::Index r = 0; r < numRows; r++)
                 {
-                    delta += A.coeff(r, c) * m_x[c];
+                    updateRow(r, b, cu);
                 }
-
-                // PGS can't converge for non-diagonal elements so its assumed
-                // we have these
-                delta = (b[r] - delta) / A.coeff(r, r);
-                // Apply relaxation factor
-                m_x(r) += m_relaxation * (delta - m_x(r));
-                // Do projection *every iteration*
-                m_x(r) = std::min(cu(r, 1), std::max(cu(r, 0), m_x(r)));
             }
 
             // Check convergence
-            m_conv = (m_x - xOld).norm();
-            //printf(" %d: %f\n", i, m_conv);
+            m_conv = (m_x - m_xOld).norm();
             if (m_conv < m_epsilon)
             {
-                //printf("Eps: %f\n", conv);
                 return m_x;
             }
         }
 
-        //printf("Eps: %f\n", conv);
         return m_x;
     }
 
+protected:
+    ///
+    /// \brief Relaxed and projected update of one unknown
+    ///
+    void updateRow(const Eigen::Index r, const Vector& b, const Eigen::Matrix<Scalar, -1, 2>& cu)
+    {
+        // Sum up row (skip r)
+        Scalar delta = 0.0;
+        for (typename RowMajorMatrix::InnerIterator it(m_rowA, r); it; ++it)
+        {
+            if (it.col() != r)
+            {
+                delta += it.value() * m_x[it.col()];
+            }
+        }
+
+        delta = (b[r] - delta) * m_invDiag[r];
+        // Apply relaxation factor
+        m_x[r] += m_relaxation * (delta - m_x[r]);
+        // Do projection *every iteration*
+        m_x[r] = std::min(cu(r, 1), std::max(cu(r, 0), m_x[r]));
+    }
+
+    ///
+    /// \brief Greedily colors the rows such that no two rows of a color reference
+    /// each other, then groups the rows by color
+    ///
+    void colorRows()
+    {
+        const int numRows = static_cast<int>(m_rowA.rows());
+
+        // Rows r and c conflict if either references the other
+        const RowMajorMatrix transposed = m_rowA.transpose();
+        m_rowColors.assign(numRows, -1);
+        m_colorUsedBy.clear();
+        int numColors = 0;
+        for (int r = 0; r < numRows; r++)
+        {
+            auto markNeighbors = [&](const RowMajorMatrix& mat)
+                                 {
+                                     for (typename RowMajorMatrix::InnerIterator it(mat, r); it; ++it)
+                                     {
+                                         const int color = m_rowColors[it.col()];
+                                         if (color != -1)
+                                         {
+                                             m_colorUsedBy[color] = r;
+                                         }
+                                     }
+                                 };
+            markNeighbors(m_rowA);
+            markNeighbors(transposed);
+
+            int color = 0;
+            while (color < numColors && m_colorUsedBy[color] == r)
+            {
+                color++;
+            }
+            if (color == numColors)
+            {
+                m_colorUsedBy.push_back(-1);
+                numColors++;
+            }
+            m_rowColors[r] = color;
+        }
+
+        // Counting sort of the rows by color
+        m_colorOffsets.assign(numColors + 1, 0);
+        for (int r = 0; r < numRows; r++)
+        {
+            m_colorOffsets[m_rowColors[r] + 1]++;
+        }
+        for (int color = 0; color < numColors; color++)
+        {
+            m_colorOffsets[color + 1] += m_colorOffsets[color];
+        }
+        m_colorRows.resize(numRows);
+        m_colorUsedBy.assign(m_colorOffsets.begin(), m_colorOffsets.end() - 1);
+        for (int r = 0; r < numRows; r++)
+        {
+            m_colorRows[m_colorUsedBy[m_rowColors[r]]++] = r;
+        }
+    }
+
 private:
     unsigned int m_maxIterations = 3;
     Scalar       m_relaxation    = static_cast<Scalar>(0.1);
     Scalar       m_epsilon       = 1.0e-4; ///< Convergence criteria
     Scalar       m_conv = 0.0;
-    Eigen::Matrix<Scalar, -1, 1> m_x;      ///< Results
+    bool         m_useGraphColoring = false;
+    Vector       m_x;                      ///< Results
+    Vector       m_xOld;
+    Vector       m_guess;
+    Vector       m_invDiag;
     Eigen::SparseMatrix<Scalar>* m_A = nullptr;
+    RowMajorMatrix   m_rowA;
+
+    std::vector<int> m_rowColors;
+    std::vector<int> m_colorUsedBy;  ///< Scratch, last row a color was seen next to, then fill position
+    std::vector<int> m_colorOffsets = { 0 };
+    std::vector<int> m_colorRows;    ///< Rows ordered by color
 };
 } // namespace imstk
\ No newline at end of file
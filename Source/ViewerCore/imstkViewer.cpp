@@ -78,7 +78,7 @@ Viewer::updateFps()
 void
 Viewer::updateModule()
 {
-    this->postEvent(Event(Module::preUpdate()));
-    this->postEvent(Event(Module::postUpdate()));
+    this->postEvent(Event(Module::preUpdateId()));
+    this->postEvent(Event(Module::postUpdateId()));
 }
 } // namespace imstk